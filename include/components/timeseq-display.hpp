@@ -1,13 +1,10 @@
 #pragma once
 #include <rack.hpp>
+#include "core/timeseq-core.hpp"
 using namespace rack;
 
 const int TIMESEQ_DISPLAY_WINDOW_SIZE = 256;
 
-namespace timeseq {
-	struct TimeSeqCore;
-}
-
 
 struct TimeSeqVoltagePoints {
 	TimeSeqVoltagePoints(int id): id(id), age(0), voltage(0.f) {}
@@ -30,21 +27,27 @@ struct TimeSeqDisplay : widget::Widget {
 
 	void onResize(const ResizeEvent& e) override;
 
-	void processChangedVoltages(std::vector<int>& changedVoltages, std::array<std::array<float, 16>, 8>& outputVoltages);
+	void processChangedVoltages(const std::array<uint16_t, 8>& changedChannels, const std::array<std::array<float, 16>, 8>& outputVoltages);
 	void ageVoltages();
 	void reset();
+	// Takes over the most recent progress of the core and its lanes
+	void processProgress(const timeseq::TimeSeqCore::ProgressSnapshot& progress);
 
 	void setError(bool error);
 	void setAssert(bool assert);
-	void setTimeSeqCore(timeseq::TimeSeqCore* timeSeqCore);
 
 	private:
 		TimeSeqDisplayAnimCoords m_animCoords;
-		timeseq::TimeSeqCore* m_timeSeqCore = nullptr;
+		// The display only shows actual data once it received progress from a module
+		bool m_hasProgress = false;
+		timeseq::TimeSeqCore::ProgressSnapshot m_progress;
 		std::vector<TimeSeqVoltagePoints> m_voltagePoints;
 		std::vector<TimeSeqVoltagePoints> m_dummyVoltagePoints;
 		bool m_error = false;
 		bool m_assert = false;
 
 		float m_arcDelta = 0.f;
+
+		void processChangedVoltage(int id, const std::array<std::array<float, 16>, 8>& outputVoltages);
+		void drawLaneProgress(const DrawArgs& args, float bottom);
 };
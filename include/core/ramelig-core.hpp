@@ -2,8 +2,9 @@
 
 #include <array>
 #include <vector>
-#include <random>
 #include <memory>
+#include <cstdint>
+#include "util/quantizer.hpp"
 
 
 enum RameligActions {
@@ -48,6 +49,8 @@ struct RameligChanceGenerator {
 	virtual ~RameligChanceGenerator() {};
 	virtual float generateJumpChance(float lower, float upper) = 0;
 	virtual float generateActionChance(float lower, float upper) = 0;
+	// Restarts the generated chances from the given seed
+	virtual void seed(uint64_t seed) {};
 };
 
 struct RameligActionListener {
@@ -69,7 +72,7 @@ struct RameligScale {
 		std::array<float, 12> m_notes;
 		std::vector<int> m_scale;
 
-		std::vector<float> m_quantizationValues;
+		Quantizer m_quantizer;
 
 		void calculateQuantization();
 };
@@ -79,6 +82,7 @@ struct RameligCore {
 	RameligCore(int id, std::shared_ptr<RameligScale> rameligScale, RameligActionListener *actionListener, RameligChanceGenerator* chanceGenerator);
 	~RameligCore();
 
+	void seed(uint64_t seed);
 	void guideLast(float value);
 	float process(RameligDistributionData& data, bool forceJump, bool forceShift, bool forceStay, float lowerLimit, float upperLimit);
 
@@ -2,8 +2,8 @@
 
 #include <array>
 #include <vector>
-#include <random>
 #include <memory>
+#include <cstdint>
 
 
 #define RATRILIG_INDEX_WRAP_ON_ADVANCE 1024
@@ -68,6 +68,8 @@ struct RatriligChanceGenerator {
 	virtual float generateDensityModifier() = 0;
 	// Range of [0, 1] (don't trigger to trigger)
 	virtual float generateTrigger() = 0;
+	// Restarts the generated chances from the given seed
+	virtual void seed(uint64_t seed) {};
 };
 
 struct RatriligCoreListener {
@@ -88,6 +90,7 @@ struct RatriligCoreProcessor {
 	virtual ~RatriligCoreProcessor();
 
 	virtual void setState(std::shared_ptr<RatriligCoreState> state);
+	virtual void seed(uint64_t seed);
 
 	virtual void advanceCluster(RatriligData& data, RatriligProcessorProgress& progress);
 	virtual void advancePhrase(RatriligData& data, RatriligProcessorProgress& progress);
@@ -115,6 +118,7 @@ struct RatriligCore {
 
 	void process(RatriligData& data);
 	void reset();
+	void seed(uint64_t seed);
 	bool isHigh();
 
 	private:
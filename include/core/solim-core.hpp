@@ -1,6 +1,8 @@
 #pragma once
 #include <array>
 #include <functional>
+#include <cstdint>
+#include "util/random.hpp"
 
 
 enum RandomTrigger {
@@ -103,8 +105,11 @@ struct SolimCoreRandomizer {
 	virtual ~SolimCoreRandomizer();
 
 	virtual void process(int columnCount, std::array<RandomTrigger, 8>* randomTriggers, std::array<SolimValueSet, 8>& oldValueSet, std::array<SolimValueSet, 8>& newValueSet);
+	// Restarts the randomization from the given seed. Only applies if the randomizer uses its own random generator.
+	virtual void seed(uint64_t seed);
 
 	private:
+		RandomGenerator m_generator;
 		SolimCoreRandomSource m_rng;
 		bool m_previousWasRandom = false;
 		int m_previousColumnCount = 0;
@@ -121,6 +126,7 @@ struct SolimCore {
 	virtual SolimValueSet& getInactiveValues(int index = 0);
 
 	virtual void processAndActivateInactiveValues(int columnCount, std::array<RandomTrigger, 8>* randomTriggers);
+	virtual void seed(uint64_t seed);
 
 	private:
 		SolimCoreProcessor* m_processor;
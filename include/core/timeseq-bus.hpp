@@ -0,0 +1,119 @@
+#pragma once
+
+#include "core/timeseq-core.hpp"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <unordered_map>
+#include <memory>
+
+// The number of distinct bus variables that can be shared between all TimeSeq instances
+#define TIMESEQ_BUS_SIZE 256
+// The prefix of the variable names that are shared through the variable bus
+#define TIMESEQ_BUS_PREFIX "bus:"
+
+
+namespace timeseq {
+
+/**
+ * A single shared variable of the variable bus. Values that are written during a frame only become visible to readers
+ * in the next frame, so the value that a TimeSeq instance reads doesn't depend on the order in which the instances are
+ * processed. If multiple instances write the same variable during a frame, the last write wins.
+ * The value is kept together with the frame in which it was written in a single atomic, so reading and writing never
+ * locks. The value of the previous frame is kept next to it for readers that come after a writer in the same frame.
+ */
+struct VariableBusSlot : VariableHandler {
+	// The name is ignored: a slot is bound to its variable name when the script is loaded
+	float getVariable(const std::string& name) const override {
+		uint32_t frame = m_frame->load(std::memory_order_relaxed);
+		uint64_t current = m_current.load(std::memory_order_acquire);
+		if ((uint32_t) (current >> 32) == frame) {
+			current = m_previous.load(std::memory_order_relaxed);
+		}
+		return unpack(current);
+	}
+
+	void setVariable(const std::string& name, float value) override {
+		uint32_t frame = m_frame->load(std::memory_order_relaxed);
+		uint64_t current = m_current.load(std::memory_order_relaxed);
+		if ((uint32_t) (current >> 32) != frame) {
+			m_previous.store(current, std::memory_order_relaxed);
+		}
+		m_current.store(pack(value, frame), std::memory_order_release);
+	}
+
+	nt_private:
+		std::atomic<uint64_t> m_current { 0 };
+		std::atomic<uint64_t> m_previous { 0 };
+		const std::atomic<uint32_t>* m_frame = nullptr;
+
+		static uint64_t pack(float value, uint32_t frame) {
+			uint32_t bits;
+			memcpy(&bits, &value, sizeof(bits));
+			return ((uint64_t) frame << 32) | bits;
+		}
+
+		static float unpack(uint64_t packed) {
+			uint32_t bits = (uint32_t) packed;
+			float value;
+			memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+	friend struct VariableBus;
+};
+
+/**
+ * A fixed set of variables that is shared between all TimeSeq instances of the plugin. Variable names are bound to a
+ * slot when a script is loaded, so the processing thread only reads and writes the atomics of that slot.
+ * Slots are reference counted: once the last loaded script that uses a name releases it, the slot is cleared and can
+ * be bound to another name.
+ */
+struct VariableBus {
+	VariableBus();
+
+	// The bus that is shared by all TimeSeq modules
+	static VariableBus& global();
+
+	// Returns the slot of a bus variable and adds a reference to it, binding a free slot to the name if needed.
+	// Returns nullptr if all slots are in use. Called while loading a script, never from the processing thread.
+	VariableBusSlot* resolve(const std::string& name);
+	// Removes a reference that was added by resolve. Called when a script is unloaded, never from the processing thread.
+	void release(const std::string& name);
+
+	// Moves the bus to the specified engine frame. Every instance sets the same frame before processing it.
+	void setFrame(uint64_t frame) {
+		m_frame.store((uint32_t) frame, std::memory_order_relaxed);
+	}
+
+	nt_private:
+		VariableBusSlot m_slots[TIMESEQ_BUS_SIZE];
+		std::atomic<uint32_t> m_frame { 0 };
+
+		std::mutex m_namesMutex;
+		std::unordered_map<std::string, int> m_names;
+		int m_references[TIMESEQ_BUS_SIZE] = {};
+};
+
+/**
+ * The bus variables that are used by one loaded script. Each name is only referenced once, no matter how often the
+ * script uses it, and all references are released when the script processor that owns this object is destroyed.
+ * The lane parser workers share the same instance, so resolving is thread-safe.
+ */
+struct VariableBusReferences {
+	VariableBusReferences(VariableBus* variableBus);
+	~VariableBusReferences();
+
+	// Returns the slot of a bus variable, or nullptr if all slots of the bus are in use
+	VariableBusSlot* resolve(const std::string& name);
+
+	nt_private:
+		VariableBus* m_variableBus;
+
+		std::mutex m_slotsMutex;
+		std::unordered_map<std::string, VariableBusSlot*> m_slots;
+};
+
+}
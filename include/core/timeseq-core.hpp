@@ -4,8 +4,12 @@
 #include <vector>
 #include <memory>
 #include <cstdint>
+#include <array>
 #include <unordered_map>
+#include <atomic>
 #include "timeseq-validation.hpp"
+#include "timeseq-profiler.hpp"
+#include "timeseq-tracer.hpp"
 
 #ifndef nt_private
 	#define nt_private private
@@ -17,12 +21,20 @@ struct JsonLoader;
 struct ProcessorLoader;
 struct Script;
 struct Processor;
+struct ProcessorCostReport;
+struct ProcessorMemoryReport;
 
 struct PortHandler {
 	virtual float getInputPortVoltage(int index, int channel) const = 0;
+	// Fills voltages (16 entries) with the voltages of the input channels in channelMask. Entries of other channels may be left untouched.
+	// The default implementation calls getInputPortVoltage for each channel in channelMask.
+	virtual void getInputPortVoltages(int index, float* voltages, uint16_t channelMask) const;
 	virtual float getOutputPortVoltage(int index, int channel) const = 0;
 
 	virtual void setOutputPortVoltage(int index, int channel, float voltage) = 0;
+	// Sets the voltages of count consecutive channels of an output, starting at the specified channel.
+	// The default implementation calls setOutputPortVoltage for each channel.
+	virtual void setOutputPortVoltages(int index, int channel, const float* voltages, int count);
 	virtual void setOutputPortChannels(int index, int channels) = 0;
 
 	virtual void setOutputPortLabel(int index, const std::string& label) = 0;
@@ -38,8 +50,29 @@ struct TriggerHandler {
 	virtual void setTrigger(const std::string& name) = 0;
 };
 
+// The operands of a failed assert expectation, collected without allocations on the processing thread so that the
+// message can be formatted on the UI thread. The terms are stored in the order of a depth-first walk over the conditions.
+struct AssertExpectation {
+	struct Term {
+		// The operator between the values of a comparison, or between the conditions of an and/or combination
+		const char* operatorName;
+		bool combination;
+		// The number of conditions of a combination, their terms follow this term
+		int conditionCount;
+		double value1;
+		double value2;
+	};
+
+	std::array<Term, 32> terms;
+	int termCount = 0;
+
+	// Returns the next term to fill in, or nullptr if the expectation has no room left
+	Term* addTerm();
+	std::string format() const;
+};
+
 struct AssertListener {
-	virtual void assertFailed(const std::string& name, const std::string& message, bool stop) = 0;
+	virtual void assertFailed(const std::string& name, const AssertExpectation& expectation, bool stop) = 0;
 };
 
 struct SampleRateReader {
@@ -53,34 +86,106 @@ struct EventListener {
 	virtual void scriptReset() = 0;
 };
 
-struct TimeSeqCore : VariableHandler, TriggerHandler {
+struct ScriptBankHandler {
+	// Requests a switch to the script at the (zero-based) index of the script bank
+	virtual void selectScript(int index) = 0;
+};
+
+// Where a lane is in its segments
+struct LaneProgress {
+	bool active = false;
+	// The index of the active segment, and the number of segments in the lane
+	int segment = 0;
+	int segmentCount = 0;
+	// How far the active segment has progressed, from 0 to 1
+	float position = 0.f;
+	// The number of times the lane looped or repeated since it was started
+	int loops = 0;
+};
+
+struct TimeSeqCore : VariableHandler, TriggerHandler, ScriptBankHandler {
 	enum Status { EMPTY, LOADING, RUNNING, PAUSED };
 
+	// The maximum number of lanes that are included in a progress snapshot
+	static constexpr int PROGRESS_LANES = 32;
+
+	// The progress of the core and its lanes at one point in time. It has a fixed size, so it can be handed from the
+	// processing thread to the UI thread without any allocations.
+	struct ProgressSnapshot {
+		Status status = Status::EMPTY;
+		uint32_t sampleRate = 48000;
+		uint32_t elapsedSamples = 0;
+		// The number of entries in lanes that are in use
+		int laneCount = 0;
+		std::array<LaneProgress, PROGRESS_LANES> lanes;
+	};
+
+	// The number of precompiled scripts that can be kept in the script bank
+	static constexpr int SCRIPT_BANK_SIZE = 8;
+
 	TimeSeqCore(PortHandler* portHandler, const SampleRateReader* sampleRateReader, EventListener* eventListener, AssertListener* assertListener);
 	TimeSeqCore(std::shared_ptr<JsonLoader> jsonLoader, std::shared_ptr<ProcessorLoader> processorLoader, const SampleRateReader* sampleRateReader, EventListener* eventListener);
 	virtual ~TimeSeqCore();
 
+	// Loads a script in the active slot of the script bank
 	const std::vector<timeseq::ValidationError> loadScript(const std::string& scriptData);
+	// Loads a script in a slot of the script bank. The script is fully compiled, so selecting it later on doesn't require any parsing.
+	const std::vector<timeseq::ValidationError> loadScript(int index, const std::string& scriptData);
+	// Loads a script from memory that is owned by the caller (e.g. a memory-mapped script file) without copying it. Only the
+	// parsed script and its compiled processors are kept once loading is done.
+	const std::vector<timeseq::ValidationError> loadScript(int index, const char* scriptData, size_t size);
+	// Recompiles all scripts in the script bank
 	void reloadScript();
+	// Clears the script in the active slot of the script bank
 	void clearScript();
+	void clearScript(int index);
+
+	// Switches to another script of the script bank at the start of the next processed sample.
+	// The variables, triggers and output voltages are kept, and the new script starts from its beginning.
+	void selectScript(int index) override;
+	int getActiveScript() const;
+	bool hasScript(int index) const;
 
 	Status getStatus() const;
 
 	void start(int sampleDelay);
 	void pause();
 	void reset();
+	// Resets the script on the next processing cycle and moves it ahead by the specified number of samples
+	void seek(uint64_t samples);
 
 	void process(int rate);
 
+	// If a fixed random seed is set, the random values restart from that seed each time the script is reset
+	void setRandomSeed(bool fixed, uint64_t seed);
+	// Switches between exact and approximated calculations. All scripts in the bank are reloaded to apply the change,
+	// which restarts the active script.
+	void setFastMath(bool fastMath);
+
 	float getVariable(const std::string& name) const override;
 	void setVariable(const std::string& name, float value) override;
 
 	const std::vector<std::string>& getTriggers() const override;
 	void setTrigger(const std::string& name) override;
 
+	// The cost report of the currently loaded script, or nullptr if no script is loaded
+	const ProcessorCostReport* getCostReport() const;
+	// The memory report of the currently loaded script, or nullptr if no script is loaded
+	const ProcessorMemoryReport* getMemoryReport() const;
+
+	// The tracer that records the events of the script processing
+	EventTracer& getEventTracer();
+
+	#ifdef __NT_TIMESEQ_PROFILING__
+		// The profiling counters of the currently loaded script
+		std::vector<ProfilerEntry> getProfile() const;
+	#endif
+
 	uint32_t getCurrentSampleRate() const;
 	uint32_t getElapsedSamples() const;
 	void resetElapsedSamples();
+	// Fills the snapshot with the current progress of the core. Should only be called from the processing thread.
+	void getProgress(ProgressSnapshot& snapshot) const;
 
 	nt_private:
 		Status m_status = Status::EMPTY;
@@ -93,20 +198,51 @@ struct TimeSeqCore : VariableHandler, TriggerHandler {
 		std::shared_ptr<ProcessorLoader> m_processorLoader;
 
 		bool m_reset = false;
-		std::shared_ptr<Script> m_script;
-		std::shared_ptr<Processor> m_processor;
+		// A seek is requested from the UI thread, which publishes the seek samples through the seek flag
+		std::atomic<bool> m_seek = { false };
+		std::atomic<uint64_t> m_seekSamples = { 0 };
+		bool m_fixedRandomSeed = false;
+		uint64_t m_randomSeed = 0;
+
+		// The scripts, processors and reports of the script bank. These are only assigned and released on the UI thread.
+		struct BankedScript {
+			std::shared_ptr<Script> script;
+			std::shared_ptr<Processor> processor;
+			std::shared_ptr<ProcessorCostReport> costReport;
+			std::shared_ptr<ProcessorMemoryReport> memoryReport;
+		};
+		BankedScript m_scriptBank[SCRIPT_BANK_SIZE];
+		// The processors of the script bank as seen by the processing thread, published by the UI thread when a slot changes
+		std::array<std::atomic<Processor*>, SCRIPT_BANK_SIZE> m_bankedProcessors = {};
+		// The active script is only changed by the processing thread, the selected script can be set from any thread
+		std::atomic<int> m_activeScript = { 0 };
+		std::atomic<int> m_selectedScript = { 0 };
 		// The loading of a new processor happens on another thread than the processing thread.
-		// If that happens while we're processing, keep the "old" processor referenced as dangling so it doesn't get immediately destroyed
-		std::vector<std::shared_ptr<Processor>> m_danglingProcessors;
+		// If that happens while we're processing, keep the "old" processor referenced as dangling until the processing thread
+		// has completed a process cycle after it was replaced, so it doesn't get destroyed while it is still in use.
+		struct DanglingProcessor {
+			std::shared_ptr<Processor> processor;
+			uint64_t processCycle;
+		};
+		std::vector<DanglingProcessor> m_danglingProcessors;
+		std::atomic<uint64_t> m_processCycles = { 0 };
 
 		std::unordered_map<std::string, float> m_variables;
 		std::vector<std::string> m_triggers[2];
 		bool m_triggerIdx = false;
 
+		EventTracer m_eventTracer;
+
 		EventListener* m_eventListener;
 		const SampleRateReader* m_sampleRateReader;
 
 		void processReset();
+		void processSeek();
+		void processSelectScript();
+
+		Processor* getActiveProcessor() const;
+		void setBankedProcessor(int index, std::shared_ptr<Processor> processor);
+		void releaseDanglingProcessors();
 };
 
 }
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "core/timeseq-core.hpp"
+#include <array>
+#include <string>
+#include <cstring>
+#include <cstdint>
+
+// The number of input and output ports that a port buffer holds
+#define TIMESEQ_PORT_COUNT 8
+
+#ifndef nt_private
+	#define nt_private private
+#endif
+
+
+namespace timeseq {
+
+struct PortLabelListener {
+	virtual void outputPortLabelChanged(int index, const std::string& label) = 0;
+};
+
+/**
+ * A port handler that keeps the port voltages in plain buffers. Its owner copies the input voltages into it before each
+ * processed sample and writes the dirty output channels to the actual ports afterwards.
+ * The struct is final so the processors that are bound to it (see PortBinding) can call it without going through the
+ * vtable, which lets the compiler inline the port reads and writes of the processors.
+ */
+struct PortBuffer final : PortHandler {
+	PortBuffer(PortLabelListener* portLabelListener) : m_portLabelListener(portLabelListener) {}
+
+	float getInputPortVoltage(int index, int channel) const override {
+		return inputVoltages[index][channel];
+	}
+
+	void getInputPortVoltages(int index, float* voltages, uint16_t channelMask) const override {
+		std::memcpy(voltages, inputVoltages[index].data(), sizeof(inputVoltages[index]));
+	}
+
+	float getOutputPortVoltage(int index, int channel) const override {
+		return outputVoltages[index][channel];
+	}
+
+	void setOutputPortVoltage(int index, int channel, float voltage) override {
+		outputVoltages[index][channel] = voltage;
+		outputDirtyChannels[index] |= 1 << channel;
+	}
+
+	void setOutputPortVoltages(int index, int channel, const float* voltages, int count) override {
+		std::memcpy(outputVoltages[index].data() + channel, voltages, count * sizeof(float));
+		outputDirtyChannels[index] |= ((1 << count) - 1) << channel;
+	}
+
+	void setOutputPortChannels(int index, int channels) override {
+		outputChannels[index] = channels;
+		outputDirtyPorts |= 1 << index;
+	}
+
+	void setOutputPortLabel(int index, const std::string& label) override {
+		m_portLabelListener->outputPortLabelChanged(index, label);
+	}
+
+	std::array<std::array<float, 16>, TIMESEQ_PORT_COUNT> inputVoltages = {};
+	std::array<std::array<float, 16>, TIMESEQ_PORT_COUNT> outputVoltages = {};
+	std::array<int, TIMESEQ_PORT_COUNT> outputChannels = {};
+	// Per output port, a bitmask of the channels that were written since the dirty channels were last cleared
+	std::array<uint16_t, TIMESEQ_PORT_COUNT> outputDirtyChannels = {};
+	// A bitmask of the output ports whose channel count changed since the dirty ports were last cleared
+	uint8_t outputDirtyPorts = 0;
+
+	nt_private:
+		PortLabelListener* m_portLabelListener;
+};
+
+/**
+ * The port handler that a processor uses. If the port handler is a PortBuffer, the calls are made directly on the final
+ * PortBuffer type. Any other port handler (e.g. the mocks of the tests or an OutputRecorder) is called through the vtable.
+ * The check is a branch that always goes the same way for a processor, which is a lot cheaper than an indirect call that
+ * can't be inlined.
+ */
+struct PortBinding {
+	PortBinding(PortHandler* portHandler) : m_portHandler(portHandler), m_portBuffer(dynamic_cast<PortBuffer*>(portHandler)) {}
+
+	float getInputPortVoltage(int index, int channel) const {
+		return m_portBuffer ? m_portBuffer->getInputPortVoltage(index, channel) : m_portHandler->getInputPortVoltage(index, channel);
+	}
+
+	void getInputPortVoltages(int index, float* voltages, uint16_t channelMask) const {
+		if (m_portBuffer) {
+			m_portBuffer->getInputPortVoltages(index, voltages, channelMask);
+		} else {
+			m_portHandler->getInputPortVoltages(index, voltages, channelMask);
+		}
+	}
+
+	float getOutputPortVoltage(int index, int channel) const {
+		return m_portBuffer ? m_portBuffer->getOutputPortVoltage(index, channel) : m_portHandler->getOutputPortVoltage(index, channel);
+	}
+
+	void setOutputPortVoltage(int index, int channel, float voltage) const {
+		if (m_portBuffer) {
+			m_portBuffer->setOutputPortVoltage(index, channel, voltage);
+		} else {
+			m_portHandler->setOutputPortVoltage(index, channel, voltage);
+		}
+	}
+
+	void setOutputPortVoltages(int index, int channel, const float* voltages, int count) const {
+		if (m_portBuffer) {
+			m_portBuffer->setOutputPortVoltages(index, channel, voltages, count);
+		} else {
+			m_portHandler->setOutputPortVoltages(index, channel, voltages, count);
+		}
+	}
+
+	void setOutputPortChannels(int index, int channels) const {
+		m_portHandler->setOutputPortChannels(index, channels);
+	}
+
+	void setOutputPortLabel(int index, const std::string& label) const {
+		m_portHandler->setOutputPortLabel(index, label);
+	}
+
+	PortHandler* getPortHandler() const {
+		return m_portHandler;
+	}
+
+	bool isPortBuffer() const {
+		return m_portBuffer != nullptr;
+	}
+
+	nt_private:
+		PortHandler* m_portHandler;
+		PortBuffer* m_portBuffer;
+};
+
+}
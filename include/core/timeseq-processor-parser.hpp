@@ -39,10 +39,14 @@ struct SequenceProcessor;
 struct PortHandler;
 struct VariableHandler;
 struct TriggerHandler;
+struct ScriptBankHandler;
+struct VariableBus;
+struct VariableBusReferences;
 struct SampleRateReader;
 struct EventListener;
 struct AssertListener;
 struct RandValueGenerator;
+struct EventTracer;
 
 struct Processor;
 struct TimelineProcessor;
@@ -51,51 +55,80 @@ struct LaneProcessor;
 struct SegmentProcessor;
 struct DurationProcessor;
 struct ActionProcessor;
+struct ActionOngoingProcessor;
 struct ActionGlideProcessor;
+struct ActionGlidePolyProcessor;
 struct ActionGateProcessor;
 struct ValueProcessor;
 struct CalcProcessor;
 struct IfProcessor;
-
-
+struct OutputRecorder;
+
+
+
+// The ids of the component pool items of a script, mapped on their position in the pool, so that refs are resolved
+// without scanning the pool. It is only read once it is built, so the lane workers can share it.
+struct ProcessorScriptPoolIndex {
+	std::unordered_map<std::string, int> segmentBlocks;
+	std::unordered_map<std::string, int> segments;
+	std::unordered_map<std::string, int> inputs;
+	std::unordered_map<std::string, int> outputs;
+	std::unordered_map<std::string, int> calcs;
+	std::unordered_map<std::string, int> values;
+	std::unordered_map<std::string, int> actions;
+	std::unordered_map<std::string, int> ifs;
+	std::unordered_map<std::string, int> tunings;
+	std::unordered_map<std::string, int> tables;
+
+	void build(const Script* script);
+	// Returns the position of the id in the pool, or -1 if the pool doesn't contain it
+	static int find(const std::unordered_map<std::string, int>& ids, const std::string& id);
+};
 
 struct ProcessorScriptParseContext {
 	Script* script;
 	std::vector<ValidationError> *validationErrors;
+	std::shared_ptr<const ProcessorScriptPoolIndex> poolIndex;
 
 	std::vector<std::shared_ptr<SequencePositionProcessor>> sharedSequences;
 	std::vector<std::shared_ptr<SequenceProcessor>> nonSharedSequences;
 
-	std::vector<std::string> location;
-	std::vector<std::vector<std::string>> stashedLocations;
+	ValidationLocation location;
+	std::vector<ValidationLocation> stashedLocations;
 
 	void stashLocation();
 	void popLocation();
 };
 
 struct ProcessorScriptParser {
-	ProcessorScriptParser(PortHandler* portHandler, VariableHandler* variableHandler, TriggerHandler* triggerHandler, const SampleRateReader* sampleRateReader, EventListener* eventListener, AssertListener* assertListener, const std::shared_ptr<RandValueGenerator> randomValueGenerator);
+	ProcessorScriptParser(PortHandler* portHandler, VariableHandler* variableHandler, TriggerHandler* triggerHandler, const SampleRateReader* sampleRateReader, EventListener* eventListener, AssertListener* assertListener, const std::shared_ptr<RandValueGenerator> randomValueGenerator, EventTracer* eventTracer, ScriptBankHandler* scriptBankHandler, VariableBus* variableBus, bool fastMath);
 
 	std::shared_ptr<Processor> parseScript(const std::shared_ptr<Script> script, std::vector<ValidationError>& validationErrors);
 
 	nt_private:
-		const std::shared_ptr<TimelineProcessor> parseTimeline(const ScriptTimeline* scriptTimeline);
-		const std::shared_ptr<TriggerProcessor> parseInputTrigger(const ScriptInputTrigger* ScriptInputTrigger);
+		const std::vector<std::vector<std::shared_ptr<LaneProcessor>>> parseLanes(const Script* script);
+		const std::vector<std::vector<std::shared_ptr<LaneProcessor>>> parseLanesParallel(const Script* script);
+		const std::shared_ptr<TimelineProcessor> parseTimeline(const ScriptTimeline* scriptTimeline, const std::vector<std::shared_ptr<LaneProcessor>>& laneProcessors);
+		void parseInputTrigger(const ScriptInputTrigger* scriptInputTrigger, std::vector<std::shared_ptr<TriggerProcessor>>& triggerProcessors);
 		const std::shared_ptr<LaneProcessor> parseLane(const ScriptLane* scriptLane, ScriptTimeScale* timeScale);
 		const std::vector<std::shared_ptr<SegmentProcessor>> parseSegments(const std::vector<ScriptSegment>* scriptSegments, const ScriptTimeScale* timeScale, std::vector<std::string>& segmentStack);
 		const std::vector<std::shared_ptr<SegmentProcessor>> parseSegment(const ScriptSegment* scriptSegment, const ScriptTimeScale* timeScale, std::vector<std::string>& segmentStack);
 		const std::shared_ptr<SegmentProcessor> parseResolvedSegment(const ScriptSegment* scriptSegment, const ScriptTimeScale* timeScale, std::vector<std::string>& segmentStack);
-		const std::vector<std::shared_ptr<SegmentProcessor>> parseSegmentBlock(const ScriptSegmentBlock* scriptSegmentBlock, const ScriptTimeScale* timeScale, const std::vector<ScriptAction>& actions, std::vector<std::string>& actionsLocation, std::vector<std::string>& segmentStack);
+		void parseSegmentActions(const ScriptSegment* scriptSegment, std::vector<std::shared_ptr<ActionProcessor>>& startActions, std::vector<std::shared_ptr<ActionProcessor>>& endActions, std::vector<std::shared_ptr<ActionOngoingProcessor>>& ongoingActions);
+		const std::vector<std::shared_ptr<SegmentProcessor>> parseSegmentBlock(const ScriptSegmentBlock* scriptSegmentBlock, const ScriptTimeScale* timeScale, const std::vector<ScriptAction>& actions, ValidationLocation& actionsLocation, std::vector<std::string>& segmentStack);
 		const std::shared_ptr<DurationProcessor> parseDuration(const ScriptDuration* scriptDuration, const ScriptTimeScale* timeScale);
 		const std::shared_ptr<ActionProcessor> parseResolvedAction(const ScriptAction* scriptAction);
 		const std::shared_ptr<ActionGlideProcessor> parseResolvedGlideAction(const ScriptAction* scriptAction);
+		const std::shared_ptr<ActionGlidePolyProcessor> parseResolvedGlidePolyAction(const ScriptAction* scriptAction);
 		const std::shared_ptr<ActionGateProcessor> parseResolvedGateAction(const ScriptAction* scriptAction);
 		const std::shared_ptr<ActionProcessor> parseSetValueAction(const ScriptAction* scriptAction, const std::shared_ptr<IfProcessor>& ifProcessor);
+		const std::shared_ptr<ActionProcessor> parseSetPolyValueAction(const ScriptAction* scriptAction, const std::shared_ptr<IfProcessor>& ifProcessor);
 		const std::shared_ptr<ActionProcessor> parseSetVariableAction(const ScriptAction* scriptAction, const std::shared_ptr<IfProcessor>& ifProcessor);
 		const std::shared_ptr<ActionProcessor> parseSetPolyphonyAction(const ScriptAction* scriptAction, const std::shared_ptr<IfProcessor>& ifProcessor);
 		const std::shared_ptr<ActionProcessor> parseSetLabelAction(const ScriptAction* scriptAction, const std::shared_ptr<IfProcessor>& ifProcessor);
 		const std::shared_ptr<ActionProcessor> parseAssertAction(const ScriptAction* scriptAction, const std::shared_ptr<IfProcessor>& ifProcessor);
 		const std::shared_ptr<ActionProcessor> parseTriggerAction(const ScriptAction* scriptAction, const std::shared_ptr<IfProcessor>& ifProcessor);
+		const std::shared_ptr<ActionProcessor> parseSelectScriptAction(const ScriptAction* scriptAction, const std::shared_ptr<IfProcessor>& ifProcessor);
 		const std::shared_ptr<ActionProcessor> parseMoveSequenceAction(const ScriptAction* scriptAction, const std::shared_ptr<IfProcessor>& ifProcessor);
 		const std::shared_ptr<ActionProcessor> parseClearSequenceAction(const ScriptAction* scriptAction, const std::shared_ptr<IfProcessor>& ifProcessor);
 		const std::shared_ptr<ActionProcessor> parseAddToSequenceAction(const ScriptAction* scriptAction, const std::shared_ptr<IfProcessor>& ifProcessor);
@@ -107,6 +140,7 @@ struct ProcessorScriptParser {
 		const std::shared_ptr<ValueProcessor> parseOutputValue(const ScriptValue* scriptValue, const std::vector<std::shared_ptr<CalcProcessor>>& calcProcessors);
 		const std::shared_ptr<ValueProcessor> parseRandValue(const ScriptValue* scriptValue, const std::vector<std::shared_ptr<CalcProcessor>>& calcProcessors, std::vector<std::string>& valueStack);
 		const std::shared_ptr<ValueProcessor> parseSequenceValue(const ScriptValue* scriptValue, const std::vector<std::shared_ptr<CalcProcessor>>& calcProcessors, std::vector<std::string>& valueStack);
+		const std::shared_ptr<ValueProcessor> parseTableValue(const ScriptValue* scriptValue, const std::vector<std::shared_ptr<CalcProcessor>>& calcProcessors, std::vector<std::string>& valueStack);
 		const std::shared_ptr<CalcProcessor> parseCalc(const ScriptCalc* scriptCalc, std::vector<std::string>& valueStack);
 		const std::shared_ptr<IfProcessor> parseIf(const ScriptIf* scriptIf, std::vector<std::string>& ifStack);
 
@@ -114,8 +148,12 @@ struct ProcessorScriptParser {
 
 		const std::pair<int, int> parseInput(const ScriptInput* scriptInput);
 		const std::pair<int, int> parseOutput(const ScriptOutput* scriptOutput);
+		const std::vector<std::shared_ptr<ValueProcessor>> parseValues(const std::vector<ScriptValue>* scriptValues);
+
+		// Returns the handler for a variable: the shared slot of the variable bus for bus variables, or the variable handler of the instance otherwise
+		VariableHandler* resolveVariableHandler(const std::string& name);
 
-		const ScriptAction* resolveScriptAction(const ScriptAction* scriptAction, std::vector<std::string>& resolvedLocation) const;
+		const ScriptAction* resolveScriptAction(const ScriptAction* scriptAction, ValidationLocation& resolvedLocation) const;
 
 		const std::shared_ptr<SequencePositionProcessor> resolveSharedSequence(const std::string& id) const;
 		bool hasNonSharedSequence(const std::string& id) const;
@@ -129,14 +167,36 @@ struct ProcessorScriptParser {
 		EventListener* m_eventListener;
 		AssertListener* m_assertListener;
 		const std::shared_ptr<RandValueGenerator> m_randomValueGenerator;
+		EventTracer* m_eventTracer;
+		ScriptBankHandler* m_scriptBankHandler;
+		// The bus variables that the script uses, shared with the lane parser workers (nullptr when there is no bus)
+		std::shared_ptr<VariableBusReferences> m_variableBusReferences;
+		bool m_fastMath;
+		// The control rate of the lane that is being parsed
+		int m_controlRate = 1;
+		// The port handler for the actions of segments that record their output voltages (created when first needed)
+		std::shared_ptr<OutputRecorder> m_outputRecorder;
+		// Scripts with at least this many lane segments have their lanes parsed on multiple workers
+		unsigned int m_parallelMinSegments;
+		// The number of workers (including the calling thread) that parse lanes in parallel
+		unsigned int m_workerCount;
 };
 
 struct ProcessorLoader {
 	ProcessorLoader(PortHandler* portHandler, VariableHandler* variableHandler, TriggerHandler* triggerHandler, const SampleRateReader* sampleRateReader, EventListener* eventListener, AssertListener* assertListener);
+	ProcessorLoader(PortHandler* portHandler, VariableHandler* variableHandler, TriggerHandler* triggerHandler, const SampleRateReader* sampleRateReader, EventListener* eventListener, AssertListener* assertListener, EventTracer* eventTracer);
 	ProcessorLoader(PortHandler* portHandler, VariableHandler* variableHandler, TriggerHandler* triggerHandler, const SampleRateReader* sampleRateReader, EventListener* eventListener, AssertListener* assertListener, const std::shared_ptr<RandValueGenerator> randomValueGenerator);
 	virtual ~ProcessorLoader();
 
 	virtual const std::shared_ptr<Processor> loadScript(const std::shared_ptr<Script>& script, std::vector<ValidationError>& validationErrors);
+	// Restarts the random values of the loaded processors from the given seed
+	void seedRandomValues(uint64_t seed);
+	// If enabled, scripts that are loaded afterwards use approximations for the more expensive calculations (see util/fastmath.hpp)
+	void setFastMath(bool fastMath);
+	// The handler that is called by 'select-script' actions of scripts that are loaded afterwards. Without handler, those actions do nothing.
+	void setScriptBankHandler(ScriptBankHandler* scriptBankHandler);
+	// The bus that 'bus:' variables of scripts that are loaded afterwards are shared through. Without bus, they are regular variables.
+	void setVariableBus(VariableBus* variableBus);
 
 	private:
 		PortHandler* m_portHandler;
@@ -146,6 +206,10 @@ struct ProcessorLoader {
 		EventListener* m_eventListener;
 		AssertListener* m_assertListener;
 		const std::shared_ptr<RandValueGenerator> m_randomValueGenerator;
+		EventTracer* m_eventTracer;
+		ScriptBankHandler* m_scriptBankHandler = nullptr;
+		VariableBus* m_variableBus = nullptr;
+		bool m_fastMath = false;
 };
 
 }
@@ -3,13 +3,19 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
 #include <utility>
-#include <random>
 #include <rack.hpp>
 #include <cstdint>
 #include <array>
 #include "core/timeseq-validation.hpp"
+#include "core/timeseq-profiler.hpp"
+#include "core/timeseq-core.hpp"
+#include "core/timeseq-port-buffer.hpp"
+#include "util/random.hpp"
+#include "util/quantizer.hpp"
+#include "util/schmitt.hpp"
 
 #ifndef nt_private
 	#define nt_private private
@@ -24,29 +30,111 @@ struct ScriptLane;
 struct ScriptSegment;
 struct ScriptCalc;
 struct ScriptTuning;
+struct ScriptTable;
 struct Script;
 struct ValueProcessor;
 struct PortHandler;
 struct VariableHandler;
 struct TriggerHandler;
+struct ScriptBankHandler;
 struct EventListener;
 struct AssertListener;
+struct AssertExpectation;
+struct EventTracer;
+struct VariableBusReferences;
+
+
+// The estimated amount of work that is done when (a part of) the processor graph is evaluated
+struct ProcessorCost {
+	// The number of value, calc, condition and action evaluations
+	int operations = 0;
+	// The length of the longest chain of (nested) value and calc evaluations
+	int depth = 0;
+	int randEvaluations = 0;
+	int sequenceEvaluations = 0;
+	int variableAccesses = 0;
+	int triggers = 0;
+
+	void add(const ProcessorCost& cost);
+};
+
+// A static estimation of the worst-case work that a loaded script can cause, based on its processor graph
+struct ProcessorCostReport {
+	struct TimelineCost {
+		int lanes = 0;
+		int segments = 0;
+		// The highest number of ongoing (glide and gate) actions that can be active at the same time
+		int maxConcurrentOngoingActions = 0;
+		// The number of operations if all lanes end and start a segment in the same sample
+		int worstCaseSampleOperations = 0;
+	};
+
+	std::vector<TimelineCost> timelines;
+	int inputTriggers = 0;
+	int maxCalcDepth = 0;
+	int maxSegmentStartRandEvaluations = 0;
+	int maxSegmentStartSequenceEvaluations = 0;
+	int maxTriggerFanOut = 0;
+	std::string maxTriggerFanOutId;
+	int worstCaseSampleOperations = 0;
+
+	// Segments that are likely to have a noticeable CPU impact
+	std::vector<ValidationError> hotSpots;
+
+	std::vector<std::string> describe() const;
+};
+
+// An estimation of the memory that a loaded script uses, based on the sizes of its objects and the capacity of their
+// strings and containers. The overhead of the memory allocator itself isn't included.
+struct ProcessorMemoryReport {
+	// The timeline, lane, segment, action, condition, duration and trigger processors
+	size_t processors = 0;
+	// The value and calc processors
+	size_t values = 0;
+	// The ids, names and labels that are kept by the processors
+	size_t strings = 0;
+	// The sequences and the positions in them
+	size_t sequences = 0;
+	// The output voltages that are recorded for the deterministic segments
+	size_t recordings = 0;
+	// The parsed script, which is kept for as long as its processors are in use
+	size_t script = 0;
+
+	size_t getTotal() const;
+	std::vector<std::string> describe() const;
+
+	// Returns false if the object was already counted. Processors can be shared (e.g. through refs), but should only be counted once.
+	bool addObject(const void* object);
+	void clearObjects();
 
+	nt_private:
+		std::unordered_set<const void*> m_objects;
+};
 
 struct CalcProcessor {
 	virtual double calc(double value) = 0;
+	virtual ProcessorCost getCost() const;
+	// Returns true if the calc always has the same outcome for the same input value
+	virtual bool isDeterministic() const;
+
+	void addMemory(ProcessorMemoryReport& memoryReport) const;
+	virtual void addCalcMemory(ProcessorMemoryReport& memoryReport) const;
 };
 
 struct CalcValueProcessor : CalcProcessor {
 	enum ValueCalcOperation { ADD, SUB, DIV, MULT, MAX, MIN, REMAIN };
 
-	CalcValueProcessor(const ScriptCalc* scriptCalc, const std::shared_ptr<ValueProcessor>& value);
+	CalcValueProcessor(const ScriptCalc* scriptCalc, const std::shared_ptr<ValueProcessor>& value, bool fastMath);
 
 	double calc(double value) override;
+	void addCalcMemory(ProcessorMemoryReport& memoryReport) const override;
+	ProcessorCost getCost() const override;
+	bool isDeterministic() const override;
 
 	nt_private:
 		ValueCalcOperation m_operation;
 		const std::shared_ptr<ValueProcessor> m_value;
+		bool m_fastMath;
 };
 
 struct CalcTruncProcessor : CalcProcessor {
@@ -54,13 +142,20 @@ struct CalcTruncProcessor : CalcProcessor {
 };
 
 struct CalcFracProcessor : CalcProcessor {
+	CalcFracProcessor(bool fastMath);
+
 	double calc(double value) override;
+	void addCalcMemory(ProcessorMemoryReport& memoryReport) const override;
+
+	nt_private:
+		bool m_fastMath;
 };
 
 struct CalcRoundProcessor : CalcProcessor {
 	CalcRoundProcessor(const ScriptCalc* scriptCalc);
 
 	double calc(double value) override;
+	void addCalcMemory(ProcessorMemoryReport& memoryReport) const override;
 
 	nt_private:
 		const ScriptCalc* m_scriptCalc;
@@ -70,22 +165,30 @@ struct CalcQuantizeProcessor : CalcProcessor {
 	CalcQuantizeProcessor(const ScriptTuning* scriptTuning);
 
 	double calc(double value) override;
+	void addCalcMemory(ProcessorMemoryReport& memoryReport) const override;
 
 	nt_private:
-		std::vector<std::array<float, 2>> m_quantizeValues;
+		Quantizer m_quantizer;
 };
 
 struct CalcSignProcessor : CalcProcessor {
 	CalcSignProcessor(const ScriptCalc* scriptCalc);
 
 	double calc(double value) override;
+	void addCalcMemory(ProcessorMemoryReport& memoryReport) const override;
 
 	nt_private:
 		bool m_positive;
 };
 
 struct CalcVtoFProcessor : CalcProcessor {
+	CalcVtoFProcessor(bool fastMath);
+
 	double calc(double value) override;
+	void addCalcMemory(ProcessorMemoryReport& memoryReport) const override;
+
+	nt_private:
+		bool m_fastMath;
 };
 
 struct RandValueGenerator {
@@ -93,15 +196,17 @@ struct RandValueGenerator {
 	virtual ~RandValueGenerator();
 
 	virtual float generate(float lower, float upper);
+	virtual void seed(uint64_t seed);
+	void addMemory(ProcessorMemoryReport& memoryReport) const;
 
 	nt_private:
-		std::minstd_rand m_generator;
+		RandomGenerator m_generator;
 };
 
 struct SequenceProcessor {
 	SequenceProcessor(const std::string& id, const std::vector<std::shared_ptr<ValueProcessor>>& values, bool retrieveVoltageOnce);
 
-	std::string getId();
+	const std::string& getId() const;
 	const std::vector<std::shared_ptr<ValueProcessor>> getValues() const;
 	bool isRetrieveVoltageOnce();
 
@@ -109,6 +214,8 @@ struct SequenceProcessor {
 	void add(const std::shared_ptr<ValueProcessor>& value, int position);
 	void remove(int position);
 
+	void addMemory(ProcessorMemoryReport& memoryReport) const;
+
 	nt_private:
 		std::string m_id;
 		std::vector<std::shared_ptr<ValueProcessor>> m_values;
@@ -118,7 +225,7 @@ struct SequenceProcessor {
 struct SequencePositionProcessor {
 	enum SequenceMoveDirection { FORWARD, BACKWARD, RANDOM, NONE };
 
-	SequencePositionProcessor(const std::shared_ptr<SequenceProcessor>& sequenceProcessor, const std::shared_ptr<RandValueGenerator>& randValueGenerator);
+	SequencePositionProcessor(const std::shared_ptr<SequenceProcessor>& sequenceProcessor, const std::shared_ptr<RandValueGenerator>& randValueGenerator, EventTracer* eventTracer);
 
 	SequenceProcessor* getSequenceProcessor();
 	double getCurrentValue();
@@ -126,10 +233,13 @@ struct SequencePositionProcessor {
 	void move(SequenceMoveDirection direction, bool wrap);
 	void move(int position);
 
+	void addMemory(ProcessorMemoryReport& memoryReport) const;
+
 	nt_private:
 		int m_position;
 		const std::shared_ptr<SequenceProcessor> m_sequenceProcessor;
 		const std::shared_ptr<RandValueGenerator> m_randValueGenerator;
+		EventTracer* m_eventTracer;
 
 		// If the sequence has 'retrieve-voltage-once' set to true, we need to store the voltage
 		// and remember it until a move is done.
@@ -143,6 +253,16 @@ struct ValueProcessor {
 	double process();
 	virtual double processValue() = 0;
 
+	ProcessorCost getCost() const;
+	virtual ProcessorCost getValueCost() const;
+
+	// Returns true if the value (including its calcs) always has the same outcome
+	bool isDeterministic() const;
+	virtual bool isValueDeterministic() const;
+
+	void addMemory(ProcessorMemoryReport& memoryReport) const;
+	virtual void addValueMemory(ProcessorMemoryReport& memoryReport) const;
+
 	nt_private:
 		const std::vector<std::shared_ptr<CalcProcessor>> m_calcProcessors;
 		bool m_quantize;
@@ -154,6 +274,8 @@ struct StaticValueProcessor : ValueProcessor {
 	StaticValueProcessor(float value, const std::vector<std::shared_ptr<CalcProcessor>>& calcProcessors, bool quantize);
 
 	double processValue() override;
+	void addValueMemory(ProcessorMemoryReport& memoryReport) const override;
+	bool isValueDeterministic() const override;
 
 	nt_private:
 		float m_value;
@@ -163,6 +285,8 @@ struct VariableValueProcessor : ValueProcessor {
 	VariableValueProcessor(const std::string& name, const std::vector<std::shared_ptr<CalcProcessor>>& calcProcessors, bool quantize, VariableHandler* variableHandler);
 
 	double processValue() override;
+	void addValueMemory(ProcessorMemoryReport& memoryReport) const override;
+	ProcessorCost getValueCost() const override;
 
 	nt_private:
 		const std::string m_name;
@@ -173,28 +297,32 @@ struct InputValueProcessor : ValueProcessor {
 	InputValueProcessor(int inputPort, int inputChannel, const std::vector<std::shared_ptr<CalcProcessor>>& calcProcessors, bool quantize, PortHandler* portHandler);
 
 	double processValue() override;
+	void addValueMemory(ProcessorMemoryReport& memoryReport) const override;
 
 	nt_private:
 		int m_inputPort;
 		int m_inputChannel;
-		PortHandler* m_portHandler;
+		PortBinding m_portHandler;
 };
 
 struct OutputValueProcessor : ValueProcessor {
 	OutputValueProcessor(int outputPort, int outputChannel, const std::vector<std::shared_ptr<CalcProcessor>>& calcProcessors, bool quantize, PortHandler* portHandler);
 
 	double processValue() override;
+	void addValueMemory(ProcessorMemoryReport& memoryReport) const override;
 
 	nt_private:
 		int m_outputPort;
 		int m_outputChannel;
-		PortHandler* m_portHandler;
+		PortBinding m_portHandler;
 };
 
 struct RandValueProcessor : ValueProcessor {
 	RandValueProcessor(const std::shared_ptr<ValueProcessor>& lowerValue, const std::shared_ptr<ValueProcessor>& upperValue, const std::shared_ptr<RandValueGenerator>& randValueGenerator, const std::vector<std::shared_ptr<CalcProcessor>>& calcProcessors, bool quantize);
 
 	double processValue() override;
+	void addValueMemory(ProcessorMemoryReport& memoryReport) const override;
+	ProcessorCost getValueCost() const override;
 
 	nt_private:
 		const std::shared_ptr<ValueProcessor> m_lowerValue;
@@ -207,6 +335,8 @@ struct SequenceValueProcessor : ValueProcessor {
 	SequenceValueProcessor(const std::shared_ptr<SequencePositionProcessor>& sequencePositionProcessor, SequencePositionProcessor::SequenceMoveDirection moveBefore, SequencePositionProcessor::SequenceMoveDirection moveAfter, bool wrap, const std::vector<std::shared_ptr<CalcProcessor>>& calcProcessors, bool quantize);
 
 	double processValue() override;
+	void addValueMemory(ProcessorMemoryReport& memoryReport) const override;
+	ProcessorCost getValueCost() const override;
 
 	nt_private:
 		const std::shared_ptr<SequencePositionProcessor> m_sequencePositionProcessor;
@@ -215,10 +345,32 @@ struct SequenceValueProcessor : ValueProcessor {
 		bool m_wrap;
 };
 
+struct TableValueProcessor : ValueProcessor {
+	TableValueProcessor(const ScriptTable* scriptTable, const std::shared_ptr<ValueProcessor>& position, const std::vector<std::shared_ptr<CalcProcessor>>& calcProcessors, bool quantize);
+
+	double processValue() override;
+	void addValueMemory(ProcessorMemoryReport& memoryReport) const override;
+	ProcessorCost getValueCost() const override;
+	bool isValueDeterministic() const override;
+
+	nt_private:
+		const std::shared_ptr<ValueProcessor> m_position;
+		bool m_wrap;
+		// The table voltages, followed by the voltage that the last one interpolates towards
+		// (the first voltage for a wrapping table, the last voltage again otherwise)
+		std::vector<float> m_voltages;
+		// The number of interpolation steps that position 0 to 1 is spread over
+		double m_steps;
+};
+
 struct IfProcessor {
 	IfProcessor(const ScriptIf* scriptIf, const std::pair<const std::shared_ptr<ValueProcessor>, const std::shared_ptr<ValueProcessor>>& values, const std::vector<std::shared_ptr<IfProcessor>>& ifs);
 
-	bool process(std::string* message);
+	// Fills in the operands of the comparisons in the expectation if one is passed
+	bool process(AssertExpectation* expectation);
+
+	ProcessorCost getCost() const;
+	void addMemory(ProcessorMemoryReport& memoryReport) const;
 
 	nt_private:
 		const ScriptIf* m_scriptIf;
@@ -232,6 +384,20 @@ struct ActionProcessor {
 	void process();
 	virtual void processAction() = 0;
 
+	ProcessorCost getCost() const;
+	virtual ProcessorCost getActionCost() const;
+
+	// Returns true if the action is unconditional and always sets the same output voltages
+	bool isDeterministic() const;
+	virtual bool isActionDeterministic() const;
+	// The number of output voltages that the action sets each time it is processed
+	virtual int getOutputVoltageCount() const;
+	// Sends the output voltages of the action to another port handler, e.g. the output recorder of a recorded segment
+	virtual void setOutputPortHandler(PortHandler* portHandler);
+
+	void addMemory(ProcessorMemoryReport& memoryReport) const;
+	virtual void addActionMemory(ProcessorMemoryReport& memoryReport) const;
+
 	nt_private:
 		const std::shared_ptr<IfProcessor> m_ifProcessor;
 };
@@ -240,18 +406,45 @@ struct ActionSetValueProcessor : ActionProcessor {
 	ActionSetValueProcessor(const std::shared_ptr<ValueProcessor>& value, int outputPort, int outputChannel, PortHandler* portHandler, const std::shared_ptr<IfProcessor>& ifProcessor);
 
 	void processAction() override;
+	void addActionMemory(ProcessorMemoryReport& memoryReport) const override;
+	ProcessorCost getActionCost() const override;
+	bool isActionDeterministic() const override;
+	int getOutputVoltageCount() const override;
+	void setOutputPortHandler(PortHandler* portHandler) override;
 
 	nt_private:
 		const std::shared_ptr<ValueProcessor> m_value;
 		int m_outputPort;
 		int m_outputChannel;
-		PortHandler* m_portHandler;
+		PortBinding m_portHandler;
+};
+
+struct ActionSetPolyValueProcessor : ActionProcessor {
+	ActionSetPolyValueProcessor(const std::vector<std::shared_ptr<ValueProcessor>>& values, int outputPort, int outputChannel, PortHandler* portHandler, const std::shared_ptr<IfProcessor>& ifProcessor);
+
+	void processAction() override;
+	void addActionMemory(ProcessorMemoryReport& memoryReport) const override;
+	ProcessorCost getActionCost() const override;
+	bool isActionDeterministic() const override;
+	int getOutputVoltageCount() const override;
+	void setOutputPortHandler(PortHandler* portHandler) override;
+
+	nt_private:
+		const std::vector<std::shared_ptr<ValueProcessor>> m_values;
+		int m_outputPort;
+		int m_outputChannel;
+		PortBinding m_portHandler;
+
+		// The voltages of all channels, passed to the port handler in one call
+		std::array<float, 16> m_voltages;
 };
 
 struct ActionSetVariableProcessor : ActionProcessor {
 	ActionSetVariableProcessor(const std::shared_ptr<ValueProcessor>& value, const std::string& name, VariableHandler* variableHandler, const std::shared_ptr<IfProcessor>& ifProcessor);
 
 	void processAction() override;
+	void addActionMemory(ProcessorMemoryReport& memoryReport) const override;
+	ProcessorCost getActionCost() const override;
 
 	nt_private:
 		const std::shared_ptr<ValueProcessor> m_value;
@@ -263,50 +456,70 @@ struct ActionSetPolyphonyProcessor : ActionProcessor {
 	ActionSetPolyphonyProcessor(int outputPort, int channelCount, PortHandler* portHandler, const std::shared_ptr<IfProcessor>& ifProcessor);
 
 	void processAction() override;
+	void addActionMemory(ProcessorMemoryReport& memoryReport) const override;
 
 	nt_private:
 		int m_outputPort;
 		int m_channelCount;
-		PortHandler* m_portHandler;
+		PortBinding m_portHandler;
 };
 
 struct ActionSetLabelProcessor : ActionProcessor {
 	ActionSetLabelProcessor(int outputPort, const std::string& label, PortHandler* portHandler, const std::shared_ptr<IfProcessor>& ifProcessor);
 
 	void processAction() override;
+	void addActionMemory(ProcessorMemoryReport& memoryReport) const override;
 
 	nt_private:
 		int m_outputPort;
 		const std::string m_label;
-		PortHandler* m_portHandler;
+		PortBinding m_portHandler;
 };
 
 struct ActionAssertProcessor : ActionProcessor {
-	ActionAssertProcessor(const std::string& name, const std::shared_ptr<IfProcessor>& expect, bool stopOnFail, AssertListener* assertListener, const std::shared_ptr<IfProcessor>& ifProcessor);
+	ActionAssertProcessor(const std::string& name, const std::shared_ptr<IfProcessor>& expect, bool stopOnFail, AssertListener* assertListener, EventTracer* eventTracer, const std::shared_ptr<IfProcessor>& ifProcessor);
 
 	void processAction() override;
+	void addActionMemory(ProcessorMemoryReport& memoryReport) const override;
+	ProcessorCost getActionCost() const override;
 
 	nt_private:
 		const std::string m_name;
 		const std::shared_ptr<IfProcessor> m_expect;
 		bool m_stopOnFail;
 		AssertListener* m_assertListener;
+		EventTracer* m_eventTracer;
 };
 
 struct ActionTriggerProcessor : ActionProcessor {
 	ActionTriggerProcessor(const std::string& trigger, TriggerHandler* triggerHandler, const std::shared_ptr<IfProcessor>& ifProcessor);
 
 	void processAction() override;
+	void addActionMemory(ProcessorMemoryReport& memoryReport) const override;
+	ProcessorCost getActionCost() const override;
 
 	nt_private:
 		const std::string m_trigger;
 		TriggerHandler* m_triggerHandler;
 };
 
+struct ActionSelectScriptProcessor : ActionProcessor {
+	ActionSelectScriptProcessor(int index, ScriptBankHandler* scriptBankHandler, const std::shared_ptr<IfProcessor>& ifProcessor);
+
+	void processAction() override;
+	void addActionMemory(ProcessorMemoryReport& memoryReport) const override;
+
+	nt_private:
+		int m_index;
+		ScriptBankHandler* m_scriptBankHandler;
+};
+
 struct ActionMoveSequenceDirectionProcessor : ActionProcessor {
 	ActionMoveSequenceDirectionProcessor(std::shared_ptr<SequencePositionProcessor>& sequencePositionProcessor, SequencePositionProcessor::SequenceMoveDirection direction, bool wrap, const std::shared_ptr<IfProcessor>& ifProcessor);
 
 	void processAction() override;
+	void addActionMemory(ProcessorMemoryReport& memoryReport) const override;
+	ProcessorCost getActionCost() const override;
 
 	nt_private:
 		std::shared_ptr<SequencePositionProcessor> m_sequencePositionProcessor;
@@ -318,6 +531,7 @@ struct ActionMoveSequencePositionProcessor : ActionProcessor {
 	ActionMoveSequencePositionProcessor(std::shared_ptr<SequencePositionProcessor>& sequencePositionProcessor, int position, const std::shared_ptr<IfProcessor>& ifProcessor);
 
 	void processAction() override;
+	void addActionMemory(ProcessorMemoryReport& memoryReport) const override;
 
 	nt_private:
 		std::shared_ptr<SequencePositionProcessor> m_sequencePositionProcessor;
@@ -328,6 +542,7 @@ struct ActionClearSequenceProcessor : ActionProcessor {
 	ActionClearSequenceProcessor(std::shared_ptr<SequencePositionProcessor>& sequencePositionProcessor, const std::shared_ptr<IfProcessor>& ifProcessor);
 
 	void processAction() override;
+	void addActionMemory(ProcessorMemoryReport& memoryReport) const override;
 
 	nt_private:
 		std::shared_ptr<SequencePositionProcessor> m_sequencePositionProcessor;
@@ -337,6 +552,8 @@ struct ActionAddToSequenceSequenceProcessor : ActionProcessor {
 	ActionAddToSequenceSequenceProcessor(std::shared_ptr<SequencePositionProcessor>& sequencePositionProcessor, const std::shared_ptr<ValueProcessor>& value, int position, bool asConstantVoltage, const std::shared_ptr<IfProcessor>& ifProcessor);
 
 	void processAction() override;
+	void addActionMemory(ProcessorMemoryReport& memoryReport) const override;
+	ProcessorCost getActionCost() const override;
 
 	nt_private:
 		std::shared_ptr<SequencePositionProcessor> m_sequencePositionProcessor;
@@ -349,6 +566,7 @@ struct ActionRemoveFromSequenceProcessor : ActionProcessor {
 	ActionRemoveFromSequenceProcessor(std::shared_ptr<SequencePositionProcessor>& sequencePositionProcessor, int position, const std::shared_ptr<IfProcessor>& ifProcessor);
 
 	void processAction() override;
+	void addActionMemory(ProcessorMemoryReport& memoryReport) const override;
 
 	nt_private:
 		std::shared_ptr<SequencePositionProcessor> m_sequencePositionProcessor;
@@ -362,6 +580,20 @@ struct ActionOngoingProcessor {
 	virtual void process(uint64_t glidePosition) = 0;
 	virtual void end() = 0;
 
+	virtual ProcessorCost getStartCost() const;
+	virtual ProcessorCost getProcessCost() const;
+
+	// Returns true if the action is unconditional and always sets the same output voltages for the same glide length and position
+	bool isDeterministic() const;
+	virtual bool isActionDeterministic() const;
+	// The number of output voltages that the action sets each time it is started, processed or ended
+	virtual int getOutputVoltageCount() const;
+	// Sends the output voltages of the action to another port handler, e.g. the output recorder of a recorded segment
+	virtual void setOutputPortHandler(PortHandler* portHandler);
+
+	void addMemory(ProcessorMemoryReport& memoryReport) const;
+	virtual void addActionMemory(ProcessorMemoryReport& memoryReport) const;
+
 	protected:
 		bool shouldProcess();
 
@@ -372,20 +604,61 @@ struct ActionOngoingProcessor {
 		bool m_if;
 };
 
+// The easing of a glide, shared by the single and polyphonic glide actions
+struct GlideEase {
+	GlideEase(float easeFactor, bool easePow, bool fastMath, int controlRate);
+
+	void start(uint64_t glideLength);
+	// Returns the eased position (from 0 to 1) for a step (starting from 0) of the glide
+	float calculate(uint64_t step);
+
+	nt_private:
+		float m_easeFactor;
+		bool m_easePow;
+		bool m_fastMath;
+		// The easing is only calculated every controlRate steps, with a linear ramp for the steps in between
+		int m_controlRate;
+
+		// Pre-calculated for runtime performance: "1.0 / duration" and the last step of the glide
+		double m_durationInverse;
+		uint64_t m_lastStep;
+
+		// The ramp between two control rate steps
+		uint64_t m_rampStartStep;
+		uint64_t m_rampEndStep;
+		float m_rampStart;
+		float m_rampEnd;
+		float m_rampDelta;
+
+		// Translates a linear position (from 0 to 1) in the glide into its eased position
+		float calculateEase(float position);
+
+		// A power-based easing calculation
+		double calculatePowEase(float ease);
+		// A sigmoid-based easing calculation
+		double calculateSigEase(float ease);
+};
+
 struct ActionGlideProcessor : ActionOngoingProcessor {
-	ActionGlideProcessor(float easeFactor, bool easePow, const std::shared_ptr<ValueProcessor>& startValue, const std::shared_ptr<ValueProcessor>& endValue, const std::shared_ptr<IfProcessor>& ifProcessor, int outputPort, int outputChannel, const std::string& variable, PortHandler* portHandler, VariableHandler* variableHandler);
+	ActionGlideProcessor(float easeFactor, bool easePow, bool fastMath, int controlRate, const std::shared_ptr<ValueProcessor>& startValue, const std::shared_ptr<ValueProcessor>& endValue, const std::shared_ptr<IfProcessor>& ifProcessor, int outputPort, int outputChannel, const std::string& variable, PortHandler* portHandler, VariableHandler* variableHandler);
 
 	void start(uint64_t glideLength) override;
 	void process(uint64_t glidePosition) override;
 	void end() override;
 
+	ProcessorCost getStartCost() const override;
+	ProcessorCost getProcessCost() const override;
+	bool isActionDeterministic() const override;
+	int getOutputVoltageCount() const override;
+	void setOutputPortHandler(PortHandler* portHandler) override;
+	void addActionMemory(ProcessorMemoryReport& memoryReport) const override;
+
 	nt_private:
-		float m_easeFactor;
-		bool m_easePow;
+		GlideEase m_ease;
 		const std::shared_ptr<ValueProcessor> m_startValueProcessor;
 		const std::shared_ptr<ValueProcessor> m_endValueProcessor;
 
-		PortHandler* m_portHandler;
+		PortBinding m_portHandler;
 		VariableHandler* m_variableHandler;
 
 		int m_outputPort;
@@ -395,14 +668,40 @@ struct ActionGlideProcessor : ActionOngoingProcessor {
 		// The start and end values that were captured when the glide action was started
 		double m_startValue;
 		double m_endValue;
-		// Pre-calculated for runtime performance: the difference between start and end, and "1.0 / duration"
+		// Pre-calculated for runtime performance: the difference between start and end
 		double m_valueDelta;
-		double m_durationInverse;
+};
 
-		// A power-based easing calculation
-		double calculatePowEase(float ease);
-		// A sigmoid-based easing calculation
-		double calculateSigEase(float ease);
+struct ActionGlidePolyProcessor : ActionOngoingProcessor {
+	ActionGlidePolyProcessor(float easeFactor, bool easePow, bool fastMath, int controlRate, const std::vector<std::shared_ptr<ValueProcessor>>& startValues, const std::vector<std::shared_ptr<ValueProcessor>>& endValues, const std::shared_ptr<IfProcessor>& ifProcessor, int outputPort, int outputChannel, PortHandler* portHandler);
+
+	void start(uint64_t glideLength) override;
+	void process(uint64_t glidePosition) override;
+	void end() override;
+
+	ProcessorCost getStartCost() const override;
+	bool isActionDeterministic() const override;
+	int getOutputVoltageCount() const override;
+	void setOutputPortHandler(PortHandler* portHandler) override;
+	void addActionMemory(ProcessorMemoryReport& memoryReport) const override;
+
+	nt_private:
+		GlideEase m_ease;
+		const std::vector<std::shared_ptr<ValueProcessor>> m_startValueProcessors;
+		const std::vector<std::shared_ptr<ValueProcessor>> m_endValueProcessors;
+
+		PortBinding m_portHandler;
+
+		int m_outputPort;
+		int m_outputChannel;
+		int m_channelCount;
+
+		// The start and end values of each channel that were captured when the glide action was started,
+		// stored as fixed-size arrays so that all channels can be calculated in a single (vectorizable) loop
+		std::array<float, 16> m_startValues;
+		std::array<float, 16> m_endValues;
+		std::array<float, 16> m_valueDeltas;
+		std::array<float, 16> m_voltages;
 };
 
 struct ActionGateProcessor : ActionOngoingProcessor {
@@ -412,8 +711,13 @@ struct ActionGateProcessor : ActionOngoingProcessor {
 	void process(uint64_t glidePosition) override;
 	void end() override;
 
+	bool isActionDeterministic() const override;
+	int getOutputVoltageCount() const override;
+	void setOutputPortHandler(PortHandler* portHandler) override;
+	void addActionMemory(ProcessorMemoryReport& memoryReport) const override;
+
 	nt_private:
-		PortHandler* m_portHandler;
+		PortBinding m_portHandler;
 
 		int m_outputPort;
 		int m_outputChannel;
@@ -428,12 +732,23 @@ struct DurationProcessor {
 
 	virtual void prepareForStart() = 0;
 
+	// Returns true if the duration is fixed when the script is loaded
+	virtual bool isConstant() const;
+	virtual ProcessorCost getCost() const;
+
+	void addMemory(ProcessorMemoryReport& memoryReport) const;
+	virtual void addDurationMemory(ProcessorMemoryReport& memoryReport) const;
+
 	DurationState getState();
 	uint64_t getPosition();
 	uint64_t getDuration();
+	double getDrift();
 
 	double process(double drift);
 	void reset();
+	// Moves the duration to the state it would have after being processed for the specified number of samples, without
+	// reaching its end. Returns the remaining drift.
+	double seek(uint64_t samples, double drift);
 
 	void setDuration(uint64_t duration);
 	void setDrift(double drift);
@@ -449,12 +764,16 @@ struct DurationConstantProcessor : DurationProcessor {
 	DurationConstantProcessor(uint64_t duration, double drift);
 
 	void prepareForStart() override;
+	bool isConstant() const override;
+	void addDurationMemory(ProcessorMemoryReport& memoryReport) const override;
 };
 
 struct DurationVariableFactorProcessor : DurationProcessor {
 	DurationVariableFactorProcessor(const std::shared_ptr<ValueProcessor>& value, double samplesFactor);
 
 	void prepareForStart() override;
+	ProcessorCost getCost() const override;
+	void addDurationMemory(ProcessorMemoryReport& memoryReport) const override;
 
 	nt_private:
 		const std::shared_ptr<ValueProcessor> m_value;
@@ -465,12 +784,81 @@ struct DurationVariableHzProcessor : DurationProcessor {
 	DurationVariableHzProcessor(const std::shared_ptr<ValueProcessor>& value, double sampleRate);
 
 	void prepareForStart() override;
+	ProcessorCost getCost() const override;
+	void addDurationMemory(ProcessorMemoryReport& memoryReport) const override;
 
 	nt_private:
 		const std::shared_ptr<ValueProcessor> m_value;
 		double m_sampleRate;
 };
 
+// The output voltages that a segment set during its first run, grouped per step of the segment.
+// Step 0 is the sample in which the segment started, the other steps are the following samples by their duration position.
+struct SegmentRecording {
+	// Allocates the recording for a segment with the given duration, with room for the given number of output voltage writes
+	// and voltages in a run of the segment. Should be called when the script is loaded, since recording a run doesn't allocate.
+	void allocate(uint64_t duration, size_t writes, size_t voltages);
+	// Prepares the recording for a new run of the segment, discarding anything that was recorded before
+	void clear();
+	// Moves the recording to a step. Returns false if that step was already recorded (e.g. when a sample is repeated to correct the drift).
+	bool startStep(uint64_t step);
+	void addVoltages(int index, int channel, const float* voltages, int count, bool poly);
+	void complete();
+	bool isComplete() const;
+	// Stops recording the current run without completing it (e.g. when the run didn't start at the start of the segment)
+	void discard();
+
+	void replay(uint64_t step, const PortBinding& portHandler) const;
+	// The memory that is allocated for the recording
+	size_t getMemorySize() const;
+
+	nt_private:
+		struct Voltages {
+			int index;
+			int channel;
+			int count;
+			// Whether the voltages were set using setOutputPortVoltages or setOutputPortVoltage
+			bool poly;
+			uint32_t offset;
+		};
+		struct Step {
+			bool recorded = false;
+			uint32_t begin = 0;
+			uint32_t end = 0;
+		};
+
+		bool m_complete = false;
+		bool m_discarded = false;
+		uint64_t m_step = 0;
+		std::vector<Step> m_steps;
+		std::vector<Voltages> m_writes;
+		std::vector<float> m_voltages;
+};
+
+// Forwards all calls to another port handler, and records the output voltages that are set into a segment recording while one is active
+struct OutputRecorder final : PortHandler {
+	OutputRecorder(PortHandler* portHandler);
+
+	float getInputPortVoltage(int index, int channel) const override;
+	void getInputPortVoltages(int index, float* voltages, uint16_t channelMask) const override;
+	float getOutputPortVoltage(int index, int channel) const override;
+
+	void setOutputPortVoltage(int index, int channel, float voltage) override;
+	void setOutputPortVoltages(int index, int channel, const float* voltages, int count) override;
+	void setOutputPortChannels(int index, int channels) override;
+
+	void setOutputPortLabel(int index, const std::string& label) override;
+
+	void startRecording(SegmentRecording* recording, uint64_t step);
+	void stopRecording();
+	// Sets the output voltages of a recorded step directly on the forwarded port handler
+	void replay(const SegmentRecording& recording, uint64_t step);
+
+	nt_private:
+		PortBinding m_portHandler;
+		SegmentRecording* m_recording = nullptr;
+};
+
 struct SegmentProcessor {
 	SegmentProcessor(const SegmentProcessor& segmentProcessor);
 	SegmentProcessor(
@@ -479,16 +867,41 @@ struct SegmentProcessor {
 		const std::vector<std::shared_ptr<ActionProcessor>>& startActions,
 		const std::vector<std::shared_ptr<ActionProcessor>>& endActions,
 		const std::vector<std::shared_ptr<ActionOngoingProcessor>>& ongoingActions,
-		EventListener* eventListener
+		EventListener* eventListener,
+		EventTracer* eventTracer
 	);
 
 	void pushStartActions(const std::vector<std::shared_ptr<ActionProcessor>>& startActions);
 	void pushEndActions(const std::vector<std::shared_ptr<ActionProcessor>>& endActions);
+	// Records the output voltages of the first run of the segment, and replays them instead of processing the actions
+	// on later runs. Should only be used if all actions of the segment are deterministic and were created with the
+	// output recorder as port handler. The writes and voltages are the maximum number of output voltage writes and
+	// voltages that the actions can do in one run of the segment.
+	void setOutputRecorder(const std::shared_ptr<OutputRecorder>& outputRecorder, size_t writes, size_t voltages);
 
 	DurationProcessor::DurationState getState();
+	DurationProcessor* getDurationProcessor();
 
 	double process(double drift);
 	void reset();
+	// Continues the segment from the specified number of samples after its start. Only the start actions are executed,
+	// the ongoing actions continue from that position on the next process. Returns the remaining drift.
+	double seek(uint64_t samples, double drift);
+
+	// The cost of the start actions and duration calculation when the segment starts
+	ProcessorCost getStartCost() const;
+	ProcessorCost getEndCost() const;
+	// The cost of the ongoing actions for each sample of the segment
+	ProcessorCost getSampleCost() const;
+	int getOngoingActionCount() const;
+	// Segments that are used multiple times (through refs or repeated segment blocks) are only reported as hot spot once
+	void addCost(ProcessorCostReport& costReport, const Script* script, std::unordered_set<const ScriptSegment*>& reportedSegments) const;
+	void addMemory(ProcessorMemoryReport& memoryReport) const;
+
+	#ifdef __NT_TIMESEQ_PROFILING__
+		const ScriptSegment* getScriptSegment() const;
+		const ProfilerCounter& getProfilerCounter() const;
+	#endif
 
 	nt_private:
 		const ScriptSegment* m_scriptSegment;
@@ -499,6 +912,16 @@ struct SegmentProcessor {
 		const std::vector<std::shared_ptr<ActionOngoingProcessor>> m_ongoingActions;
 
 		EventListener* m_eventListener;
+		EventTracer* m_eventTracer;
+
+		// Actions that are pushed afterwards don't go through the output recorder, so they turn off the recording
+		std::shared_ptr<OutputRecorder> m_outputRecorder;
+		bool m_recordOutputs = false;
+		SegmentRecording m_recording;
+
+		#ifdef __NT_TIMESEQ_PROFILING__
+			ProfilerCounter m_profilerCounter;
+		#endif
 
 		void processStartActions();
 		void processEndActions();
@@ -508,16 +931,44 @@ struct SegmentProcessor {
 struct LaneProcessor {
 	enum LaneState { STATE_IDLE, STATE_PROCESSING, STATE_PENDING_LOOP };
 
-	LaneProcessor(const ScriptLane* scriptLane, const std::vector<std::shared_ptr<SegmentProcessor>>& segments, EventListener* eventListener);
+	LaneProcessor(const ScriptLane* scriptLane, const std::vector<std::shared_ptr<SegmentProcessor>>& segments, EventListener* eventListener, EventTracer* eventTracer);
 
 	LaneState getState();
 
 	bool process();
 	void loop();
 	void reset();
+	// Moves a processing lane ahead by the specified number of samples by skipping over whole segments, without executing
+	// the actions of those segments. Stops at the start of a segment that doesn't have a constant duration.
+	// If loop is false, the lane stops at the end of its current pass instead of looping.
+	void seek(uint64_t samples, bool loop);
+	// The number of samples until the specified number of passes are completed, for a lane at the start of its pass
+	uint64_t getPassSamples(uint64_t passes);
+	// The shortest and longest number of samples that a single pass can take, depending on the accumulated drift
+	uint64_t getMinPassSamples();
+	uint64_t getMaxPassSamples();
+	// The number of whole passes that fit in the specified number of samples, for a lane at the start of its pass
+	uint64_t getPassCount(uint64_t samples);
+	// The number of times that the lane will still loop, or UINT64_MAX if it loops forever
+	uint64_t getRemainingLoops();
+	// Completes a number of passes without processing them, for a lane at the start of its pass. The lane is
+	// left pending a loop, and the last of the passes is only counted once the lane restarts.
+	void skipPasses(uint64_t passes);
+	// Loops a lane that is pending a loop without processing or notifying the loop. Returns false if the lane doesn't loop.
+	bool restart();
 
 	void processTriggers(const std::vector<std::string>& triggers);
 
+	void getProgress(LaneProgress& progress) const;
+
+	void addCost(ProcessorCostReport& costReport, ProcessorCostReport::TimelineCost& timelineCost, const Script* script, std::unordered_set<const ScriptSegment*>& reportedSegments) const;
+	void addMemory(ProcessorMemoryReport& memoryReport) const;
+
+	#ifdef __NT_TIMESEQ_PROFILING__
+		const std::vector<std::shared_ptr<SegmentProcessor>>& getSegments() const;
+		const ProfilerCounter& getProfilerCounter() const;
+	#endif
+
 	nt_private:
 		const ScriptLane* m_scriptLane;
 		const std::vector<std::shared_ptr<SegmentProcessor>> m_segments;
@@ -528,7 +979,20 @@ struct LaneProcessor {
 		int m_activeSegment = 0;
 		double m_drift = 0.;
 
+		// The length of one pass over the segments, in whole samples and the drift that accumulates on top of that.
+		// Only known if all segments have a constant duration.
+		bool m_constantPass = true;
+		uint64_t m_passSamples = 0;
+		double m_passDrift = 0.;
+
 		EventListener* m_eventListener;
+		EventTracer* m_eventTracer;
+
+		#ifdef __NT_TIMESEQ_PROFILING__
+			ProfilerCounter m_profilerCounter;
+		#endif
+
+		bool shouldLoop();
 	};
 
 struct TimelineProcessor {
@@ -542,6 +1006,19 @@ struct TimelineProcessor {
 
 	void process();
 	void reset();
+	// Moves the lanes ahead by the specified number of samples. A loop-locked timeline that can't skip its passes at once
+	// continues the seek during the next process cycles, without processing the lanes until the seek completes.
+	void seek(uint64_t samples);
+
+	// Fills in the progress of the lanes, up to maxLanes. Returns the number of lanes that were filled in.
+	int getLaneProgress(LaneProgress* lanes, int maxLanes) const;
+
+	void addCost(ProcessorCostReport& costReport, std::unordered_map<std::string, int>& triggerFanOut, const Script* script, std::unordered_set<const ScriptSegment*>& reportedSegments) const;
+	void addMemory(ProcessorMemoryReport& memoryReport) const;
+
+	#ifdef __NT_TIMESEQ_PROFILING__
+		const std::vector<std::shared_ptr<LaneProcessor>>& getLanes() const;
+	#endif
 
 	nt_private:
 		const ScriptTimeline* m_scriptTimeline;
@@ -551,28 +1028,59 @@ struct TimelineProcessor {
 		const std::unordered_map<std::string, std::vector<std::shared_ptr<LaneProcessor>>> m_stopTriggers;
 
 		TriggerHandler* m_triggerHandler;
+
+		// A seek over many passes that can't be skipped at once continues during the next process cycles
+		bool m_seeking = false;
+		uint64_t m_seekSamples = 0;
+
+		void continueSeek();
 };
 
+// Detects the input triggers of all channels of one input port in a single batch
 struct TriggerProcessor {
-	TriggerProcessor(const std::string& id, int inputPort, int inputChannel, PortHandler* portHandler, TriggerHandler* triggerHandler);
+	TriggerProcessor(int inputPort, PortHandler* portHandler, TriggerHandler* triggerHandler);
+
+	void addTrigger(const std::string& id, int inputChannel);
+	int getInputPort() const;
+	int getTriggerCount() const;
 
 	void process();
 
+	void addMemory(ProcessorMemoryReport& memoryReport) const;
+
 	nt_private:
-		const std::string m_id;
 		int m_inputPort;
-		int m_inputChannel;
-		PortHandler* m_portHandler;
+		PortBinding m_portHandler;
 		TriggerHandler* m_triggerHandler;
 
-		rack::dsp::TSchmittTrigger<float> m_trigger;
+		// The ids of the triggers to fire for each channel, and the mask of channels that have at least one trigger
+		std::array<std::vector<std::string>, 16> m_ids;
+		uint16_t m_channelMask = 0;
+		int m_triggerCount = 0;
+
+		std::array<float, 16> m_voltages = {};
+		BatchSchmittTrigger m_trigger;
 };
 
 struct Processor {
 	Processor(const std::shared_ptr<Script>& script, const std::vector<std::shared_ptr<TimelineProcessor>>& timelines, const std::vector<std::shared_ptr<TriggerProcessor>>& triggers, const std::vector<std::shared_ptr<ActionProcessor>>& startActions);
+	Processor(const std::shared_ptr<Script>& script, const std::vector<std::shared_ptr<TimelineProcessor>>& timelines, const std::vector<std::shared_ptr<TriggerProcessor>>& triggers, const std::vector<std::shared_ptr<ActionProcessor>>& startActions, const std::shared_ptr<VariableBusReferences>& variableBusReferences);
 
 	virtual void reset();
 	virtual void process();
+	// Moves the timelines ahead by the specified number of samples after a reset, without processing the samples in between
+	virtual void seek(uint64_t samples);
+
+	// Fills in the progress of the lanes of all timelines, up to maxLanes. Returns the number of lanes that were filled in.
+	int getLaneProgress(LaneProgress* lanes, int maxLanes) const;
+
+	ProcessorCostReport getCostReport() const;
+	ProcessorMemoryReport getMemoryReport() const;
+
+	#ifdef __NT_TIMESEQ_PROFILING__
+		// The profiling counters of all lanes, followed by those of the segments (grouped by segment id where available)
+		std::vector<ProfilerEntry> getProfile() const;
+	#endif
 
 	nt_private:
 		const std::vector<std::shared_ptr<TimelineProcessor>> m_timelines;
@@ -582,6 +1090,8 @@ struct Processor {
 		// The script objects are used throughout the processor hierarchy,
 		// keep a reference so it doesn't get deleted on script switch
 		const std::shared_ptr<Script> m_script;
+		// The bus variables of the script, released when the processor is destroyed
+		const std::shared_ptr<VariableBusReferences> m_variableBusReferences;
 };
 
 }
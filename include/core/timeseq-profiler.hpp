@@ -0,0 +1,70 @@
+#pragma once
+
+// The profiling counters are only available if the plugin is built with the __NT_TIMESEQ_PROFILING__ flag.
+// Without that flag, the TIMESEQ_PROFILE macro compiles to nothing.
+#ifdef __NT_TIMESEQ_PROFILING__
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <cstdint>
+
+// Only one in this many invocations is timed, the duration of the other invocations is extrapolated from them
+#define TIMESEQ_PROFILER_SAMPLE_INTERVAL 64
+
+#define TIMESEQ_PROFILE(counter) timeseq::ProfilerScope profilerScope(counter)
+
+
+namespace timeseq {
+
+// The counters are only updated by the processing thread, but can be read from the UI thread
+struct ProfilerCounter {
+	std::atomic<uint64_t> invocations { 0 };
+	std::atomic<uint64_t> sampledInvocations { 0 };
+	std::atomic<uint64_t> sampledNanos { 0 };
+
+	// The estimated total duration of all invocations
+	double getEstimatedNanos() const {
+		uint64_t sampled = sampledInvocations.load(std::memory_order_relaxed);
+		return sampled > 0 ? (double) sampledNanos.load(std::memory_order_relaxed) * invocations.load(std::memory_order_relaxed) / sampled : 0.;
+	}
+};
+
+struct ProfilerScope {
+	ProfilerScope(ProfilerCounter& counter) : m_counter(counter) {
+		uint64_t invocations = counter.invocations.load(std::memory_order_relaxed) + 1;
+		counter.invocations.store(invocations, std::memory_order_relaxed);
+		m_sampled = (invocations % TIMESEQ_PROFILER_SAMPLE_INTERVAL) == 0;
+		if (m_sampled) {
+			m_start = std::chrono::steady_clock::now();
+		}
+	}
+
+	~ProfilerScope() {
+		if (m_sampled) {
+			uint64_t nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count();
+			m_counter.sampledNanos.store(m_counter.sampledNanos.load(std::memory_order_relaxed) + nanos, std::memory_order_relaxed);
+			m_counter.sampledInvocations.store(m_counter.sampledInvocations.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		}
+	}
+
+	private:
+		ProfilerCounter& m_counter;
+		bool m_sampled;
+		std::chrono::steady_clock::time_point m_start;
+};
+
+struct ProfilerEntry {
+	std::string name;
+	uint64_t invocations;
+	// The estimated total duration of all invocations (including the durations of nested profiled entries)
+	double nanos;
+};
+
+}
+
+#else
+
+#define TIMESEQ_PROFILE(counter)
+
+#endif
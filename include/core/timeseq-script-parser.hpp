@@ -12,7 +12,7 @@ namespace timeseq {
 
 struct JsonScriptParseContext {
 	int version;
-	std::vector<std::string> location;
+	ValidationLocation location;
 	std::vector<ValidationError> validationErrors;
 
 	void reset();
@@ -32,6 +32,8 @@ struct JsonScriptParser {
 		ScriptDuration parseDuration(const nlohmann::json& durationJson);
 		ScriptAction parseAction(const nlohmann::json& actionJson, bool allowRefs);
 		ScriptSetValue parseSetValue(const nlohmann::json& setValueJson);
+		ScriptSetPolyValue parseSetPolyValue(const nlohmann::json& setPolyValueJson);
+		std::unique_ptr<std::vector<ScriptValue>> parseGlideValues(const nlohmann::json& valuesJson, const char* subLocation, ValidationErrorCode validationErrorCode);
 		ScriptSetVariable parseSetVariable(const nlohmann::json& setVariableJson);
 		ScriptSetPolyphony parseSetPolyphony(const nlohmann::json& setPolyphonyJson);
 		ScriptSetLabel parseSetLabel(const nlohmann::json& setLabelJson);
@@ -39,16 +41,18 @@ struct JsonScriptParser {
 		ScriptMoveSequence parseMoveSequence(const nlohmann::json& moveSequenceJson);
 		ScriptAddToSequence parseAddToSequence(const nlohmann::json& addToSequenceJson);
 		ScriptRemoveFromSequence parseRemoveFromSequence(const nlohmann::json& removeFromJson);
-		ScriptValue parseValue(const nlohmann::json& valueJson, bool allowRefs, const std::string& subLocation, ValidationErrorCode validationErrorCode, const std::string& validationErrorMessage);
+		ScriptValue parseValue(const nlohmann::json& valueJson, bool allowRefs, ValidationLocation::Entry subLocation, ValidationErrorCode validationErrorCode, const std::string& validationErrorMessage);
 		ScriptValue parseFullValue(const nlohmann::json& valueJson, bool allowRefs, bool fromShorthand);
-		ScriptOutput parseOutput(const nlohmann::json& outputJson, bool allowRefs, const std::string& subLocation, ValidationErrorCode validationErrorCode, const std::string& validationErrorMessage);
+		ScriptOutput parseOutput(const nlohmann::json& outputJson, bool allowRefs, ValidationLocation::Entry subLocation, ValidationErrorCode validationErrorCode, const std::string& validationErrorMessage);
 		ScriptOutput parseFullOutput(const nlohmann::json& outputJson, bool allowRefs, bool fromShorthand);
-		ScriptInput parseInput(const nlohmann::json& inputJson, bool allowRefs, const std::string& subLocation, ValidationErrorCode validationErrorCode, const std::string& validationErrorMessage);
+		ScriptInput parseInput(const nlohmann::json& inputJson, bool allowRefs, ValidationLocation::Entry subLocation, ValidationErrorCode validationErrorCode, const std::string& validationErrorMessage);
 		ScriptInput parseFullInput(const nlohmann::json& inputJson, bool allowRefs, bool fromShorthand);
 		ScriptRand parseRand(const nlohmann::json& randJson);
 		ScriptCalc parseCalc(const nlohmann::json& calcJson, bool allowRefs);
 		ScriptInputTrigger parseInputTrigger(const nlohmann::json& inputTriggerJson);
 		ScriptTuning parseTuning(const nlohmann::json& tuningJson, bool allowRefs);
+		ScriptTable parseTable(const nlohmann::json& tableJson);
+		ScriptTableValue parseTableValue(const nlohmann::json& tableValueJson);
 		ScriptIf parseIf(const nlohmann::json& ifJson, bool allowRefs);
 		std::pair<ScriptValue, ScriptValue> parseIfValues(const std::string& ifOperator, const nlohmann::json& valuesJson);
 		std::unique_ptr<std::vector<ScriptIf>> parseIfIfs(const std::string& ifOperator, const nlohmann::json& ifsJson);
@@ -61,6 +65,19 @@ struct JsonScriptParser {
 		JsonScriptParseContext m_context;
 };
 
+// A read-only stream buffer on top of memory that is owned elsewhere (e.g. a memory-mapped script file). Scripts that
+// are loaded from a stream with this buffer are parsed directly from the memory, without copying it first.
+struct MemoryStreamBuffer : std::streambuf {
+	MemoryStreamBuffer(const char* data, size_t size);
+
+	const char* data() const;
+	size_t size() const;
+
+	private:
+		const char* m_data;
+		size_t m_size;
+};
+
 struct JsonLoader {
 	virtual ~JsonLoader();
 
@@ -76,6 +76,28 @@ struct ScriptTuning : ScriptRefObject {
 	std::vector<float> notes;
 };
 
+struct ScriptTable : ScriptRefObject {
+	/**
+	 * @brief The voltages of the table, evenly spread over the table positions
+	 */
+	std::vector<float> voltages;
+	/**
+	 * @brief If the table should wrap around
+	 * A wrapping table repeats itself outside of the position range, interpolating between
+	 * the last and the first voltage. A non-wrapping table keeps its first and last voltage
+	 * outside of the position range.
+	 */
+	bool wrap;
+};
+
+struct ScriptTableValue {
+	std::string id;
+	/**
+	 * @brief The position in the table, where 0 is the first voltage and 1 the end of the table
+	 */
+	std::unique_ptr<ScriptValue> position;
+};
+
 struct ScriptCalc : ScriptRefObject {
 	enum CalcOperation { ADD, SUB, DIV, MULT, MAX, MIN, REMAIN, TRUNC, FRAC, ROUND, QUANTIZE, SIGN, VTOF };
 	enum RoundType { UP, DOWN, NEAR };
@@ -131,6 +153,10 @@ struct ScriptValue : ScriptRefObject {
 	 * @brief Uses a value from a sequence
 	 */
 	std::unique_ptr<ScriptSequenceValue> sequence;
+	/**
+	 * @brief Uses a voltage that is interpolated from a table
+	 */
+	std::unique_ptr<ScriptTableValue> table;
 
 	/**
 	 * @brief A sequence of calculation to perform on the value
@@ -145,6 +171,11 @@ struct ScriptSetValue {
 	ScriptValue value;
 };
 
+struct ScriptSetPolyValue {
+	ScriptOutput output;
+	std::vector<ScriptValue> values;
+};
+
 struct ScriptSetVariable {
 	std::string name;
 	ScriptValue value;
@@ -206,11 +237,13 @@ struct ScriptAction : ScriptRefObject {
 	std::unique_ptr<ScriptIf> condition;
 
 	std::unique_ptr<ScriptSetValue> setValue;
+	std::unique_ptr<ScriptSetPolyValue> setPolyValue;
 	std::unique_ptr<ScriptSetVariable> setVariable;
 	std::unique_ptr<ScriptSetPolyphony> setPolyphony;
 	std::unique_ptr<ScriptSetLabel> setLabel;
 	std::unique_ptr<ScriptAssert> assert;
 	std::string trigger;
+	std::unique_ptr<int> selectScript;
 
 	std::unique_ptr<ScriptMoveSequence> moveSequence;
 	std::string clearSequence;
@@ -219,6 +252,8 @@ struct ScriptAction : ScriptRefObject {
 
 	std::unique_ptr<ScriptValue> startValue;
 	std::unique_ptr<ScriptValue> endValue;
+	std::unique_ptr<std::vector<ScriptValue>> startValues;
+	std::unique_ptr<std::vector<ScriptValue>> endValues;
 	std::unique_ptr<float> easeFactor;
 	std::unique_ptr<EaseAlgorithm> easeAlgorithm;
 	std::unique_ptr<ScriptOutput> output;
@@ -260,6 +295,8 @@ struct ScriptLane {
 	std::string restartTrigger;
 	std::string stopTrigger;
 	std::vector<ScriptSegment> segments;
+	// The number of samples between evaluations of the glide easing, with the glide output ramped in between
+	int controlRate;
 
 	bool disableUi;
 };
@@ -284,6 +321,8 @@ struct ScriptInputTrigger {
 struct Script {
 	std::string type;
 	std::string version;
+	// The version as a number that can be compared (e.g. 130 for version 1.3.0)
+	int versionNumber = 0;
 
 	std::vector<ScriptTimeline> timelines;
 	std::vector<ScriptAction> globalActions;
@@ -297,6 +336,7 @@ struct Script {
 	std::vector<ScriptAction> actions;
 	std::vector<ScriptIf> ifs;
 	std::vector<ScriptTuning> tunings;
+	std::vector<ScriptTable> tables;
 	std::vector<ScriptSequence> sequences;
 };
 
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
+// The number of events that the tracer keeps. Must be a power of two.
+#define TIMESEQ_TRACE_CAPACITY 4096
+// The ids of the traced events are truncated to this length (including the terminating 0)
+#define TIMESEQ_TRACE_ID_LENGTH 40
+
+
+namespace timeseq {
+
+enum TraceEventType : uint8_t { SEGMENT_START, SEGMENT_END, LANE_LOOP, TRIGGER, VARIABLE_SET, SEQUENCE_MOVE, ASSERT_FAILED };
+
+struct TraceEvent {
+	uint64_t sample;
+	// Identifies the processor instance that recorded the event
+	const void* source;
+	float value;
+	TraceEventType type;
+	char id[TIMESEQ_TRACE_ID_LENGTH];
+};
+
+/**
+ * A fixed-size ring buffer of timestamped events, recorded by the processing thread and dumped by the UI thread.
+ * Recording an event never allocates: the ids are copied into the pre-allocated event slots. When the buffer is full,
+ * the oldest events are overwritten. If tracing is disabled, recording an event is a single check of the enabled flag.
+ */
+struct EventTracer {
+	void setEnabled(bool enabled) {
+		m_enabled.store(enabled, std::memory_order_relaxed);
+	}
+
+	bool isEnabled() const {
+		return m_enabled.load(std::memory_order_relaxed);
+	}
+
+	// Moves the timestamp of the recorded events one sample forward
+	void advance() {
+		m_sample++;
+	}
+
+	void record(TraceEventType type, const void* source, const std::string& id, float value = 0.f) {
+		if (m_enabled.load(std::memory_order_relaxed)) {
+			recordEvent(type, source, id.data(), id.size(), value);
+		}
+	}
+
+	// Records an event with a 0-terminated id, which avoids constructing a string for events without an id
+	void record(TraceEventType type, const void* source, const char* id, float value = 0.f) {
+		if (m_enabled.load(std::memory_order_relaxed)) {
+			recordEvent(type, source, id, strnlen(id, TIMESEQ_TRACE_ID_LENGTH), value);
+		}
+	}
+
+	// Discards the events that were recorded up to now. Can be called from the UI thread.
+	void clear() {
+		m_start.store(m_count.load(std::memory_order_acquire), std::memory_order_relaxed);
+	}
+
+	// Dumps the recorded events as Chrome trace_event JSON, which can be opened in Perfetto or chrome://tracing
+	std::string getChromeTrace(float sampleRate) const;
+
+	private:
+		TraceEvent m_events[TIMESEQ_TRACE_CAPACITY] = {};
+		std::atomic<uint64_t> m_count { 0 };
+		std::atomic<uint64_t> m_start { 0 };
+		std::atomic<bool> m_enabled { false };
+		uint64_t m_sample = 0;
+
+		void recordEvent(TraceEventType type, const void* source, const char* id, size_t idLength, float value) {
+			uint64_t count = m_count.load(std::memory_order_relaxed);
+			TraceEvent& event = m_events[count & (TIMESEQ_TRACE_CAPACITY - 1)];
+			size_t length = std::min(idLength, (size_t) TIMESEQ_TRACE_ID_LENGTH - 1);
+			event.sample = m_sample;
+			event.source = source;
+			event.value = value;
+			event.type = type;
+			memcpy(event.id, id, length);
+			event.id[length] = 0;
+			m_count.store(count + 1, std::memory_order_release);
+		}
+};
+
+}
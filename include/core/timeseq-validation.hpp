@@ -2,6 +2,7 @@
 
 #include <string>
 #include <vector>
+#include <initializer_list>
 
 namespace timeseq {
 
@@ -50,6 +51,8 @@ enum ValidationErrorCode {
 	Script_TuningObject = 130, // Since 1.1.0
 	Script_SequencesArray = 131, // Since 1.2.0
 	Script_SequenceObject = 132, // Since 1.2.0
+	Script_TablesArray = 133, // Since 1.3.0
+	Script_TableObject = 134, // Since 1.3.0
 
 	Timeline_TimeScaleObject = 200,
 	Timeline_LanesMissing = 201,
@@ -74,6 +77,7 @@ enum ValidationErrorCode {
 	Lane_SegmentsMissing = 409,
 	Lane_SegmentObject = 410,
 	Lane_DisableUiBoolean = 411,
+	Lane_ControlRateNumber = 412, // Since 1.3.0
 
 	If_RefOrinstance = 500,
 	If_EqArray = 501,
@@ -151,6 +155,15 @@ enum ValidationErrorCode {
 	Action_ClearSequenceLength = 931, // Since 1.2.0
 	Action_AddToSequenceObject = 932, // Since 1.2.0
 	Action_RemoveFromSequenceObject = 933, // Since 1.2.0
+	Action_SetPolyValueObject = 934, // Since 1.3.0
+	Action_StartValuesArray = 935, // Since 1.3.0
+	Action_EndValuesArray = 936, // Since 1.3.0
+	Action_GlideValuesSize = 937, // Since 1.3.0
+	Action_GlideValueOrValues = 938, // Since 1.3.0
+	Action_GlideValuesVariable = 939, // Since 1.3.0
+	Action_GlideValuesChannelRange = 940, // Since 1.3.0
+	Action_SelectScriptNumber = 941, // Since 1.3.0
+	Action_SelectScriptRange = 942, // Since 1.3.0
 
 	SetValue_OutputObject = 1000,
 	SetValue_ValueObject = 1001,
@@ -186,6 +199,7 @@ enum ValidationErrorCode {
 	Value_QuantizeBool = 1415,
 	Value_NoLimitBoolean = 1416,
 	Value_NoLimitOnNonVoltage = 1417,
+	Value_TableObject = 1418, // Since 1.3.0
 
 	Output_RefOrInstance = 1500,
 	Output_IndexNumber = 1501,
@@ -276,6 +290,24 @@ enum ValidationErrorCode {
 	RemoveFromSequence_SequenceNotFound = 2603, // Since 1.2.0
 
 	ClearSequence_SequenceNotFound = 2700, // Since 1.2.0
+
+	SetPolyValue_OutputObject = 2800, // Since 1.3.0
+	SetPolyValue_ValuesArray = 2801, // Since 1.3.0
+	SetPolyValue_ValuesSize = 2802, // Since 1.3.0
+	SetPolyValue_ValueObject = 2803, // Since 1.3.0
+	SetPolyValue_ChannelRange = 2804, // Since 1.3.0
+
+	Table_VoltagesArray = 2900, // Since 1.3.0
+	Table_VoltagesArraySize = 2901, // Since 1.3.0
+	Table_VoltageFloat = 2902, // Since 1.3.0
+	Table_WrapBoolean = 2903, // Since 1.3.0
+
+	TableValue_IdString = 3000, // Since 1.3.0
+	TableValue_IdLength = 3001, // Since 1.3.0
+	TableValue_PositionObject = 3002, // Since 1.3.0
+	TableValue_TableNotFound = 3003, // Since 1.3.0
+
+	VariableBus_Full = 3100, // Since 1.3.0
 };
 
 
@@ -291,11 +323,55 @@ struct ValidationError {
 	}
 };
 
+/**
+ * The location in a script that is being parsed. Each entry is either a property name or an array index, and property
+ * names are kept as pointers to strings that outlive the entry (usually string literals), so entering and leaving a
+ * property or array element doesn't allocate. The location is only formatted as a string when a validation error is
+ * actually reported.
+ */
+struct ValidationLocation {
+	struct Entry {
+		Entry(const char* name) : name(name), index(-1) {}
+		Entry(int index) : name(nullptr), index(index) {}
+
+		const char* name;
+		int index;
+	};
+
+	ValidationLocation() {
+		m_entries.reserve(16);
+	}
+	ValidationLocation(std::initializer_list<Entry> entries) : m_entries(entries) {}
+
+	void push_back(Entry entry) {
+		m_entries.push_back(entry);
+	}
+	void pop_back() {
+		m_entries.pop_back();
+	}
+	void clear() {
+		m_entries.clear();
+	}
+	size_t size() const {
+		return m_entries.size();
+	}
+
+	std::vector<Entry>::const_iterator begin() const {
+		return m_entries.begin();
+	}
+	std::vector<Entry>::const_iterator end() const {
+		return m_entries.end();
+	}
+
+	private:
+		std::vector<Entry> m_entries;
+};
+
 const std::string createValidationErrorMessage(ValidationErrorCode code, ...);
-const std::string createValidationErrorLocation(const std::vector<std::string>& location);
+const std::string createValidationErrorLocation(const ValidationLocation& location);
 
 template <typename... Args>
-void addValidationError(std::vector<ValidationError>* validationErrors, const std::vector<std::string>& location, ValidationErrorCode code, Args&&... args)
+void addValidationError(std::vector<ValidationError>* validationErrors, const ValidationLocation& location, ValidationErrorCode code, Args&&... args)
 {
     if (!validationErrors)
         return;
@@ -115,4 +115,6 @@ struct RatriligModule : NTModule, DrawListener, RatriligCoreListener {
 
 struct RatriligWidget : NTModuleWidget {
 	RatriligWidget(RatriligModule* module);
+
+	void appendContextMenu(Menu* menu) override;
 };
\ No newline at end of file
@@ -29,6 +29,7 @@ struct SolimInputOctaverModule : NTModule, DrawListener {
 	SolimInputOctaverModule();
 
 	void draw(const widget::Widget::DrawArgs& args) override;
+	void onExpanderChange(const ExpanderChangeEvent& event) override;
 };
 
 struct SolimInputOctaverWidget : NTModuleWidget {
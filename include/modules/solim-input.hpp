@@ -23,6 +23,7 @@ struct SolimInputModule : NTModule, DrawListener {
 	SolimInputModule();
 
 	void draw(const widget::Widget::DrawArgs& args) override;
+	void onExpanderChange(const ExpanderChangeEvent& event) override;
 };
 
 struct SolimInputWidget : NTModuleWidget {
@@ -38,6 +38,7 @@ struct SolimOutputOctaverModule : NTModule, DrawListener {
 	void dataFromJson(json_t *rootJ) override;
 
 	void draw(const widget::Widget::DrawArgs& args) override;
+	void onExpanderChange(const ExpanderChangeEvent& event) override;
 
 	SortMode getSortMode();
 	void setSortMode(SortMode sortMode);
@@ -28,6 +28,7 @@ struct SolimOutputModule : NTModule, DrawListener {
 	void dataFromJson(json_t *rootJ) override;
 
 	void draw(const widget::Widget::DrawArgs& args) override;
+	void onExpanderChange(const ExpanderChangeEvent& event) override;
 	void onPortChange(const PortChangeEvent& event) override;
 
 	SolimOutputMode getOutputMode();
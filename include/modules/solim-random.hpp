@@ -1,5 +1,6 @@
 #pragma once
 #include <array>
+#include <atomic>
 #include "not-things.hpp"
 
 
@@ -47,11 +48,21 @@ struct SolimRandomModule : NTModule, DrawListener {
 
 	void process(const ProcessArgs& args) override;
 	void draw(const widget::Widget::DrawArgs& args) override;
+	void onExpanderChange(const ExpanderChangeEvent& event) override;
+
+	// Makes the next draw detect the Solim modules that this module is connected to again
+	void expandersChanged();
 
 	private:
 		dsp::BooleanTrigger m_buttonTrigger[TriggerId::NUM_TRIGGERS];
 		dsp::TSchmittTrigger<float> m_trigTriggers[TriggerId::NUM_TRIGGERS][8];
 
+		std::atomic<bool> m_expandersChanged { true };
+		bool m_hasLeftSolimModule = false;
+		bool m_hasRightSolimModule = false;
+
+		void detectSolimModules();
+
 		bool processTriggers(ParamId paramId, InputId inputId, TriggerId triggerId, std::array<int, 8>& counters);
 };
 
@@ -1,5 +1,6 @@
 #pragma once
 #include <array>
+#include <atomic>
 #include "not-things.hpp"
 
 #include "core/solim-core.hpp"
@@ -78,6 +79,10 @@ struct SolimModule : NTModule, DrawListener {
 	void draw(const widget::Widget::DrawArgs& args) override;
 	void onSampleRateChange(const SampleRateChangeEvent& sampleRateChangeEvent) override;
 	void onPortChange(const PortChangeEvent& event) override;
+	void onExpanderChange(const ExpanderChangeEvent& event) override;
+
+	// Lets the Solim and Solim Random modules in the chain of the module know that they have to detect their expanders again
+	static void expanderChainChanged(Module* module);
 
 	ProcessRate getProcessRate();
 	void setProcessRate(ProcessRate processRate);
@@ -93,6 +98,8 @@ struct SolimModule : NTModule, DrawListener {
 
 		SolimCore *m_solimCore;
 		SolimExpanders m_solimExpanders;
+		// Set when the expander chain changed, and consumed by the processing thread to detect the expanders again
+		std::atomic<bool> m_expandersChanged { true };
 		bool m_hasRandomModule = false;
 
 		bool m_lastRandom = false;
@@ -3,11 +3,32 @@
 #include "not-things.hpp"
 
 #include "core/timeseq-core.hpp"
+#include "core/timeseq-port-buffer.hpp"
+#include "util/triplebuffer.hpp"
+#include "util/messagequeue.hpp"
 
 struct TimeSeqDisplay;
 struct LEDDisplay;
 
-struct TimeSeqModule : NTModule, DrawListener, timeseq::PortHandler, timeseq::SampleRateReader, timeseq::EventListener, timeseq::AssertListener {
+struct TimeSeqVoltageSnapshot {
+	// Per output port, a bitmask of the channels that changed since the previous snapshot
+	std::array<uint16_t, 8> changedChannels;
+	std::array<std::array<float, 16>, 8> voltages;
+};
+
+// A notification from the engine thread that has to be handled on the UI thread
+struct TimeSeqUiMessage {
+	enum Type { SCRIPT_RESET, SET_LABEL, ASSERT_FAILED };
+
+	Type type;
+	int index;
+	// The label for SET_LABEL, or the assert name for ASSERT_FAILED
+	char name[128];
+	// The operands of the failed expectation for ASSERT_FAILED
+	timeseq::AssertExpectation expectation;
+};
+
+struct TimeSeqModule : NTModule, DrawListener, timeseq::PortLabelListener, timeseq::SampleRateReader, timeseq::EventListener, timeseq::AssertListener {
 	enum ParamId {
 		PARAM_RUN,
 		PARAM_RESET,
@@ -55,27 +76,44 @@ struct TimeSeqModule : NTModule, DrawListener, timeseq::PortHandler, timeseq::Sa
 	void onSampleRateChange(const SampleRateChangeEvent& sampleRateChangeEvent) override;
 	void onRemove(const RemoveEvent& e) override;
 
-	float getInputPortVoltage(int index, int channel) const override;
-	float getOutputPortVoltage(int index, int channel) const override;
+	void outputPortLabelChanged(int index, const std::string& label) override;
 	float getSampleRate() const override;
-	void setOutputPortVoltage(int index, int channel, float voltage) override;
-	void setOutputPortChannels(int index, int channels) override;
-	void setOutputPortLabel(int index, const std::string& label) override;
 
 	void laneLooped() override;
 	void segmentStarted() override;
 	void triggerTriggered() override;
 	void scriptReset() override;
 
-	void assertFailed(const std::string& name, const std::string& message, bool stop) override;
+	void assertFailed(const std::string& name, const timeseq::AssertExpectation& expectation, bool stop) override;
 
 
 	std::shared_ptr<std::string> getScript();
 	std::string loadScript(std::shared_ptr<std::string> script);
+	std::string loadScript(int index, std::shared_ptr<std::string> script);
+	// Loads a script file in the active slot of the script bank by parsing it directly from a memory mapping of the file
+	std::string loadScriptFile(const std::string& path);
 	void clearScript();
+	// Switches to another script of the script bank at the next sample
+	void selectScript(int index);
+	int getActiveScript();
+	bool hasScript(int index);
 	std::list<std::string>& getLastScriptLoadErrors();
+	std::vector<std::string> getCostReport();
+	std::vector<std::string> getMemoryReport();
+	bool isEventTraceEnabled();
+	void setEventTraceEnabled(bool enabled);
+	void clearEventTrace();
+	std::string getEventTrace();
+	bool isFastMath();
+	void setFastMath(bool fastMath);
+	// Restarts the script at the specified position (in seconds) without processing the samples before it
+	void seek(double seconds);
+	#ifdef __NT_TIMESEQ_PROFILING__
+		std::vector<timeseq::ProfilerEntry> getProfile();
+	#endif
 
 	std::vector<std::string>& getFailedAsserts();
+	void processUiMessages();
 
 	void setTimeSeqDisplay(TimeSeqDisplay* timeSeqDisplay);
 	void setLEDDisplay(LEDDisplay* ledDisplay);
@@ -85,46 +123,95 @@ struct TimeSeqModule : NTModule, DrawListener, timeseq::PortHandler, timeseq::Sa
 		LEDDisplay* m_ledDisplay = nullptr;
 
 		timeseq::TimeSeqCore *m_timeSeqCore;
-		std::shared_ptr<std::string> m_script;
+		// The script data of each slot of the script bank
+		std::shared_ptr<std::string> m_scripts[timeseq::TimeSeqCore::SCRIPT_BANK_SIZE];
 		std::list<std::string> m_lastScriptLoadErrors;
+		// The compressed patch data of each slot, and the script data it was compressed from
+		std::string m_compressedScripts[timeseq::TimeSeqCore::SCRIPT_BANK_SIZE];
+		std::shared_ptr<std::string> m_compressedScriptSources[timeseq::TimeSeqCore::SCRIPT_BANK_SIZE];
+
+		// Loads the script data in a slot. If there is no script string yet, one is only created from the data if the script loads.
+		std::string loadScript(int index, const char* scriptData, size_t size, std::shared_ptr<std::string> script);
+		// Creates the patch data of a slot of the script bank, compressing the script if it changed since the last save.
+		json_t* scriptToJson(int index);
+		// Reads the script data of a slot of the script bank, which can be compressed or a plain string from older patches.
+		std::shared_ptr<std::string> scriptFromJson(json_t* scriptJ);
 
 		dsp::BooleanTrigger m_buttonTrigger[TriggerId::NUM_TRIGGERS];
 		dsp::TSchmittTrigger<float> m_trigTriggers[TriggerId::NUM_TRIGGERS];
 		dsp::PulseGenerator m_runPulse;
 		dsp::PulseGenerator m_resetPulse;
 
-		std::array<std::array<float, 16>, 8> m_outputVoltages;
-		std::array<int, 8> m_outputChannels;
+		// The port voltages that the processors use. The input voltages are captured once per sample, and the written
+		// output voltages are flushed to the Rack ports after each sample, so the processors don't have to go through the Rack ports.
+		timeseq::PortBuffer m_portBuffer;
 
 		bool m_laneLooped = false;
 		bool m_segmentStarted = false;
 		bool m_triggerTriggered = false;
 		int m_rateDivision = 0;
 
-		std::vector<int> m_changedPortChannelVoltages;
+		// Per output port, a bitmask of the channels that changed since the last voltage snapshot was published
+		std::array<uint16_t, 8> m_changedChannels = {};
+		// Per output port, a bitmask of the channels that changed in published voltage snapshots that weren't consumed
+		// yet, so they can be carried into the next snapshot if the display skips them
+		std::array<uint16_t, 8> m_unconsumedChangedChannels = {};
+		// The voltage snapshots are published by the engine thread and consumed by the UI thread for the voltage display
+		TripleBuffer<TimeSeqVoltageSnapshot> m_voltageSnapshots;
+		// The progress of the core and its lanes, published by the engine thread together with the voltage snapshots
+		TripleBuffer<timeseq::TimeSeqCore::ProgressSnapshot> m_progressSnapshots;
 		dsp::ClockDivider m_portChannelChangeClockDivider;
 
+		// Label changes and assert failures are queued by the engine thread and handled by the UI thread
+		MessageQueue<TimeSeqUiMessage, 64> m_uiMessages;
 		std::vector<std::string> m_failedAsserts;
 		dsp::ClockDivider m_failedAssertBlinkClockDivider;
 
 		// There was an error loading the latest script
 		bool m_scriptError = false;
+		// Use approximations for the more expensive calculations in the script
+		bool m_fastMath = false;
 
 		void resetUi();
 		void resetOutputs();
+		void resetOutputLabels();
+		void queueUiMessage(TimeSeqUiMessage::Type type, int index, const std::string& name, const timeseq::AssertExpectation* expectation);
 		void updateOutputs();
+		void captureInputs();
+		void flushOutputs();
+		void publishVoltageSnapshot();
+		void publishProgressSnapshot();
 		void setDisplayScriptError(bool error);
 
 		int getRate();
 };
 
+// A context menu text field that seeks the script to a position entered as "seconds" or "minutes:seconds"
+struct TimeSeqSeekField : ui::TextField {
+	TimeSeqSeekField(TimeSeqModule* module);
+
+	void onSelectKey(const SelectKeyEvent& e) override;
+
+	private:
+		TimeSeqModule* m_module;
+};
+
 struct TimeSeqWidget : NTModuleWidget {
 	TimeSeqWidget(TimeSeqModule* module);
 
 	virtual void appendContextMenu(Menu* menu) override;
 	virtual void onRemove(const RemoveEvent& e) override;
+	virtual void step() override;
 
 	private:
+		#ifdef __NT_TIMESEQ_PROFILING__
+			enum ProfileSort { SORT_BY_TIME, SORT_BY_INVOCATIONS, SORT_BY_NAME };
+			ProfileSort m_profileSort = SORT_BY_TIME;
+
+			std::vector<std::string> getProfileTable(const char* separator);
+			void copyProfile();
+		#endif
+
 		void loadScript();
 		void saveScript();
 		void copyScript();
@@ -133,6 +220,10 @@ struct TimeSeqWidget : NTModuleWidget {
 		void copyLastLoadErrors();
 
 		void copyAssertions();
+		void copyCostReport();
+		void copyMemoryReport();
+		void saveEventTrace();
+		void copyEventTrace();
 
 		bool hasScript();
 		bool hasFailedAsserts();
@@ -1,5 +1,6 @@
 #pragma once
 #include <rack.hpp>
+#include <atomic>
 using namespace rack;
 
 // #define __NT_DEBUG__
@@ -36,9 +37,23 @@ struct NTModule : Module {
 	void setTheme(ThemeId themeId);
 	void addThemeChangeListener(ThemeChangeListener* listener);
 
+	// A fixed random seed is stored in the patch, so the random behaviour of the module can be reproduced
+	bool hasFixedRandomSeed();
+	uint32_t getRandomSeed();
+	void setFixedRandomSeed(bool fixed);
+	void newRandomSeed();
+
+	protected:
+		// Returns true once after the random seed changed, so the module can apply it on the processing thread
+		bool randomSeedChanged();
+
 	private:
 		ThemeId m_themeId = VCV;
 		std::vector<ThemeChangeListener*> m_themeChangeListeners;
+
+		bool m_fixedRandomSeed = false;
+		uint32_t m_randomSeed = 0;
+		std::atomic<bool> m_randomSeedChanged { false };
 };
 
 struct NTModuleWidget : ModuleWidget {
@@ -50,6 +65,7 @@ struct NTModuleWidget : ModuleWidget {
 	void addParam(ParamWidget* output);
 
 	void appendContextMenu(Menu* menu) override;
+	void appendRandomSeedMenu(Menu* menu);
 
 	void addThemeChangeListener(Widget* widget);
 	void setTheme(ThemeId themeId);
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+
+/**
+ * Approximations of math functions that are faster than their standard library counterparts, for code that runs at
+ * audio rate and can trade some accuracy for speed.
+ *
+ * Error bounds (verified by the fastmath unit tests):
+ * - fastExp2: relative error below 3e-7 for x in [-126, 126]. Values outside that range (including infinities) are
+ *   clamped to it, and NaN is returned as is.
+ * - fastLog2: absolute error below 3e-6 for positive normal x.
+ * - fastPow: relative error below |exponent| * 3e-6 + 3e-7 for a positive base, 0 for a base of 0.
+ * - fastFrac: exact.
+ * - fastFmod: absolute error below 4 * |x| * 2^-52 for |x / y| < 2^52 (0 is returned above that). If x is within that
+ *   error of a multiple of y, the result can also differ from fmod by y (i.e. be close to y instead of close to 0).
+ */
+
+inline float fastExp2(float x) {
+	// NaN would pass the clamping below, and converting it to an integer is undefined
+	if (std::isnan(x)) {
+		return x;
+	}
+	x = x < -126.f ? -126.f : x > 126.f ? 126.f : x;
+
+	// Split into an integer part that goes into the exponent bits, and a fraction in [0, 1) that is approximated with a polynomial
+	int32_t integral = (int32_t) x;
+	if (x < integral) {
+		integral--;
+	}
+	float fract = x - integral;
+	// The constant term is exactly 1, so whole numbers result in exact powers of two
+	float result = 1.8671966e-03f;
+	result = result * fract + 9.0166582e-03f;
+	result = result * fract + 5.5800468e-02f;
+	result = result * fract + 2.4016415e-01f;
+	result = result * fract + 6.9315135e-01f;
+	result = result * fract + 1.f;
+
+	// Work on the bits as unsigned, since shifting a negative value is undefined
+	uint32_t bits;
+	memcpy(&bits, &result, sizeof(bits));
+	bits += (uint32_t) integral << 23;
+	memcpy(&result, &bits, sizeof(bits));
+	return result;
+}
+
+inline float fastLog2(float x) {
+	// Split into the exponent and a mantissa in [1, 2), for which log2 is approximated with a polynomial
+	int32_t bits;
+	memcpy(&bits, &x, sizeof(bits));
+	int32_t exponent = ((bits >> 23) & 0xFF) - 127;
+	bits = (bits & 0x007FFFFF) | 0x3F800000;
+	float mantissa;
+	memcpy(&mantissa, &bits, sizeof(bits));
+
+	float m = mantissa - 1.f;
+	float result = -2.5123486e-02f;
+	result = result * m + 1.1929956e-01f;
+	result = result * m - 2.7462542e-01f;
+	result = result * m + 4.5552868e-01f;
+	result = result * m - 7.1755844e-01f;
+	result = result * m + 1.4424754e+00f;
+	result = result * m + 2.1204901e-06f;
+	return result + exponent;
+}
+
+inline float fastPow(float base, float exponent) {
+	if (base <= 0.f) {
+		return 0.f;
+	}
+	return fastExp2(exponent * fastLog2(base));
+}
+
+inline double fastFrac(double x) {
+	// From 2^52 onwards, all doubles are whole numbers
+	if ((x >= 4503599627370496.) || (x <= -4503599627370496.)) {
+		return 0.;
+	}
+	return x - (double) (int64_t) x;
+}
+
+inline double fastFmod(double x, double y) {
+	double quotient = x / y;
+	if ((quotient >= 4503599627370496.) || (quotient <= -4503599627370496.)) {
+		return 0.;
+	}
+	return x - (double) (int64_t) quotient * y;
+}
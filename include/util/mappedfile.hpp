@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+/**
+ * A read-only memory mapping of a complete file. The contents are paged in from the file by the OS when they are read,
+ * so large files can be parsed without first copying them into memory. The mapping is released when the object is
+ * destroyed, so the data must not be used beyond the lifetime of the object.
+ */
+struct MappedFile {
+	MappedFile(const std::string& path);
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// Whether the file could be opened and mapped. An empty file is open, but has no data.
+	bool isOpen() const {
+		return m_open;
+	}
+	const char* data() const {
+		return m_data;
+	}
+	size_t size() const {
+		return m_size;
+	}
+
+	private:
+		bool m_open = false;
+		const char* m_data = nullptr;
+		size_t m_size = 0;
+#ifdef _WIN32
+		void* m_fileHandle = nullptr;
+		void* m_mappingHandle = nullptr;
+#endif
+};
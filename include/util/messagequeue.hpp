@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * A fixed-size lock-free single-producer/single-consumer message queue.
+ * The producer (e.g. the audio thread) pushes messages that are later popped by the consumer (e.g. the UI thread).
+ * The messages are copied into pre-allocated slots, so pushing never allocates or waits. If the queue is full, the
+ * message is dropped.
+ */
+template <typename T, size_t capacity>
+struct MessageQueue {
+	// Returns a reference to the slot for the next message, or nullptr if the queue is full.
+	// The message is only made available to the consumer once commit() is called.
+	T* prepare() {
+		size_t head = m_head.load(std::memory_order_relaxed);
+		if (head - m_tail.load(std::memory_order_acquire) >= capacity) {
+			return nullptr;
+		}
+		return &m_messages[head % capacity];
+	}
+
+	void commit() {
+		m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	// Returns the oldest message in the queue, or nullptr if the queue is empty.
+	// The message stays valid until release() is called.
+	const T* peek() const {
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+		if (tail == m_head.load(std::memory_order_acquire)) {
+			return nullptr;
+		}
+		return &m_messages[tail % capacity];
+	}
+
+	void release() {
+		m_tail.store(m_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	private:
+		T m_messages[capacity] = {};
+		std::atomic<size_t> m_head { 0 };
+		std::atomic<size_t> m_tail { 0 };
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+#include <array>
+#include <cstddef>
+
+// The number of steps in the lookup table that covers one octave. Must be a power of two.
+#define QUANTIZER_TABLE_SIZE 256
+
+
+struct QuantizedNote {
+	// The octave of the quantized note, which can differ from the octave of the quantized voltage if it was rounded to a note of the octave below or above
+	int octave;
+	// The index of the note within the notes of the quantizer
+	int index;
+};
+
+// How a value that is exactly halfway between two notes is quantized
+enum class QuantizerTieBreak { ROUND_UP, ROUND_DOWN };
+
+/**
+ * Quantizes voltages to the nearest note of a tuning, where a value halfway between two notes is quantized up (unless
+ * the quantizer is created with QuantizerTieBreak::ROUND_DOWN).
+ * The notes of the tuning are repeated every octave (i.e. 1V). When the quantizer is created, the octave is split up
+ * in QUANTIZER_TABLE_SIZE equal steps, and for each step the lowest note that can be quantized to within that step is
+ * stored. Quantizing a voltage then only needs the index of its step in the table, and at most a single comparison with
+ * the boundary of the next note (as long as no two notes are closer together than the size of one step).
+ */
+struct Quantizer {
+	// Creates a quantizer for the 12 notes of the equal-tempered chromatic scale
+	Quantizer();
+	// Creates a quantizer for the notes, which must be sorted, unique and within the 0V-1V range
+	Quantizer(const std::vector<float>& notes, QuantizerTieBreak tieBreak = QuantizerTieBreak::ROUND_UP);
+
+	// A shared quantizer for the 12 notes of the equal-tempered chromatic scale
+	static const Quantizer& chromatic();
+
+	QuantizedNote quantizeNote(double voltage) const;
+	double quantize(double voltage) const;
+	float quantize(float voltage) const;
+	// Quantizes the voltages in place, e.g. for all channels of a polyphonic frame
+	void quantize(float* voltages, int count) const;
+
+	const std::vector<float>& getNotes() const;
+	// The heap memory that is used by the notes and lookup data of the quantizer
+	size_t getMemorySize() const;
+
+	private:
+		std::vector<float> m_notes;
+		// The notes that can be quantized to within one octave: the last note of the previous octave, all notes and the first note of the next octave
+		std::vector<float> m_targets;
+		// The upper boundary of each target, halfway between the target and the next one. The boundary itself belongs to the
+		// next target, unless halfway values are rounded down.
+		std::vector<float> m_boundaries;
+		bool m_roundDown;
+		// For each step of the octave, the first target that can be quantized to within that step
+		std::array<int, QUANTIZER_TABLE_SIZE> m_table;
+
+		template<typename T>
+		int findTarget(T fract) const;
+};
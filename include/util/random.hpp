@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * A fast seedable random generator (xoshiro128++), with its state kept per instance.
+ * It runs four independent xoshiro128++ streams side by side, so each step produces a block of four values with
+ * operations that the compiler can vectorize. Single values are handed out from that block, while fill() writes whole
+ * blocks at once.
+ * The generator meets the UniformRandomBitGenerator requirements, so it can also be used with the standard library.
+ */
+struct RandomGenerator {
+	typedef uint32_t result_type;
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return UINT32_MAX; }
+
+	RandomGenerator() : RandomGenerator(createSeed()) {}
+	explicit RandomGenerator(uint64_t seed) {
+		this->seed(seed);
+	}
+
+	// Returns a different seed on each call, for generators that don't need to be reproducible.
+	static uint64_t createSeed() {
+		static std::atomic<uint64_t> counter { 0 };
+		return (uint64_t) std::chrono::steady_clock::now().time_since_epoch().count() ^ (++counter * 0x9E3779B97F4A7C15ull);
+	}
+
+	void seed(uint64_t seed) {
+		// Expand the seed into the stream states using splitmix64, which never results in an all-zero state
+		for (int i = 0; i < 4; i++) {
+			for (int lane = 0; lane < 4; lane += 2) {
+				seed += 0x9E3779B97F4A7C15ull;
+				uint64_t z = seed;
+				z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+				z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+				z = z ^ (z >> 31);
+				m_state[i][lane] = (uint32_t) z;
+				m_state[i][lane + 1] = (uint32_t) (z >> 32);
+			}
+		}
+		m_index = 4;
+	}
+
+	result_type operator()() {
+		if (m_index >= 4) {
+			advance();
+			m_index = 0;
+		}
+		return m_block[m_index++];
+	}
+
+	// A uniform value in the range [0, 1)
+	float nextFloat() {
+		return toFloat((*this)());
+	}
+
+	// A uniform value in the range [lower, upper)
+	float nextFloat(float lower, float upper) {
+		return lower + nextFloat() * (upper - lower);
+	}
+
+	// Fills the values with uniform values in the range [lower, upper)
+	void fill(float* values, int count, float lower, float upper) {
+		float range = upper - lower;
+		int i = 0;
+		for (; i + 4 <= count; i += 4) {
+			advance();
+			for (int lane = 0; lane < 4; lane++) {
+				values[i + lane] = lower + toFloat(m_block[lane]) * range;
+			}
+		}
+		// The block was fully used by the loop above
+		m_index = 4;
+		for (; i < count; i++) {
+			values[i] = nextFloat(lower, upper);
+		}
+	}
+
+	private:
+		// The state of the four streams, kept as four words per lane so that each step works on all lanes at once
+		alignas(16) uint32_t m_state[4][4];
+		alignas(16) uint32_t m_block[4];
+		int m_index;
+
+		static uint32_t rotl(uint32_t x, int k) {
+			return (x << k) | (x >> (32 - k));
+		}
+
+		// Use the upper 24 bits, which fit exactly in the mantissa of a float
+		static float toFloat(uint32_t value) {
+			return (value >> 8) * (1.f / 16777216.f);
+		}
+
+		void advance() {
+			for (int lane = 0; lane < 4; lane++) {
+				m_block[lane] = rotl(m_state[0][lane] + m_state[3][lane], 7) + m_state[0][lane];
+
+				uint32_t t = m_state[1][lane] << 9;
+				m_state[2][lane] ^= m_state[0][lane];
+				m_state[3][lane] ^= m_state[1][lane];
+				m_state[1][lane] ^= m_state[2][lane];
+				m_state[0][lane] ^= m_state[3][lane];
+				m_state[2][lane] ^= t;
+				m_state[3][lane] = rotl(m_state[3][lane], 11);
+			}
+		}
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Schmitt trigger detection for the 16 channels of a polyphonic port at once. Each channel behaves like a
+ * rack::dsp::TSchmittTrigger<float> with a low threshold of 0v and a high threshold of 1v (including the initial high
+ * state), but the channel states are kept as a bitmask so that the detection of all channels is a few integer
+ * operations after a single pass over the voltages.
+ */
+struct BatchSchmittTrigger {
+	// Processes the voltages of the channels in channelMask and returns the mask of channels that went high.
+	// All 16 voltages are read, but the state of channels outside channelMask is left untouched.
+	uint16_t process(const float* voltages, uint16_t channelMask) {
+		uint32_t on = 0;
+		uint32_t off = 0;
+		for (int i = 0; i < 16; i++) {
+			on |= (uint32_t) (voltages[i] >= 1.f) << i;
+			off |= (uint32_t) (voltages[i] <= 0.f) << i;
+		}
+		on &= channelMask;
+		off &= channelMask;
+
+		uint16_t triggered = ~m_state & on;
+		m_state = on | (m_state & ~off);
+		return triggered;
+	}
+
+	void reset() {
+		m_state = 0xFFFF;
+	}
+
+	bool isHigh(int channel) const {
+		return m_state & (1 << channel);
+	}
+
+	private:
+		uint16_t m_state = 0xFFFF;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * A lock-free single-producer/single-consumer triple buffer.
+ * The producer (e.g. the audio thread) fills the write buffer and publishes it, while the consumer (e.g. the UI thread)
+ * picks up the most recently published buffer. Neither side ever waits for the other, and no allocations are done.
+ */
+template <typename T>
+struct TripleBuffer {
+	// Bit that is set on the shared index when it contains a buffer that hasn't been consumed yet.
+	static const uint8_t FRESH = 0x4;
+
+	T& getWriteBuffer() {
+		return m_buffers[m_writeIndex];
+	}
+
+	// Returns true if the previously published buffer was never consumed, i.e. if it was replaced by this one.
+	bool publish() {
+		uint8_t previous = m_sharedIndex.exchange(m_writeIndex | FRESH, std::memory_order_acq_rel);
+		m_writeIndex = previous & ~FRESH;
+		return previous & FRESH;
+	}
+
+	bool consume() {
+		if (m_sharedIndex.load(std::memory_order_relaxed) & FRESH) {
+			m_readIndex = m_sharedIndex.exchange(m_readIndex, std::memory_order_acq_rel) & ~FRESH;
+			return true;
+		}
+		return false;
+	}
+
+	const T& getReadBuffer() const {
+		return m_buffers[m_readIndex];
+	}
+
+	private:
+		T m_buffers[3] = {};
+		uint8_t m_writeIndex = 0;
+		std::atomic<uint8_t> m_sharedIndex { 1 };
+		uint8_t m_readIndex = 2;
+};
@@ -1,9 +1,9 @@
 #include "components/timeseq-display.hpp"
-#include "core/timeseq-core.hpp"
 #include <algorithm>
 #include <array>
 #include <cmath>
 
+#define TO_CHANNEL_PORT_IDENTIFIER(channel, port) ((channel << 5) + port)
 #define CHANNEL_FROM_CHANNEL_PORT_IDENTIFIER(identifier) (identifier >> 5)
 #define PORT_FROM_CHANNEL_PORT_IDENTIFIER(identifier) (identifier & 0xF)
 
@@ -13,6 +13,10 @@ float END_ARC = nvgDegToRad(540);
 NVGcolor LIGHT_RED = nvgRGBA(0xBB, 0x45, 0x45, 0xFF);
 NVGcolor DARK_RED = nvgRGBA(0x20, 0x20, 0x20, 0xFF);
 
+// The top of the lane progress bars (below the status line) and the vertical space that each lane takes
+#define LANE_PROGRESS_TOP 13.f
+#define LANE_PROGRESS_PITCH 4.f
+
 
 extern Plugin* pluginInstance;
 
@@ -33,11 +37,11 @@ void TimeSeqDisplay::drawLayer(const DrawArgs& args, int layer) {
 	float animationPos;
 	timeseq::TimeSeqCore::Status status;
 	std::vector<TimeSeqVoltagePoints>* voltagePoints;
-	if (m_timeSeqCore) {
-		// If there is a TimeSeq core assigned, there is actual data to draw
-		status = m_timeSeqCore->getStatus();
-		uint32_t tripSampleRate = m_timeSeqCore->getCurrentSampleRate() * 3; // Let each animation loop take 3 seconds
-		uint32_t sampleRemainder = m_timeSeqCore->getElapsedSamples() % tripSampleRate * 4; // Multiply by 4 so we can divide it over the four circles
+	if (m_hasProgress) {
+		// If there is progress from a TimeSeq module, there is actual data to draw
+		status = m_progress.status;
+		uint32_t tripSampleRate = m_progress.sampleRate * 3; // Let each animation loop take 3 seconds
+		uint32_t sampleRemainder = m_progress.elapsedSamples % tripSampleRate * 4; // Multiply by 4 so we can divide it over the four circles
 		animationPos = (float) sampleRemainder / tripSampleRate; // How far along we are in the animation, between 0.f and 4.f
 
 		voltagePoints = &m_voltagePoints;
@@ -119,10 +123,36 @@ void TimeSeqDisplay::drawLayer(const DrawArgs& args, int layer) {
 		}
 	}
 
+	if ((m_hasProgress) && (status != timeseq::TimeSeqCore::Status::EMPTY)) {
+		// The lane progress uses the space between the status line and the topmost voltage
+		drawLaneProgress(args, voltagePoints->size() > 0 ? 177.f - voltagePoints->size() * 11.f - 2.f : box.getHeight());
+	}
+
 	nvgResetScissor(args.vg);
 	nvgRestore(args.vg);
 }
 
+void TimeSeqDisplay::drawLaneProgress(const DrawArgs& args, float bottom) {
+	for (int i = 0; i < m_progress.laneCount; i++) {
+		float top = LANE_PROGRESS_TOP + i * LANE_PROGRESS_PITCH;
+		if (top + LANE_PROGRESS_PITCH > bottom) {
+			// Lanes that don't fit above the voltages are left out
+			break;
+		}
+
+		const timeseq::LaneProgress& lane = m_progress.lanes[i];
+		float progress = lane.segmentCount > 0 ? (lane.segment + lane.position) / lane.segmentCount : 0.f;
+		// Alternate the color on each loop, so it's visible when a lane starts over
+		NVGcolor color = lane.loops % 2 == 0 ? LIGHT_RED : nvgRGBA(0x6D, 0x2D, 0x2D, 0xFF);
+		color.a = lane.active ? 1.f : .4f;
+
+		nvgBeginPath(args.vg);
+		nvgRect(args.vg, 1.f, top, 37.f * progress, LANE_PROGRESS_PITCH - 1.f);
+		nvgFillColor(args.vg, color);
+		nvgFill(args.vg);
+	}
+}
+
 void TimeSeqDisplay::onResize(const ResizeEvent& e) {
 	m_animCoords.m_arcDelta = box.getWidth() / 4;
 	m_animCoords.m_arcOffset = m_animCoords.m_arcDelta / 2;
@@ -140,7 +170,7 @@ void TimeSeqDisplay::onResize(const ResizeEvent& e) {
 	m_animCoords.m_offsetCircles[3][2] = m_animCoords.m_arcOffset + m_animCoords.m_arcDelta;
 }
 
-void TimeSeqDisplay::processChangedVoltages(std::vector<int>& changedVoltages, std::array<std::array<float, 16>, 8>& outputVoltages) {
+void TimeSeqDisplay::processChangedVoltages(const std::array<uint16_t, 8>& changedChannels, const std::array<std::array<float, 16>, 8>& outputVoltages) {
 	// Remove voltage points that haven't changed recently, and update & age those that are recent enough
 	for (int i = m_voltagePoints.size() - 1; i >= 0; i--) {
 		if (m_voltagePoints[i].age >= TIMESEQ_DISPLAY_WINDOW_SIZE * 2) {
@@ -152,35 +182,43 @@ void TimeSeqDisplay::processChangedVoltages(std::vector<int>& changedVoltages, s
 	}
 
 	// Update/add the voltage points for the recently changed ports
-	for (std::vector<int>::iterator it = changedVoltages.begin(); it != changedVoltages.end(); it++) {
-		bool found = false;
-		// See if the port&channel combination is already in the current list of voltage points
-		for (std::vector<TimeSeqVoltagePoints>::iterator vpIt = m_voltagePoints.begin(); vpIt != m_voltagePoints.end(); vpIt++) {
-			if (vpIt->id == *it) {
-				// The voltage point is already in there, so it was already captured. Just reset its age.
-				found = true;
-				vpIt->age = 0;
-				break;
+	for (int port = 0; port < 8; port++) {
+		for (int channel = 0; channel < 16; channel++) {
+			if (changedChannels[port] & (1 << channel)) {
+				processChangedVoltage(TO_CHANNEL_PORT_IDENTIFIER(port, channel), outputVoltages);
 			}
 		}
-		// It's a new voltage point
-		if (!found)
-		{
-			if (m_voltagePoints.size() < 15) {
-				// We haven't reached the limit of trackable voltages yet, so just add a new one to the list.
-				m_voltagePoints.emplace_back(*it);
-				TimeSeqVoltagePoints& voltagePoints = m_voltagePoints.back();
-				voltagePoints.voltage = outputVoltages[CHANNEL_FROM_CHANNEL_PORT_IDENTIFIER(voltagePoints.id)][PORT_FROM_CHANNEL_PORT_IDENTIFIER(voltagePoints.id)];
-			} else {
-				// We have reached the limit of trackable voltages. See if there is one that hasn't updated in the last cycle (start from the end, i.e. the most recent changing one)
-				for (std::vector<TimeSeqVoltagePoints>::reverse_iterator vpIt = m_voltagePoints.rbegin(); vpIt != m_voltagePoints.rend(); vpIt++) {
-					if (vpIt->age > TIMESEQ_DISPLAY_WINDOW_SIZE) {
-						// Replace this tracked output with the newly changed one
-						vpIt->id = *it;
-						vpIt->age = 0;
-						vpIt->voltage = outputVoltages[CHANNEL_FROM_CHANNEL_PORT_IDENTIFIER(vpIt->id)][PORT_FROM_CHANNEL_PORT_IDENTIFIER(vpIt->id)];
-						break;
-					}
+	}
+}
+
+void TimeSeqDisplay::processChangedVoltage(int id, const std::array<std::array<float, 16>, 8>& outputVoltages) {
+	bool found = false;
+	// See if the port&channel combination is already in the current list of voltage points
+	for (std::vector<TimeSeqVoltagePoints>::iterator vpIt = m_voltagePoints.begin(); vpIt != m_voltagePoints.end(); vpIt++) {
+		if (vpIt->id == id) {
+			// The voltage point is already in there, so it was already captured. Just reset its age.
+			found = true;
+			vpIt->age = 0;
+			break;
+		}
+	}
+	// It's a new voltage point
+	if (!found)
+	{
+		if (m_voltagePoints.size() < 15) {
+			// We haven't reached the limit of trackable voltages yet, so just add a new one to the list.
+			m_voltagePoints.emplace_back(id);
+			TimeSeqVoltagePoints& voltagePoints = m_voltagePoints.back();
+			voltagePoints.voltage = outputVoltages[CHANNEL_FROM_CHANNEL_PORT_IDENTIFIER(voltagePoints.id)][PORT_FROM_CHANNEL_PORT_IDENTIFIER(voltagePoints.id)];
+		} else {
+			// We have reached the limit of trackable voltages. See if there is one that hasn't updated in the last cycle (start from the end, i.e. the most recent changing one)
+			for (std::vector<TimeSeqVoltagePoints>::reverse_iterator vpIt = m_voltagePoints.rbegin(); vpIt != m_voltagePoints.rend(); vpIt++) {
+				if (vpIt->age > TIMESEQ_DISPLAY_WINDOW_SIZE) {
+					// Replace this tracked output with the newly changed one
+					vpIt->id = id;
+					vpIt->age = 0;
+					vpIt->voltage = outputVoltages[CHANNEL_FROM_CHANNEL_PORT_IDENTIFIER(vpIt->id)][PORT_FROM_CHANNEL_PORT_IDENTIFIER(vpIt->id)];
+					break;
 				}
 			}
 		}
@@ -210,6 +248,7 @@ void TimeSeqDisplay::setAssert(bool assert) {
 	m_assert = assert;
 }
 
-void TimeSeqDisplay::setTimeSeqCore(timeseq::TimeSeqCore* timeSeqCore) {
-	m_timeSeqCore = timeSeqCore;
+void TimeSeqDisplay::processProgress(const timeseq::TimeSeqCore::ProgressSnapshot& progress) {
+	m_progress = progress;
+	m_hasProgress = true;
 }
\ No newline at end of file
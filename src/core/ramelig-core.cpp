@@ -1,50 +1,25 @@
 #include "core/ramelig-core.hpp"
+#include <cmath>
+#include "util/random.hpp"
 
 
 struct RameligUniformChanceGenerator : RameligChanceGenerator {
-	RameligUniformChanceGenerator() {
-		m_jumpLower = -1.f;
-		m_jumpUpper = 1.f;
-		m_jumpDistribution = std::uniform_real_distribution<float>(m_jumpLower, m_jumpUpper);
-		m_actionLower = -1.f;
-		m_actionUpper = 1.f;
-		m_actionDistribution = std::uniform_real_distribution<float>(m_actionLower, m_actionUpper);
-
-		m_generator.seed(std::random_device{}());
-	}
-
 	~RameligUniformChanceGenerator() {}
 
 	float generateJumpChance(float lower, float upper) override {
-		if ((lower != m_jumpLower) || (upper != m_jumpUpper)) {
-			m_jumpLower = lower;
-			m_jumpUpper = upper;
-			m_jumpDistribution.param(std::uniform_real_distribution<float>::param_type(m_jumpLower, m_jumpUpper));
-		}
-
-		return m_jumpDistribution(m_generator);
+		return m_generator.nextFloat(lower, upper);
 	}
 
 	float generateActionChance(float lower, float upper) override {
-		if ((lower != m_actionLower) || (upper != m_actionUpper)) {
-			m_actionLower = lower;
-			m_actionUpper = upper;
-			m_actionDistribution.param(std::uniform_real_distribution<float>::param_type(m_actionLower, m_actionUpper));
-		}
+		return m_generator.nextFloat(lower, upper);
+	}
 
-		return m_actionDistribution(m_generator);
+	void seed(uint64_t seed) override {
+		m_generator.seed(seed);
 	}
 
 	private:
-		std::minstd_rand m_generator;
-
-		std::uniform_real_distribution<float> m_jumpDistribution;
-		float m_jumpLower;
-		float m_jumpUpper;
-
-		std::uniform_real_distribution<float> m_actionDistribution;
-		float m_actionLower;
-		float m_actionUpper;
+		RandomGenerator m_generator;
 };
 
 
@@ -83,57 +58,18 @@ void RameligScale::setScale(const std::vector<int>& scale) {
 }
 
 void RameligScale::calculateQuantization() {
-	// The quantizationValues contains a list of floats, so that you have to quantize to the index if:
-	// - The list item at that index is lower or equal to the current value
-	// - The list item at (index + 1) is higher than the current value
-	m_quantizationValues.clear();
-
-	if (m_scale.size() > 1) {
-		// The first item is the lower limit, so it is the average of the first note in this scale and the last note of the previous one
-		m_quantizationValues.push_back((m_notes[m_scale.back()] - 1.f + m_notes[m_scale.front()]) / 2);
-		// Now loop through all items in the scale and the average of that item combined with the next one
-		for (unsigned int i = 0; i < m_scale.size() - 1; i++) {
-			m_quantizationValues.push_back((m_notes[m_scale[i]] + m_notes[m_scale[i + 1]]) / 2.f);
-		}
-		// Finally add the average of the last item in this scale and the first of the next scale, which is the upper boundry of the range for the last item in this scale
-		m_quantizationValues.push_back((m_notes[m_scale.front()] + 1.f + m_notes[m_scale.back()]) / 2);
-	} else if (m_scale.size() > 0) {
-		// There is only one item in the scale, so just add the range it.
-		m_quantizationValues.push_back(m_notes[m_scale[0]] - .5f);
-		m_quantizationValues.push_back(m_notes[m_scale[0]]);
+	std::vector<float> notes;
+	for (int index : m_scale) {
+		notes.push_back(m_notes[index]);
 	}
+	// Ramelig has always quantized values that are halfway between two notes of the scale down
+	m_quantizer = Quantizer(notes, QuantizerTieBreak::ROUND_DOWN);
 }
 
 std::pair<int, int> RameligScale::quantize(float value, float lowerLimit, float upperLimit) {
-	float oct;
-	int index = 0;
-	float fract;
-	if (value < 0) {
-		oct = std::floor(value); // The amount we'll have to subtract from the end result, since we'll make the decimal part positive to easier compare with the quantization notes list
-		fract = value - oct; // Results in the fractal part moved between 0 and 1
-	} else {
-		// For a positive value, we can just use modf to separate into octave and fractal part (for a negative value, it would result in negative oct and fract)
-		fract = std::modf(value, &oct);
-	}
-
-	if (fract < m_quantizationValues.front()) {
-		// If the value is below the first item in the quantization list, we'll have to quantize towards the last note of the previous octave
-		oct--;
-		index = m_scale.size() - 1;
-	} else if (fract > m_quantizationValues.back()) {
-		// If the value is above the last item in the quantization list, we'll have to quantize towards the first note of the next octave
-		oct++;
-		index = 0;
-	} else {
-		// Look for the position in the quantization values list where the next item in the list is above the current value
-		for (int i = 0; i < (int) m_quantizationValues.size() - 1; i++) {
-			if (fract <= m_quantizationValues[i + 1]) {
-				// We found the index in the scale to quantize to, so take that index and undo the octave-up we did before.
-				index = i;
-				break;
-			}
-		}
-	}
+	QuantizedNote quantizedNote = m_quantizer.quantizeNote(value);
+	int oct = quantizedNote.octave;
+	int index = quantizedNote.index;
 
 	// Make sure the quantized result remains within the limits
 	while (oct + m_notes[m_scale[index]] < lowerLimit) {
@@ -186,6 +122,10 @@ RameligCore::~RameligCore() {
 	}
 }
 
+void RameligCore::seed(uint64_t seed) {
+	m_chanceGenerator->seed(seed);
+}
+
 void RameligCore::guideLast(float value) {
 	m_state.lastResult = value;
 	m_state.isDirty = true;
@@ -1,5 +1,5 @@
 #include "core/ratrilig-core.hpp"
-#include <chrono>
+#include "util/random.hpp"
 
 bool static isBiased(int index, int size, float biasDirection) {
 	int biasIndex = biasDirection >= 1.f ? size - 1 : size * biasDirection;
@@ -9,28 +9,26 @@ bool static isBiased(int index, int size, float biasDirection) {
 
 
 struct RatriligUniformChanceGenerator : RatriligChanceGenerator {
-	RatriligUniformChanceGenerator() {
-		m_distribution = std::uniform_real_distribution<float>(0.f, 1.f);
-		m_generator.seed(std::random_device{}());
-	}
-
 	~RatriligUniformChanceGenerator() {}
 
 	float generateSkipChance() override {
-		return m_distribution(m_generator);
+		return m_generator.nextFloat();
 	}
 
 	float generateDensityModifier() override {
-		return (m_distribution(m_generator) - 0.5f) * 2;
+		return (m_generator.nextFloat() - 0.5f) * 2;
 	}
 
 	float generateTrigger() override {
-		return m_distribution(m_generator);
+		return m_generator.nextFloat();
+	}
+
+	void seed(uint64_t seed) override {
+		m_generator.seed(seed);
 	}
 
 	private:
-		std::minstd_rand m_generator;
-		std::uniform_real_distribution<float> m_distribution;
+		RandomGenerator m_generator;
 };
 
 bool RatriligCoreLayerState::operator==(const RatriligCoreLayerState& other) const {
@@ -60,6 +58,10 @@ void RatriligCoreProcessor::setState(std::shared_ptr<RatriligCoreState> state) {
 	m_state = state;
 }
 
+void RatriligCoreProcessor::seed(uint64_t seed) {
+	m_chanceGenerator->seed(seed);
+}
+
 void RatriligCoreProcessor::advanceCluster(RatriligData& data, RatriligProcessorProgress& progress) {
 	progress.clusterStarted = advanceLayer(m_state->clusterState, data.clusterData);
 }
@@ -224,6 +226,10 @@ void RatriligCore::reset() {
 	}
 }
 
+void RatriligCore::seed(uint64_t seed) {
+	m_processor->seed(seed);
+}
+
 bool RatriligCore::isHigh()  {
 	return m_state->high;
 }
@@ -1,6 +1,5 @@
-#include <chrono>
+#include <cmath>
 #include <algorithm>
-#include <random>
 #include <functional>
 #include "core/solim-core.hpp"
 
@@ -8,8 +7,6 @@
 // Apply this float deviation correction to the upper and lower limits to compensate for that inaccuracy.
 #define FLOAT_DEVIATION 0.00001f
 
-std::mt19937 rng = std::mt19937(std::chrono::steady_clock::now().time_since_epoch().count());
-
 
 struct ValueSorter {
 	ValueSorter(float sort) : descending(sort < 0) {}
@@ -249,7 +246,7 @@ void SolimCoreProcessor::processResults(SolimValueSet& solimValuesSet) {
 }
 
 
-SolimCoreRandomizer::SolimCoreRandomizer() : SolimCoreRandomizer(rng.min(), rng.max(), rng) {
+SolimCoreRandomizer::SolimCoreRandomizer() : SolimCoreRandomizer(RandomGenerator::min(), RandomGenerator::max(), [this]() { return m_generator(); }) {
 }
 
 SolimCoreRandomizer::SolimCoreRandomizer(uint_fast32_t min, uint_fast32_t max, std::function<uint_fast32_t()> urng) : m_rng(SolimCoreRandomSource(min, max, urng)) {
@@ -258,6 +255,10 @@ SolimCoreRandomizer::SolimCoreRandomizer(uint_fast32_t min, uint_fast32_t max, s
 SolimCoreRandomizer::~SolimCoreRandomizer() {
 }
 
+void SolimCoreRandomizer::seed(uint64_t seed) {
+	m_generator.seed(seed);
+}
+
 void SolimCoreRandomizer::process(int columnCount, std::array<RandomTrigger, 8>* randomTriggers, std::array<SolimValueSet, 8>& oldValueSet, std::array<SolimValueSet, 8>& newValueSet) {
 	if (randomTriggers != nullptr) {
 		if (!m_previousWasRandom) {
@@ -289,7 +290,10 @@ void SolimCoreRandomizer::process(int columnCount, std::array<RandomTrigger, 8>*
 				if ((*randomTriggers)[i] == RandomTrigger::RESET) {
 					newValueSet[i].indices = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
 				} else if ((*randomTriggers)[i] == RandomTrigger::ALL) {
-					std::shuffle(newValueSet[i].indices.begin(), newValueSet[i].indices.begin() + newValueSet[i].outputValueCount, rng);
+					// Fisher-Yates shuffle of the active indices
+					for (int j = newValueSet[i].outputValueCount - 1; j > 0; j--) {
+						std::swap(newValueSet[i].indices[j], newValueSet[i].indices[m_rng() % (j + 1)]);
+					}
 				} else if ((*randomTriggers)[i] == RandomTrigger::ONE) {
 					// There have to be at least two items in order to swap two of them
 					if (newValueSet[i].outputValueCount > 1) {
@@ -371,6 +375,10 @@ SolimCore::~SolimCore() {
 	delete m_randomizer;
 }
 
+void SolimCore::seed(uint64_t seed) {
+	m_randomizer->seed(seed);
+}
+
 SolimValueSet& SolimCore::getActiveValues(int index) {
 	return m_values[m_activeValuesIndex][index];
 }
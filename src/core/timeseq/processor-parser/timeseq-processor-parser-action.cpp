@@ -36,6 +36,10 @@ const shared_ptr<ActionProcessor> ProcessorScriptParser::parseResolvedAction(con
 		m_context.location.push_back("set-value");
 		actionProcessor = parseSetValueAction(scriptAction, ifProcessor);
 		m_context.location.pop_back();
+	} else if (scriptAction->setPolyValue) {
+		m_context.location.push_back("set-poly-value");
+		actionProcessor = parseSetPolyValueAction(scriptAction, ifProcessor);
+		m_context.location.pop_back();
 	} else if (scriptAction->setVariable) {
 		m_context.location.push_back("set-variable");
 		actionProcessor = parseSetVariableAction(scriptAction, ifProcessor);
@@ -56,6 +60,10 @@ const shared_ptr<ActionProcessor> ProcessorScriptParser::parseResolvedAction(con
 		m_context.location.push_back("trigger");
 		actionProcessor = parseTriggerAction(scriptAction, ifProcessor);
 		m_context.location.pop_back();
+	} else if (scriptAction->selectScript) {
+		m_context.location.push_back("select-script");
+		actionProcessor = parseSelectScriptAction(scriptAction, ifProcessor);
+		m_context.location.pop_back();
 	} else if (scriptAction->moveSequence) {
 		m_context.location.push_back("move-sequence");
 		actionProcessor = parseMoveSequenceAction(scriptAction, ifProcessor);
@@ -119,7 +127,45 @@ const shared_ptr<ActionGlideProcessor> ProcessorScriptParser::parseResolvedGlide
 		}
 	}
 
-	return make_shared<ActionGlideProcessor>(easeFactor, easePow, startValueProcessor, endValueProcessor, ifProcessor, outputPort, outputChannel, scriptAction->variable, m_portHandler, m_variableHandler);
+	return make_shared<ActionGlideProcessor>(easeFactor, easePow, m_fastMath, m_controlRate, startValueProcessor, endValueProcessor, ifProcessor, outputPort, outputChannel, scriptAction->variable, m_portHandler, resolveVariableHandler(scriptAction->variable));
+}
+
+const shared_ptr<ActionGlidePolyProcessor> ProcessorScriptParser::parseResolvedGlidePolyAction(const ScriptAction* scriptAction) {
+	shared_ptr<IfProcessor> ifProcessor;
+
+	if (scriptAction->condition) {
+		m_context.location.push_back("if");
+		vector<string> stack;
+		ifProcessor = parseIf(scriptAction->condition.get(), stack);
+		m_context.location.pop_back();
+	}
+
+	m_context.location.push_back("start-values");
+	vector<shared_ptr<ValueProcessor>> startValueProcessors = parseValues(scriptAction->startValues.get());
+	m_context.location.pop_back();
+	m_context.location.push_back("end-values");
+	vector<shared_ptr<ValueProcessor>> endValueProcessors = parseValues(scriptAction->endValues.get());
+	m_context.location.pop_back();
+
+	m_context.location.push_back("output");
+	pair<int, int> output = parseOutput(&(*scriptAction->output));
+	m_context.location.pop_back();
+	if ((output.second >= 0) && (output.second + (int) startValueProcessors.size() > 16)) {
+		addValidationError(m_context.validationErrors, m_context.location, ValidationErrorCode::Action_GlideValuesChannelRange, "The 'start-values' and 'end-values' don't fit in the channels of the output, starting from the output 'channel'.");
+	}
+
+	float easeFactor = 0.f;
+	bool easePow = false;
+	if (scriptAction->easeFactor) {
+		easeFactor = *scriptAction->easeFactor.get();
+	}
+	if (scriptAction->easeAlgorithm) {
+		if (*scriptAction->easeAlgorithm == ScriptAction::EaseAlgorithm::POW) {
+			easePow = true;
+		}
+	}
+
+	return make_shared<ActionGlidePolyProcessor>(easeFactor, easePow, m_fastMath, m_controlRate, startValueProcessors, endValueProcessors, ifProcessor, output.first, output.second, m_portHandler);
 }
 
 const shared_ptr<ActionGateProcessor> ProcessorScriptParser::parseResolvedGateAction(const ScriptAction* scriptAction) {
@@ -163,13 +209,28 @@ const shared_ptr<ActionProcessor> ProcessorScriptParser::parseSetValueAction(con
 	return make_shared<ActionSetValueProcessor>(valueProcessor, output.first, output.second, m_portHandler, ifProcessor);
 }
 
+const shared_ptr<ActionProcessor> ProcessorScriptParser::parseSetPolyValueAction(const ScriptAction* scriptAction, const shared_ptr<IfProcessor>& ifProcessor) {
+	m_context.location.push_back("values");
+	vector<shared_ptr<ValueProcessor>> valueProcessors = parseValues(&scriptAction->setPolyValue.get()->values);
+	m_context.location.pop_back();
+
+	m_context.location.push_back("output");
+	pair<int, int> output = parseOutput(&scriptAction->setPolyValue.get()->output);
+	m_context.location.pop_back();
+	if ((output.second >= 0) && (output.second + (int) valueProcessors.size() > 16)) {
+		addValidationError(m_context.validationErrors, m_context.location, ValidationErrorCode::SetPolyValue_ChannelRange, "The 'values' don't fit in the channels of the output, starting from the output 'channel'.");
+	}
+
+	return make_shared<ActionSetPolyValueProcessor>(valueProcessors, output.first, output.second, m_portHandler, ifProcessor);
+}
+
 const shared_ptr<ActionProcessor> ProcessorScriptParser::parseSetVariableAction(const ScriptAction* scriptAction, const shared_ptr<IfProcessor>& ifProcessor) {
 	m_context.location.push_back("value");
 	vector<string> stack;
 	shared_ptr<ValueProcessor> valueProcessor = parseValue(&scriptAction->setVariable.get()->value, stack);
 	m_context.location.pop_back();
 
-	return make_shared<ActionSetVariableProcessor>(valueProcessor, scriptAction->setVariable.get()->name, m_variableHandler, ifProcessor);
+	return make_shared<ActionSetVariableProcessor>(valueProcessor, scriptAction->setVariable.get()->name, resolveVariableHandler(scriptAction->setVariable.get()->name), ifProcessor);
 }
 
 const shared_ptr<ActionProcessor> ProcessorScriptParser::parseSetPolyphonyAction(const ScriptAction* scriptAction, const shared_ptr<IfProcessor>& ifProcessor) {
@@ -190,13 +251,17 @@ const shared_ptr<ActionProcessor> ProcessorScriptParser::parseAssertAction(const
 	shared_ptr<IfProcessor> expect = parseIf(&scriptAssert->expect, stack);
 	m_context.location.pop_back();
 
-	return make_shared<ActionAssertProcessor>(scriptAssert->name, expect, scriptAssert->stopOnFail, m_assertListener, ifProcessor);
+	return make_shared<ActionAssertProcessor>(scriptAssert->name, expect, scriptAssert->stopOnFail, m_assertListener, m_eventTracer, ifProcessor);
 }
 
 const shared_ptr<ActionProcessor> ProcessorScriptParser::parseTriggerAction(const ScriptAction* scriptAction, const shared_ptr<IfProcessor>& ifProcessor) {
 	return make_shared<ActionTriggerProcessor>(scriptAction->trigger, m_triggerHandler, ifProcessor);
 }
 
+const shared_ptr<ActionProcessor> ProcessorScriptParser::parseSelectScriptAction(const ScriptAction* scriptAction, const shared_ptr<IfProcessor>& ifProcessor) {
+	return make_shared<ActionSelectScriptProcessor>(*scriptAction->selectScript - 1, m_scriptBankHandler, ifProcessor);
+}
+
 const shared_ptr<ActionProcessor> ProcessorScriptParser::parseMoveSequenceAction(const ScriptAction* scriptAction, const shared_ptr<IfProcessor>& ifProcessor) {
 	ScriptMoveSequence* moveSequence = &(*scriptAction->moveSequence);
 	shared_ptr<SequencePositionProcessor> sequenceProcessor = resolveSharedSequence(moveSequence->id);
@@ -268,18 +333,15 @@ const shared_ptr<ActionProcessor> ProcessorScriptParser::parseRemoveFromSequence
 	}
 }
 
-const ScriptAction* ProcessorScriptParser::resolveScriptAction(const ScriptAction* scriptAction, vector<string>& resolvedLocation) const {
+const ScriptAction* ProcessorScriptParser::resolveScriptAction(const ScriptAction* scriptAction, ValidationLocation& resolvedLocation) const {
 	if (scriptAction->ref.length() == 0) {
 		resolvedLocation = m_context.location;
 		return scriptAction;
 	} else {
-		int count = 0;
-		for (const ScriptAction& action : m_context.script->actions) {
-			if (scriptAction->ref.compare(action.id) == 0) {
-				resolvedLocation = { "component-pool", "actions", to_string(count) };
-				return &action;
-			}
-			count++;
+		int index = ProcessorScriptPoolIndex::find(m_context.poolIndex->actions, scriptAction->ref);
+		if (index >= 0) {
+			resolvedLocation = { "component-pool", "actions", index };
+			return &m_context.script->actions[index];
 		}
 
 		return nullptr;
@@ -6,23 +6,38 @@
 using namespace std;
 using namespace timeseq;
 
-const shared_ptr<TriggerProcessor> ProcessorScriptParser::parseInputTrigger(const ScriptInputTrigger* scriptInputTrigger) {
+void ProcessorScriptParser::parseInputTrigger(const ScriptInputTrigger* scriptInputTrigger, vector<shared_ptr<TriggerProcessor>>& triggerProcessors) {
+	const ScriptInput* input = nullptr;
 	// Check if it's a ref input trigger object or a full one
 	if (scriptInputTrigger->input.ref.length() == 0) {
-		return make_shared<TriggerProcessor>(scriptInputTrigger->id, scriptInputTrigger->input.index - 1, ((bool) scriptInputTrigger->input.channel) ? *scriptInputTrigger->input.channel.get() - 1 : 0, m_portHandler, m_triggerHandler);
+		input = &scriptInputTrigger->input;
 	} else {
-		for (const ScriptInput& input : m_context.script->inputs) {
-			if (scriptInputTrigger->input.ref.compare(input.id) == 0) {
-				return make_shared<TriggerProcessor>(scriptInputTrigger->id, input.index - 1, ((bool) input.channel) ? *input.channel.get() - 1 : 0, m_portHandler, m_triggerHandler);
-			}
+		int index = ProcessorScriptPoolIndex::find(m_context.poolIndex->inputs, scriptInputTrigger->input.ref);
+		if (index >= 0) {
+			input = &m_context.script->inputs[index];
 		}
 
-		// Couldn't find the referenced input...
-		m_context.location.push_back("input");
-		addValidationError(m_context.validationErrors, m_context.location, ValidationErrorCode::Ref_NotFound, "Could not find the referenced input with id '", scriptInputTrigger->input.ref.c_str(), "' in the script inputs.");
-		m_context.location.pop_back();
-		return shared_ptr<TriggerProcessor>();
+		if (input == nullptr) {
+			// Couldn't find the referenced input...
+			m_context.location.push_back("input");
+			addValidationError(m_context.validationErrors, m_context.location, ValidationErrorCode::Ref_NotFound, "Could not find the referenced input with id '", scriptInputTrigger->input.ref.c_str(), "' in the script inputs.");
+			m_context.location.pop_back();
+			return;
+		}
+	}
+
+	// Input triggers on the same input port are detected together, so add it to the processor of that port
+	int inputPort = input->index - 1;
+	int inputChannel = ((bool) input->channel) ? *input->channel.get() - 1 : 0;
+	for (const shared_ptr<TriggerProcessor>& triggerProcessor : triggerProcessors) {
+		if (triggerProcessor->getInputPort() == inputPort) {
+			triggerProcessor->addTrigger(scriptInputTrigger->id, inputChannel);
+			return;
+		}
 	}
+	shared_ptr<TriggerProcessor> triggerProcessor = make_shared<TriggerProcessor>(inputPort, m_portHandler, m_triggerHandler);
+	triggerProcessor->addTrigger(scriptInputTrigger->id, inputChannel);
+	triggerProcessors.push_back(triggerProcessor);
 }
 
 const pair<int, int> ProcessorScriptParser::parseInput(const ScriptInput* scriptInput) {
@@ -30,16 +45,13 @@ const pair<int, int> ProcessorScriptParser::parseInput(const ScriptInput* script
 	if (scriptInput->ref.length() == 0) {
 		return pair<int, int>(scriptInput->index - 1, scriptInput->channel ? *scriptInput->channel.get() - 1 : 0);
 	} else {
-		int count = 0;
-		for (const ScriptInput& input : m_context.script->inputs) {
-			if (scriptInput->ref.compare(input.id) == 0) {
-				m_context.stashLocation();
-				m_context.location = { "component-pool",  "inputs", to_string(count) };
-				pair<int, int> result = parseInput(&input);
-				m_context.popLocation();
-				return result;
-			}
-			count++;
+		int index = ProcessorScriptPoolIndex::find(m_context.poolIndex->inputs, scriptInput->ref);
+		if (index >= 0) {
+			m_context.stashLocation();
+			m_context.location = { "component-pool",  "inputs", index };
+			pair<int, int> result = parseInput(&m_context.script->inputs[index]);
+			m_context.popLocation();
+			return result;
 		}
 
 		// Couldn't find the referenced input...
@@ -54,16 +66,13 @@ const pair<int, int> ProcessorScriptParser::parseOutput(const ScriptOutput* scri
 	if (scriptOutput->ref.length() == 0) {
 		return pair<int, int>(scriptOutput->index - 1, scriptOutput->channel ? *scriptOutput->channel.get() - 1 : 0);
 	} else {
-		int count = 0;
-		for (const ScriptOutput& output : m_context.script->outputs) {
-			if (scriptOutput->ref.compare(output.id) == 0) {
-				m_context.stashLocation();
-				m_context.location = { "component-pool",  "outputs", to_string(count) };
-				pair<int, int> result = parseOutput(&output);
-				m_context.popLocation();
-				return result;
-			}
-			count++;
+		int index = ProcessorScriptPoolIndex::find(m_context.poolIndex->outputs, scriptOutput->ref);
+		if (index >= 0) {
+			m_context.stashLocation();
+			m_context.location = { "component-pool",  "outputs", index };
+			pair<int, int> result = parseOutput(&m_context.script->outputs[index]);
+			m_context.popLocation();
+			return result;
 		}
 
 		// Couldn't find the referenced output...
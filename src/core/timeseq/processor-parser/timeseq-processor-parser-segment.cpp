@@ -6,6 +6,12 @@
 using namespace std;
 using namespace timeseq;
 
+// Segments with only deterministic actions that last between these amounts of samples record their output voltages
+// during their first run and replay them afterwards. Longer segments are not worth the memory, and shorter ones only
+// run the actions once or twice anyway (and would need special handling of the drift correction in their first sample).
+#define RECORDING_MIN_SAMPLES 3
+#define RECORDING_MAX_SAMPLES 4096
+
 inline uint64_t uint64_max(uint64_t a, uint64_t b) {
 	return a > b ? a : b;
 }
@@ -15,7 +21,7 @@ const vector<shared_ptr<SegmentProcessor>> ProcessorScriptParser::parseSegments(
 	vector<shared_ptr<SegmentProcessor>> segmentProcessors;
 
 	for (const ScriptSegment& segment : *scriptSegments) {
-		m_context.location.push_back(to_string(count));
+		m_context.location.push_back(count);
 		vector<shared_ptr<SegmentProcessor>> segmentProcessorsSubset = parseSegment(&segment, timeScale, segmentStack);
 		segmentProcessors.insert(segmentProcessors.end(), segmentProcessorsSubset.begin(), segmentProcessorsSubset.end());
 		m_context.location.pop_back();
@@ -34,7 +40,7 @@ const vector<shared_ptr<SegmentProcessor>> ProcessorScriptParser::parseSegment(c
 		} else {
 			// It's a segment-block segment
 			vector<shared_ptr<SegmentProcessor>> blockSegments;
-			vector<string> actionsLocation = m_context.location;
+			ValidationLocation actionsLocation = m_context.location;
 			m_context.location.push_back("segment-block");
 			blockSegments = parseSegmentBlock(scriptSegment->segmentBlock.get(), timeScale, scriptSegment->actions, actionsLocation, segmentStack);
 			m_context.location.pop_back();
@@ -42,19 +48,16 @@ const vector<shared_ptr<SegmentProcessor>> ProcessorScriptParser::parseSegment(c
 		}
 	} else {
 		if (find(segmentStack.begin(), segmentStack.end(), string("s-") + scriptSegment->ref) == segmentStack.end()) {
-			int count = 0;
-			for (const ScriptSegment& segment : m_context.script->segments) {
-				if (scriptSegment->ref.compare(segment.id) == 0) {
-					vector<shared_ptr<SegmentProcessor>> segments;
-					m_context.stashLocation();
-					m_context.location = { "component-pool",  "segments", to_string(count) };
-					segmentStack.push_back(string("s-") + scriptSegment->ref);
-					segments = parseSegment(&segment, timeScale, segmentStack);
-					segmentStack.pop_back();
-					m_context.popLocation();
-					return segments;
-				}
-				count++;
+			int index = ProcessorScriptPoolIndex::find(m_context.poolIndex->segments, scriptSegment->ref);
+			if (index >= 0) {
+				vector<shared_ptr<SegmentProcessor>> segments;
+				m_context.stashLocation();
+				m_context.location = { "component-pool",  "segments", index };
+				segmentStack.push_back(string("s-") + scriptSegment->ref);
+				segments = parseSegment(&m_context.script->segments[index], timeScale, segmentStack);
+				segmentStack.pop_back();
+				m_context.popLocation();
+				return segments;
 			}
 
 			// Couldn't find the referenced segment...
@@ -67,28 +70,87 @@ const vector<shared_ptr<SegmentProcessor>> ProcessorScriptParser::parseSegment(c
 }
 
 const shared_ptr<SegmentProcessor> ProcessorScriptParser::parseResolvedSegment(const ScriptSegment* scriptSegment, const ScriptTimeScale* timeScale, vector<string>& segmentStack) {
+	unsigned int validationCount = m_context.validationErrors->size();
+
 	m_context.location.push_back("duration");
 	shared_ptr<DurationProcessor> durationProcessor = parseDuration(&scriptSegment->duration, timeScale);
 	m_context.location.pop_back();
 
-	int count = 0;
 	vector<shared_ptr<ActionProcessor>> startActions;
 	vector<shared_ptr<ActionProcessor>> endActions;
 	vector<shared_ptr<ActionOngoingProcessor>> ongoingActions;
+	parseSegmentActions(scriptSegment, startActions, endActions, ongoingActions);
+
+	// Check if the output voltages of the segment will be the same on each run, so that they can be recorded
+	bool recordOutputs = (m_context.validationErrors->size() == validationCount) && (durationProcessor->isConstant())
+		&& (durationProcessor->getDuration() >= RECORDING_MIN_SAMPLES) && (durationProcessor->getDuration() <= RECORDING_MAX_SAMPLES)
+		&& ((startActions.size() > 0) || (endActions.size() > 0) || (ongoingActions.size() > 0));
+	for (const shared_ptr<ActionProcessor>& action : startActions) {
+		recordOutputs = recordOutputs && action->isDeterministic();
+	}
+	for (const shared_ptr<ActionProcessor>& action : endActions) {
+		recordOutputs = recordOutputs && action->isDeterministic();
+	}
+	for (const shared_ptr<ActionOngoingProcessor>& action : ongoingActions) {
+		recordOutputs = recordOutputs && action->isDeterministic();
+	}
+
+	shared_ptr<SegmentProcessor> segmentProcessor = make_shared<SegmentProcessor>(scriptSegment, durationProcessor, startActions, endActions, ongoingActions, m_eventListener, m_eventTracer);
+	if (recordOutputs) {
+		// Send the output voltages of the actions through the output recorder
+		if (!m_outputRecorder) {
+			m_outputRecorder = make_shared<OutputRecorder>(m_portHandler);
+		}
+		for (const shared_ptr<ActionProcessor>& action : startActions) {
+			action->setOutputPortHandler(m_outputRecorder.get());
+		}
+		for (const shared_ptr<ActionProcessor>& action : endActions) {
+			action->setOutputPortHandler(m_outputRecorder.get());
+		}
+		for (const shared_ptr<ActionOngoingProcessor>& action : ongoingActions) {
+			action->setOutputPortHandler(m_outputRecorder.get());
+		}
+
+		// Allocate the recording up front, so recording the first run doesn't allocate on the processing thread.
+		// Each action sets its output voltages at most once when it starts or ends, and ongoing actions also once per step.
+		uint64_t steps = durationProcessor->getDuration() + 1;
+		size_t writes = 0;
+		size_t voltages = 0;
+		for (const shared_ptr<ActionProcessor>& action : startActions) {
+			writes += action->getOutputVoltageCount() > 0 ? 1 : 0;
+			voltages += action->getOutputVoltageCount();
+		}
+		for (const shared_ptr<ActionProcessor>& action : endActions) {
+			writes += action->getOutputVoltageCount() > 0 ? 1 : 0;
+			voltages += action->getOutputVoltageCount();
+		}
+		for (const shared_ptr<ActionOngoingProcessor>& action : ongoingActions) {
+			writes += action->getOutputVoltageCount() > 0 ? steps + 1 : 0;
+			voltages += action->getOutputVoltageCount() * (steps + 1);
+		}
+		segmentProcessor->setOutputRecorder(m_outputRecorder, writes, voltages);
+	}
+	return segmentProcessor;
+}
+
+void ProcessorScriptParser::parseSegmentActions(const ScriptSegment* scriptSegment, vector<shared_ptr<ActionProcessor>>& startActions, vector<shared_ptr<ActionProcessor>>& endActions, vector<shared_ptr<ActionOngoingProcessor>>& ongoingActions) {
+	int count = 0;
 	m_context.location.push_back("actions");
 	for (const ScriptAction& action : scriptSegment->actions) {
-		m_context.location.push_back(to_string(count));
+		m_context.location.push_back(count);
 
-		vector<string> actionLocation;
+		ValidationLocation actionLocation;
 		const ScriptAction* resolvedAction = resolveScriptAction(&action, actionLocation);
 
 		if (resolvedAction) {
-			vector<string> location = m_context.location;
+			ValidationLocation location = m_context.location;
 			m_context.stashLocation();
 			if (resolvedAction->timing == ScriptAction::ActionTiming::START) {
 				startActions.push_back(parseResolvedAction(resolvedAction));
 			} else if (resolvedAction->timing == ScriptAction::ActionTiming::END) {
 				endActions.push_back(parseResolvedAction(resolvedAction));
+			} else if ((resolvedAction->timing == ScriptAction::ActionTiming::GLIDE) && (resolvedAction->startValues)) {
+				ongoingActions.push_back(parseResolvedGlidePolyAction(resolvedAction));
 			} else if (resolvedAction->timing == ScriptAction::ActionTiming::GLIDE) {
 				ongoingActions.push_back(parseResolvedGlideAction(resolvedAction));
 			} else if (resolvedAction->timing == ScriptAction::ActionTiming::GATE) {
@@ -103,11 +165,9 @@ const shared_ptr<SegmentProcessor> ProcessorScriptParser::parseResolvedSegment(c
 		count++;
 	}
 	m_context.location.pop_back();
-
-	return make_shared<SegmentProcessor>(scriptSegment, durationProcessor, startActions, endActions, ongoingActions, m_eventListener);
 }
 
-const vector<shared_ptr<SegmentProcessor>> ProcessorScriptParser::parseSegmentBlock(const ScriptSegmentBlock* scriptSegmentBlock, const ScriptTimeScale* timeScale, const vector<ScriptAction>& actions, vector<string>& actionsLocation, vector<string>& segmentStack) {
+const vector<shared_ptr<SegmentProcessor>> ProcessorScriptParser::parseSegmentBlock(const ScriptSegmentBlock* scriptSegmentBlock, const ScriptTimeScale* timeScale, const vector<ScriptAction>& actions, ValidationLocation& actionsLocation, vector<string>& segmentStack) {
 	// Check if it's a ref segment block object or a full one
 	if (scriptSegmentBlock->ref.length() == 0) {
 		m_context.location.push_back("segments");
@@ -133,13 +193,13 @@ const vector<shared_ptr<SegmentProcessor>> ProcessorScriptParser::parseSegmentBl
 
 			actionsLocation.push_back("actions");
 			for (const ScriptAction& action : actions) {
-				actionsLocation.push_back(to_string(count));
+				actionsLocation.push_back(count);
 
-				vector<string> actionLocation;
+				ValidationLocation actionLocation;
 				const ScriptAction* resolvedAction = resolveScriptAction(&action, actionLocation);
 
 				if (resolvedAction) {
-					vector<string> location = m_context.location;
+					ValidationLocation location = m_context.location;
 					m_context.stashLocation();
 					if (resolvedAction->timing == ScriptAction::ActionTiming::START) {
 						startActions.push_back(parseResolvedAction(resolvedAction));
@@ -177,18 +237,15 @@ const vector<shared_ptr<SegmentProcessor>> ProcessorScriptParser::parseSegmentBl
 		return segmentProcessors;
 	} else {
 		if (find(segmentStack.begin(), segmentStack.end(), string("sb-") + scriptSegmentBlock->ref) == segmentStack.end()) {
-			int count = 0;
-			for (const ScriptSegmentBlock& segmentBlock : m_context.script->segmentBlocks) {
-				if (scriptSegmentBlock->ref.compare(segmentBlock.id) == 0) {
-					m_context.stashLocation();
-					m_context.location = { "component-pool",  "segment-blocks", to_string(count) };
-					segmentStack.push_back(string("sb-") + scriptSegmentBlock->ref);
-					vector<shared_ptr<SegmentProcessor>> segments = parseSegmentBlock(&segmentBlock, timeScale, actions, actionsLocation, segmentStack);
-					segmentStack.pop_back();
-					m_context.popLocation();
-					return segments;
-				}
-				count++;
+			int index = ProcessorScriptPoolIndex::find(m_context.poolIndex->segmentBlocks, scriptSegmentBlock->ref);
+			if (index >= 0) {
+				m_context.stashLocation();
+				m_context.location = { "component-pool",  "segment-blocks", index };
+				segmentStack.push_back(string("sb-") + scriptSegmentBlock->ref);
+				vector<shared_ptr<SegmentProcessor>> segments = parseSegmentBlock(&m_context.script->segmentBlocks[index], timeScale, actions, actionsLocation, segmentStack);
+				segmentStack.pop_back();
+				m_context.popLocation();
+				return segments;
 			}
 
 			// Couldn't find the referenced segment-block...
@@ -29,7 +29,7 @@ const shared_ptr<ValueProcessor> ProcessorScriptParser::parseValue(const ScriptV
 		m_context.location.push_back("calc");
 		vector<shared_ptr<CalcProcessor>> calcProcessors;
 		for (const ScriptCalc& calc : scriptValue->calc) {
-			m_context.location.push_back(to_string(count));
+			m_context.location.push_back(count);
 			calcProcessors.push_back(parseCalc(&calc, valueStack));
 			m_context.location.pop_back();
 			count++;
@@ -48,22 +48,21 @@ const shared_ptr<ValueProcessor> ProcessorScriptParser::parseValue(const ScriptV
 			return parseRandValue(scriptValue, calcProcessors, valueStack);
 		} else if (scriptValue->sequence) {
 			return parseSequenceValue(scriptValue, calcProcessors, valueStack);
+		} else if (scriptValue->table) {
+			return parseTableValue(scriptValue, calcProcessors, valueStack);
 		}
 
 	} else {
 		if (find(valueStack.begin(), valueStack.end(), string("v-") + scriptValue->ref) == valueStack.end()) {
-			int count = 0;
-			for (const ScriptValue& value : m_context.script->values) {
-				if (scriptValue->ref.compare(value.id) == 0) {
-					m_context.stashLocation();
-					m_context.location = { "component-pool",  "values", to_string(count) };
-					valueStack.push_back(string("v-") + scriptValue->ref);
-					const shared_ptr<ValueProcessor> processorValue = parseValue(&value, valueStack);
-					valueStack.pop_back();
-					m_context.popLocation();
-					return processorValue;
-				}
-				count++;
+			int index = ProcessorScriptPoolIndex::find(m_context.poolIndex->values, scriptValue->ref);
+			if (index >= 0) {
+				m_context.stashLocation();
+				m_context.location = { "component-pool",  "values", index };
+				valueStack.push_back(string("v-") + scriptValue->ref);
+				const shared_ptr<ValueProcessor> processorValue = parseValue(&m_context.script->values[index], valueStack);
+				valueStack.pop_back();
+				m_context.popLocation();
+				return processorValue;
 			}
 
 			// Couldn't find the referenced value...
@@ -76,6 +75,19 @@ const shared_ptr<ValueProcessor> ProcessorScriptParser::parseValue(const ScriptV
 	return shared_ptr<ValueProcessor>();
 }
 
+const vector<shared_ptr<ValueProcessor>> ProcessorScriptParser::parseValues(const vector<ScriptValue>* scriptValues) {
+	vector<shared_ptr<ValueProcessor>> valueProcessors;
+	int count = 0;
+	for (const ScriptValue& scriptValue : *scriptValues) {
+		m_context.location.push_back(count);
+		vector<string> stack;
+		valueProcessors.push_back(parseValue(&scriptValue, stack));
+		m_context.location.pop_back();
+		count++;
+	}
+	return valueProcessors;
+}
+
 const shared_ptr<ValueProcessor> ProcessorScriptParser::parseStaticValue(const ScriptValue* scriptValue, const vector<shared_ptr<CalcProcessor>>& calcProcessors) {
 	float value = 0.f;
 	if (scriptValue->voltage) {
@@ -96,7 +108,7 @@ const shared_ptr<ValueProcessor> ProcessorScriptParser::parseStaticValue(const S
 }
 
 const shared_ptr<ValueProcessor> ProcessorScriptParser::parseVariableValue(const ScriptValue* scriptValue, const vector<shared_ptr<CalcProcessor>>& calcProcessors) {
-	return make_shared<VariableValueProcessor>(*scriptValue->variable.get(), calcProcessors, scriptValue->quantize, m_variableHandler);
+	return make_shared<VariableValueProcessor>(*scriptValue->variable.get(), calcProcessors, scriptValue->quantize, resolveVariableHandler(*scriptValue->variable.get()));
 }
 
 const shared_ptr<ValueProcessor> ProcessorScriptParser::parseInputValue(const ScriptValue* scriptValue, const vector<shared_ptr<CalcProcessor>>& calcProcessors) {
@@ -153,6 +165,31 @@ const shared_ptr<ValueProcessor> ProcessorScriptParser::parseSequenceValue(const
 	return processor;
 }
 
+const shared_ptr<ValueProcessor> ProcessorScriptParser::parseTableValue(const ScriptValue* scriptValue, const vector<shared_ptr<CalcProcessor>>& calcProcessors, vector<string>& valueStack) {
+	m_context.location.push_back("table");
+
+	m_context.location.push_back("position");
+	shared_ptr<ValueProcessor> positionProcessor = parseValue(scriptValue->table->position.get(), valueStack);
+	m_context.location.pop_back();
+
+	shared_ptr<ValueProcessor> processor;
+	const ScriptTable* scriptTable = nullptr;
+	int index = ProcessorScriptPoolIndex::find(m_context.poolIndex->tables, scriptValue->table->id);
+	if (index >= 0) {
+		scriptTable = &m_context.script->tables[index];
+	}
+
+	if (scriptTable != nullptr) {
+		processor = make_shared<TableValueProcessor>(scriptTable, positionProcessor, calcProcessors, scriptValue->quantize);
+	} else {
+		addValidationError(m_context.validationErrors, m_context.location, ValidationErrorCode::TableValue_TableNotFound, "Could not find the referenced table with id '", scriptValue->table->id.c_str(), "' in the script tables.");
+	}
+
+	m_context.location.pop_back();
+
+	return processor;
+}
+
 const shared_ptr<CalcProcessor> ProcessorScriptParser::parseCalc(const ScriptCalc* scriptCalc, vector<string>& valueStack) {
 	if (scriptCalc->ref.length() == 0) {
 		bool valueProcessor = false;
@@ -222,11 +259,11 @@ const shared_ptr<CalcProcessor> ProcessorScriptParser::parseCalc(const ScriptCal
 
 		if (valueProcessor) {
 			shared_ptr<ValueProcessor> valueProcessor = parseValue(scriptCalc->value.get(), valueStack);
-			calcProcessor = make_shared<CalcValueProcessor>(scriptCalc, valueProcessor);
+			calcProcessor = make_shared<CalcValueProcessor>(scriptCalc, valueProcessor, m_fastMath);
 		} else if (truncProcessor) {
 			calcProcessor = make_shared<CalcTruncProcessor>();
 		} else if (fracProcessor) {
-			calcProcessor = make_shared<CalcFracProcessor>();
+			calcProcessor = make_shared<CalcFracProcessor>(m_fastMath);
 		} else if (roundProcessor) {
 			calcProcessor = make_shared<CalcRoundProcessor>(scriptCalc);
 		} else if (quantizeProcessor) {
@@ -234,11 +271,9 @@ const shared_ptr<CalcProcessor> ProcessorScriptParser::parseCalc(const ScriptCal
 			if (scriptCalc->tuning->ref.length() == 0) {
 				scriptTuning = scriptCalc->tuning.get();
 			} else {
-				for (const ScriptTuning& tuning : m_context.script->tunings) {
-					if (tuning.id == scriptCalc->tuning->ref) {
-						scriptTuning = &tuning;
-						break;
-					}
+				int index = ProcessorScriptPoolIndex::find(m_context.poolIndex->tunings, scriptCalc->tuning->ref);
+				if (index >= 0) {
+					scriptTuning = &m_context.script->tunings[index];
 				}
 			}
 
@@ -250,7 +285,7 @@ const shared_ptr<CalcProcessor> ProcessorScriptParser::parseCalc(const ScriptCal
 		} else if (signProcessor) {
 			calcProcessor = make_shared<CalcSignProcessor>(scriptCalc);
 		} else if (vtofProcessor) {
-			calcProcessor = make_shared<CalcVtoFProcessor>();
+			calcProcessor = make_shared<CalcVtoFProcessor>(m_fastMath);
 		}
 
 		m_context.location.pop_back();
@@ -258,18 +293,15 @@ const shared_ptr<CalcProcessor> ProcessorScriptParser::parseCalc(const ScriptCal
 		return calcProcessor;
 	} else {
 		if (find(valueStack.begin(), valueStack.end(), string("c-") + scriptCalc->ref) == valueStack.end()) {
-			int count = 0;
-			for (const ScriptCalc& calc : m_context.script->calcs) {
-				if (scriptCalc->ref.compare(calc.id) == 0) {
-					m_context.stashLocation();
-					m_context.location = { "component-pool",  "calcs", to_string(count) };
-					valueStack.push_back(string("c-") + scriptCalc->ref);
-					shared_ptr<CalcProcessor> calcProcessor = parseCalc(&calc, valueStack);
-					valueStack.pop_back();
-					m_context.popLocation();
-					return calcProcessor;
-				}
-				count++;
+			int index = ProcessorScriptPoolIndex::find(m_context.poolIndex->calcs, scriptCalc->ref);
+			if (index >= 0) {
+				m_context.stashLocation();
+				m_context.location = { "component-pool",  "calcs", index };
+				valueStack.push_back(string("c-") + scriptCalc->ref);
+				shared_ptr<CalcProcessor> calcProcessor = parseCalc(&m_context.script->calcs[index], valueStack);
+				valueStack.pop_back();
+				m_context.popLocation();
+				return calcProcessor;
 			}
 
 			// Couldn't find the referenced calc...
@@ -2,12 +2,48 @@
 #include "core/timeseq-processor.hpp"
 #include "core/timeseq-script.hpp"
 #include "core/timeseq-core.hpp"
+#include "core/timeseq-bus.hpp"
 #include <sstream>
+#include <thread>
+#include <atomic>
 #include <stdarg.h>
 
+// Scripts with fewer lane segments are parsed on the calling thread only, since starting the workers would take longer
+#define PARALLEL_PARSE_MIN_SEGMENTS 512
+#define PARALLEL_PARSE_MAX_WORKERS 4u
+
 using namespace std;
 using namespace timeseq;
 
+namespace {
+	template<typename T>
+	void indexPool(unordered_map<string, int>& ids, const vector<T>& pool) {
+		ids.reserve(pool.size());
+		for (unsigned int i = 0; i < pool.size(); i++) {
+			// Keep the first item if an id occurs multiple times, like a scan of the pool would
+			ids.emplace(pool[i].id, i);
+		}
+	}
+}
+
+void ProcessorScriptPoolIndex::build(const Script* script) {
+	indexPool(segmentBlocks, script->segmentBlocks);
+	indexPool(segments, script->segments);
+	indexPool(inputs, script->inputs);
+	indexPool(outputs, script->outputs);
+	indexPool(calcs, script->calcs);
+	indexPool(values, script->values);
+	indexPool(actions, script->actions);
+	indexPool(ifs, script->ifs);
+	indexPool(tunings, script->tunings);
+	indexPool(tables, script->tables);
+}
+
+int ProcessorScriptPoolIndex::find(const unordered_map<string, int>& ids, const string& id) {
+	unordered_map<string, int>::const_iterator it = ids.find(id);
+	return it != ids.end() ? it->second : -1;
+}
+
 void ProcessorScriptParseContext::stashLocation() {
 	stashedLocations.push_back(location);
 }
@@ -18,39 +54,47 @@ void ProcessorScriptParseContext::popLocation() {
 }
 
 
-ProcessorScriptParser::ProcessorScriptParser(PortHandler* portHandler, VariableHandler* variableHandler, TriggerHandler* triggerHandler, const SampleRateReader* sampleRateReader, EventListener* eventListener, AssertListener* assertListener, const shared_ptr<RandValueGenerator> randomValueGenerator) :
-	m_portHandler(portHandler), m_variableHandler(variableHandler), m_triggerHandler(triggerHandler), m_sampleRateReader(sampleRateReader), m_eventListener(eventListener), m_assertListener(assertListener), m_randomValueGenerator(randomValueGenerator) {
+ProcessorScriptParser::ProcessorScriptParser(PortHandler* portHandler, VariableHandler* variableHandler, TriggerHandler* triggerHandler, const SampleRateReader* sampleRateReader, EventListener* eventListener, AssertListener* assertListener, const shared_ptr<RandValueGenerator> randomValueGenerator, EventTracer* eventTracer, ScriptBankHandler* scriptBankHandler, VariableBus* variableBus, bool fastMath) :
+	m_portHandler(portHandler), m_variableHandler(variableHandler), m_triggerHandler(triggerHandler), m_sampleRateReader(sampleRateReader), m_eventListener(eventListener), m_assertListener(assertListener), m_randomValueGenerator(randomValueGenerator), m_eventTracer(eventTracer), m_scriptBankHandler(scriptBankHandler), m_variableBusReferences(variableBus != nullptr ? make_shared<VariableBusReferences>(variableBus) : nullptr), m_fastMath(fastMath),
+	m_parallelMinSegments(PARALLEL_PARSE_MIN_SEGMENTS), m_workerCount(min(max(thread::hardware_concurrency(), 1u), PARALLEL_PARSE_MAX_WORKERS)) {
 }
 
 shared_ptr<Processor> ProcessorScriptParser::parseScript(shared_ptr<Script> script, vector<ValidationError>& validationErrors) {
 	m_context.script = script.get();
 	m_context.validationErrors = &validationErrors;
+	shared_ptr<ProcessorScriptPoolIndex> poolIndex = make_shared<ProcessorScriptPoolIndex>();
+	poolIndex->build(script.get());
+	m_context.poolIndex = poolIndex;
 
 	int count = 0;
 	for (const ScriptSequence& sequence : script->sequences) {
 		m_context.stashLocation();
-		m_context.location = { "component-pool",  "sequences", to_string(count) };
+		m_context.location = { "component-pool",  "sequences", count };
 		parseSequence(&sequence);
 		m_context.popLocation();
 	}
 
+	unsigned int segmentCount = 0;
+	for (const ScriptTimeline& timeline : script->timelines) {
+		for (const ScriptLane& lane : timeline.lanes) {
+			segmentCount += lane.segments.size();
+		}
+	}
+	vector<vector<shared_ptr<LaneProcessor>>> laneProcessors = ((m_workerCount > 1) && (segmentCount >= m_parallelMinSegments)) ? parseLanesParallel(script.get()) : parseLanes(script.get());
+
 	count = 0;
-	m_context.location.push_back("timelines");
 	vector<shared_ptr<TimelineProcessor>> timelineProcessors;
 	for (const ScriptTimeline& timeline : script->timelines) {
-		m_context.location.push_back(to_string(count));
-		timelineProcessors.push_back(parseTimeline(&timeline));
-		m_context.location.pop_back();
+		timelineProcessors.push_back(parseTimeline(&timeline, laneProcessors[count]));
 		count++;
 	}
-	m_context.location.pop_back();
 
 	count = 0;
 	m_context.location.push_back("input-triggers");
 	vector<shared_ptr<TriggerProcessor>> triggerProcessors;
 	for (const ScriptInputTrigger& trigger : script->inputTriggers) {
-		m_context.location.push_back(to_string(count));
-		triggerProcessors.push_back(parseInputTrigger(&trigger));
+		m_context.location.push_back(count);
+		parseInputTrigger(&trigger, triggerProcessors);
 		m_context.location.pop_back();
 		count++;
 	}
@@ -60,9 +104,9 @@ shared_ptr<Processor> ProcessorScriptParser::parseScript(shared_ptr<Script> scri
 	m_context.location.push_back("global-actions");
 	vector<shared_ptr<ActionProcessor>> startActionProcessors;
 	for (const ScriptAction& action : script->globalActions) {
-		m_context.location.push_back(to_string(count));
+		m_context.location.push_back(count);
 
-		vector<string> actionLocation;
+		ValidationLocation actionLocation;
 		const ScriptAction* resolvedAction = resolveScriptAction(&action, actionLocation);
 
 		if (resolvedAction) {
@@ -79,23 +123,94 @@ shared_ptr<Processor> ProcessorScriptParser::parseScript(shared_ptr<Script> scri
 	}
 	m_context.location.pop_back();
 
-	return make_shared<Processor>(script, timelineProcessors, triggerProcessors, startActionProcessors);
+	return make_shared<Processor>(script, timelineProcessors, triggerProcessors, startActionProcessors, m_variableBusReferences);
+}
+
+const vector<vector<shared_ptr<LaneProcessor>>> ProcessorScriptParser::parseLanes(const Script* script) {
+	vector<vector<shared_ptr<LaneProcessor>>> laneProcessors;
+
+	int timelineCount = 0;
+	m_context.location.push_back("timelines");
+	for (const ScriptTimeline& timeline : script->timelines) {
+		int laneCount = 0;
+		laneProcessors.emplace_back();
+		m_context.location.push_back(timelineCount);
+		m_context.location.push_back("lanes");
+		for (const ScriptLane& lane : timeline.lanes) {
+			m_context.location.push_back(laneCount);
+			laneProcessors.back().push_back(parseLane(&lane, timeline.timeScale.get()));
+			m_context.location.pop_back();
+			laneCount++;
+		}
+		m_context.location.pop_back();
+		m_context.location.pop_back();
+		timelineCount++;
+	}
+	m_context.location.pop_back();
+
+	return laneProcessors;
+}
+
+const vector<vector<shared_ptr<LaneProcessor>>> ProcessorScriptParser::parseLanesParallel(const Script* script) {
+	struct LaneTask {
+		const ScriptTimeline* timeline;
+		const ScriptLane* lane;
+		ValidationLocation location;
+		shared_ptr<LaneProcessor> laneProcessor;
+		vector<ValidationError> validationErrors;
+	};
+
+	vector<LaneTask> tasks;
+	for (unsigned int i = 0; i < script->timelines.size(); i++) {
+		const ScriptTimeline& timeline = script->timelines[i];
+		for (unsigned int j = 0; j < timeline.lanes.size(); j++) {
+			tasks.push_back({ &timeline, &timeline.lanes[j], { "timelines", (int) i, "lanes", (int) j }, nullptr, {} });
+		}
+	}
+
+	// The workers share the same output recorder, so make sure that it exists before they start
+	if (!m_outputRecorder) {
+		m_outputRecorder = make_shared<OutputRecorder>(m_portHandler);
+	}
+
+	// Each worker parses lanes with its own copy of the parser, which only shares the read-only parts of the context
+	atomic<unsigned int> nextTask { 0 };
+	auto work = [this, &tasks, &nextTask]() {
+		ProcessorScriptParser parser(*this);
+		for (unsigned int i = nextTask++; i < tasks.size(); i = nextTask++) {
+			LaneTask& task = tasks[i];
+			parser.m_context.validationErrors = &task.validationErrors;
+			parser.m_context.location = task.location;
+			task.laneProcessor = parser.parseLane(task.lane, task.timeline->timeScale.get());
+		}
+	};
+
+	vector<thread> workers;
+	for (unsigned int i = 1; i < min(m_workerCount, (unsigned int) tasks.size()); i++) {
+		workers.emplace_back(work);
+	}
+	work();
+	for (thread& worker : workers) {
+		worker.join();
+	}
+
+	// Collect the results in script order, so that the processors and the validation errors are the same as when parsing serially
+	vector<vector<shared_ptr<LaneProcessor>>> laneProcessors(script->timelines.size());
+	for (LaneTask& task : tasks) {
+		laneProcessors[task.timeline - script->timelines.data()].push_back(task.laneProcessor);
+		m_context.validationErrors->insert(m_context.validationErrors->end(), task.validationErrors.begin(), task.validationErrors.end());
+	}
+
+	return laneProcessors;
 }
 
-const shared_ptr<TimelineProcessor> ProcessorScriptParser::parseTimeline(const ScriptTimeline* scriptTimeline) {
+const shared_ptr<TimelineProcessor> ProcessorScriptParser::parseTimeline(const ScriptTimeline* scriptTimeline, const vector<shared_ptr<LaneProcessor>>& laneProcessors) {
 	unordered_map<string, vector<shared_ptr<LaneProcessor>>> startTriggers;
 	unordered_map<string, vector<shared_ptr<LaneProcessor>>> stopTriggers;
 
-	int count = 0;
-	m_context.location.push_back("lanes");
-	vector<shared_ptr<LaneProcessor>> laneProcessors;
-	for (const ScriptLane& lane : scriptTimeline->lanes) {
-		shared_ptr<LaneProcessor> laneProcessor;
-		m_context.location.push_back(to_string(count));
-		laneProcessor = parseLane(&lane, scriptTimeline->timeScale.get());
-		laneProcessors.push_back(laneProcessor);
-		m_context.location.pop_back();
-		count++;
+	for (unsigned int i = 0; i < scriptTimeline->lanes.size(); i++) {
+		const ScriptLane& lane = scriptTimeline->lanes[i];
+		const shared_ptr<LaneProcessor>& laneProcessor = laneProcessors[i];
 
 		if (lane.startTrigger.length() > 0) {
 			if (startTriggers.find(lane.startTrigger) == startTriggers.end()) {
@@ -111,7 +226,6 @@ const shared_ptr<TimelineProcessor> ProcessorScriptParser::parseTimeline(const S
 			stopTriggers[lane.stopTrigger].push_back(laneProcessor);
 		}
 	}
-	m_context.location.pop_back();
 
 	return make_shared<TimelineProcessor>(scriptTimeline, laneProcessors, startTriggers, stopTriggers, m_triggerHandler);
 }
@@ -121,12 +235,14 @@ const shared_ptr<LaneProcessor> ProcessorScriptParser::parseLane(const ScriptLan
 
 	m_context.location.push_back("segments");
 	vector<string> stack;
+	m_controlRate = scriptLane->controlRate;
 	vector<shared_ptr<SegmentProcessor>> segmentProcessors = parseSegments(&scriptLane->segments, timeScale, stack);
+	m_controlRate = 1;
 	m_context.location.pop_back();
 
 	// Only return an actual processor if there were no validation errors during parsing. Otherwise there might be partially loaded children, and we can't reliably continue with this processor.
 	if (validationCount == m_context.validationErrors->size()) {
-		return make_shared<LaneProcessor>(scriptLane, segmentProcessors, m_eventListener);
+		return make_shared<LaneProcessor>(scriptLane, segmentProcessors, m_eventListener, m_eventTracer);
 	} else {
 		return shared_ptr<LaneProcessor>();
 	}
@@ -183,7 +299,7 @@ const shared_ptr<IfProcessor> ProcessorScriptParser::parseIf(const ScriptIf* scr
 		if (parseIfs) {
 			int count = 0;
 			for (const ScriptIf& scriptIf : *scriptIf->ifs.get()) {
-				m_context.location.push_back(to_string(count));
+				m_context.location.push_back(count);
 				ifs.push_back(parseIf(&scriptIf, ifStack));
 				m_context.location.pop_back();
 				count++;
@@ -195,18 +311,15 @@ const shared_ptr<IfProcessor> ProcessorScriptParser::parseIf(const ScriptIf* scr
 		return make_shared<IfProcessor>(scriptIf, values, ifs);
 	} else {
 		if (find(ifStack.begin(), ifStack.end(), scriptIf->ref) == ifStack.end()) {
-			int count = 0;
-			for (const ScriptIf& refIf : m_context.script->ifs) {
-				if (scriptIf->ref.compare(refIf.id) == 0) {
-					m_context.stashLocation();
-					m_context.location = { "component-pool",  "ifs", to_string(count) };
-					ifStack.push_back(scriptIf->ref);
-					shared_ptr<IfProcessor> ifProcessor = parseIf(&refIf, ifStack);
-					ifStack.pop_back();
-					m_context.popLocation();
-					return ifProcessor;
-				}
-				count++;
+			int index = ProcessorScriptPoolIndex::find(m_context.poolIndex->ifs, scriptIf->ref);
+			if (index >= 0) {
+				m_context.stashLocation();
+				m_context.location = { "component-pool",  "ifs", index };
+				ifStack.push_back(scriptIf->ref);
+				shared_ptr<IfProcessor> ifProcessor = parseIf(&m_context.script->ifs[index], ifStack);
+				ifStack.pop_back();
+				m_context.popLocation();
+				return ifProcessor;
 			}
 
 			// Couldn't find the referenced if...
@@ -228,7 +341,7 @@ void ProcessorScriptParser::parseSequence(const ScriptSequence* scriptSequence)
 	shared_ptr<SequenceProcessor> sequenceProcessor = make_shared<SequenceProcessor>(scriptSequence->id, values, scriptSequence->retrieveVoltageOnce);
 
 	if (scriptSequence->shared) {
-		m_context.sharedSequences.push_back(make_shared<SequencePositionProcessor>(sequenceProcessor, m_randomValueGenerator));
+		m_context.sharedSequences.push_back(make_shared<SequencePositionProcessor>(sequenceProcessor, m_randomValueGenerator, m_eventTracer));
 	} else {
 		m_context.nonSharedSequences.push_back(sequenceProcessor);
 	}
@@ -257,20 +370,49 @@ bool ProcessorScriptParser::hasNonSharedSequence(const string& id) const {
 const shared_ptr<SequencePositionProcessor> ProcessorScriptParser::resolveNonSharedSequence(const string& id) const {
 	for (const shared_ptr<SequenceProcessor>& sequenceProcessor : m_context.nonSharedSequences) {
 		if (id == sequenceProcessor->getId()) {
-			return make_shared<SequencePositionProcessor>(sequenceProcessor, m_randomValueGenerator);
+			return make_shared<SequencePositionProcessor>(sequenceProcessor, m_randomValueGenerator, m_eventTracer);
 		}
 	}
 
 	return nullptr;
 }
 
-ProcessorLoader::ProcessorLoader(PortHandler* portHandler, VariableHandler* variableHandler, TriggerHandler* triggerHandler, const SampleRateReader* sampleRateReader, EventListener* eventListener, AssertListener* assertListener) : m_portHandler(portHandler), m_variableHandler(variableHandler), m_triggerHandler(triggerHandler), m_sampleRateReader(sampleRateReader), m_eventListener(eventListener), m_assertListener(assertListener), m_randomValueGenerator(make_shared<RandValueGenerator>()) {}
-ProcessorLoader::ProcessorLoader(PortHandler* portHandler, VariableHandler* variableHandler, TriggerHandler* triggerHandler, const SampleRateReader* sampleRateReader, EventListener* eventListener, AssertListener* assertListener, const shared_ptr<RandValueGenerator> randomValueGenerator) : m_portHandler(portHandler), m_variableHandler(variableHandler), m_triggerHandler(triggerHandler), m_sampleRateReader(sampleRateReader), m_eventListener(eventListener), m_assertListener(assertListener), m_randomValueGenerator(randomValueGenerator) {}
+VariableHandler* ProcessorScriptParser::resolveVariableHandler(const string& name) {
+	// Variable names with the bus prefix only became shared in script version 1.3.0
+	if ((m_variableBusReferences) && (name.compare(0, strlen(TIMESEQ_BUS_PREFIX), TIMESEQ_BUS_PREFIX) == 0) && (m_context.script->versionNumber >= 130)) {
+		VariableBusSlot* variableBusSlot = m_variableBusReferences->resolve(name);
+		if (variableBusSlot != nullptr) {
+			return variableBusSlot;
+		}
+		addValidationError(m_context.validationErrors, m_context.location, ValidationErrorCode::VariableBus_Full, "The variable '", name.c_str(), "' can not be added to the variable bus, since all ", to_string(TIMESEQ_BUS_SIZE).c_str(), " bus variables are already in use.");
+	}
+	return m_variableHandler;
+}
+
+ProcessorLoader::ProcessorLoader(PortHandler* portHandler, VariableHandler* variableHandler, TriggerHandler* triggerHandler, const SampleRateReader* sampleRateReader, EventListener* eventListener, AssertListener* assertListener) : m_portHandler(portHandler), m_variableHandler(variableHandler), m_triggerHandler(triggerHandler), m_sampleRateReader(sampleRateReader), m_eventListener(eventListener), m_assertListener(assertListener), m_randomValueGenerator(make_shared<RandValueGenerator>()), m_eventTracer(nullptr) {}
+ProcessorLoader::ProcessorLoader(PortHandler* portHandler, VariableHandler* variableHandler, TriggerHandler* triggerHandler, const SampleRateReader* sampleRateReader, EventListener* eventListener, AssertListener* assertListener, EventTracer* eventTracer) : m_portHandler(portHandler), m_variableHandler(variableHandler), m_triggerHandler(triggerHandler), m_sampleRateReader(sampleRateReader), m_eventListener(eventListener), m_assertListener(assertListener), m_randomValueGenerator(make_shared<RandValueGenerator>()), m_eventTracer(eventTracer) {}
+ProcessorLoader::ProcessorLoader(PortHandler* portHandler, VariableHandler* variableHandler, TriggerHandler* triggerHandler, const SampleRateReader* sampleRateReader, EventListener* eventListener, AssertListener* assertListener, const shared_ptr<RandValueGenerator> randomValueGenerator) : m_portHandler(portHandler), m_variableHandler(variableHandler), m_triggerHandler(triggerHandler), m_sampleRateReader(sampleRateReader), m_eventListener(eventListener), m_assertListener(assertListener), m_randomValueGenerator(randomValueGenerator), m_eventTracer(nullptr) {}
 
 ProcessorLoader::~ProcessorLoader() {
 }
 
 const shared_ptr<Processor> ProcessorLoader::loadScript(const shared_ptr<Script>& script, vector<ValidationError>& validationErrors) {
-	ProcessorScriptParser processorScriptParser(m_portHandler, m_variableHandler, m_triggerHandler, m_sampleRateReader, m_eventListener, m_assertListener, m_randomValueGenerator);
+	ProcessorScriptParser processorScriptParser(m_portHandler, m_variableHandler, m_triggerHandler, m_sampleRateReader, m_eventListener, m_assertListener, m_randomValueGenerator, m_eventTracer, m_scriptBankHandler, m_variableBus, m_fastMath);
 	return processorScriptParser.parseScript(script, validationErrors);
 }
+
+void ProcessorLoader::seedRandomValues(uint64_t seed) {
+	m_randomValueGenerator->seed(seed);
+}
+
+void ProcessorLoader::setFastMath(bool fastMath) {
+	m_fastMath = fastMath;
+}
+
+void ProcessorLoader::setScriptBankHandler(ScriptBankHandler* scriptBankHandler) {
+	m_scriptBankHandler = scriptBankHandler;
+}
+
+void ProcessorLoader::setVariableBus(VariableBus* variableBus) {
+	m_variableBus = variableBus;
+}
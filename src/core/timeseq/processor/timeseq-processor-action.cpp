@@ -1,6 +1,8 @@
 #include "core/timeseq-processor.hpp"
 #include "core/timeseq-script.hpp"
 #include "core/timeseq-core.hpp"
+#include "core/timeseq-tracer.hpp"
+#include "util/fastmath.hpp"
 
 using namespace std;
 using namespace timeseq;
@@ -13,11 +15,31 @@ void ActionProcessor::process() {
 	}
 }
 
+void ActionProcessor::setOutputPortHandler(PortHandler* portHandler) {}
+
 ActionSetValueProcessor::ActionSetValueProcessor(const shared_ptr<ValueProcessor>& value, int outputPort, int outputChannel, PortHandler* portHandler, const shared_ptr<IfProcessor>& ifProcessor) : ActionProcessor(ifProcessor), m_value(value), m_outputPort(outputPort), m_outputChannel(outputChannel), m_portHandler(portHandler) {}
 
 void ActionSetValueProcessor::processAction() {
 	float value = m_value->process();
-	m_portHandler->setOutputPortVoltage(m_outputPort, m_outputChannel, value);
+	m_portHandler.setOutputPortVoltage(m_outputPort, m_outputChannel, value);
+}
+
+void ActionSetValueProcessor::setOutputPortHandler(PortHandler* portHandler) {
+	m_portHandler = PortBinding(portHandler);
+}
+
+ActionSetPolyValueProcessor::ActionSetPolyValueProcessor(const vector<shared_ptr<ValueProcessor>>& values, int outputPort, int outputChannel, PortHandler* portHandler, const shared_ptr<IfProcessor>& ifProcessor) : ActionProcessor(ifProcessor), m_values(values), m_outputPort(outputPort), m_outputChannel(outputChannel), m_portHandler(portHandler) {}
+
+void ActionSetPolyValueProcessor::processAction() {
+	int count = m_values.size();
+	for (int i = 0; i < count; i++) {
+		m_voltages[i] = m_values[i]->process();
+	}
+	m_portHandler.setOutputPortVoltages(m_outputPort, m_outputChannel, m_voltages.data(), count);
+}
+
+void ActionSetPolyValueProcessor::setOutputPortHandler(PortHandler* portHandler) {
+	m_portHandler = PortBinding(portHandler);
 }
 
 ActionSetVariableProcessor::ActionSetVariableProcessor(const shared_ptr<ValueProcessor>& value, const string& name, VariableHandler* variableHandler, const shared_ptr<IfProcessor>& ifProcessor) : ActionProcessor(ifProcessor), m_value(value), m_name(name), m_variableHandler(variableHandler) {}
@@ -30,24 +52,27 @@ void ActionSetVariableProcessor::processAction() {
 ActionSetPolyphonyProcessor::ActionSetPolyphonyProcessor(int outputPort, int channelCount, PortHandler* portHandler, const shared_ptr<IfProcessor>& ifProcessor) : ActionProcessor(ifProcessor), m_outputPort(outputPort), m_channelCount(channelCount), m_portHandler(portHandler) {}
 
 void ActionSetPolyphonyProcessor::processAction() {
-	m_portHandler->setOutputPortChannels(m_outputPort, m_channelCount);
+	m_portHandler.setOutputPortChannels(m_outputPort, m_channelCount);
 }
 
 ActionSetLabelProcessor::ActionSetLabelProcessor(int outputPort, const string& label, PortHandler* portHandler, const shared_ptr<IfProcessor>& ifProcessor) : ActionProcessor(ifProcessor), m_outputPort(outputPort), m_label(label), m_portHandler(portHandler) {}
 
 void ActionSetLabelProcessor::processAction() {
-	m_portHandler->setOutputPortLabel(m_outputPort, m_label);
+	m_portHandler.setOutputPortLabel(m_outputPort, m_label);
 }
 
-ActionAssertProcessor::ActionAssertProcessor(const string& name, const shared_ptr<IfProcessor>& expect, bool stopOnFail, AssertListener* assertListener, const shared_ptr<IfProcessor>& ifProcessor) : ActionProcessor(ifProcessor), m_name(name), m_expect(expect), m_stopOnFail(stopOnFail), m_assertListener(assertListener) {}
+ActionAssertProcessor::ActionAssertProcessor(const string& name, const shared_ptr<IfProcessor>& expect, bool stopOnFail, AssertListener* assertListener, EventTracer* eventTracer, const shared_ptr<IfProcessor>& ifProcessor) : ActionProcessor(ifProcessor), m_name(name), m_expect(expect), m_stopOnFail(stopOnFail), m_assertListener(assertListener), m_eventTracer(eventTracer) {}
 
 void ActionAssertProcessor::processAction() {
-	// First check the expectation without constructing a message to avoid performance impact
+	// First check the expectation without collecting its operands to avoid performance impact
 	if (!m_expect->process(nullptr)) {
-		// If the expectation failed, re-execute it to generate the message
-		string message;
-		m_expect->process(&message);
-		m_assertListener->assertFailed(m_name, message, m_stopOnFail);
+		// If the expectation failed, re-execute it to collect the operands. The message is formatted on the UI thread.
+		AssertExpectation expectation;
+		m_expect->process(&expectation);
+		if (m_eventTracer) {
+			m_eventTracer->record(TraceEventType::ASSERT_FAILED, this, m_name);
+		}
+		m_assertListener->assertFailed(m_name, expectation, m_stopOnFail);
 	}
 }
 
@@ -57,6 +82,14 @@ void ActionTriggerProcessor::processAction() {
 	m_triggerHandler->setTrigger(m_trigger);
 }
 
+ActionSelectScriptProcessor::ActionSelectScriptProcessor(int index, ScriptBankHandler* scriptBankHandler, const shared_ptr<IfProcessor>& ifProcessor) : ActionProcessor(ifProcessor), m_index(index), m_scriptBankHandler(scriptBankHandler) {}
+
+void ActionSelectScriptProcessor::processAction() {
+	if (m_scriptBankHandler != nullptr) {
+		m_scriptBankHandler->selectScript(m_index);
+	}
+}
+
 ActionMoveSequenceDirectionProcessor::ActionMoveSequenceDirectionProcessor(shared_ptr<SequencePositionProcessor>& sequencePositionProcessor, SequencePositionProcessor::SequenceMoveDirection direction, bool wrap, const shared_ptr<IfProcessor>& ifProcessor) : ActionProcessor(ifProcessor), m_sequencePositionProcessor(sequencePositionProcessor), m_direction(direction), m_wrap(wrap) {}
 
 void ActionMoveSequenceDirectionProcessor::processAction() {
@@ -101,9 +134,13 @@ bool ActionOngoingProcessor::shouldProcess() {
 	return m_if;
 }
 
+void ActionOngoingProcessor::setOutputPortHandler(PortHandler* portHandler) {}
+
 ActionGlideProcessor::ActionGlideProcessor(
 	float easeFactor,
 	bool easePow,
+	bool fastMath,
+	int controlRate,
 	const shared_ptr<ValueProcessor>& startValue,
 	const shared_ptr<ValueProcessor>& endValue,
 	const shared_ptr<IfProcessor>& ifProcessor,
@@ -112,13 +149,7 @@ ActionGlideProcessor::ActionGlideProcessor(
 	const string& variable,
 	PortHandler* portHandler,
 	VariableHandler* variableHandler) :
-		ActionOngoingProcessor(ifProcessor), m_easeFactor(easeFactor), m_easePow(easePow), m_startValueProcessor(startValue), m_endValueProcessor(endValue), m_portHandler(portHandler), m_variableHandler(variableHandler), m_outputPort(outputPort), m_outputChannel(outputChannel), m_variable(variable) {
-
-	if (!m_easePow) {
-		// Multiply the ease factor if we're using the sigmoid function since it reacts slower to the easing factor when compared to the power-based algorithm.
-		m_easeFactor *= 3.5f;
-	}
-}
+		ActionOngoingProcessor(ifProcessor), m_ease(easeFactor, easePow, fastMath, controlRate), m_startValueProcessor(startValue), m_endValueProcessor(endValue), m_portHandler(portHandler), m_variableHandler(variableHandler), m_outputPort(outputPort), m_outputChannel(outputChannel), m_variable(variable) {}
 
 void ActionGlideProcessor::start(uint64_t glideLength) {
 	ActionOngoingProcessor::start(glideLength);
@@ -128,7 +159,7 @@ void ActionGlideProcessor::start(uint64_t glideLength) {
 		m_endValue = m_endValueProcessor->process();
 
 		m_valueDelta = m_endValue - m_startValue;
-		m_durationInverse = glideLength > 1. ? 1. / (glideLength - 1.) : 1.;
+		m_ease.start(glideLength);
 	}
 }
 
@@ -137,20 +168,13 @@ void ActionGlideProcessor::process(uint64_t glidePosition) {
 		// The position coming from the DurationProcessor goes from 1 until duration.
 		// For glide actions, we want the first call to be at position 0 so that the exact start value is used for the first iteration.
 		// The glide will then run through the range in the process() until just before the exact end value, and the exact end value will be set when the end() method is called.
-		float ease = m_durationInverse * (glidePosition - 1);
-		if (m_easeFactor != 0.f) {
-			if (m_easePow) {
-				ease = calculatePowEase(ease);
-			} else {
-				ease = calculateSigEase(ease);
-			}
-		}
+		float ease = m_ease.calculate(glidePosition - 1);
 
 		double value = m_startValue + m_valueDelta * ease;
 		if (m_variable.length() > 0) {
 			m_variableHandler->setVariable(m_variable, value);
 		} else {
-			m_portHandler->setOutputPortVoltage(m_outputPort, m_outputChannel, value);
+			m_portHandler.setOutputPortVoltage(m_outputPort, m_outputChannel, value);
 		}
 	}
 }
@@ -160,20 +184,139 @@ void ActionGlideProcessor::end() {
 		if (m_variable.length() > 0) {
 			m_variableHandler->setVariable(m_variable, m_endValue);
 		} else {
-			m_portHandler->setOutputPortVoltage(m_outputPort, m_outputChannel, m_endValue);
+			m_portHandler.setOutputPortVoltage(m_outputPort, m_outputChannel, m_endValue);
 		}
 	}
 }
 
-double ActionGlideProcessor::calculatePowEase(float ease) {
-	if (m_easeFactor > 0.f) {
+void ActionGlideProcessor::setOutputPortHandler(PortHandler* portHandler) {
+	m_portHandler = PortBinding(portHandler);
+}
+
+ActionGlidePolyProcessor::ActionGlidePolyProcessor(
+	float easeFactor,
+	bool easePow,
+	bool fastMath,
+	int controlRate,
+	const vector<shared_ptr<ValueProcessor>>& startValues,
+	const vector<shared_ptr<ValueProcessor>>& endValues,
+	const shared_ptr<IfProcessor>& ifProcessor,
+	int outputPort,
+	int outputChannel,
+	PortHandler* portHandler) :
+		ActionOngoingProcessor(ifProcessor), m_ease(easeFactor, easePow, fastMath, controlRate), m_startValueProcessors(startValues), m_endValueProcessors(endValues), m_portHandler(portHandler), m_outputPort(outputPort), m_outputChannel(outputChannel), m_channelCount(startValues.size()) {}
+
+void ActionGlidePolyProcessor::start(uint64_t glideLength) {
+	ActionOngoingProcessor::start(glideLength);
+
+	if (shouldProcess()) {
+		for (int i = 0; i < m_channelCount; i++) {
+			m_startValues[i] = m_startValueProcessors[i]->process();
+			m_endValues[i] = m_endValueProcessors[i]->process();
+			m_valueDeltas[i] = m_endValues[i] - m_startValues[i];
+		}
+
+		m_ease.start(glideLength);
+	}
+}
+
+void ActionGlidePolyProcessor::process(uint64_t glidePosition) {
+	if (shouldProcess()) {
+		// The ease is the same for all channels, so it only has to be calculated once
+		float ease = m_ease.calculate(glidePosition - 1);
+
+		for (int i = 0; i < m_channelCount; i++) {
+			m_voltages[i] = m_startValues[i] + m_valueDeltas[i] * ease;
+		}
+		m_portHandler.setOutputPortVoltages(m_outputPort, m_outputChannel, m_voltages.data(), m_channelCount);
+	}
+}
+
+void ActionGlidePolyProcessor::end() {
+	if (shouldProcess()) {
+		m_portHandler.setOutputPortVoltages(m_outputPort, m_outputChannel, m_endValues.data(), m_channelCount);
+	}
+}
+
+void ActionGlidePolyProcessor::setOutputPortHandler(PortHandler* portHandler) {
+	m_portHandler = PortBinding(portHandler);
+}
+
+GlideEase::GlideEase(float easeFactor, bool easePow, bool fastMath, int controlRate) : m_easeFactor(easeFactor), m_easePow(easePow), m_fastMath(fastMath), m_controlRate(controlRate) {
+	if (!m_easePow) {
+		// Multiply the ease factor if we're using the sigmoid function since it reacts slower to the easing factor when compared to the power-based algorithm.
+		m_easeFactor *= 3.5f;
+	}
+	// A linear glide is as cheap as the ramp, so there is no point in using a control rate for it
+	if (m_easeFactor == 0.f) {
+		m_controlRate = 1;
+	}
+}
+
+void GlideEase::start(uint64_t glideLength) {
+	m_durationInverse = glideLength > 1. ? 1. / (glideLength - 1.) : 1.;
+	m_lastStep = glideLength > 1 ? glideLength - 1 : 1;
+	// Make sure that the first step starts a new ramp
+	m_rampStartStep = 1;
+	m_rampEndStep = 0;
+	m_rampEnd = 0.f;
+}
+
+float GlideEase::calculate(uint64_t step) {
+	if (m_controlRate <= 1) {
+		return calculateEase(m_durationInverse * step);
+	}
+
+	// The step can be repeated (when the segment corrects its drift), so check the range instead of only the control rate boundaries
+	if ((step < m_rampStartStep) || (step >= m_rampEndStep)) {
+		uint64_t rampStartStep = step - (step % m_controlRate);
+		uint64_t rampEndStep = min(rampStartStep + m_controlRate, m_lastStep);
+
+		// Continuing from the previous ramp can re-use its end value as start of the new ramp
+		bool continueRamp = (m_rampStartStep < m_rampEndStep) && (rampStartStep == m_rampEndStep);
+		m_rampStart = continueRamp ? m_rampEnd : calculateEase(m_durationInverse * min(rampStartStep, m_lastStep));
+		if (rampEndStep > rampStartStep) {
+			m_rampEnd = calculateEase(m_durationInverse * rampEndStep);
+			m_rampDelta = (m_rampEnd - m_rampStart) / (rampEndStep - rampStartStep);
+		} else {
+			// Past the last step of the glide, so remain at the end of the glide
+			rampEndStep = rampStartStep + 1;
+			m_rampEnd = m_rampStart;
+			m_rampDelta = 0.f;
+		}
+		m_rampStartStep = rampStartStep;
+		m_rampEndStep = rampEndStep;
+	}
+
+	return m_rampStart + m_rampDelta * (step - m_rampStartStep);
+}
+
+float GlideEase::calculateEase(float position) {
+	if (m_easeFactor != 0.f) {
+		if (m_easePow) {
+			return calculatePowEase(position);
+		} else {
+			return calculateSigEase(position);
+		}
+	}
+	return position;
+}
+
+double GlideEase::calculatePowEase(float ease) {
+	if (m_fastMath) {
+		if (m_easeFactor > 0.f) {
+			return fastPow(ease, 1.f + m_easeFactor * 2.f);
+		} else {
+			return 1.f - fastPow(1.f - (ease), 1.f - m_easeFactor * 2.f);
+		}
+	} else if (m_easeFactor > 0.f) {
 		return pow(ease, 1.f + m_easeFactor * 2.f);
 	} else {
 		return 1.f - pow(1.f - (ease), 1.f - m_easeFactor * 2.f);
 	}
 }
 
-double ActionGlideProcessor::calculateSigEase(float ease) {
+double GlideEase::calculateSigEase(float ease) {
 	if (m_easeFactor > 0.f) {
 		return ease / (1.0f + m_easeFactor * (1.0f - ease));
 	} else {
@@ -193,7 +336,7 @@ void ActionGateProcessor::start(uint64_t glideLength) {
 		m_gateLowPosition = fmax(ceil(m_gateHighRatio * glideLength), 1.f);
 
 		m_gateHigh = true;
-		m_portHandler->setOutputPortVoltage(m_outputPort, m_outputChannel, 10.f);
+		m_portHandler.setOutputPortVoltage(m_outputPort, m_outputChannel, 10.f);
 	}
 }
 
@@ -201,7 +344,7 @@ void ActionGateProcessor::process(uint64_t glidePosition) {
 	if ((shouldProcess()) && (m_gateHigh)) {
 		if (glidePosition > m_gateLowPosition) {
 			m_gateHigh = false;
-			m_portHandler->setOutputPortVoltage(m_outputPort, m_outputChannel, 0.f);
+			m_portHandler.setOutputPortVoltage(m_outputPort, m_outputChannel, 0.f);
 		}
 	}
 }
@@ -209,6 +352,10 @@ void ActionGateProcessor::process(uint64_t glidePosition) {
 void ActionGateProcessor::end() {
 	if ((shouldProcess()) && (m_gateHigh)) {
 		m_gateHigh = false;
-		m_portHandler->setOutputPortVoltage(m_outputPort, m_outputChannel, 0.f);
+		m_portHandler.setOutputPortVoltage(m_outputPort, m_outputChannel, 0.f);
 	}
 }
+
+void ActionGateProcessor::setOutputPortHandler(PortHandler* portHandler) {
+	m_portHandler = PortBinding(portHandler);
+}
@@ -0,0 +1,544 @@
+#include "core/timeseq-processor.hpp"
+#include "core/timeseq-script.hpp"
+#include "core/timeseq-core.hpp"
+#include <algorithm>
+#include <sstream>
+
+using namespace std;
+using namespace timeseq;
+
+// Segments that last this many samples or less are considered to be running at audio rate
+#define HOT_SPOT_MAX_SAMPLES 64
+// The number of start and end operations from which an audio rate segment is considered to be heavy
+#define HOT_SPOT_MIN_OPERATIONS 4
+
+
+namespace {
+
+bool findSegmentLocation(const vector<ScriptSegment>& segments, const ScriptSegment* scriptSegment, ValidationLocation& location) {
+	for (unsigned int i = 0; i < segments.size(); i++) {
+		if (&segments[i] == scriptSegment) {
+			location.push_back(i);
+			return true;
+		}
+	}
+	return false;
+}
+
+// Looks up where a segment is defined in the script: in a lane, or in the segments or segment-blocks of the component
+// pool. The processors don't keep the location themselves, since it's only needed for the (rare) hot spots.
+string getSegmentLocation(const Script* script, const ScriptSegment* scriptSegment) {
+	for (unsigned int i = 0; i < script->timelines.size(); i++) {
+		for (unsigned int j = 0; j < script->timelines[i].lanes.size(); j++) {
+			ValidationLocation location = { "timelines", (int) i, "lanes", (int) j, "segments" };
+			if (findSegmentLocation(script->timelines[i].lanes[j].segments, scriptSegment, location)) {
+				return createValidationErrorLocation(location);
+			}
+		}
+	}
+
+	ValidationLocation poolLocation = { "component-pool", "segments" };
+	if (findSegmentLocation(script->segments, scriptSegment, poolLocation)) {
+		return createValidationErrorLocation(poolLocation);
+	}
+
+	for (unsigned int i = 0; i < script->segmentBlocks.size(); i++) {
+		ValidationLocation location = { "component-pool", "segment-blocks", (int) i, "segments" };
+		if (findSegmentLocation(script->segmentBlocks[i].segments, scriptSegment, location)) {
+			return createValidationErrorLocation(location);
+		}
+	}
+
+	return "/";
+}
+
+}
+
+void ProcessorCost::add(const ProcessorCost& cost) {
+	operations += cost.operations;
+	depth = max(depth, cost.depth);
+	randEvaluations += cost.randEvaluations;
+	sequenceEvaluations += cost.sequenceEvaluations;
+	variableAccesses += cost.variableAccesses;
+	triggers += cost.triggers;
+}
+
+ProcessorCost CalcProcessor::getCost() const {
+	ProcessorCost cost;
+	cost.operations = 1;
+	return cost;
+}
+
+bool CalcProcessor::isDeterministic() const {
+	return true;
+}
+
+ProcessorCost CalcValueProcessor::getCost() const {
+	ProcessorCost cost = m_value->getCost();
+	cost.operations++;
+	return cost;
+}
+
+bool CalcValueProcessor::isDeterministic() const {
+	return m_value->isDeterministic();
+}
+
+ProcessorCost ValueProcessor::getCost() const {
+	ProcessorCost cost = getValueCost();
+
+	// Each calc in the chain has to wait for the result of the previous one
+	for (const shared_ptr<CalcProcessor>& calcProcessor : m_calcProcessors) {
+		ProcessorCost calcCost = calcProcessor->getCost();
+		int depth = max(cost.depth, calcCost.depth) + 1;
+		cost.add(calcCost);
+		cost.depth = depth;
+	}
+
+	if (m_quantize) {
+		cost.operations++;
+	}
+
+	return cost;
+}
+
+ProcessorCost ValueProcessor::getValueCost() const {
+	ProcessorCost cost;
+	cost.operations = 1;
+	cost.depth = 1;
+	return cost;
+}
+
+bool ValueProcessor::isDeterministic() const {
+	if (!isValueDeterministic()) {
+		return false;
+	}
+	for (const shared_ptr<CalcProcessor>& calcProcessor : m_calcProcessors) {
+		if (!calcProcessor->isDeterministic()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool ValueProcessor::isValueDeterministic() const {
+	// Variables, inputs, outputs, random values and sequences can all change between evaluations
+	return false;
+}
+
+bool StaticValueProcessor::isValueDeterministic() const {
+	return true;
+}
+
+ProcessorCost TableValueProcessor::getValueCost() const {
+	ProcessorCost cost = m_position->getCost();
+	cost.operations++;
+	cost.depth++;
+	return cost;
+}
+
+bool TableValueProcessor::isValueDeterministic() const {
+	return m_position->isDeterministic();
+}
+
+ProcessorCost VariableValueProcessor::getValueCost() const {
+	ProcessorCost cost = ValueProcessor::getValueCost();
+	cost.variableAccesses++;
+	return cost;
+}
+
+ProcessorCost RandValueProcessor::getValueCost() const {
+	ProcessorCost cost = m_lowerValue->getCost();
+	cost.add(m_upperValue->getCost());
+	cost.operations++;
+	cost.depth++;
+	cost.randEvaluations++;
+	return cost;
+}
+
+ProcessorCost SequenceValueProcessor::getValueCost() const {
+	ProcessorCost cost = ValueProcessor::getValueCost();
+	cost.sequenceEvaluations++;
+	if (m_moveBefore == SequencePositionProcessor::SequenceMoveDirection::RANDOM) {
+		cost.randEvaluations++;
+	}
+	if (m_moveAfter == SequencePositionProcessor::SequenceMoveDirection::RANDOM) {
+		cost.randEvaluations++;
+	}
+	return cost;
+}
+
+ProcessorCost IfProcessor::getCost() const {
+	ProcessorCost cost;
+	cost.operations = 1;
+	if (m_values.first) {
+		cost.add(m_values.first->getCost());
+	}
+	if (m_values.second) {
+		cost.add(m_values.second->getCost());
+	}
+	for (const shared_ptr<IfProcessor>& ifProcessor : m_ifs) {
+		cost.add(ifProcessor->getCost());
+	}
+	return cost;
+}
+
+ProcessorCost ActionProcessor::getCost() const {
+	ProcessorCost cost = getActionCost();
+	if (m_ifProcessor) {
+		cost.add(m_ifProcessor->getCost());
+	}
+	return cost;
+}
+
+ProcessorCost ActionProcessor::getActionCost() const {
+	ProcessorCost cost;
+	cost.operations = 1;
+	return cost;
+}
+
+bool ActionProcessor::isDeterministic() const {
+	return (!m_ifProcessor) && (isActionDeterministic());
+}
+
+bool ActionProcessor::isActionDeterministic() const {
+	return false;
+}
+
+int ActionProcessor::getOutputVoltageCount() const {
+	return 0;
+}
+
+ProcessorCost ActionSetValueProcessor::getActionCost() const {
+	ProcessorCost cost = m_value->getCost();
+	cost.operations++;
+	return cost;
+}
+
+bool ActionSetValueProcessor::isActionDeterministic() const {
+	return m_value->isDeterministic();
+}
+
+int ActionSetValueProcessor::getOutputVoltageCount() const {
+	return 1;
+}
+
+ProcessorCost ActionSetPolyValueProcessor::getActionCost() const {
+	ProcessorCost cost;
+	for (const shared_ptr<ValueProcessor>& value : m_values) {
+		cost.add(value->getCost());
+	}
+	cost.operations++;
+	return cost;
+}
+
+bool ActionSetPolyValueProcessor::isActionDeterministic() const {
+	for (const shared_ptr<ValueProcessor>& value : m_values) {
+		if (!value->isDeterministic()) {
+			return false;
+		}
+	}
+	return true;
+}
+int ActionSetPolyValueProcessor::getOutputVoltageCount() const {
+	return m_values.size();
+}
+
+
+ProcessorCost ActionSetVariableProcessor::getActionCost() const {
+	ProcessorCost cost = m_value->getCost();
+	cost.operations++;
+	cost.variableAccesses++;
+	return cost;
+}
+
+ProcessorCost ActionAssertProcessor::getActionCost() const {
+	ProcessorCost cost = m_expect->getCost();
+	cost.operations++;
+	return cost;
+}
+
+ProcessorCost ActionTriggerProcessor::getActionCost() const {
+	ProcessorCost cost = ActionProcessor::getActionCost();
+	cost.triggers++;
+	return cost;
+}
+
+ProcessorCost ActionMoveSequenceDirectionProcessor::getActionCost() const {
+	ProcessorCost cost = ActionProcessor::getActionCost();
+	if (m_direction == SequencePositionProcessor::SequenceMoveDirection::RANDOM) {
+		cost.randEvaluations++;
+	}
+	return cost;
+}
+
+ProcessorCost ActionAddToSequenceSequenceProcessor::getActionCost() const {
+	ProcessorCost cost = m_value->getCost();
+	cost.operations++;
+	return cost;
+}
+
+ProcessorCost ActionOngoingProcessor::getStartCost() const {
+	ProcessorCost cost;
+	cost.operations = 1;
+	if (m_ifProcessor) {
+		cost.add(m_ifProcessor->getCost());
+	}
+	return cost;
+}
+
+ProcessorCost ActionOngoingProcessor::getProcessCost() const {
+	ProcessorCost cost;
+	cost.operations = 1;
+	return cost;
+}
+
+bool ActionOngoingProcessor::isDeterministic() const {
+	return (!m_ifProcessor) && (isActionDeterministic());
+}
+
+bool ActionOngoingProcessor::isActionDeterministic() const {
+	return false;
+}
+
+int ActionOngoingProcessor::getOutputVoltageCount() const {
+	return 0;
+}
+
+ProcessorCost ActionGlideProcessor::getStartCost() const {
+	ProcessorCost cost = ActionOngoingProcessor::getStartCost();
+	cost.add(m_startValueProcessor->getCost());
+	cost.add(m_endValueProcessor->getCost());
+	return cost;
+}
+
+ProcessorCost ActionGlideProcessor::getProcessCost() const {
+	ProcessorCost cost = ActionOngoingProcessor::getProcessCost();
+	if (m_variable.size() > 0) {
+		cost.variableAccesses++;
+	}
+	return cost;
+}
+
+bool ActionGlideProcessor::isActionDeterministic() const {
+	// Only glides to an output can be recorded
+	return (m_variable.size() == 0) && (m_startValueProcessor->isDeterministic()) && (m_endValueProcessor->isDeterministic());
+}
+
+int ActionGlideProcessor::getOutputVoltageCount() const {
+	return m_variable.size() == 0 ? 1 : 0;
+}
+
+ProcessorCost ActionGlidePolyProcessor::getStartCost() const {
+	ProcessorCost cost = ActionOngoingProcessor::getStartCost();
+	for (const shared_ptr<ValueProcessor>& value : m_startValueProcessors) {
+		cost.add(value->getCost());
+	}
+	for (const shared_ptr<ValueProcessor>& value : m_endValueProcessors) {
+		cost.add(value->getCost());
+	}
+	return cost;
+}
+
+bool ActionGlidePolyProcessor::isActionDeterministic() const {
+	for (const shared_ptr<ValueProcessor>& value : m_startValueProcessors) {
+		if (!value->isDeterministic()) {
+			return false;
+		}
+	}
+	for (const shared_ptr<ValueProcessor>& value : m_endValueProcessors) {
+		if (!value->isDeterministic()) {
+			return false;
+		}
+	}
+	return true;
+}
+int ActionGlidePolyProcessor::getOutputVoltageCount() const {
+	return m_channelCount;
+}
+
+
+bool ActionGateProcessor::isActionDeterministic() const {
+	return true;
+}
+
+int ActionGateProcessor::getOutputVoltageCount() const {
+	return 1;
+}
+
+bool DurationProcessor::isConstant() const {
+	return false;
+}
+
+ProcessorCost DurationProcessor::getCost() const {
+	return ProcessorCost();
+}
+
+bool DurationConstantProcessor::isConstant() const {
+	return true;
+}
+
+ProcessorCost DurationVariableFactorProcessor::getCost() const {
+	return m_value->getCost();
+}
+
+ProcessorCost DurationVariableHzProcessor::getCost() const {
+	return m_value->getCost();
+}
+
+ProcessorCost SegmentProcessor::getStartCost() const {
+	ProcessorCost cost = m_duration->getCost();
+	for (const shared_ptr<ActionProcessor>& action : m_startActions) {
+		cost.add(action->getCost());
+	}
+	for (const shared_ptr<ActionOngoingProcessor>& action : m_ongoingActions) {
+		cost.add(action->getStartCost());
+	}
+	return cost;
+}
+
+ProcessorCost SegmentProcessor::getEndCost() const {
+	ProcessorCost cost;
+	for (const shared_ptr<ActionProcessor>& action : m_endActions) {
+		cost.add(action->getCost());
+	}
+	return cost;
+}
+
+ProcessorCost SegmentProcessor::getSampleCost() const {
+	ProcessorCost cost;
+	cost.operations = 1;
+	for (const shared_ptr<ActionOngoingProcessor>& action : m_ongoingActions) {
+		cost.add(action->getProcessCost());
+	}
+	return cost;
+}
+
+int SegmentProcessor::getOngoingActionCount() const {
+	return m_ongoingActions.size();
+}
+
+void SegmentProcessor::addCost(ProcessorCostReport& costReport, const Script* script, unordered_set<const ScriptSegment*>& reportedSegments) const {
+	ProcessorCost startCost = getStartCost();
+	ProcessorCost endCost = getEndCost();
+
+	costReport.maxCalcDepth = max(costReport.maxCalcDepth, max(startCost.depth, endCost.depth));
+	costReport.maxSegmentStartRandEvaluations = max(costReport.maxSegmentStartRandEvaluations, startCost.randEvaluations);
+	costReport.maxSegmentStartSequenceEvaluations = max(costReport.maxSegmentStartSequenceEvaluations, startCost.sequenceEvaluations);
+
+	// Segments that (can) run at audio rate and do a lot of work when they start or end are reported as hot spots
+	int operations = startCost.operations + endCost.operations;
+	if ((operations >= HOT_SPOT_MIN_OPERATIONS) && (reportedSegments.find(m_scriptSegment) == reportedSegments.end())) {
+		bool hz = (m_scriptSegment->duration.hz) || (m_scriptSegment->duration.hzValue);
+		if ((m_duration->isConstant()) && (m_duration->getDuration() <= HOT_SPOT_MAX_SAMPLES)) {
+			ostringstream message;
+			message << "The " << (hz ? "hz " : "") << "segment lasts " << m_duration->getDuration() << " sample(s), but does " << operations << " operations each time it starts and ends";
+			if (startCost.randEvaluations + startCost.sequenceEvaluations > 0) {
+				message << " (including " << startCost.randEvaluations << " rand and " << startCost.sequenceEvaluations << " sequence evaluations)";
+			}
+			message << ".";
+			costReport.hotSpots.emplace_back(getSegmentLocation(script, m_scriptSegment), message.str());
+			reportedSegments.insert(m_scriptSegment);
+		} else if ((!m_duration->isConstant()) && (hz)) {
+			ostringstream message;
+			message << "The segment has a variable hz duration that may run at audio rate, and does " << operations << " operations each time it starts and ends.";
+			costReport.hotSpots.emplace_back(getSegmentLocation(script, m_scriptSegment), message.str());
+			reportedSegments.insert(m_scriptSegment);
+		}
+	}
+}
+
+void LaneProcessor::addCost(ProcessorCostReport& costReport, ProcessorCostReport::TimelineCost& timelineCost, const Script* script, unordered_set<const ScriptSegment*>& reportedSegments) const {
+	int maxOngoingActions = 0;
+	int maxSampleOperations = 0;
+
+	for (unsigned int i = 0; i < m_segments.size(); i++) {
+		const shared_ptr<SegmentProcessor>& segment = m_segments[i];
+		segment->addCost(costReport, script, reportedSegments);
+
+		// In the worst case, a segment ends, the next one starts and its ongoing actions are processed in the same sample
+		int sampleOperations = segment->getStartCost().operations + segment->getSampleCost().operations + m_segments[i > 0 ? i - 1 : m_segments.size() - 1]->getEndCost().operations;
+		maxSampleOperations = max(maxSampleOperations, sampleOperations);
+		maxOngoingActions = max(maxOngoingActions, segment->getOngoingActionCount());
+	}
+
+	timelineCost.lanes++;
+	timelineCost.segments += m_segments.size();
+	timelineCost.maxConcurrentOngoingActions += maxOngoingActions;
+	timelineCost.worstCaseSampleOperations += maxSampleOperations;
+}
+
+void TimelineProcessor::addCost(ProcessorCostReport& costReport, unordered_map<string, int>& triggerFanOut, const Script* script, unordered_set<const ScriptSegment*>& reportedSegments) const {
+	ProcessorCostReport::TimelineCost timelineCost;
+
+	for (const shared_ptr<LaneProcessor>& lane : m_lanes) {
+		lane->addCost(costReport, timelineCost, script, reportedSegments);
+	}
+
+	// A trigger fans out to all lanes that it starts or stops
+	for (const pair<const string, vector<shared_ptr<LaneProcessor>>>& startTrigger : m_startTriggers) {
+		triggerFanOut[startTrigger.first] += startTrigger.second.size();
+	}
+	for (const pair<const string, vector<shared_ptr<LaneProcessor>>>& stopTrigger : m_stopTriggers) {
+		triggerFanOut[stopTrigger.first] += stopTrigger.second.size();
+	}
+
+	costReport.worstCaseSampleOperations += timelineCost.worstCaseSampleOperations;
+	costReport.timelines.push_back(timelineCost);
+}
+
+ProcessorCostReport Processor::getCostReport() const {
+	ProcessorCostReport costReport;
+	unordered_map<string, int> triggerFanOut;
+	unordered_set<const ScriptSegment*> reportedSegments;
+
+	for (const shared_ptr<TimelineProcessor>& timeline : m_timelines) {
+		timeline->addCost(costReport, triggerFanOut, m_script.get(), reportedSegments);
+	}
+
+	for (const pair<const string, int>& trigger : triggerFanOut) {
+		// Use the trigger id as tie breaker so the report doesn't depend on the map ordering
+		if ((trigger.second > costReport.maxTriggerFanOut) || ((trigger.second == costReport.maxTriggerFanOut) && (trigger.first < costReport.maxTriggerFanOutId))) {
+			costReport.maxTriggerFanOut = trigger.second;
+			costReport.maxTriggerFanOutId = trigger.first;
+		}
+	}
+
+	// The input triggers do their detection on every sample, batched per input port
+	costReport.inputTriggers = 0;
+	for (const shared_ptr<TriggerProcessor>& trigger : m_triggers) {
+		costReport.inputTriggers += trigger->getTriggerCount();
+	}
+	costReport.worstCaseSampleOperations += m_triggers.size();
+
+	return costReport;
+}
+
+vector<string> ProcessorCostReport::describe() const {
+	vector<string> lines;
+	int lanes = 0;
+
+	for (unsigned int i = 0; i < timelines.size(); i++) {
+		ostringstream line;
+		line << "Timeline " << (i + 1) << ": " << timelines[i].lanes << " lane(s), " << timelines[i].segments << " segment(s), up to " << timelines[i].maxConcurrentOngoingActions << " concurrent ongoing action(s)";
+		lines.push_back(line.str());
+		lanes += timelines[i].lanes;
+	}
+
+	lines.push_back("Lanes: " + to_string(lanes));
+	lines.push_back("Input triggers: " + to_string(inputTriggers));
+	lines.push_back("Longest calc chain: " + to_string(maxCalcDepth));
+	lines.push_back("Rand evaluations per segment start: " + to_string(maxSegmentStartRandEvaluations));
+	lines.push_back("Sequence evaluations per segment start: " + to_string(maxSegmentStartSequenceEvaluations));
+	if (maxTriggerFanOut > 0) {
+		lines.push_back("Largest trigger fan-out: " + to_string(maxTriggerFanOut) + " lane(s) for '" + maxTriggerFanOutId + "'");
+	} else {
+		lines.push_back("Largest trigger fan-out: 0 lane(s)");
+	}
+	lines.push_back("Worst-case operations per sample: " + to_string(worstCaseSampleOperations));
+
+	for (const ValidationError& hotSpot : hotSpots) {
+		lines.push_back(hotSpot.location + " : " + hotSpot.message);
+	}
+
+	return lines;
+}
@@ -8,9 +8,9 @@ using namespace timeseq;
 
 IfProcessor::IfProcessor(const ScriptIf* scriptIf, const pair<const shared_ptr<ValueProcessor>, const shared_ptr<ValueProcessor>>& values, const vector<shared_ptr<IfProcessor>>& ifs) : m_scriptIf(scriptIf), m_values(values), m_ifs(ifs) {}
 
-bool IfProcessor::process(string* message) {
-	if (message == nullptr) {
-		// If no message needs to be returned upon failure, we can do a simple check for the different operator types
+bool IfProcessor::process(AssertExpectation* expectation) {
+	if (expectation == nullptr) {
+		// If no expectation needs to be filled in upon failure, we can do a simple check for the different operator types
 		switch (m_scriptIf->ifOperator) {
 			case ScriptIf::IfOperator::EQ: {
 				if (m_scriptIf->tolerance) {
@@ -53,56 +53,27 @@ bool IfProcessor::process(string* message) {
 		return false;
 	} else {
 		// We'll need to return the details of the comparison if it failed, so we'll need to do some additional work...
-		ostringstream oss;
-		oss.precision(10);
-		if (m_scriptIf->ifOperator == ScriptIf::IfOperator::AND) {
-			bool result = true;
-			bool addAnd = false;
-			oss << "(";
-			for (const shared_ptr<IfProcessor>& condition : m_ifs) {
-				string message;
-				if (!condition->process(&message)) {
-					result = false;
-				}
-
-				if (addAnd) {
-					oss << " and ";
-				} else {
-					addAnd = true;
-				}
-				oss << message;
+		AssertExpectation::Term* term = expectation->addTerm();
+		if ((m_scriptIf->ifOperator == ScriptIf::IfOperator::AND) || (m_scriptIf->ifOperator == ScriptIf::IfOperator::OR)) {
+			bool isAnd = m_scriptIf->ifOperator == ScriptIf::IfOperator::AND;
+			if (term != nullptr) {
+				term->operatorName = isAnd ? " and " : " or ";
+				term->combination = true;
+				term->conditionCount = m_ifs.size();
 			}
 
-			oss << ")";
-			*message = oss.str();
-
-			return result;
-		} else if (m_scriptIf->ifOperator == ScriptIf::IfOperator::OR) {
-			bool result = false;
-			bool addOr = false;
-			oss << "(";
+			bool result = isAnd;
 			for (const shared_ptr<IfProcessor>& condition : m_ifs) {
-				string message;
-				if (condition->process(&message)) {
-					result = true;
-				}
-
-				if (addOr) {
-					oss << " or ";
-				} else {
-					addOr = true;
+				if (condition->process(expectation) != isAnd) {
+					result = !isAnd;
 				}
-				oss << message;
 			}
 
-			oss << ")";
-			*message = oss.str();
-
 			return result;
 		} else {
 			double value1 = m_values.first->process();
 			double value2 = m_values.second->process();
-			string operatorName;
+			const char* operatorName = "";
 			bool result = false;
 
 			switch (m_scriptIf->ifOperator) {
@@ -151,8 +122,13 @@ bool IfProcessor::process(string* message) {
 				}
 			}
 
-			oss << "(" << value1 << operatorName << value2 << ")";
-			*message = oss.str();
+			if (term != nullptr) {
+				term->operatorName = operatorName;
+				term->combination = false;
+				term->conditionCount = 0;
+				term->value1 = value1;
+				term->value2 = value2;
+			}
 
 			return result;
 		}
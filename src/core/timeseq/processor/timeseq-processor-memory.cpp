@@ -0,0 +1,647 @@
+#include "core/timeseq-processor.hpp"
+#include "core/timeseq-script.hpp"
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+#include <type_traits>
+
+using namespace std;
+using namespace timeseq;
+
+// The estimated size of the control block that make_shared allocates together with each processor
+#define SHARED_OBJECT_OVERHEAD 16
+
+
+namespace {
+	template<typename T>
+	size_t getSharedObjectSize(const T*) {
+		return sizeof(T) + SHARED_OBJECT_OVERHEAD;
+	}
+
+	// Short strings are kept inside the string object itself, only longer ones use heap memory
+	size_t getHeapSize(const string& value) {
+		return value.capacity() > string().capacity() ? value.capacity() + 1 : 0;
+	}
+
+	template<typename T>
+	size_t getVectorSize(const vector<T>& values) {
+		return values.capacity() * sizeof(T);
+	}
+
+	// The buckets and nodes of a trigger map, not including the lane processors that it refers to
+	size_t getTriggerMapSize(const unordered_map<string, vector<shared_ptr<LaneProcessor>>>& triggers, ProcessorMemoryReport& memoryReport) {
+		size_t size = triggers.bucket_count() * sizeof(void*);
+		for (const pair<const string, vector<shared_ptr<LaneProcessor>>>& trigger : triggers) {
+			size += sizeof(void*) + sizeof(size_t) + sizeof(trigger) + getVectorSize(trigger.second);
+			memoryReport.strings += getHeapSize(trigger.first);
+		}
+		return size;
+	}
+
+	// The heap memory that is owned by the parsed script objects. Every script object type has its own
+	// overload, so a new member in the script structs only needs to be added to the overload of its struct.
+	template<typename T>
+	typename enable_if<is_arithmetic<T>::value || is_enum<T>::value, size_t>::type getHeapSize(const T&);
+	template<typename T>
+	size_t getHeapSize(const unique_ptr<T>& value);
+	template<typename T>
+	size_t getHeapSize(const vector<T>& values);
+	template<typename T1, typename T2>
+	size_t getHeapSize(const pair<T1, T2>& values);
+
+	size_t getHeapSize(const ScriptRefObject& refObject);
+	size_t getHeapSize(const ScriptPort& port);
+	size_t getHeapSize(const ScriptInput& input);
+	size_t getHeapSize(const ScriptOutput& output);
+	size_t getHeapSize(const ScriptRand& rand);
+	size_t getHeapSize(const ScriptSequence& sequence);
+	size_t getHeapSize(const ScriptSequenceValue& sequenceValue);
+	size_t getHeapSize(const ScriptTuning& tuning);
+	size_t getHeapSize(const ScriptTable& table);
+	size_t getHeapSize(const ScriptTableValue& tableValue);
+	size_t getHeapSize(const ScriptCalc& calc);
+	size_t getHeapSize(const ScriptValue& value);
+	size_t getHeapSize(const ScriptSetValue& setValue);
+	size_t getHeapSize(const ScriptSetPolyValue& setPolyValue);
+	size_t getHeapSize(const ScriptSetVariable& setVariable);
+	size_t getHeapSize(const ScriptSetPolyphony& setPolyphony);
+	size_t getHeapSize(const ScriptSetLabel& setLabel);
+	size_t getHeapSize(const ScriptIf& scriptIf);
+	size_t getHeapSize(const ScriptAssert& scriptAssert);
+	size_t getHeapSize(const ScriptMoveSequence& moveSequence);
+	size_t getHeapSize(const ScriptAddToSequence& addToSequence);
+	size_t getHeapSize(const ScriptRemoveFromSequence& removeFromSequence);
+	size_t getHeapSize(const ScriptAction& action);
+	size_t getHeapSize(const ScriptDuration& duration);
+	size_t getHeapSize(const ScriptSegment& segment);
+	size_t getHeapSize(const ScriptSegmentBlock& segmentBlock);
+	size_t getHeapSize(const ScriptLane& lane);
+	size_t getHeapSize(const ScriptTimeScale& timeScale);
+	size_t getHeapSize(const ScriptTimeline& timeline);
+	size_t getHeapSize(const ScriptInputTrigger& inputTrigger);
+	size_t getHeapSize(const Script& script);
+
+	template<typename T>
+	typename enable_if<is_arithmetic<T>::value || is_enum<T>::value, size_t>::type getHeapSize(const T&) {
+		return 0;
+	}
+
+	template<typename T>
+	size_t getHeapSize(const unique_ptr<T>& value) {
+		return value ? sizeof(T) + getHeapSize(*value) : 0;
+	}
+
+	template<typename T>
+	size_t getHeapSize(const vector<T>& values) {
+		size_t size = getVectorSize(values);
+		for (const T& value : values) {
+			size += getHeapSize(value);
+		}
+		return size;
+	}
+
+	template<typename T1, typename T2>
+	size_t getHeapSize(const pair<T1, T2>& values) {
+		return getHeapSize(values.first) + getHeapSize(values.second);
+	}
+
+	size_t getHeapSize(const ScriptRefObject& refObject) {
+		return getHeapSize(refObject.id) + getHeapSize(refObject.ref);
+	}
+
+	size_t getHeapSize(const ScriptPort& port) {
+		return getHeapSize(port.channel);
+	}
+
+	size_t getHeapSize(const ScriptInput& input) {
+		return getHeapSize(static_cast<const ScriptRefObject&>(input)) + getHeapSize(static_cast<const ScriptPort&>(input));
+	}
+
+	size_t getHeapSize(const ScriptOutput& output) {
+		return getHeapSize(static_cast<const ScriptRefObject&>(output)) + getHeapSize(static_cast<const ScriptPort&>(output));
+	}
+
+	size_t getHeapSize(const ScriptRand& rand) {
+		return getHeapSize(rand.lower) + getHeapSize(rand.upper);
+	}
+
+	size_t getHeapSize(const ScriptSequence& sequence) {
+		return getHeapSize(static_cast<const ScriptRefObject&>(sequence)) + getHeapSize(sequence.values);
+	}
+
+	size_t getHeapSize(const ScriptSequenceValue& sequenceValue) {
+		return getHeapSize(sequenceValue.id);
+	}
+
+	size_t getHeapSize(const ScriptTuning& tuning) {
+		return getHeapSize(static_cast<const ScriptRefObject&>(tuning)) + getHeapSize(tuning.notes);
+	}
+
+	size_t getHeapSize(const ScriptTable& table) {
+		return getHeapSize(static_cast<const ScriptRefObject&>(table)) + getHeapSize(table.voltages);
+	}
+
+	size_t getHeapSize(const ScriptTableValue& tableValue) {
+		return getHeapSize(tableValue.id) + getHeapSize(tableValue.position);
+	}
+
+	size_t getHeapSize(const ScriptCalc& calc) {
+		return getHeapSize(static_cast<const ScriptRefObject&>(calc)) + getHeapSize(calc.value) + getHeapSize(calc.roundType) + getHeapSize(calc.tuning) + getHeapSize(calc.signType);
+	}
+
+	size_t getHeapSize(const ScriptValue& value) {
+		return getHeapSize(static_cast<const ScriptRefObject&>(value)) +
+			getHeapSize(value.voltage) + getHeapSize(value.note) + getHeapSize(value.variable) +
+			getHeapSize(value.input) + getHeapSize(value.output) + getHeapSize(value.rand) +
+			getHeapSize(value.sequence) + getHeapSize(value.table) + getHeapSize(value.calc);
+	}
+
+	size_t getHeapSize(const ScriptSetValue& setValue) {
+		return getHeapSize(setValue.output) + getHeapSize(setValue.value);
+	}
+
+	size_t getHeapSize(const ScriptSetPolyValue& setPolyValue) {
+		return getHeapSize(setPolyValue.output) + getHeapSize(setPolyValue.values);
+	}
+
+	size_t getHeapSize(const ScriptSetVariable& setVariable) {
+		return getHeapSize(setVariable.name) + getHeapSize(setVariable.value);
+	}
+
+	size_t getHeapSize(const ScriptSetPolyphony& setPolyphony) {
+		return 0;
+	}
+
+	size_t getHeapSize(const ScriptSetLabel& setLabel) {
+		return getHeapSize(setLabel.label);
+	}
+
+	size_t getHeapSize(const ScriptIf& scriptIf) {
+		return getHeapSize(static_cast<const ScriptRefObject&>(scriptIf)) + getHeapSize(scriptIf.values) + getHeapSize(scriptIf.tolerance) + getHeapSize(scriptIf.ifs);
+	}
+
+	size_t getHeapSize(const ScriptAssert& scriptAssert) {
+		return getHeapSize(scriptAssert.name) + getHeapSize(scriptAssert.expect);
+	}
+
+	size_t getHeapSize(const ScriptMoveSequence& moveSequence) {
+		return getHeapSize(moveSequence.id) + getHeapSize(moveSequence.direction) + getHeapSize(moveSequence.position);
+	}
+
+	size_t getHeapSize(const ScriptAddToSequence& addToSequence) {
+		return getHeapSize(addToSequence.id) + getHeapSize(addToSequence.value);
+	}
+
+	size_t getHeapSize(const ScriptRemoveFromSequence& removeFromSequence) {
+		return getHeapSize(removeFromSequence.id);
+	}
+
+	size_t getHeapSize(const ScriptAction& action) {
+		return getHeapSize(static_cast<const ScriptRefObject&>(action)) + getHeapSize(action.condition) +
+			getHeapSize(action.setValue) + getHeapSize(action.setPolyValue) + getHeapSize(action.setVariable) +
+			getHeapSize(action.setPolyphony) + getHeapSize(action.setLabel) + getHeapSize(action.assert) +
+			getHeapSize(action.trigger) + getHeapSize(action.selectScript) +
+			getHeapSize(action.moveSequence) + getHeapSize(action.clearSequence) + getHeapSize(action.addToSequence) + getHeapSize(action.removeFromSequence) +
+			getHeapSize(action.startValue) + getHeapSize(action.endValue) + getHeapSize(action.startValues) + getHeapSize(action.endValues) +
+			getHeapSize(action.easeFactor) + getHeapSize(action.easeAlgorithm) + getHeapSize(action.output) + getHeapSize(action.variable) +
+			getHeapSize(action.gateHighRatio);
+	}
+
+	size_t getHeapSize(const ScriptDuration& duration) {
+		return getHeapSize(duration.samples) + getHeapSize(duration.samplesValue) +
+			getHeapSize(duration.millis) + getHeapSize(duration.millisValue) +
+			getHeapSize(duration.bars) + getHeapSize(duration.beats) + getHeapSize(duration.beatsValue) +
+			getHeapSize(duration.hz) + getHeapSize(duration.hzValue);
+	}
+
+	size_t getHeapSize(const ScriptSegment& segment) {
+		return getHeapSize(static_cast<const ScriptRefObject&>(segment)) + getHeapSize(segment.duration) + getHeapSize(segment.actions) + getHeapSize(segment.segmentBlock);
+	}
+
+	size_t getHeapSize(const ScriptSegmentBlock& segmentBlock) {
+		return getHeapSize(static_cast<const ScriptRefObject&>(segmentBlock)) + getHeapSize(segmentBlock.repeat) + getHeapSize(segmentBlock.segments);
+	}
+
+	size_t getHeapSize(const ScriptLane& lane) {
+		return getHeapSize(lane.startTrigger) + getHeapSize(lane.restartTrigger) + getHeapSize(lane.stopTrigger) + getHeapSize(lane.segments);
+	}
+
+	size_t getHeapSize(const ScriptTimeScale& timeScale) {
+		return getHeapSize(timeScale.sampleRate) + getHeapSize(timeScale.bpm) + getHeapSize(timeScale.bpb);
+	}
+
+	size_t getHeapSize(const ScriptTimeline& timeline) {
+		return getHeapSize(timeline.timeScale) + getHeapSize(timeline.lanes);
+	}
+
+	size_t getHeapSize(const ScriptInputTrigger& inputTrigger) {
+		return getHeapSize(inputTrigger.id) + getHeapSize(inputTrigger.input);
+	}
+
+	size_t getHeapSize(const Script& script) {
+		return getHeapSize(script.type) + getHeapSize(script.version) +
+			getHeapSize(script.timelines) + getHeapSize(script.globalActions) + getHeapSize(script.inputTriggers) +
+			getHeapSize(script.segmentBlocks) + getHeapSize(script.segments) + getHeapSize(script.inputs) + getHeapSize(script.outputs) +
+			getHeapSize(script.calcs) + getHeapSize(script.values) + getHeapSize(script.actions) + getHeapSize(script.ifs) +
+			getHeapSize(script.tunings) + getHeapSize(script.tables) + getHeapSize(script.sequences);
+	}
+
+	string formatBytes(size_t bytes) {
+		ostringstream text;
+		if (bytes < 1024) {
+			text << bytes << " bytes";
+		} else if (bytes < 1024 * 1024) {
+			text << fixed << setprecision(1) << (bytes / 1024.) << " kB";
+		} else {
+			text << fixed << setprecision(1) << (bytes / (1024. * 1024.)) << " MB";
+		}
+		return text.str();
+	}
+}
+
+
+size_t ProcessorMemoryReport::getTotal() const {
+	return processors + values + strings + sequences + recordings + script;
+}
+
+vector<string> ProcessorMemoryReport::describe() const {
+	vector<string> lines;
+	lines.push_back("Processors: " + formatBytes(processors));
+	lines.push_back("Values and calcs: " + formatBytes(values));
+	lines.push_back("Strings: " + formatBytes(strings));
+	lines.push_back("Sequences: " + formatBytes(sequences));
+	lines.push_back("Segment recordings: " + formatBytes(recordings));
+	lines.push_back("Parsed script: " + formatBytes(script));
+	lines.push_back("Total: " + formatBytes(getTotal()));
+	return lines;
+}
+
+bool ProcessorMemoryReport::addObject(const void* object) {
+	return m_objects.insert(object).second;
+}
+
+void ProcessorMemoryReport::clearObjects() {
+	m_objects.clear();
+}
+
+void CalcProcessor::addMemory(ProcessorMemoryReport& memoryReport) const {
+	if (memoryReport.addObject(this)) {
+		addCalcMemory(memoryReport);
+	}
+}
+
+void CalcProcessor::addCalcMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.values += getSharedObjectSize(this);
+}
+
+void CalcValueProcessor::addCalcMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.values += getSharedObjectSize(this);
+	m_value->addMemory(memoryReport);
+}
+
+void CalcFracProcessor::addCalcMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.values += getSharedObjectSize(this);
+}
+
+void CalcRoundProcessor::addCalcMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.values += getSharedObjectSize(this);
+}
+
+void CalcQuantizeProcessor::addCalcMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.values += getSharedObjectSize(this) + m_quantizer.getMemorySize();
+}
+
+void CalcSignProcessor::addCalcMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.values += getSharedObjectSize(this);
+}
+
+void CalcVtoFProcessor::addCalcMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.values += getSharedObjectSize(this);
+}
+
+void RandValueGenerator::addMemory(ProcessorMemoryReport& memoryReport) const {
+	if (memoryReport.addObject(this)) {
+		memoryReport.values += getSharedObjectSize(this);
+	}
+}
+
+void SequenceProcessor::addMemory(ProcessorMemoryReport& memoryReport) const {
+	if (!memoryReport.addObject(this)) {
+		return;
+	}
+
+	memoryReport.sequences += getSharedObjectSize(this) + getVectorSize(m_values);
+	memoryReport.strings += getHeapSize(m_id);
+	for (const shared_ptr<ValueProcessor>& value : m_values) {
+		value->addMemory(memoryReport);
+	}
+}
+
+void SequencePositionProcessor::addMemory(ProcessorMemoryReport& memoryReport) const {
+	if (!memoryReport.addObject(this)) {
+		return;
+	}
+
+	memoryReport.sequences += getSharedObjectSize(this);
+	m_sequenceProcessor->addMemory(memoryReport);
+	m_randValueGenerator->addMemory(memoryReport);
+}
+
+void ValueProcessor::addMemory(ProcessorMemoryReport& memoryReport) const {
+	if (!memoryReport.addObject(this)) {
+		return;
+	}
+
+	addValueMemory(memoryReport);
+	memoryReport.values += getVectorSize(m_calcProcessors);
+	for (const shared_ptr<CalcProcessor>& calcProcessor : m_calcProcessors) {
+		calcProcessor->addMemory(memoryReport);
+	}
+}
+
+void ValueProcessor::addValueMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.values += getSharedObjectSize(this);
+}
+
+void StaticValueProcessor::addValueMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.values += getSharedObjectSize(this);
+}
+
+void VariableValueProcessor::addValueMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.values += getSharedObjectSize(this);
+	memoryReport.strings += getHeapSize(m_name);
+}
+
+void InputValueProcessor::addValueMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.values += getSharedObjectSize(this);
+}
+
+void OutputValueProcessor::addValueMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.values += getSharedObjectSize(this);
+}
+
+void RandValueProcessor::addValueMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.values += getSharedObjectSize(this);
+	m_lowerValue->addMemory(memoryReport);
+	m_upperValue->addMemory(memoryReport);
+	m_randValueGenerator->addMemory(memoryReport);
+}
+
+void SequenceValueProcessor::addValueMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.values += getSharedObjectSize(this);
+	m_sequencePositionProcessor->addMemory(memoryReport);
+}
+
+void TableValueProcessor::addValueMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.values += getSharedObjectSize(this) + getVectorSize(m_voltages);
+	m_position->addMemory(memoryReport);
+}
+
+void IfProcessor::addMemory(ProcessorMemoryReport& memoryReport) const {
+	if (!memoryReport.addObject(this)) {
+		return;
+	}
+
+	memoryReport.processors += getSharedObjectSize(this) + getVectorSize(m_ifs);
+	if (m_values.first) {
+		m_values.first->addMemory(memoryReport);
+	}
+	if (m_values.second) {
+		m_values.second->addMemory(memoryReport);
+	}
+	for (const shared_ptr<IfProcessor>& ifProcessor : m_ifs) {
+		ifProcessor->addMemory(memoryReport);
+	}
+}
+
+void ActionProcessor::addMemory(ProcessorMemoryReport& memoryReport) const {
+	if (!memoryReport.addObject(this)) {
+		return;
+	}
+
+	addActionMemory(memoryReport);
+	if (m_ifProcessor) {
+		m_ifProcessor->addMemory(memoryReport);
+	}
+}
+
+void ActionProcessor::addActionMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.processors += getSharedObjectSize(this);
+}
+
+void ActionSetValueProcessor::addActionMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.processors += getSharedObjectSize(this);
+	m_value->addMemory(memoryReport);
+}
+
+void ActionSetPolyValueProcessor::addActionMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.processors += getSharedObjectSize(this) + getVectorSize(m_values);
+	for (const shared_ptr<ValueProcessor>& value : m_values) {
+		value->addMemory(memoryReport);
+	}
+}
+
+void ActionSetVariableProcessor::addActionMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.processors += getSharedObjectSize(this);
+	memoryReport.strings += getHeapSize(m_name);
+	m_value->addMemory(memoryReport);
+}
+
+void ActionSetPolyphonyProcessor::addActionMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.processors += getSharedObjectSize(this);
+}
+
+void ActionSetLabelProcessor::addActionMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.processors += getSharedObjectSize(this);
+	memoryReport.strings += getHeapSize(m_label);
+}
+
+void ActionAssertProcessor::addActionMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.processors += getSharedObjectSize(this);
+	memoryReport.strings += getHeapSize(m_name);
+	m_expect->addMemory(memoryReport);
+}
+
+void ActionTriggerProcessor::addActionMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.processors += getSharedObjectSize(this);
+	memoryReport.strings += getHeapSize(m_trigger);
+}
+
+void ActionSelectScriptProcessor::addActionMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.processors += getSharedObjectSize(this);
+}
+
+void ActionMoveSequenceDirectionProcessor::addActionMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.processors += getSharedObjectSize(this);
+	m_sequencePositionProcessor->addMemory(memoryReport);
+}
+
+void ActionMoveSequencePositionProcessor::addActionMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.processors += getSharedObjectSize(this);
+	m_sequencePositionProcessor->addMemory(memoryReport);
+}
+
+void ActionClearSequenceProcessor::addActionMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.processors += getSharedObjectSize(this);
+	m_sequencePositionProcessor->addMemory(memoryReport);
+}
+
+void ActionAddToSequenceSequenceProcessor::addActionMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.processors += getSharedObjectSize(this);
+	m_sequencePositionProcessor->addMemory(memoryReport);
+	m_value->addMemory(memoryReport);
+}
+
+void ActionRemoveFromSequenceProcessor::addActionMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.processors += getSharedObjectSize(this);
+	m_sequencePositionProcessor->addMemory(memoryReport);
+}
+
+void ActionOngoingProcessor::addMemory(ProcessorMemoryReport& memoryReport) const {
+	if (!memoryReport.addObject(this)) {
+		return;
+	}
+
+	addActionMemory(memoryReport);
+	if (m_ifProcessor) {
+		m_ifProcessor->addMemory(memoryReport);
+	}
+}
+
+void ActionOngoingProcessor::addActionMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.processors += getSharedObjectSize(this);
+}
+
+void ActionGlideProcessor::addActionMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.processors += getSharedObjectSize(this);
+	memoryReport.strings += getHeapSize(m_variable);
+	m_startValueProcessor->addMemory(memoryReport);
+	m_endValueProcessor->addMemory(memoryReport);
+}
+
+void ActionGlidePolyProcessor::addActionMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.processors += getSharedObjectSize(this) + getVectorSize(m_startValueProcessors) + getVectorSize(m_endValueProcessors);
+	for (const shared_ptr<ValueProcessor>& value : m_startValueProcessors) {
+		value->addMemory(memoryReport);
+	}
+	for (const shared_ptr<ValueProcessor>& value : m_endValueProcessors) {
+		value->addMemory(memoryReport);
+	}
+}
+
+void ActionGateProcessor::addActionMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.processors += getSharedObjectSize(this);
+}
+
+void DurationProcessor::addMemory(ProcessorMemoryReport& memoryReport) const {
+	if (memoryReport.addObject(this)) {
+		addDurationMemory(memoryReport);
+	}
+}
+
+void DurationProcessor::addDurationMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.processors += getSharedObjectSize(this);
+}
+
+void DurationConstantProcessor::addDurationMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.processors += getSharedObjectSize(this);
+}
+
+void DurationVariableFactorProcessor::addDurationMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.processors += getSharedObjectSize(this);
+	m_value->addMemory(memoryReport);
+}
+
+void DurationVariableHzProcessor::addDurationMemory(ProcessorMemoryReport& memoryReport) const {
+	memoryReport.processors += getSharedObjectSize(this);
+	m_value->addMemory(memoryReport);
+}
+
+size_t SegmentRecording::getMemorySize() const {
+	// The recording is allocated when the script is loaded, so this is also the memory of a fully recorded run
+	return getVectorSize(m_steps) + getVectorSize(m_writes) + getVectorSize(m_voltages);
+}
+
+void SegmentProcessor::addMemory(ProcessorMemoryReport& memoryReport) const {
+	if (!memoryReport.addObject(this)) {
+		return;
+	}
+
+	memoryReport.processors += getSharedObjectSize(this) + getVectorSize(m_startActions) + getVectorSize(m_endActions) + getVectorSize(m_ongoingActions);
+	m_duration->addMemory(memoryReport);
+	for (const shared_ptr<ActionProcessor>& action : m_startActions) {
+		action->addMemory(memoryReport);
+	}
+	for (const shared_ptr<ActionProcessor>& action : m_endActions) {
+		action->addMemory(memoryReport);
+	}
+	for (const shared_ptr<ActionOngoingProcessor>& action : m_ongoingActions) {
+		action->addMemory(memoryReport);
+	}
+
+	if (m_outputRecorder && memoryReport.addObject(m_outputRecorder.get())) {
+		memoryReport.processors += getSharedObjectSize(m_outputRecorder.get());
+	}
+	if (m_recordOutputs) {
+		memoryReport.recordings += m_recording.getMemorySize();
+	}
+}
+
+void LaneProcessor::addMemory(ProcessorMemoryReport& memoryReport) const {
+	if (!memoryReport.addObject(this)) {
+		return;
+	}
+
+	memoryReport.processors += getSharedObjectSize(this) + getVectorSize(m_segments);
+	for (const shared_ptr<SegmentProcessor>& segment : m_segments) {
+		segment->addMemory(memoryReport);
+	}
+}
+
+void TimelineProcessor::addMemory(ProcessorMemoryReport& memoryReport) const {
+	if (!memoryReport.addObject(this)) {
+		return;
+	}
+
+	memoryReport.processors += getSharedObjectSize(this) + getVectorSize(m_lanes);
+	memoryReport.processors += getTriggerMapSize(m_startTriggers, memoryReport) + getTriggerMapSize(m_stopTriggers, memoryReport);
+	for (const shared_ptr<LaneProcessor>& lane : m_lanes) {
+		lane->addMemory(memoryReport);
+	}
+}
+
+void TriggerProcessor::addMemory(ProcessorMemoryReport& memoryReport) const {
+	if (!memoryReport.addObject(this)) {
+		return;
+	}
+
+	memoryReport.processors += getSharedObjectSize(this);
+	for (const vector<string>& ids : m_ids) {
+		memoryReport.processors += getVectorSize(ids);
+		for (const string& id : ids) {
+			memoryReport.strings += getHeapSize(id);
+		}
+	}
+}
+
+ProcessorMemoryReport Processor::getMemoryReport() const {
+	ProcessorMemoryReport memoryReport;
+
+	memoryReport.processors += getSharedObjectSize(this) + getVectorSize(m_timelines) + getVectorSize(m_triggers) + getVectorSize(m_startActions);
+	for (const shared_ptr<TimelineProcessor>& timeline : m_timelines) {
+		timeline->addMemory(memoryReport);
+	}
+	for (const shared_ptr<TriggerProcessor>& trigger : m_triggers) {
+		trigger->addMemory(memoryReport);
+	}
+	for (const shared_ptr<ActionProcessor>& action : m_startActions) {
+		action->addMemory(memoryReport);
+	}
+
+	if (m_script) {
+		memoryReport.script += getSharedObjectSize(m_script.get()) + getHeapSize(*m_script);
+	}
+
+	memoryReport.clearObjects();
+	return memoryReport;
+}
@@ -0,0 +1,70 @@
+#ifdef __NT_TIMESEQ_PROFILING__
+
+#include "core/timeseq-processor.hpp"
+#include "core/timeseq-script.hpp"
+#include <unordered_set>
+
+using namespace std;
+using namespace timeseq;
+
+
+const ScriptSegment* SegmentProcessor::getScriptSegment() const {
+	return m_scriptSegment;
+}
+
+const ProfilerCounter& SegmentProcessor::getProfilerCounter() const {
+	return m_profilerCounter;
+}
+
+const vector<shared_ptr<SegmentProcessor>>& LaneProcessor::getSegments() const {
+	return m_segments;
+}
+
+const ProfilerCounter& LaneProcessor::getProfilerCounter() const {
+	return m_profilerCounter;
+}
+
+const vector<shared_ptr<LaneProcessor>>& TimelineProcessor::getLanes() const {
+	return m_lanes;
+}
+
+vector<ProfilerEntry> Processor::getProfile() const {
+	vector<ProfilerEntry> laneEntries;
+	vector<ProfilerEntry> segmentEntries;
+	// Segments with an id are grouped under that id, other segments are identified by their (processed) location
+	unordered_map<string, int> segmentEntryIndexes;
+	// The same segment instance can be used multiple times in a lane (e.g. in repeated segment blocks), but should only be counted once
+	unordered_set<const SegmentProcessor*> countedSegments;
+
+	for (unsigned int i = 0; i < m_timelines.size(); i++) {
+		const vector<shared_ptr<LaneProcessor>>& lanes = m_timelines[i]->getLanes();
+		for (unsigned int j = 0; j < lanes.size(); j++) {
+			string laneName = "/timelines/" + to_string(i) + "/lanes/" + to_string(j);
+			const ProfilerCounter& laneCounter = lanes[j]->getProfilerCounter();
+			laneEntries.push_back({ laneName, laneCounter.invocations.load(memory_order_relaxed), laneCounter.getEstimatedNanos() });
+
+			const vector<shared_ptr<SegmentProcessor>>& segments = lanes[j]->getSegments();
+			for (unsigned int k = 0; k < segments.size(); k++) {
+				if (countedSegments.insert(segments[k].get()).second) {
+					const string& id = segments[k]->getScriptSegment()->id;
+					string segmentName = id.size() > 0 ? "segment '" + id + "'" : laneName + "/segments/" + to_string(k);
+					const ProfilerCounter& segmentCounter = segments[k]->getProfilerCounter();
+
+					unordered_map<string, int>::iterator entryIndex = segmentEntryIndexes.find(segmentName);
+					if (entryIndex == segmentEntryIndexes.end()) {
+						segmentEntryIndexes[segmentName] = segmentEntries.size();
+						segmentEntries.push_back({ segmentName, segmentCounter.invocations.load(memory_order_relaxed), segmentCounter.getEstimatedNanos() });
+					} else {
+						segmentEntries[entryIndex->second].invocations += segmentCounter.invocations.load(memory_order_relaxed);
+						segmentEntries[entryIndex->second].nanos += segmentCounter.getEstimatedNanos();
+					}
+				}
+			}
+		}
+	}
+
+	laneEntries.insert(laneEntries.end(), segmentEntries.begin(), segmentEntries.end());
+	return laneEntries;
+}
+
+#endif
@@ -1,6 +1,8 @@
 #include "core/timeseq-processor.hpp"
 #include "core/timeseq-script.hpp"
 #include "core/timeseq-core.hpp"
+#include "core/timeseq-tracer.hpp"
+#include <algorithm>
 
 using namespace std;
 using namespace timeseq;
@@ -11,7 +13,10 @@ SegmentProcessor::SegmentProcessor(const SegmentProcessor& segmentProcessor) :
 	m_startActions(segmentProcessor.m_startActions),
 	m_endActions(segmentProcessor.m_endActions),
 	m_ongoingActions(segmentProcessor.m_ongoingActions),
-	m_eventListener(segmentProcessor.m_eventListener) {
+	m_eventListener(segmentProcessor.m_eventListener),
+	m_eventTracer(segmentProcessor.m_eventTracer),
+	m_outputRecorder(segmentProcessor.m_outputRecorder),
+	m_recordOutputs(segmentProcessor.m_recordOutputs) {
 }
 
 SegmentProcessor::SegmentProcessor(
@@ -20,49 +25,96 @@ SegmentProcessor::SegmentProcessor(
 	const vector<shared_ptr<ActionProcessor>>& startActions,
 	const vector<shared_ptr<ActionProcessor>>& endActions,
 	const vector<shared_ptr<ActionOngoingProcessor>>& ongoingActions,
-	EventListener* eventListener) :
-		m_scriptSegment(scriptSegment), m_duration(duration), m_startActions(startActions), m_endActions(endActions), m_ongoingActions(ongoingActions), m_eventListener(eventListener) {}
+	EventListener* eventListener,
+	EventTracer* eventTracer) :
+		m_scriptSegment(scriptSegment), m_duration(duration), m_startActions(startActions), m_endActions(endActions), m_ongoingActions(ongoingActions), m_eventListener(eventListener), m_eventTracer(eventTracer) {}
 
 void SegmentProcessor::pushStartActions(const vector<shared_ptr<ActionProcessor>>& startActions) {
 	m_startActions.insert(m_startActions.begin(), startActions.begin(), startActions.end());
+	m_recordOutputs = false;
 }
 
 void SegmentProcessor::pushEndActions(const vector<shared_ptr<ActionProcessor>>& endActions) {
 	m_endActions.insert(m_endActions.end(), endActions.begin(), endActions.end());
+	m_recordOutputs = false;
+}
+
+void SegmentProcessor::setOutputRecorder(const shared_ptr<OutputRecorder>& outputRecorder, size_t writes, size_t voltages) {
+	m_outputRecorder = outputRecorder;
+	m_recordOutputs = true;
+	m_recording.allocate(m_duration->getDuration(), writes, voltages);
 }
 
 DurationProcessor::DurationState SegmentProcessor::getState() {
 	return m_duration->getState();
 }
 
+DurationProcessor* SegmentProcessor::getDurationProcessor() {
+	return m_duration.get();
+}
+
 double SegmentProcessor::process(double drift) {
+	TIMESEQ_PROFILE(m_profilerCounter);
 	bool starting = false;
+	// Once a full run of the segment is recorded, the recorded voltages are used instead of processing the actions
+	bool replaying = (m_recordOutputs) && (m_recording.isComplete());
+	bool recording = (m_recordOutputs) && (!replaying);
 
 	// Trigger the start actions if we're at the start of the segment
 	if (m_duration->getState() == DurationProcessor::DurationState::STATE_START) {
 		if (!m_scriptSegment->disableUi) {
 			m_eventListener->segmentStarted();
 		}
-		processStartActions();
+		if (m_eventTracer) {
+			m_eventTracer->record(TraceEventType::SEGMENT_START, this, m_scriptSegment->id);
+		}
+		if (recording) {
+			// Any partial recording of an interrupted run is discarded
+			m_recording.clear();
+			m_outputRecorder->startRecording(&m_recording, 0);
+		}
+		if (!replaying) {
+			processStartActions();
+		}
 		m_duration->prepareForStart();
 		starting = true; // The glide actions will have to be processed from their start position.
 	}
 
 	drift = m_duration->process(drift);
 
+	if (replaying) {
+		m_outputRecorder->replay(m_recording, starting ? 0 : m_duration->getPosition());
+	} else if ((recording) && (!starting)) {
+		m_outputRecorder->startRecording(&m_recording, m_duration->getPosition());
+	}
+
 	switch (m_duration->getState()) {
 		case DurationProcessor::DurationState::STATE_START:
 			// Shouldn't occur since duration processing will move us away from the start state
 			break;
 		case DurationProcessor::DurationState::STATE_PROGRESS:
-			processOngoingActions(starting, false);
+			if (!replaying) {
+				processOngoingActions(starting, false);
+			}
 			break;
 		case DurationProcessor::DurationState::STATE_END:
-			processOngoingActions(starting, true);
-			processEndActions();
+			if (!replaying) {
+				processOngoingActions(starting, true);
+				processEndActions();
+			}
+			if (recording) {
+				m_recording.complete();
+			}
+			if (m_eventTracer) {
+				m_eventTracer->record(TraceEventType::SEGMENT_END, this, m_scriptSegment->id);
+			}
 			break;
 	}
 
+	if (recording) {
+		m_outputRecorder->stopRecording();
+	}
+
 	return drift;
 }
 
@@ -70,6 +122,38 @@ void SegmentProcessor::reset() {
 	m_duration->reset();
 }
 
+double SegmentProcessor::seek(uint64_t samples, double drift) {
+	// Landing on the start of the segment is left to the regular processing
+	if (samples == 0) {
+		return drift;
+	}
+
+	bool replaying = (m_recordOutputs) && (m_recording.isComplete());
+	if (!replaying) {
+		if (m_recordOutputs) {
+			// The recording must cover a full run of the segment, so this run can't be recorded
+			m_recording.discard();
+		}
+		processStartActions();
+	}
+
+	m_duration->prepareForStart();
+	drift = m_duration->seek(samples, drift);
+
+	if (replaying) {
+		// The recording only contains the changes of each step, so replay all steps up to the current position
+		for (uint64_t step = 0; step <= m_duration->getPosition(); step++) {
+			m_outputRecorder->replay(m_recording, step);
+		}
+	} else {
+		for (const shared_ptr<ActionOngoingProcessor>& actionProcessor : m_ongoingActions) {
+			actionProcessor->start(m_duration->getDuration());
+		}
+	}
+
+	return drift;
+}
+
 void SegmentProcessor::processStartActions() {
 	for (const shared_ptr<ActionProcessor>& actionProcessor : m_startActions) {
 		actionProcessor->process();
@@ -96,6 +180,118 @@ void SegmentProcessor::processOngoingActions(bool start, bool end) {
 	}
 }
 
+void SegmentRecording::allocate(uint64_t duration, size_t writes, size_t voltages) {
+	m_steps.assign(duration + 1, Step());
+	m_writes.reserve(writes);
+	m_voltages.reserve(voltages);
+	clear();
+}
+
+void SegmentRecording::clear() {
+	m_complete = false;
+	m_discarded = false;
+	m_step = 0;
+	fill(m_steps.begin(), m_steps.end(), Step());
+	m_writes.clear();
+	m_voltages.clear();
+}
+
+bool SegmentRecording::startStep(uint64_t step) {
+	if ((m_discarded) || (m_steps[step].recorded)) {
+		return false;
+	}
+
+	m_step = step;
+	m_steps[step].recorded = true;
+	m_steps[step].begin = m_writes.size();
+	m_steps[step].end = m_writes.size();
+	return true;
+}
+
+void SegmentRecording::addVoltages(int index, int channel, const float* voltages, int count, bool poly) {
+	// Recording must not allocate, so a run that doesn't fit in the allocated recording can't be recorded
+	if ((m_writes.size() == m_writes.capacity()) || (m_voltages.size() + count > m_voltages.capacity())) {
+		m_discarded = true;
+		return;
+	}
+
+	m_writes.push_back({ index, channel, count, poly, (uint32_t) m_voltages.size() });
+	m_voltages.insert(m_voltages.end(), voltages, voltages + count);
+	m_steps[m_step].end = m_writes.size();
+}
+
+void SegmentRecording::complete() {
+	m_complete = !m_discarded;
+}
+
+bool SegmentRecording::isComplete() const {
+	return m_complete;
+}
+
+void SegmentRecording::discard() {
+	m_discarded = true;
+}
+
+void SegmentRecording::replay(uint64_t step, const PortBinding& portHandler) const {
+	const Step& recordedStep = m_steps[step];
+	for (uint32_t i = recordedStep.begin; i < recordedStep.end; i++) {
+		const Voltages& write = m_writes[i];
+		if (write.poly) {
+			portHandler.setOutputPortVoltages(write.index, write.channel, m_voltages.data() + write.offset, write.count);
+		} else {
+			portHandler.setOutputPortVoltage(write.index, write.channel, m_voltages[write.offset]);
+		}
+	}
+}
+
+OutputRecorder::OutputRecorder(PortHandler* portHandler) : m_portHandler(portHandler) {}
+
+float OutputRecorder::getInputPortVoltage(int index, int channel) const {
+	return m_portHandler.getInputPortVoltage(index, channel);
+}
+
+void OutputRecorder::getInputPortVoltages(int index, float* voltages, uint16_t channelMask) const {
+	m_portHandler.getInputPortVoltages(index, voltages, channelMask);
+}
+
+float OutputRecorder::getOutputPortVoltage(int index, int channel) const {
+	return m_portHandler.getOutputPortVoltage(index, channel);
+}
+
+void OutputRecorder::setOutputPortVoltage(int index, int channel, float voltage) {
+	m_portHandler.setOutputPortVoltage(index, channel, voltage);
+	if (m_recording) {
+		m_recording->addVoltages(index, channel, &voltage, 1, false);
+	}
+}
+
+void OutputRecorder::setOutputPortVoltages(int index, int channel, const float* voltages, int count) {
+	m_portHandler.setOutputPortVoltages(index, channel, voltages, count);
+	if (m_recording) {
+		m_recording->addVoltages(index, channel, voltages, count, true);
+	}
+}
+
+void OutputRecorder::setOutputPortChannels(int index, int channels) {
+	m_portHandler.setOutputPortChannels(index, channels);
+}
+
+void OutputRecorder::setOutputPortLabel(int index, const string& label) {
+	m_portHandler.setOutputPortLabel(index, label);
+}
+
+void OutputRecorder::startRecording(SegmentRecording* recording, uint64_t step) {
+	m_recording = recording->startStep(step) ? recording : nullptr;
+}
+
+void OutputRecorder::stopRecording() {
+	m_recording = nullptr;
+}
+
+void OutputRecorder::replay(const SegmentRecording& recording, uint64_t step) {
+	recording.replay(step, m_portHandler);
+}
+
 DurationProcessor::DurationState DurationProcessor::getState() {
 	return m_state;
 }
@@ -108,6 +304,10 @@ uint64_t DurationProcessor::getDuration() {
 	return m_duration;
 }
 
+double DurationProcessor::getDrift() {
+	return m_drift;
+}
+
 double DurationProcessor::process(double drift) {
 	if (m_state == DurationState::STATE_START) {
 		m_position = 0;
@@ -136,6 +336,14 @@ void DurationProcessor::reset() {
 	m_position = 0;
 }
 
+double DurationProcessor::seek(uint64_t samples, double drift) {
+	// The first sample moves away from the start, each further sample either moves one position
+	// ahead or (once at the last position before the end) corrects one step of the drift
+	m_state = DurationState::STATE_PROGRESS;
+	m_position = min(samples, m_duration - 1);
+	return drift + m_drift - (samples - m_position);
+}
+
 void DurationProcessor::setDuration(uint64_t duration) {
 	m_duration = duration;
 }
@@ -1,11 +1,12 @@
 #include "core/timeseq-processor.hpp"
 #include "core/timeseq-script.hpp"
 #include "core/timeseq-core.hpp"
+#include "util/fastmath.hpp"
 
 using namespace std;
 using namespace timeseq;
 
-CalcValueProcessor::CalcValueProcessor(const ScriptCalc *scriptCalc, const shared_ptr<ValueProcessor>& value) : m_value(value) {
+CalcValueProcessor::CalcValueProcessor(const ScriptCalc *scriptCalc, const shared_ptr<ValueProcessor>& value, bool fastMath) : m_value(value), m_fastMath(fastMath) {
 	switch (scriptCalc->operation) {
 		case ScriptCalc::ADD:
 			m_operation = ValueCalcOperation::ADD;
@@ -61,7 +62,7 @@ double CalcValueProcessor::calc(double value) {
 			return value < calcValue ? value : calcValue;
 		case ValueCalcOperation::REMAIN:
 			if (calcValue != 0.f) {
-				return fmod(value, calcValue);
+				return m_fastMath ? fastFmod(value, calcValue) : fmod(value, calcValue);
 			} else {
 				return 0.f;
 			}
@@ -75,7 +76,13 @@ double CalcTruncProcessor::calc(double value) {
 	return trunc(value);
 }
 
+CalcFracProcessor::CalcFracProcessor(bool fastMath) : m_fastMath(fastMath) {}
+
 double CalcFracProcessor::calc(double value) {
+	if (m_fastMath) {
+		return fastFrac(value);
+	}
+
 	double x;
 	return modf(value, &x);
 }
@@ -96,48 +103,10 @@ double CalcRoundProcessor::calc(double value) {
 	return value;
 }
 
-CalcQuantizeProcessor::CalcQuantizeProcessor(const ScriptTuning* scriptTuning) {
-	vector<float> tuningValues;
-
-	if (scriptTuning->notes.size() == 1) {
-		// If there is only one note in the tuning, add the note one octave lower, the note itself, and the note one octave higher
-		tuningValues.push_back(scriptTuning->notes[0] - 1.f);
-		tuningValues.push_back(scriptTuning->notes[0]);
-		tuningValues.push_back(scriptTuning->notes[0] + 1.f);
-	} else {
-		// First create a list of all the tuning notes with the last one added at the front one octave lower
-		// And the first one added at the back one octave higher
-		tuningValues.push_back(scriptTuning->notes.back() - 1.f);
-		tuningValues.insert(tuningValues.end(), scriptTuning->notes.begin(), scriptTuning->notes.end());
-		tuningValues.push_back(scriptTuning->notes.front() + 1.f);
-	}
-
-	// Based on the tuningValues list, determine all the quantization points as being halfway between each tuning value
-	for (unsigned int i = 0; i < tuningValues.size() - 1; i++) {
-		float boundary = tuningValues[i] + ((tuningValues[i + 1] - tuningValues[i]) / 2.f);
-		m_quantizeValues.push_back({ boundary, tuningValues[i] });
-	}
-	// Add in the last tuningValue entry as a round-up entry
-	m_quantizeValues.push_back({ 2.f, tuningValues.back()});
-}
+CalcQuantizeProcessor::CalcQuantizeProcessor(const ScriptTuning* scriptTuning) : m_quantizer(scriptTuning->notes) {}
 
 double CalcQuantizeProcessor::calc(double value) {
-	float integral;
-	float fract = modf(value, &integral);
-
-	if (fract < 0.f) {
-		fract += 1.f;
-		integral -= 1.f;
-	}
-
-	for (vector<array<float, 2>>::iterator it = m_quantizeValues.begin(); it != m_quantizeValues.end(); it++) {
-		if (fract < (*it)[0]) {
-			return integral + (*it)[1];
-		}
-	}
-
-	// Shouldn't reach this point...
-	return value;
+	return m_quantizer.quantize((float) value);
 }
 
 CalcSignProcessor::CalcSignProcessor(const ScriptCalc* scriptCalc) : m_positive(*scriptCalc->signType == ScriptCalc::SignType::POS) {}
@@ -150,7 +119,13 @@ double CalcSignProcessor::calc(double value) {
 	}
 }
 
+CalcVtoFProcessor::CalcVtoFProcessor(bool fastMath) : m_fastMath(fastMath) {}
+
 double CalcVtoFProcessor::calc(double value) {
+	if (m_fastMath) {
+		return fastExp2((float) value) * 261.6256f;
+	}
+
 	return pow(2, value) * 261.6256f;
 }
 
@@ -170,42 +145,8 @@ double ValueProcessor::process() {
 	return value;
 }
 
-// The quantizing thresholds within an octave for quantizing to the nearest note.
-// The first value is halfway between two quantized notes, the second value is the quantized note that is below it.
-// Any value that is below the first value should be quantized down to the note that's in the second value.
-const float quantize_thresholds[][2] = {
-	{ 1.f / 24, 0.f }, // C
-	{ (1.f / 12) + (1.f / 24), (1.f / 12) }, // C#
-	{ (2.f / 12) + (1.f / 24), (2.f / 12) }, // D
-	{ (3.f / 12) + (1.f / 24), (3.f / 12) }, // Eb
-	{ (4.f / 12) + (1.f / 24), (4.f / 12) }, // E
-	{ (5.f / 12) + (1.f / 24), (5.f / 12) }, // F
-	{ (6.f / 12) + (1.f / 24), (6.f / 12) }, // F#
-	{ (7.f / 12) + (1.f / 24), (7.f / 12) }, // G
-	{ (8.f / 12) + (1.f / 24), (8.f / 12) }, // Ab
-	{ (9.f / 12) + (1.f / 24), (9.f / 12) }, // A
-	{ (10.f / 12) + (1.f / 24), (10.f / 12) }, // Bb
-	{ (11.f / 12) + (1.f / 24), (11.f / 12) }, // B
-	{ 1.f, 1.f }, // C
-};
-
 double ValueProcessor::quantize(double value) {
-	double octave;
-	double note = modf(value, &octave);
-
-	if (note < 0.f) {
-		note += 1.f;
-		octave -= 1;
-	}
-
-	for (int i = 0; i < 13; i++) {
-		if (note < quantize_thresholds[i][0]) {
-			note = quantize_thresholds[i][1];
-			break;
-		}
-	}
-
-	return octave + note;
+	return Quantizer::chromatic().quantize(value);
 }
 
 StaticValueProcessor::StaticValueProcessor(float value, const vector<shared_ptr<CalcProcessor>>& calcProcessors, bool quantize) : ValueProcessor(calcProcessors, quantize), m_value(value) {}
@@ -223,31 +164,33 @@ double VariableValueProcessor::processValue() {
 InputValueProcessor::InputValueProcessor(int inputPort, int inputChannel, const vector<shared_ptr<CalcProcessor>>& calcProcessors, bool quantize, PortHandler* portHandler) : ValueProcessor(calcProcessors, quantize), m_inputPort(inputPort), m_inputChannel(inputChannel), m_portHandler(portHandler) {}
 
 double InputValueProcessor::processValue() {
-	return m_portHandler->getInputPortVoltage(m_inputPort, m_inputChannel);
+	return m_portHandler.getInputPortVoltage(m_inputPort, m_inputChannel);
 }
 
 OutputValueProcessor::OutputValueProcessor(int outputPort, int outputChannel, const vector<shared_ptr<CalcProcessor>>& calcProcessors, bool quantize, PortHandler* portHandler) : ValueProcessor(calcProcessors, quantize), m_outputPort(outputPort), m_outputChannel(outputChannel), m_portHandler(portHandler) {}
 
 double OutputValueProcessor::processValue() {
-	return m_portHandler->getOutputPortVoltage(m_outputPort, m_outputChannel);
+	return m_portHandler.getOutputPortVoltage(m_outputPort, m_outputChannel);
 }
 
-RandValueGenerator::RandValueGenerator() : m_generator(chrono::steady_clock::now().time_since_epoch().count()) {}
+RandValueGenerator::RandValueGenerator() {}
 RandValueGenerator::~RandValueGenerator() {}
 
 float RandValueGenerator::generate(float lower, float upper) {
-	// uniform_real_distribution expects lower < upper, so make sure to handle possible edge cases.
+	// Always generate from the lowest to the highest value, so that the upper value is never included.
 	if (lower == upper) {
 		return lower;
 	} else if (lower < upper) {
-		uniform_real_distribution<float> distribution(lower, upper);
-		return distribution(m_generator);
+		return m_generator.nextFloat(lower, upper);
 	} else {
-		uniform_real_distribution<float> distribution(upper, lower);
-		return distribution(m_generator);
+		return m_generator.nextFloat(upper, lower);
 	}
 }
 
+void RandValueGenerator::seed(uint64_t seed) {
+	m_generator.seed(seed);
+}
+
 RandValueProcessor::RandValueProcessor(const shared_ptr<ValueProcessor>& lowerValue, const shared_ptr<ValueProcessor>& upperValue, const shared_ptr<RandValueGenerator>& randValueGenerator, const vector<shared_ptr<CalcProcessor>>& calcProcessors, bool quantize) : ValueProcessor(calcProcessors, quantize), m_lowerValue(lowerValue), m_upperValue(upperValue), m_randValueGenerator(randValueGenerator) {}
 
 double RandValueProcessor::processValue() {
@@ -272,3 +215,31 @@ double SequenceValueProcessor::processValue() {
 
 	return value;
 }
+
+TableValueProcessor::TableValueProcessor(const ScriptTable* scriptTable, const shared_ptr<ValueProcessor>& position, const vector<shared_ptr<CalcProcessor>>& calcProcessors, bool quantize) : ValueProcessor(calcProcessors, quantize), m_position(position), m_wrap(scriptTable->wrap), m_voltages(scriptTable->voltages) {
+	m_voltages.push_back(m_wrap ? m_voltages.front() : m_voltages.back());
+	m_steps = m_wrap ? m_voltages.size() - 1 : m_voltages.size() - 2;
+}
+
+double TableValueProcessor::processValue() {
+	double position = m_position->process();
+	if (m_wrap) {
+		position = (position - floor(position)) * m_steps;
+	} else {
+		position = position < 0. ? 0. : position > 1. ? m_steps : position * m_steps;
+	}
+
+	// A NaN position (or an infinite one that is wrapped) has no place in the table, so it is treated as its start
+	if (std::isnan(position)) {
+		position = 0.;
+	}
+
+	// Rounding can put a wrapping position right at the end of the table
+	size_t index = (size_t) position;
+	if (index > m_voltages.size() - 2) {
+		index = m_voltages.size() - 2;
+	}
+
+	float fraction = position - index;
+	return m_voltages[index] + (m_voltages[index + 1] - m_voltages[index]) * fraction;
+}
@@ -1,6 +1,7 @@
 #include "core/timeseq-processor.hpp"
 #include "core/timeseq-script.hpp"
 #include "core/timeseq-core.hpp"
+#include "core/timeseq-tracer.hpp"
 #include <sstream>
 #include <stdarg.h>
 #include <chrono>
@@ -9,8 +10,20 @@
 using namespace std;
 using namespace timeseq;
 
+// The number of passes that a loop-locked timeline skips one by one in a single process cycle when seeking
+#define SEEK_MAX_SINGLE_PASSES 4096
+
+LaneProcessor::LaneProcessor(const ScriptLane* scriptLane, const vector<shared_ptr<SegmentProcessor>>& segments, EventListener* eventListener, EventTracer* eventTracer) : m_scriptLane(scriptLane), m_segments(segments), m_eventListener(eventListener), m_eventTracer(eventTracer) {
+	for (const shared_ptr<SegmentProcessor>& segment : m_segments) {
+		DurationProcessor* duration = segment->getDurationProcessor();
+		if (duration->isConstant()) {
+			m_passSamples += duration->getDuration();
+			m_passDrift += duration->getDrift();
+		} else {
+			m_constantPass = false;
+		}
+	}
 
-LaneProcessor::LaneProcessor(const ScriptLane* scriptLane, const vector<shared_ptr<SegmentProcessor>>& segments, EventListener* eventListener) : m_scriptLane(scriptLane), m_segments(segments), m_eventListener(eventListener) {
 	reset();
 }
 
@@ -19,6 +32,7 @@ LaneProcessor::LaneState LaneProcessor::getState() {
 }
 
 bool LaneProcessor::process() {
+	TIMESEQ_PROFILE(m_profilerCounter);
 	bool stopped = false;
 
 	if ((m_state == LaneState::STATE_PROCESSING) && (m_segments.size() > 0)) {
@@ -56,24 +70,47 @@ bool LaneProcessor::process() {
 }
 
 void LaneProcessor::loop() {
-	if (m_state == LaneState::STATE_PENDING_LOOP) {
-		// Check if we need to loop or repeat
-		if ((m_scriptLane->loop) || (m_scriptLane->repeat > 1 && m_repeatCount < m_scriptLane->repeat - 1)) {
-			m_repeatCount++;
-			m_activeSegment = 0;
-			m_state = LaneState::STATE_PROCESSING;
+	if (restart()) {
+		if (!m_scriptLane->disableUi) {
+			m_eventListener->laneLooped();
+		}
+		if (m_eventTracer) {
+			m_eventTracer->record(TraceEventType::LANE_LOOP, this, "", m_repeatCount);
+		}
 
-			// If there is a first segment, make sure it is at its starting position
-			if (m_segments.size() > 0) {
-				m_segments[0]->reset();
-			}
+		process();
+	}
+}
 
-			if (!m_scriptLane->disableUi) {
-				m_eventListener->laneLooped();
-			}
+bool LaneProcessor::restart() {
+	// Check if we need to loop or repeat
+	if ((m_state == LaneState::STATE_PENDING_LOOP) && (shouldLoop())) {
+		m_repeatCount++;
+		m_activeSegment = 0;
+		m_state = LaneState::STATE_PROCESSING;
 
-			process();
+		// If there is a first segment, make sure it is at its starting position
+		if (m_segments.size() > 0) {
+			m_segments[0]->reset();
 		}
+
+		return true;
+	}
+
+	return false;
+}
+
+bool LaneProcessor::shouldLoop() {
+	return (m_scriptLane->loop) || (m_scriptLane->repeat > 1 && m_repeatCount < m_scriptLane->repeat - 1);
+}
+
+uint64_t LaneProcessor::getRemainingLoops() {
+	if (m_scriptLane->loop) {
+		return UINT64_MAX;
+	} else if (shouldLoop()) {
+		return m_scriptLane->repeat - 1 - m_repeatCount;
+	} else {
+		return 0;
 	}
 }
 
@@ -94,6 +131,100 @@ void LaneProcessor::reset() {
 	}
 }
 
+void LaneProcessor::seek(uint64_t samples, bool loop) {
+	if (m_state != LaneState::STATE_PROCESSING) {
+		return;
+	}
+
+	// Whole passes over the segments can be skipped at once when starting from the first segment. The samples of each run of a
+	// segment are its duration plus the whole samples of the drift it accumulated, so the samples of n passes are
+	// n * passSamples + floor(drift + n * passDrift).
+	if ((loop) && (m_constantPass) && (m_activeSegment == 0) && (m_segments[0]->getState() == DurationProcessor::DurationState::STATE_START)) {
+		uint64_t passes = min(getPassCount(samples), getRemainingLoops());
+
+		double drift = m_drift + passes * m_passDrift;
+		samples -= passes * m_passSamples + (uint64_t) drift;
+		m_drift = drift - floor(drift);
+		m_repeatCount += passes;
+	}
+
+	// Walk over the remaining segments until the one that contains the target sample
+	int segment = m_activeSegment;
+	while (true) {
+		if (segment == (int) m_segments.size()) {
+			if ((loop) && (shouldLoop())) {
+				m_repeatCount++;
+				segment = 0;
+			} else {
+				// Wait at the end of the lane until the timeline loops it
+				m_activeSegment = segment;
+				m_state = LaneState::STATE_PENDING_LOOP;
+				return;
+			}
+		}
+
+		DurationProcessor* duration = m_segments[segment]->getDurationProcessor();
+		if (!duration->isConstant()) {
+			// The duration is only known once the segment starts, so the seek stops at its start
+			samples = 0;
+			break;
+		}
+
+		double drift = m_drift + duration->getDrift();
+		uint64_t segmentSamples = duration->getDuration() + (uint64_t) drift;
+		if (samples < segmentSamples) {
+			break;
+		}
+
+		samples -= segmentSamples;
+		m_drift = drift - floor(drift);
+		segment++;
+	}
+
+	m_activeSegment = segment;
+	m_segments[segment]->reset();
+	m_drift = m_segments[segment]->seek(samples, m_drift);
+}
+
+uint64_t LaneProcessor::getPassSamples(uint64_t passes) {
+	if (!m_constantPass) {
+		return UINT64_MAX;
+	}
+
+	return passes * m_passSamples + (uint64_t) (m_drift + passes * m_passDrift);
+}
+
+uint64_t LaneProcessor::getMinPassSamples() {
+	return m_constantPass ? m_passSamples + (uint64_t) floor(m_passDrift) : UINT64_MAX;
+}
+
+uint64_t LaneProcessor::getMaxPassSamples() {
+	return m_constantPass ? m_passSamples + (uint64_t) ceil(m_passDrift) : UINT64_MAX;
+}
+
+uint64_t LaneProcessor::getPassCount(uint64_t samples) {
+	// Lanes without segments don't take any samples, so there is no number of passes that fills the samples
+	if ((!m_constantPass) || (m_passSamples + m_passDrift <= 0.)) {
+		return 0;
+	}
+
+	uint64_t passes = (uint64_t) (samples / (m_passSamples + m_passDrift));
+	// The division can overshoot by one pass due to the rounding of the drift
+	while ((passes > 0) && (getPassSamples(passes) > samples)) {
+		passes--;
+	}
+	return passes;
+}
+
+void LaneProcessor::skipPasses(uint64_t passes) {
+	double drift = m_drift + passes * m_passDrift;
+	m_drift = drift - floor(drift);
+	// The last pass is counted when the lane restarts
+	m_repeatCount += passes - 1;
+	m_activeSegment = m_segments.size();
+	m_state = LaneState::STATE_PENDING_LOOP;
+}
+
 void LaneProcessor::processTriggers(const vector<string>& triggers) {
 	// No use in starting if we have no segments...
 	if (m_segments.size() > 0) {
@@ -116,6 +247,26 @@ void LaneProcessor::processTriggers(const vector<string>& triggers) {
 
 }
 
+void LaneProcessor::getProgress(LaneProgress& progress) const {
+	progress.active = m_state == LaneState::STATE_PROCESSING;
+	progress.segmentCount = m_segments.size();
+	progress.loops = m_repeatCount;
+
+	if (m_segments.size() == 0) {
+		progress.segment = 0;
+		progress.position = 0.f;
+	} else if (m_activeSegment >= (int) m_segments.size()) {
+		// All segments of the current pass are done, and the lane is waiting to loop
+		progress.segment = m_segments.size() - 1;
+		progress.position = 1.f;
+	} else {
+		DurationProcessor* duration = m_segments[m_activeSegment]->getDurationProcessor();
+		uint64_t length = duration->getDuration();
+		progress.segment = m_activeSegment;
+		progress.position = (duration->getState() == DurationProcessor::DurationState::STATE_START) || (length == 0) ? 0.f : min((float) duration->getPosition() / length, 1.f);
+	}
+}
+
 TimelineProcessor::TimelineProcessor(
 	const ScriptTimeline* scriptTimeline,
 	const vector<shared_ptr<LaneProcessor>>& lanes,
@@ -125,6 +276,15 @@ TimelineProcessor::TimelineProcessor(
 		m_scriptTimeline(scriptTimeline), m_lanes(lanes), m_startTriggers(startTriggers), m_stopTriggers(stopTriggers), m_triggerHandler(triggerHandler) {}
 
 void TimelineProcessor::process() {
+	if (m_seeking) {
+		// The timeline waits while a seek continues, so the seek target moves along with each waiting sample
+		continueSeek();
+		if (m_seeking) {
+			m_seekSamples++;
+			return;
+		}
+	}
+
 	bool checkLoop = false;
 
 	// Check if any lane start or stop triggers were fired
@@ -169,16 +329,141 @@ void TimelineProcessor::process() {
 }
 
 void TimelineProcessor::reset() {
+	m_seeking = false;
 	for (const shared_ptr<LaneProcessor>& lanes : m_lanes) {
 		lanes->reset();
 	}
 }
 
-TriggerProcessor::TriggerProcessor(const string& id, int inputPort, int inputChannel, PortHandler* portHandler, TriggerHandler* triggerHandler) : m_id(id), m_inputPort(inputPort), m_inputChannel(inputChannel), m_portHandler(portHandler), m_triggerHandler(triggerHandler) {}
+void TimelineProcessor::seek(uint64_t samples) {
+	if (!m_scriptTimeline->loopLock) {
+		for (const shared_ptr<LaneProcessor>& lane : m_lanes) {
+			lane->seek(samples, true);
+		}
+		return;
+	}
+
+	m_seeking = true;
+	m_seekSamples = samples;
+	continueSeek();
+}
+
+void TimelineProcessor::continueSeek() {
+	uint64_t samples = m_seekSamples;
+	int singlePasses = 0;
+
+	// With a loop-lock, the lanes only loop once all of them completed their pass, so a pass takes as long as its longest lane
+	while (true) {
+		LaneProcessor* longestLane = nullptr;
+		uint64_t remainingLoops = UINT64_MAX;
+		for (const shared_ptr<LaneProcessor>& lane : m_lanes) {
+			if (lane->getState() == LaneProcessor::LaneState::STATE_PROCESSING) {
+				if ((!longestLane) || (lane->getMinPassSamples() > longestLane->getMinPassSamples())) {
+					longestLane = lane.get();
+				}
+				remainingLoops = min(remainingLoops, lane->getRemainingLoops());
+			}
+		}
+
+		if ((!longestLane) || (longestLane->getMinPassSamples() == UINT64_MAX)) {
+			break;
+		}
+
+		// If none of the other lanes can take longer than the shortest pass of the longest lane, that lane determines the
+		// length of all passes, so they can be skipped at once until the first lane stops repeating
+		bool dominant = true;
+		for (const shared_ptr<LaneProcessor>& lane : m_lanes) {
+			if ((lane.get() != longestLane) && (lane->getState() == LaneProcessor::LaneState::STATE_PROCESSING) && (lane->getMaxPassSamples() > longestLane->getMinPassSamples())) {
+				dominant = false;
+				break;
+			}
+		}
+
+		uint64_t passes;
+		uint64_t passSamples;
+		if (dominant) {
+			passes = longestLane->getPassCount(samples);
+			if (remainingLoops < UINT64_MAX) {
+				passes = min(passes, remainingLoops + 1);
+			}
+			passSamples = longestLane->getPassSamples(passes);
+		} else {
+			// The lanes that determine the length of a pass alternate, so the passes are skipped one by one
+			passes = 1;
+			passSamples = 0;
+			for (const shared_ptr<LaneProcessor>& lane : m_lanes) {
+				if (lane->getState() == LaneProcessor::LaneState::STATE_PROCESSING) {
+					passSamples = max(passSamples, lane->getPassSamples(1));
+				}
+			}
+
+			if ((passSamples <= samples) && (++singlePasses > SEEK_MAX_SINGLE_PASSES)) {
+				// Continue in the next process cycle
+				m_seekSamples = samples;
+				return;
+			}
+		}
+
+		if ((passes == 0) || (passSamples == 0) || (passSamples > samples)) {
+			break;
+		}
+
+		samples -= passSamples;
+		for (const shared_ptr<LaneProcessor>& lane : m_lanes) {
+			if (lane->getState() == LaneProcessor::LaneState::STATE_PROCESSING) {
+				lane->skipPasses(passes);
+			}
+		}
+
+		bool looped = false;
+		for (const shared_ptr<LaneProcessor>& lane : m_lanes) {
+			looped = lane->restart() || looped;
+		}
+		if (!looped) {
+			m_seeking = false;
+			return;
+		}
+	}
+
+	m_seeking = false;
+	for (const shared_ptr<LaneProcessor>& lane : m_lanes) {
+		lane->seek(samples, false);
+	}
+}
+
+int TimelineProcessor::getLaneProgress(LaneProgress* lanes, int maxLanes) const {
+	int laneCount = min((int) m_lanes.size(), maxLanes);
+	for (int i = 0; i < laneCount; i++) {
+		m_lanes[i]->getProgress(lanes[i]);
+	}
+	return laneCount;
+}
+
+TriggerProcessor::TriggerProcessor(int inputPort, PortHandler* portHandler, TriggerHandler* triggerHandler) : m_inputPort(inputPort), m_portHandler(portHandler), m_triggerHandler(triggerHandler) {}
+
+void TriggerProcessor::addTrigger(const string& id, int inputChannel) {
+	m_ids[inputChannel].push_back(id);
+	m_channelMask |= 1 << inputChannel;
+	m_triggerCount++;
+}
+
+int TriggerProcessor::getInputPort() const {
+	return m_inputPort;
+}
+
+int TriggerProcessor::getTriggerCount() const {
+	return m_triggerCount;
+}
 
 void TriggerProcessor::process() {
-	if (m_trigger.process(m_portHandler->getInputPortVoltage(m_inputPort, m_inputChannel), 0.f, 1.f)) {
-		m_triggerHandler->setTrigger(m_id);
+	m_portHandler.getInputPortVoltages(m_inputPort, m_voltages.data(), m_channelMask);
+	uint16_t triggered = m_trigger.process(m_voltages.data(), m_channelMask);
+	for (int channel = 0; triggered; channel++, triggered >>= 1) {
+		if (triggered & 1) {
+			for (const string& id : m_ids[channel]) {
+				m_triggerHandler->setTrigger(id);
+			}
+		}
 	}
 }
 
@@ -188,7 +473,7 @@ void SequenceProcessor::clear() {
 	m_values.clear();
 }
 
-string SequenceProcessor::getId() {
+const string& SequenceProcessor::getId() const {
 	return m_id;
 }
 
@@ -222,7 +507,7 @@ void SequenceProcessor::remove(int position) {
 	}
 }
 
-SequencePositionProcessor::SequencePositionProcessor(const shared_ptr<SequenceProcessor>& sequenceProcessor, const shared_ptr<RandValueGenerator>& randValueGenerator) : m_position(0), m_sequenceProcessor(sequenceProcessor), m_randValueGenerator(randValueGenerator), m_hasStoredVoltage(false) {}
+SequencePositionProcessor::SequencePositionProcessor(const shared_ptr<SequenceProcessor>& sequenceProcessor, const shared_ptr<RandValueGenerator>& randValueGenerator, EventTracer* eventTracer) : m_position(0), m_sequenceProcessor(sequenceProcessor), m_randValueGenerator(randValueGenerator), m_eventTracer(eventTracer), m_hasStoredVoltage(false) {}
 
 SequenceProcessor* SequencePositionProcessor::getSequenceProcessor() {
 	return m_sequenceProcessor.get();
@@ -283,6 +568,10 @@ void SequencePositionProcessor::move(SequenceMoveDirection direction, bool wrap)
 	} else {
 		m_position = 0;
 	}
+
+	if (m_eventTracer) {
+		m_eventTracer->record(TraceEventType::SEQUENCE_MOVE, this, m_sequenceProcessor->getId(), m_position);
+	}
 }
 
 void SequencePositionProcessor::move(int position) {
@@ -293,9 +582,14 @@ void SequencePositionProcessor::move(int position) {
 	} else {
 		m_position = position;
 	}
+
+	if (m_eventTracer) {
+		m_eventTracer->record(TraceEventType::SEQUENCE_MOVE, this, m_sequenceProcessor->getId(), m_position);
+	}
 }
 
 Processor::Processor(const shared_ptr<Script>& script, const vector<shared_ptr<TimelineProcessor>>& timelines, const vector<shared_ptr<TriggerProcessor>>& triggers, const vector<shared_ptr<ActionProcessor>>& startActions) : m_timelines(timelines), m_triggers(triggers), m_startActions(startActions), m_script(script) {}
+Processor::Processor(const shared_ptr<Script>& script, const vector<shared_ptr<TimelineProcessor>>& timelines, const vector<shared_ptr<TriggerProcessor>>& triggers, const vector<shared_ptr<ActionProcessor>>& startActions, const shared_ptr<VariableBusReferences>& variableBusReferences) : m_timelines(timelines), m_triggers(triggers), m_startActions(startActions), m_script(script), m_variableBusReferences(variableBusReferences) {}
 
 void Processor::reset() {
 	for (const shared_ptr<ActionProcessor>& actions : m_startActions) {
@@ -307,6 +601,20 @@ void Processor::reset() {
 	}
 }
 
+void Processor::seek(uint64_t samples) {
+	for (const shared_ptr<TimelineProcessor>& timeline : m_timelines) {
+		timeline->seek(samples);
+	}
+}
+
+int Processor::getLaneProgress(LaneProgress* lanes, int maxLanes) const {
+	int laneCount = 0;
+	for (const shared_ptr<TimelineProcessor>& timeline : m_timelines) {
+		laneCount += timeline->getLaneProgress(lanes + laneCount, maxLanes - laneCount);
+	}
+	return laneCount;
+}
+
 void Processor::process() {
 	for (const shared_ptr<TimelineProcessor>& timeline : m_timelines) {
 		timeline->process();
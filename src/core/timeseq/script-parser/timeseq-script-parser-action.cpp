@@ -1,7 +1,7 @@
 #include "core/timeseq-script-parser-internal.hpp"
 
 ScriptAction JsonScriptParser::parseAction(const json& actionJson, bool allowRefs) {
-	static const char* cActionProperties[] = { "timing", "set-value", "set-variable", "set-polyphony", "set-label", "assert", "trigger", "move-sequence", "clear-sequence", "add-to-sequence", "remove-from-sequence", "start-value", "end-value", "ease-factor", "ease-algorithm", "output", "variable", "if", "gate-high-ratio" };
+	static const char* cActionProperties[] = { "timing", "set-value", "set-poly-value", "set-variable", "set-polyphony", "set-label", "assert", "trigger", "select-script", "move-sequence", "clear-sequence", "add-to-sequence", "remove-from-sequence", "start-value", "end-value", "start-values", "end-values", "ease-factor", "ease-algorithm", "output", "variable", "if", "gate-high-ratio" };
 	static const vector<string> vActionProperties(begin(cActionProperties), end(cActionProperties));
 	ScriptAction action;
 
@@ -45,6 +45,20 @@ ScriptAction JsonScriptParser::parseAction(const json& actionJson, bool allowRef
 			}
 		}
 
+		json::const_iterator setPolyValue = actionJson.find("set-poly-value");
+		if (setPolyValue != actionJson.end()) {
+			verifyVersion(VERSION_1_3_0, m_context, "'set-poly-value'");
+			actionCount++;
+			if (setPolyValue->is_object()) {
+				m_context.location.push_back("set-poly-value");
+				ScriptSetPolyValue *scriptSetPolyValue = new ScriptSetPolyValue(parseSetPolyValue(*setPolyValue));
+				action.setPolyValue.reset(scriptSetPolyValue);
+				m_context.location.pop_back();
+			} else {
+				addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Action_SetPolyValueObject, "'set-poly-value' must be an object.");
+			}
+		}
+
 		json::const_iterator setVariable = actionJson.find("set-variable");
 		if (setVariable != actionJson.end()) {
 			actionCount++;
@@ -110,6 +124,20 @@ ScriptAction JsonScriptParser::parseAction(const json& actionJson, bool allowRef
 			}
 		}
 
+		json::const_iterator selectScript = actionJson.find("select-script");
+		if (selectScript != actionJson.end()) {
+			verifyVersion(VERSION_1_3_0, m_context, "'select-script'");
+			actionCount++;
+			if (selectScript->is_number_unsigned()) {
+				action.selectScript.reset(new int(selectScript->get<int>()));
+				if ((*action.selectScript < 1) || (*action.selectScript > 8)) {
+					addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Action_SelectScriptRange, "'select-script' must be a number between 1 and 8.");
+				}
+			} else {
+				addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Action_SelectScriptNumber, "'select-script' must be a number between 1 and 8.");
+			}
+		}
+
 		json::const_iterator moveSequence = actionJson.find("move-sequence");
 		if (moveSequence != actionJson.end()) {
 			verifyVersion(VERSION_1_2_0, m_context, "'move-sequence'");
@@ -178,6 +206,18 @@ ScriptAction JsonScriptParser::parseAction(const json& actionJson, bool allowRef
 			action.endValue.reset(scriptValue);
 		}
 
+		json::const_iterator startValues = actionJson.find("start-values");
+		if (startValues != actionJson.end()) {
+			verifyVersion(VERSION_1_3_0, m_context, "'start-values'");
+			action.startValues = parseGlideValues(*startValues, "start-values", ValidationErrorCode::Action_StartValuesArray);
+		}
+
+		json::const_iterator endValues = actionJson.find("end-values");
+		if (endValues != actionJson.end()) {
+			verifyVersion(VERSION_1_3_0, m_context, "'end-values'");
+			action.endValues = parseGlideValues(*endValues, "end-values", ValidationErrorCode::Action_EndValuesArray);
+		}
+
 		json::const_iterator easeFactor = actionJson.find("ease-factor");
 		if (easeFactor != actionJson.end()) {
 			if (easeFactor->is_number()) {
@@ -248,10 +288,23 @@ ScriptAction JsonScriptParser::parseAction(const json& actionJson, bool allowRef
 		}
 
 		if (action.timing == ScriptAction::ActionTiming::GLIDE) {
-			if ((action.setValue) || (action.setVariable) || (action.setPolyphony) || (action.setLabel) || (action.assert) || (action.trigger.size() > 0) || (action.moveSequence) || (action.clearSequence.length() > 0) || (action.addToSequence) || (action.removeFromSequence) || (action.gateHighRatio)) {
-				addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Action_NonGlideProperties, "'set-value', 'set-variable', 'set-polyphony', 'set-label', 'assert', 'trigger', 'move-sequence', 'clear-sequence', 'add-to-sequence', 'remove-from-sequence' and 'gate-high-ratio' can not be used in combination with 'GLIDE' timing.");
+			if ((action.setValue) || (action.setPolyValue) || (action.setVariable) || (action.setPolyphony) || (action.setLabel) || (action.assert) || (action.trigger.size() > 0) || (action.selectScript) || (action.moveSequence) || (action.clearSequence.length() > 0) || (action.addToSequence) || (action.removeFromSequence) || (action.gateHighRatio)) {
+				addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Action_NonGlideProperties, "'set-value', 'set-poly-value', 'set-variable', 'set-polyphony', 'set-label', 'assert', 'trigger', 'select-script', 'move-sequence', 'clear-sequence', 'add-to-sequence', 'remove-from-sequence' and 'gate-high-ratio' can not be used in combination with 'GLIDE' timing.");
 			}
-			if ((!action.startValue) || (!action.endValue)) {
+			if ((action.startValues) || (action.endValues)) {
+				// A polyphonic glide, gliding multiple channels of an output at once
+				if ((action.startValue) || (action.endValue)) {
+					addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Action_GlideValueOrValues, "'start-value' and 'end-value' can not be combined with 'start-values' and 'end-values'.");
+				}
+				if ((!action.startValues) || (!action.endValues)) {
+					addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Action_MissingGlideValues, "'start-values' and 'end-values' must both be present when one of them is used.");
+				} else if (action.startValues->size() != action.endValues->size()) {
+					addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Action_GlideValuesSize, "'start-values' and 'end-values' must contain the same number of values.");
+				}
+				if (action.variable.length() > 0) {
+					addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Action_GlideValuesVariable, "'start-values' and 'end-values' can only be used in combination with 'output', not with 'variable'.");
+				}
+			} else if ((!action.startValue) || (!action.endValue)) {
 				addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Action_MissingGlideValues, "'start-value' and 'end-value' must be present when 'GLIDE' timing is used.");
 			}
 			if ((!action.output) && (action.variable.length() == 0)) {
@@ -261,8 +314,8 @@ ScriptAction JsonScriptParser::parseAction(const json& actionJson, bool allowRef
 				addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Action_TooManyGlideActions, "Only one of 'output' and 'variable' can be present when 'GLIDE' timing is used.");
 			}
 		} else if (action.timing == ScriptAction::ActionTiming::GATE) {
-			if ((action.setValue) || (action.setVariable) || (action.setPolyphony) || (action.setLabel) || (action.assert) || (action.trigger.size() > 0) || (action.moveSequence) || (action.clearSequence.length() > 0) || (action.addToSequence) || (action.removeFromSequence) || (action.startValue) || (action.endValue) || (action.easeFactor) || (action.easeAlgorithm)) {
-				addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Action_NonGateProperties, "'set-value', 'set-variable', 'set-polyphony', 'set-label', 'assert', 'trigger', 'move-sequence', 'clear-sequence', 'add-to-sequence', 'remove-from-sequence', 'start-value', 'end-value', 'ease-factory' and 'ease-algorithm' can not be used in combination with 'GATE' timing.");
+			if ((action.setValue) || (action.setPolyValue) || (action.setVariable) || (action.setPolyphony) || (action.setLabel) || (action.assert) || (action.trigger.size() > 0) || (action.selectScript) || (action.moveSequence) || (action.clearSequence.length() > 0) || (action.addToSequence) || (action.removeFromSequence) || (action.startValue) || (action.endValue) || (action.startValues) || (action.endValues) || (action.easeFactor) || (action.easeAlgorithm)) {
+				addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Action_NonGateProperties, "'set-value', 'set-poly-value', 'set-variable', 'set-polyphony', 'set-label', 'assert', 'trigger', 'select-script', 'move-sequence', 'clear-sequence', 'add-to-sequence', 'remove-from-sequence', 'start-value', 'end-value', 'start-values', 'end-values', 'ease-factory' and 'ease-algorithm' can not be used in combination with 'GATE' timing.");
 			}
 			if (!action.output) {
 				addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Action_GateOutput, "'output' must be present when 'GATE' timing is used.");
@@ -271,19 +324,19 @@ ScriptAction JsonScriptParser::parseAction(const json& actionJson, bool allowRef
 				addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Action_NonGateProperties, "'variable' can only be used in combination with 'GLIDE' timing.");
 			}
 		} else {
-			if ((action.startValue) || (action.endValue) || (action.easeFactor) || (action.easeAlgorithm) || (action.gateHighRatio)) {
-				addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Action_GlidePropertiesOnNonGlideAction, "'start-value', 'end-value', 'ease-factory' 'ease-algorithm' and 'gate-high-ratio' can only be used in combination with 'GLIDE' timing.");
+			if ((action.startValue) || (action.endValue) || (action.startValues) || (action.endValues) || (action.easeFactor) || (action.easeAlgorithm) || (action.gateHighRatio)) {
+				addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Action_GlidePropertiesOnNonGlideAction, "'start-value', 'end-value', 'start-values', 'end-values', 'ease-factory' 'ease-algorithm' and 'gate-high-ratio' can only be used in combination with 'GLIDE' timing.");
 			}
 			if ((action.output) || (action.variable.length() > 0)) {
 				addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Action_GlidePropertiesOnNonGlideAction, "'output' and 'variable' can only be used in combination with 'GLIDE' timing.");
 			}
-			if ((!action.setValue) && (!action.setVariable) && (!action.setPolyphony) && (!action.setLabel) && (!action.assert) && (action.trigger.size() == 0) && (!action.moveSequence) && (action.clearSequence.length() == 0) && (!action.addToSequence) && (!action.removeFromSequence)) {
+			if ((!action.setValue) && (!action.setPolyValue) && (!action.setVariable) && (!action.setPolyphony) && (!action.setLabel) && (!action.assert) && (action.trigger.size() == 0) && (!action.selectScript) && (!action.moveSequence) && (action.clearSequence.length() == 0) && (!action.addToSequence) && (!action.removeFromSequence)) {
 				string timingStr = timing != actionJson.end() ? *timing : "start";
-				addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Action_MissingNonGlideProperties, "'set-value', 'set-variable', 'set-polyphony', 'set-label', 'assert', 'trigger', 'move-sequence', 'clear-sequence', 'add-to-sequence' or 'remove-from-sequence' must be present for '", timingStr.c_str(), "' timing.");
+				addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Action_MissingNonGlideProperties, "'set-value', 'set-poly-value', 'set-variable', 'set-polyphony', 'set-label', 'assert', 'trigger', 'select-script', 'move-sequence', 'clear-sequence', 'add-to-sequence' or 'remove-from-sequence' must be present for '", timingStr.c_str(), "' timing.");
 			}
 			if (actionCount > 1) {
 				string timingStr = timing != actionJson.end() ? *timing : "start";
-				addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Action_TooManyNonGlideProperties, "Only one of 'set-value', 'set-variable', 'set-polyphony', 'set-label', 'assert', 'trigger', 'move-sequence', 'clear-sequence', 'add-to-sequence' or 'remove-from-sequence' can be used in the same '", timingStr.c_str(), "' action.");
+				addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Action_TooManyNonGlideProperties, "Only one of 'set-value', 'set-poly-value', 'set-variable', 'set-polyphony', 'set-label', 'assert', 'trigger', 'select-script', 'move-sequence', 'clear-sequence', 'add-to-sequence' or 'remove-from-sequence' can be used in the same '", timingStr.c_str(), "' action.");
 			}
 		}
 	}
@@ -314,6 +367,67 @@ ScriptSetValue JsonScriptParser::parseSetValue(const json& setValueJson) {
 	return setValue;
 }
 
+ScriptSetPolyValue JsonScriptParser::parseSetPolyValue(const json& setPolyValueJson) {
+	static const vector<string> setPolyValueProperties = { "output", "values" };
+	ScriptSetPolyValue setPolyValue;
+
+	verifyAllowedProperties(setPolyValueJson, setPolyValueProperties, false, m_context);
+
+	json::const_iterator output = setPolyValueJson.find("output");
+	if (output != setPolyValueJson.end()) {
+		setPolyValue.output = parseOutput(*output, true, "output", ValidationErrorCode::SetPolyValue_OutputObject, "'output' is required and must be an object.");
+	} else {
+		addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::SetPolyValue_OutputObject, "'output' is required and must be a output object.");
+	}
+
+	json::const_iterator values = setPolyValueJson.find("values");
+	if ((values != setPolyValueJson.end()) && (values->is_array())) {
+		m_context.location.push_back("values");
+
+		int count = 0;
+		vector<json> valueElements = (*values);
+		for (const json& value : valueElements) {
+			setPolyValue.values.push_back(parseValue(value, true, count, ValidationErrorCode::SetPolyValue_ValueObject, "'values' elements must be objects."));
+			count++;
+		}
+
+		m_context.location.pop_back();
+
+		if ((setPolyValue.values.size() < 1) || (setPolyValue.values.size() > 16)) {
+			addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::SetPolyValue_ValuesSize, "'values' must contain between 1 and 16 values.");
+		}
+	} else {
+		addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::SetPolyValue_ValuesArray, "'values' is required and must be an array.");
+	}
+
+	return setPolyValue;
+}
+
+unique_ptr<vector<ScriptValue>> JsonScriptParser::parseGlideValues(const json& valuesJson, const char* subLocation, ValidationErrorCode validationErrorCode) {
+	unique_ptr<vector<ScriptValue>> values(new vector<ScriptValue>());
+
+	if (valuesJson.is_array()) {
+		m_context.location.push_back(subLocation);
+
+		int count = 0;
+		vector<json> valueElements = valuesJson;
+		for (const json& value : valueElements) {
+			values->push_back(parseValue(value, true, count, validationErrorCode, string("'") + subLocation + "' elements must be objects."));
+			count++;
+		}
+
+		m_context.location.pop_back();
+
+		if ((values->size() < 1) || (values->size() > 16)) {
+			addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Action_GlideValuesSize, "'", subLocation, "' must contain between 1 and 16 values.");
+		}
+	} else {
+		addValidationError(&m_context.validationErrors, m_context.location, validationErrorCode, "'", subLocation, "' must be an array.");
+	}
+
+	return values;
+}
+
 ScriptSetVariable JsonScriptParser::parseSetVariable(const json& setVariableJson) {
 	static const vector<string> setVariableProperties  = { "name", "value" };
 	ScriptSetVariable setVariable;
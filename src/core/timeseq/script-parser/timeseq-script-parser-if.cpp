@@ -164,7 +164,7 @@ unique_ptr<vector<ScriptIf>> JsonScriptParser::parseIfIfs(const string& ifOperat
 		int count = 0;
 		ifs.reset(new vector<ScriptIf>());
 		for (const json& ifElement : ifElements) {
-			m_context.location.push_back(to_string(count));
+			m_context.location.push_back(count);
 			ifs->push_back(parseIf(ifElement, true));
 			m_context.location.pop_back();
 			count++;
@@ -1,6 +1,6 @@
 #include "core/timeseq-script-parser-internal.hpp"
 
-ScriptOutput JsonScriptParser::parseOutput(const json& outputJson, bool allowRefs, const string& subLocation, ValidationErrorCode validationErrorCode, const string& validationErrorMessage) {
+ScriptOutput JsonScriptParser::parseOutput(const json& outputJson, bool allowRefs, ValidationLocation::Entry subLocation, ValidationErrorCode validationErrorCode, const string& validationErrorMessage) {
 	ScriptOutput scriptOutput;
 
 	if (outputJson.is_object()) {
@@ -56,7 +56,7 @@ ScriptOutput JsonScriptParser::parseFullOutput(const json& outputJson, bool allo
 	return output;
 }
 
-ScriptInput JsonScriptParser::parseInput(const json& inputJson, bool allowRefs, const string& subLocation, ValidationErrorCode validationErrorCode, const string& validationErrorMessage) {
+ScriptInput JsonScriptParser::parseInput(const json& inputJson, bool allowRefs, ValidationLocation::Entry subLocation, ValidationErrorCode validationErrorCode, const string& validationErrorMessage) {
 	ScriptInput scriptInput;
 
 	if (inputJson.is_object()) {
@@ -61,7 +61,7 @@ ScriptSegment JsonScriptParser::parseSegment(const json& segmentJson, bool allow
 				int count = 0;
 				vector<json> actionElements = (*actions);
 				for (const json& action : actionElements) {
-					m_context.location.push_back(to_string(count));
+					m_context.location.push_back(count);
 					if (action.is_object()) {
 						segment.actions.push_back(parseAction(action, true));
 					} else {
@@ -104,7 +104,7 @@ ScriptSegmentBlock JsonScriptParser::parseSegmentBlock(const json& segmentBlockJ
 		int count = 0;
 		vector<json> segmentElements = (*segments);
 		for (const json& segment : segmentElements) {
-			m_context.location.push_back(to_string(count));
+			m_context.location.push_back(count);
 			if (segment.is_object()) {
 				segmentBlock.segments.push_back(parseSegment(segment, true));
 			} else {
@@ -1,7 +1,7 @@
 #include "core/timeseq-script-parser-internal.hpp"
 #include "util/notes.hpp"
 
-ScriptValue JsonScriptParser::parseValue(const json& valueJson, bool allowRefs, const string& subLocation, ValidationErrorCode validationErrorCode, const string& validationErrorMessage) {
+ScriptValue JsonScriptParser::parseValue(const json& valueJson, bool allowRefs, ValidationLocation::Entry subLocation, ValidationErrorCode validationErrorCode, const string& validationErrorMessage) {
 	ScriptValue scriptValue;
 	m_context.location.push_back(subLocation);
 
@@ -22,7 +22,7 @@ ScriptValue JsonScriptParser::parseValue(const json& valueJson, bool allowRefs,
 }
 
 ScriptValue JsonScriptParser::parseFullValue(const json& valueJson, bool allowRefs, bool fromShorthand) {
-	static const char* cValueProperties[] = { "voltage", "no-limit", "note", "variable", "input", "output", "rand", "sequence", "calc", "quantize" };
+	static const char* cValueProperties[] = { "voltage", "no-limit", "note", "variable", "input", "output", "rand", "sequence", "table", "calc", "quantize" };
 	static const vector<string> vValueProperties(begin(cValueProperties), end(cValueProperties));
 	ScriptValue value;
 
@@ -142,6 +142,20 @@ ScriptValue JsonScriptParser::parseFullValue(const json& valueJson, bool allowRe
 			m_context.location.pop_back();
 		}
 
+		json::const_iterator table = valueJson.find("table");
+		if (table != valueJson.end()) {
+			verifyVersion(VERSION_1_3_0, m_context, "value 'table'");
+			valueTypes++;
+			if (table->is_object()) {
+				m_context.location.push_back("table");
+				ScriptTableValue* scriptTableValue = new ScriptTableValue(parseTableValue(*table));
+				value.table.reset(scriptTableValue);
+				m_context.location.pop_back();
+			} else {
+				addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Value_TableObject, "'table' must be an object.");
+			}
+		}
+
 		if (valueTypes == 0) {
 			addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Value_NoActualValue, "One of 'voltage', 'note', 'variable', 'input', 'output' or 'rand' must be set.");
 		} else if (valueTypes > 1) {
@@ -156,7 +170,7 @@ ScriptValue JsonScriptParser::parseFullValue(const json& valueJson, bool allowRe
 				int count = 0;
 				vector<json> calcElements = (*calcs);
 				for (const json& calc : calcElements) {
-					m_context.location.push_back(to_string(count));
+					m_context.location.push_back(count);
 					if (calc.is_object()) {
 						value.calc.push_back(parseCalc(calc, true));
 					} else {
@@ -400,7 +414,7 @@ ScriptTuning JsonScriptParser::parseTuning(const json& tuningJson, bool allowRef
 			int count = 0;
 			vector<json> noteElements = (*notes);
 			for (const json& noteElement : noteElements) {
-				m_context.location.push_back(to_string(count));
+				m_context.location.push_back(count);
 				if (noteElement.is_number()) {
 					float x;
 					float note = noteElement.get<float>();
@@ -463,6 +477,79 @@ ScriptTuning JsonScriptParser::parseTuning(const json& tuningJson, bool allowRef
 	return tuning;
 }
 
+ScriptTable JsonScriptParser::parseTable(const json& tableJson) {
+	static const vector<string> tableProperties = { "voltages", "wrap" };
+	ScriptTable table;
+
+	verifyAllowedProperties(tableJson, tableProperties, true, m_context);
+	populateRef(table, tableJson, false);
+
+	json::const_iterator voltages = tableJson.find("voltages");
+	if ((voltages != tableJson.end()) && (voltages->is_array())) {
+		m_context.location.push_back("voltages");
+		int count = 0;
+		vector<json> voltageElements = (*voltages);
+		for (const json& voltage : voltageElements) {
+			m_context.location.push_back(count);
+			if (voltage.is_number()) {
+				table.voltages.push_back(voltage.get<float>());
+			} else {
+				addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Table_VoltageFloat, "'voltages' elements must be decimal numbers.");
+			}
+			m_context.location.pop_back();
+			count++;
+		}
+		m_context.location.pop_back();
+
+		if (voltageElements.size() == 0) {
+			addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Table_VoltagesArraySize, "'voltages' must contain at least one element.");
+		}
+	} else {
+		addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Table_VoltagesArray, "'voltages' is required and must be an array.");
+	}
+
+	table.wrap = false;
+	json::const_iterator wrap = tableJson.find("wrap");
+	if (wrap != tableJson.end()) {
+		if (wrap->is_boolean()) {
+			table.wrap = wrap->get<bool>();
+		} else {
+			addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Table_WrapBoolean, "'wrap' must be a boolean.");
+		}
+	}
+
+	return table;
+}
+
+ScriptTableValue JsonScriptParser::parseTableValue(const json& tableValueJson) {
+	static const vector<string> tableValueProperties = { "id", "position" };
+	ScriptTableValue scriptTableValue;
+
+	verifyAllowedProperties(tableValueJson, tableValueProperties, false, m_context);
+
+	json::const_iterator id = tableValueJson.find("id");
+	if ((id != tableValueJson.end()) && (id->is_string())) {
+		string idValue = *id;
+		if (idValue.length() > 0) {
+			scriptTableValue.id = idValue;
+		} else {
+			addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::TableValue_IdLength, "'id' can not be an empty string.");
+		}
+	} else {
+		addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::TableValue_IdString, "'id' is required and must be a string.");
+	}
+
+	json::const_iterator position = tableValueJson.find("position");
+	if (position != tableValueJson.end()) {
+		ScriptValue *scriptValue = new ScriptValue(parseValue(*position, true, "position", ValidationErrorCode::TableValue_PositionObject, "'position' is required and must be a value object."));
+		scriptTableValue.position.reset(scriptValue);
+	} else {
+		addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::TableValue_PositionObject, "'position' is required and must be a value object.");
+	}
+
+	return scriptTableValue;
+}
+
 ScriptSequenceValue JsonScriptParser::parseSequenceValue(const json& sequenceJson, bool allowRefs) {
 	ScriptSequenceValue scriptSequenceValue;
 
@@ -5,7 +5,8 @@ void verifyVersion(int expectedVersion, JsonScriptParseContext& context, const c
 		map<int, string> versionMap = {
 				{ VERSION_1_0_0, "1.0.0" },
 				{ VERSION_1_1_0, "1.1.0" },
-				{ VERSION_1_2_0, "1.2.0" }
+				{ VERSION_1_2_0, "1.2.0" },
+				{ VERSION_1_3_0, "1.3.0" }
 		};
 
 		addValidationError(&context.validationErrors, context.location, ValidationErrorCode::Feature_Not_In_Version, feature, " requires version ", versionMap[expectedVersion].c_str(), " but the script has its version set to ", versionMap[context.version].c_str(), ".");
@@ -64,7 +65,7 @@ ScriptSequenceMoveDirection parseScriptSequenceMoveDirection(const json& moveDir
 }
 
 template<class ScriptType>
-void parseChildArray(JsonScriptParseContext& context, const json& parent, const std::string jsonTag, int version, vector<ScriptType>& scriptArray, const std::function<ScriptType(const json&)> parseFunc, ValidationErrorCode objectErrorCode, ValidationErrorCode arrayErrorCode) {
+void parseChildArray(JsonScriptParseContext& context, const json& parent, const char* jsonTag, int version, vector<ScriptType>& scriptArray, const std::function<ScriptType(const json&)> parseFunc, ValidationErrorCode objectErrorCode, ValidationErrorCode arrayErrorCode) {
 	json::const_iterator items = parent.find(jsonTag);
 	if (items != parent.end()) {
 		if (version > 0) {
@@ -77,7 +78,7 @@ void parseChildArray(JsonScriptParseContext& context, const json& parent, const
 			vector<string> ids;
 			vector<json> elements = (*items);
 			for (const json& element : elements) {
-				context.location.push_back(to_string(count));
+				context.location.push_back(count);
 				if (element.is_object()) {
 					scriptArray.push_back(parseFunc(element));
 					if (find(ids.begin(), ids.end(), scriptArray.back().id) != ids.end()) {
@@ -86,7 +87,7 @@ void parseChildArray(JsonScriptParseContext& context, const json& parent, const
 						ids.push_back(scriptArray.back().id);
 					}
 				} else {
-					addValidationError(&context.validationErrors, context.location, objectErrorCode, "'", jsonTag.c_str(), "' elements must be objects.");
+					addValidationError(&context.validationErrors, context.location, objectErrorCode, "'", jsonTag, "' elements must be objects.");
 				}
 				context.location.pop_back();
 				count++;
@@ -94,7 +95,7 @@ void parseChildArray(JsonScriptParseContext& context, const json& parent, const
 
 			context.location.pop_back();
 		} else {
-			addValidationError(&context.validationErrors, context.location, arrayErrorCode, "'", jsonTag.c_str(), "' must be an array.");
+			addValidationError(&context.validationErrors, context.location, arrayErrorCode, "'", jsonTag, "' must be an array.");
 		}
 	}
 }
@@ -140,11 +141,14 @@ const shared_ptr<Script> JsonScriptParser::parseScript(const json& scriptJson) {
 			m_context.version = 110;
 		} else if (script->version == "1.2.0") {
 			m_context.version = 120;
+		} else if (script->version == "1.3.0") {
+			m_context.version = 130;
 		}
 		else {
 			string versionValue = (*version);
-			addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Script_VersionUnsupported, "'version' '", versionValue.c_str(), "' is an unsupported version. Only versions 1.0.0, 1.1.0 and 1.2.0 are currently supported.");
+			addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Script_VersionUnsupported, "'version' '", versionValue.c_str(), "' is an unsupported version. Only versions 1.0.0, 1.1.0, 1.2.0 and 1.3.0 are currently supported.");
 		}
+		script->versionNumber = m_context.version;
 	}
 
 	json::const_iterator timelines = scriptJson.find("timelines");
@@ -154,7 +158,7 @@ const shared_ptr<Script> JsonScriptParser::parseScript(const json& scriptJson) {
 		int count = 0;
 		vector<json> timelineElements = (*timelines);
 		for (const json& timeline : timelineElements) {
-			m_context.location.push_back(to_string(count));
+			m_context.location.push_back(count);
 			if (timeline.is_object()) {
 				script->timelines.push_back(parseTimeline(timeline));
 			} else {
@@ -177,7 +181,7 @@ const shared_ptr<Script> JsonScriptParser::parseScript(const json& scriptJson) {
 			int count = 0;
 			vector<json> actionElements = (*globalActions);
 			for (const json& action : actionElements) {
-				m_context.location.push_back(to_string(count));
+				m_context.location.push_back(count);
 				if (action.is_object()) {
 					script->globalActions.push_back(parseAction(action, true));
 				} else {
@@ -201,7 +205,7 @@ const shared_ptr<Script> JsonScriptParser::parseScript(const json& scriptJson) {
 			int count = 0;
 			vector<json> inputTriggerElements = (*inputTriggers);
 			for (const json& inputTrigger : inputTriggerElements) {
-				m_context.location.push_back(to_string(count));
+				m_context.location.push_back(count);
 				if (inputTrigger.is_object()) {
 					script->inputTriggers.push_back(parseInputTrigger(inputTrigger));
 				} else {
@@ -222,7 +226,7 @@ const shared_ptr<Script> JsonScriptParser::parseScript(const json& scriptJson) {
 	json::const_iterator componentPool = scriptJson.find("component-pool");
 	if (componentPool != scriptJson.end()) {
 		if (componentPool->is_object()) {
-			static const vector<string> componentPoolProperties = { "segment-blocks", "segments", "inputs", "outputs", "calcs", "values", "actions", "ifs", "tunings" };
+			static const vector<string> componentPoolProperties = { "segment-blocks", "segments", "inputs", "outputs", "calcs", "values", "actions", "ifs", "tunings", "tables" };
 			m_context.location.push_back("component-pool");
 
 			verifyAllowedProperties(*componentPool, componentPoolProperties, false, m_context);
@@ -236,6 +240,7 @@ const shared_ptr<Script> JsonScriptParser::parseScript(const json& scriptJson) {
 			parseChildArray<ScriptAction>(m_context, *componentPool, "actions", 0, script->actions, [this](const json& action) { return parseAction(action, false); }, ValidationErrorCode::Script_ActionObject, ValidationErrorCode::Script_ActionsArray);
 			parseChildArray<ScriptIf>(m_context, *componentPool, "ifs", 0, script->ifs, [this](const json& ifObj) { return parseIf(ifObj, false); }, ValidationErrorCode::Script_IfObject, ValidationErrorCode::Script_IfsArray);
 			parseChildArray<ScriptTuning>(m_context, *componentPool, "tunings", VERSION_1_1_0, script->tunings, [this](const json& tuning) { return parseTuning(tuning, false); }, ValidationErrorCode::Script_TuningObject, ValidationErrorCode::Script_TuningsArray);
+			parseChildArray<ScriptTable>(m_context, *componentPool, "tables", VERSION_1_3_0, script->tables, [this](const json& table) { return parseTable(table); }, ValidationErrorCode::Script_TableObject, ValidationErrorCode::Script_TablesArray);
 
 			m_context.location.pop_back();
 		} else {
@@ -270,7 +275,7 @@ ScriptTimeline JsonScriptParser::parseTimeline(const json& timelineJson) {
 		int count = 0;
 		vector<json> laneElements = (*lanes);
 		for (const json& lane : laneElements) {
-			m_context.location.push_back(to_string(count));
+			m_context.location.push_back(count);
 			if (lane.is_object()) {
 				timeline.lanes.push_back(parseLane(lane));
 			} else {
@@ -341,7 +346,7 @@ ScriptTimeScale JsonScriptParser::parseTimeScale(const json& timeScaleJson) {
 }
 
 ScriptLane JsonScriptParser::parseLane(const json& laneJson) {
-	static const vector<string> laneProperties = { "auto-start", "loop", "repeat", "start-trigger", "restart-trigger", "stop-trigger", "segments", "disable-ui" };
+	static const vector<string> laneProperties = { "auto-start", "loop", "repeat", "start-trigger", "restart-trigger", "stop-trigger", "segments", "disable-ui", "control-rate" };
 	ScriptLane lane;
 
 	verifyAllowedProperties(laneJson, laneProperties, false, m_context);
@@ -419,7 +424,7 @@ ScriptLane JsonScriptParser::parseLane(const json& laneJson) {
 		int count = 0;
 		vector<json> segmentElements = (*segments);
 		for (const json& segment : segmentElements) {
-			m_context.location.push_back(to_string(count));
+			m_context.location.push_back(count);
 			if (segment.is_object()) {
 				lane.segments.push_back(parseSegment(segment, true));
 			} else {
@@ -444,6 +449,17 @@ ScriptLane JsonScriptParser::parseLane(const json& laneJson) {
 		}
 	}
 
+	json::const_iterator controlRate = laneJson.find("control-rate");
+	lane.controlRate = 1;
+	if (controlRate != laneJson.end()) {
+		verifyVersion(VERSION_1_3_0, m_context, "'control-rate'");
+		if ((controlRate->is_number_unsigned()) && (controlRate->get<uint64_t>() >= 1) && (controlRate->get<uint64_t>() <= 1024)) {
+			lane.controlRate = controlRate->get<int>();
+		} else {
+			addValidationError(&m_context.validationErrors, m_context.location, ValidationErrorCode::Lane_ControlRateNumber, "'control-rate' must be a whole number between 1 and 1024.");
+		}
+	}
+
 	return lane;
 }
 
@@ -483,7 +499,7 @@ ScriptSequence JsonScriptParser::parseSequence(const json& sequenceJson) {
 			int count = 0;
 			vector<json> valueElements = (*values);
 			for (const json& value : valueElements) {
-				sequence.values.push_back(parseValue(value, true, to_string(count), Sequence_ValueObject, "'values' elements must be objects."));
+				sequence.values.push_back(parseValue(value, true, count, Sequence_ValueObject, "'values' elements must be objects."));
 				count++;
 			}
 
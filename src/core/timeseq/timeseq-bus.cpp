@@ -0,0 +1,77 @@
+#include "core/timeseq-bus.hpp"
+
+using namespace std;
+using namespace timeseq;
+
+
+VariableBus::VariableBus() {
+	for (VariableBusSlot& slot : m_slots) {
+		slot.m_frame = &m_frame;
+	}
+}
+
+VariableBus& VariableBus::global() {
+	static VariableBus variableBus;
+	return variableBus;
+}
+
+VariableBusSlot* VariableBus::resolve(const string& name) {
+	lock_guard<mutex> lock(m_namesMutex);
+
+	unordered_map<string, int>::iterator it = m_names.find(name);
+	if (it != m_names.end()) {
+		m_references[it->second]++;
+		return &m_slots[it->second];
+	}
+
+	for (int i = 0; i < TIMESEQ_BUS_SIZE; i++) {
+		if (m_references[i] == 0) {
+			m_names[name] = i;
+			m_references[i] = 1;
+			return &m_slots[i];
+		}
+	}
+
+	return nullptr;
+}
+
+void VariableBus::release(const string& name) {
+	lock_guard<mutex> lock(m_namesMutex);
+
+	unordered_map<string, int>::iterator it = m_names.find(name);
+	if (it == m_names.end()) {
+		return;
+	}
+
+	int index = it->second;
+	m_references[index]--;
+	if (m_references[index] == 0) {
+		// Don't let the value of the old variable leak into the next variable that is bound to this slot
+		m_slots[index].m_current.store(0, memory_order_relaxed);
+		m_slots[index].m_previous.store(0, memory_order_relaxed);
+		m_names.erase(it);
+	}
+}
+
+VariableBusReferences::VariableBusReferences(VariableBus* variableBus) : m_variableBus(variableBus) {}
+
+VariableBusReferences::~VariableBusReferences() {
+	for (const pair<const string, VariableBusSlot*>& slot : m_slots) {
+		m_variableBus->release(slot.first);
+	}
+}
+
+VariableBusSlot* VariableBusReferences::resolve(const string& name) {
+	lock_guard<mutex> lock(m_slotsMutex);
+
+	unordered_map<string, VariableBusSlot*>::iterator it = m_slots.find(name);
+	if (it != m_slots.end()) {
+		return it->second;
+	}
+
+	VariableBusSlot* slot = m_variableBus->resolve(name);
+	if (slot != nullptr) {
+		m_slots[name] = slot;
+	}
+	return slot;
+}
@@ -2,16 +2,74 @@
 #include "core/timeseq-script-parser.hpp"
 #include "core/timeseq-processor-parser.hpp"
 #include "core/timeseq-processor.hpp"
+#include "core/timeseq-bus.hpp"
 #include <rack.hpp>
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <algorithm>
 
 using namespace timeseq;
 
 
+void PortHandler::getInputPortVoltages(int index, float* voltages, uint16_t channelMask) const {
+	for (int i = 0; i < 16; i++) {
+		if (channelMask & (1 << i)) {
+			voltages[i] = getInputPortVoltage(index, i);
+		}
+	}
+}
+
+void PortHandler::setOutputPortVoltages(int index, int channel, const float* voltages, int count) {
+	for (int i = 0; i < count; i++) {
+		setOutputPortVoltage(index, channel + i, voltages[i]);
+	}
+}
+
+AssertExpectation::Term* AssertExpectation::addTerm() {
+	return termCount < (int) terms.size() ? &terms[termCount++] : nullptr;
+}
+
+namespace {
+
+// Formats the term at the index and the terms of its conditions. Returns the index of the next term.
+int formatAssertTerm(const AssertExpectation& expectation, int index, std::ostringstream& oss) {
+	if (index >= expectation.termCount) {
+		// The expectation was too large to keep all of its terms
+		oss << "...";
+		return index;
+	}
+
+	const AssertExpectation::Term& term = expectation.terms[index++];
+	oss << "(";
+	if (term.combination) {
+		for (int i = 0; i < term.conditionCount; i++) {
+			if (i > 0) {
+				oss << term.operatorName;
+			}
+			index = formatAssertTerm(expectation, index, oss);
+		}
+	} else {
+		oss << term.value1 << term.operatorName << term.value2;
+	}
+	oss << ")";
+
+	return index;
+}
+
+}
+
+std::string AssertExpectation::format() const {
+	std::ostringstream oss;
+	oss.precision(10);
+	formatAssertTerm(*this, 0, oss);
+	return oss.str();
+}
+
 TimeSeqCore::TimeSeqCore(PortHandler* portHandler, const SampleRateReader* sampleRateReader, EventListener* eventListener, AssertListener* assertListener) :
-		TimeSeqCore(std::make_shared<JsonLoader>(), std::make_shared<ProcessorLoader>(portHandler, this, this, sampleRateReader, eventListener, assertListener), sampleRateReader, eventListener) {
+		TimeSeqCore(std::make_shared<JsonLoader>(), std::make_shared<ProcessorLoader>(portHandler, this, this, sampleRateReader, eventListener, assertListener, &m_eventTracer), sampleRateReader, eventListener) {
+	m_processorLoader->setScriptBankHandler(this);
+	m_processorLoader->setVariableBus(&VariableBus::global());
 }
 
 TimeSeqCore::TimeSeqCore(std::shared_ptr<JsonLoader> jsonLoader, std::shared_ptr<ProcessorLoader> processorLoader, const SampleRateReader* sampleRateReader, EventListener* eventListener) :
@@ -22,7 +80,16 @@ TimeSeqCore::~TimeSeqCore() {
 }
 
 const std::vector<ValidationError> TimeSeqCore::loadScript(const std::string& scriptData) {
-	std::istringstream scriptStream(scriptData);
+	return loadScript(m_activeScript, scriptData);
+}
+
+const std::vector<ValidationError> TimeSeqCore::loadScript(int index, const std::string& scriptData) {
+	return loadScript(index, scriptData.data(), scriptData.size());
+}
+
+const std::vector<ValidationError> TimeSeqCore::loadScript(int index, const char* scriptData, size_t size) {
+	MemoryStreamBuffer scriptBuffer(scriptData, size);
+	std::istream scriptStream(&scriptBuffer);
 	std::vector<ValidationError> validationErrors;
 
 	std::shared_ptr<Script> script = m_jsonLoader->loadScript(scriptStream, validationErrors);
@@ -32,12 +99,18 @@ const std::vector<ValidationError> TimeSeqCore::loadScript(const std::string& sc
 		if ((validationErrors.size() == 0) && (processor)) {
 			m_sampleRate = m_sampleRateReader->getSampleRate();
 			m_samplesPerHour = m_sampleRate * 60 * 60;
-			m_script = script;
-			m_danglingProcessors.push_back(m_processor ? m_processor : processor);
-			m_processor = processor;
-			m_reset = true; // Make sure that the next processing cycle triggers a reset
 
-			m_status = Status::LOADING;
+			BankedScript& bankedScript = m_scriptBank[index];
+			bankedScript.script = script;
+			setBankedProcessor(index, processor);
+			bankedScript.costReport = std::make_shared<ProcessorCostReport>(processor->getCostReport());
+			bankedScript.memoryReport = std::make_shared<ProcessorMemoryReport>(processor->getMemoryReport());
+
+			if (index == m_activeScript) {
+				m_reset = true; // Make sure that the next processing cycle triggers a reset
+
+				m_status = Status::LOADING;
+			}
 		}
 	}
 
@@ -45,10 +118,17 @@ const std::vector<ValidationError> TimeSeqCore::loadScript(const std::string& sc
 }
 
 void TimeSeqCore::reloadScript() {
-	if (m_script) {
-		std::vector<ValidationError> validationErrors;
-		m_danglingProcessors.push_back(m_processor);
-		m_processor = m_processorLoader->loadScript(m_script, validationErrors);
+	for (int i = 0; i < SCRIPT_BANK_SIZE; i++) {
+		BankedScript& bankedScript = m_scriptBank[i];
+		if (bankedScript.script) {
+			std::vector<ValidationError> validationErrors;
+			setBankedProcessor(i, m_processorLoader->loadScript(bankedScript.script, validationErrors));
+			bankedScript.costReport = bankedScript.processor ? std::make_shared<ProcessorCostReport>(bankedScript.processor->getCostReport()) : nullptr;
+			bankedScript.memoryReport = bankedScript.processor ? std::make_shared<ProcessorMemoryReport>(bankedScript.processor->getMemoryReport()) : nullptr;
+		}
+	}
+
+	if (m_scriptBank[m_activeScript].script) {
 		m_sampleRate = m_sampleRateReader->getSampleRate();
 		m_reset = true;
 
@@ -61,10 +141,30 @@ void TimeSeqCore::reloadScript() {
 }
 
 void TimeSeqCore::clearScript() {
-	m_status = Status::LOADING;
-	m_danglingProcessors.push_back(m_processor);
-	m_processor.reset();
-	m_script.reset();
+	clearScript(m_activeScript);
+}
+
+void TimeSeqCore::clearScript(int index) {
+	setBankedProcessor(index, nullptr);
+	m_scriptBank[index] = BankedScript();
+
+	if (index == m_activeScript) {
+		m_status = Status::LOADING;
+	}
+}
+
+void TimeSeqCore::selectScript(int index) {
+	if ((index >= 0) && (index < SCRIPT_BANK_SIZE)) {
+		m_selectedScript = index;
+	}
+}
+
+int TimeSeqCore::getActiveScript() const {
+	return m_activeScript;
+}
+
+bool TimeSeqCore::hasScript(int index) const {
+	return (index >= 0) && (index < SCRIPT_BANK_SIZE) && (m_scriptBank[index].script);
 }
 
 TimeSeqCore::Status TimeSeqCore::getStatus() const {
@@ -73,7 +173,8 @@ TimeSeqCore::Status TimeSeqCore::getStatus() const {
 
 void TimeSeqCore::start(int sampleDelay) {
 	if (m_status != Status::RUNNING) {
-		if (m_processor) {
+		// Use the script that will be active once processing starts
+		if (m_scriptBank[m_selectedScript].processor) {
 			m_status = Status::RUNNING;
 			m_startSampleDelay = sampleDelay;
 		} else {
@@ -84,7 +185,7 @@ void TimeSeqCore::start(int sampleDelay) {
 
 void TimeSeqCore::pause() {
 	m_startSampleDelay = 0;
-	if (m_processor) {
+	if (m_scriptBank[m_activeScript].processor) {
 		m_status = Status::PAUSED;
 	} else {
 		m_status = Status::EMPTY;
@@ -95,26 +196,57 @@ void TimeSeqCore::reset() {
 	m_reset = true;
 }
 
+void TimeSeqCore::seek(uint64_t samples) {
+	m_seekSamples.store(samples, std::memory_order_relaxed);
+	m_seek.store(true, std::memory_order_release);
+}
+
+void TimeSeqCore::setRandomSeed(bool fixed, uint64_t seed) {
+	m_fixedRandomSeed = fixed;
+	m_randomSeed = seed;
+}
+
+void TimeSeqCore::setFastMath(bool fastMath) {
+	m_processorLoader->setFastMath(fastMath);
+	reloadScript();
+}
+
 void TimeSeqCore::process(int rate) {
 	if (m_startSampleDelay > 0) {
 		// Don't process until the sample delay reaches 0
 		m_startSampleDelay--;
 	} else {
+		if (m_selectedScript != m_activeScript) {
+			processSelectScript();
+		}
 		if (m_reset) {
 			processReset();
 		}
+		if (m_seek.exchange(false, std::memory_order_acquire)) {
+			processSeek();
+		}
 
 		// We can safely use this processor instance outside of the smart pointer, since the m_danglingProcessors vector
-		// keeps references to the processors as they are replaced by a (re)load until we clear it at the end of this method.
-		Processor* processor = m_processor.get();
+		// keeps references to the processors as they are replaced by a (re)load until this process cycle is completed.
+		Processor* processor = getActiveProcessor();
 
 		if (m_status == Status::LOADING) {
 				m_status = processor ? Status::PAUSED : Status::EMPTY;
 		} else if ((m_status == Status::RUNNING) && (processor)) {
 			for (int i = 0; i < rate; i++) {
+				// A script action may have selected another script during the previous sample
+				if (m_selectedScript != m_activeScript) {
+					processSelectScript();
+					processor = getActiveProcessor();
+					if (!processor) {
+						break;
+					}
+				}
+
 				m_triggerIdx = !m_triggerIdx; // Triggers that were set in the previous process become the active triggers now
 				m_triggers[!m_triggerIdx].clear();
 				processor->process();
+				m_eventTracer.advance();
 
 				m_elapsedSamples++;
 				if (m_elapsedSamples >= m_samplesPerHour) {
@@ -122,12 +254,10 @@ void TimeSeqCore::process(int rate) {
 				}
 			}
 		}
-
-		// If there is an old processor still dangling, it can be released now
-		if (m_danglingProcessors.size() > 0) {
-			m_danglingProcessors.clear();
-		}
 	}
+
+	// Any processor that was replaced before this cycle started is no longer in use, so the UI thread can release it
+	m_processCycles.fetch_add(1, std::memory_order_release);
 }
 
 float TimeSeqCore::getVariable(const std::string& name) const {
@@ -140,6 +270,7 @@ float TimeSeqCore::getVariable(const std::string& name) const {
 }
 
 void TimeSeqCore::setVariable(const std::string& name, float value) {
+	m_eventTracer.record(TraceEventType::VARIABLE_SET, this, name, value);
 	if (value == 0.f) {
 		std::unordered_map<std::string, float>::iterator it = m_variables.find(name);
 		if (it != m_variables.end()) {
@@ -156,9 +287,29 @@ const std::vector<std::string>& TimeSeqCore::getTriggers() const {
 
 void TimeSeqCore::setTrigger(const std::string& name) {
 	m_triggers[!m_triggerIdx].push_back(name);
+	m_eventTracer.record(TraceEventType::TRIGGER, this, name);
 	m_eventListener->triggerTriggered();
 }
 
+const ProcessorCostReport* TimeSeqCore::getCostReport() const {
+	return m_scriptBank[m_activeScript].costReport.get();
+}
+
+const ProcessorMemoryReport* TimeSeqCore::getMemoryReport() const {
+	return m_scriptBank[m_activeScript].memoryReport.get();
+}
+
+EventTracer& TimeSeqCore::getEventTracer() {
+	return m_eventTracer;
+}
+
+#ifdef __NT_TIMESEQ_PROFILING__
+	std::vector<ProfilerEntry> TimeSeqCore::getProfile() const {
+		const std::shared_ptr<Processor>& processor = m_scriptBank[m_activeScript].processor;
+		return processor ? processor->getProfile() : std::vector<ProfilerEntry>();
+	}
+#endif
+
 uint32_t TimeSeqCore::getCurrentSampleRate() const {
 	return m_sampleRate;
 }
@@ -171,6 +322,14 @@ void TimeSeqCore::resetElapsedSamples() {
 	m_elapsedSamples = 0;
 }
 
+void TimeSeqCore::getProgress(ProgressSnapshot& snapshot) const {
+	snapshot.status = m_status;
+	snapshot.sampleRate = m_sampleRate;
+	snapshot.elapsedSamples = m_elapsedSamples;
+	Processor* processor = getActiveProcessor();
+	snapshot.laneCount = processor ? processor->getLaneProgress(snapshot.lanes.data(), PROGRESS_LANES) : 0;
+}
+
 void TimeSeqCore::processReset() {
 	m_eventListener->scriptReset();
 
@@ -178,11 +337,69 @@ void TimeSeqCore::processReset() {
 	m_triggers[1].clear();
 	m_variables.clear();
 
-	if (m_processor) {
-		m_processor->reset();
+	if (m_fixedRandomSeed) {
+		m_processorLoader->seedRandomValues(m_randomSeed);
+	}
+
+	Processor* processor = getActiveProcessor();
+	if (processor) {
+		processor->reset();
 	}
 
 	resetElapsedSamples();
 
 	m_reset = false;
 }
+
+void TimeSeqCore::processSeek() {
+	processReset();
+
+	uint64_t seekSamples = m_seekSamples.load(std::memory_order_relaxed);
+	Processor* processor = getActiveProcessor();
+	if (processor) {
+		processor->seek(seekSamples);
+	}
+
+	m_elapsedSamples = seekSamples % m_samplesPerHour;
+}
+
+void TimeSeqCore::processSelectScript() {
+	// The bank keeps the processors alive, so switching between them only changes the active slot index
+	m_activeScript.store(m_selectedScript.load(std::memory_order_relaxed), std::memory_order_release);
+	Processor* processor = getActiveProcessor();
+
+	if (processor) {
+		// A pending reset or seek will reset the processor anyway
+		if ((!m_reset) && (!m_seek.load(std::memory_order_acquire))) {
+			processor->reset();
+		}
+		if (m_status == Status::EMPTY) {
+			m_status = Status::PAUSED;
+		}
+	} else if (m_status != Status::LOADING) {
+		m_status = Status::EMPTY;
+	}
+}
+
+Processor* TimeSeqCore::getActiveProcessor() const {
+	return m_bankedProcessors[m_activeScript.load(std::memory_order_acquire)].load(std::memory_order_acquire);
+}
+
+void TimeSeqCore::setBankedProcessor(int index, std::shared_ptr<Processor> processor) {
+	releaseDanglingProcessors();
+
+	BankedScript& bankedScript = m_scriptBank[index];
+	if (bankedScript.processor) {
+		m_danglingProcessors.push_back({ bankedScript.processor, m_processCycles.load(std::memory_order_acquire) });
+	}
+	bankedScript.processor = processor;
+	m_bankedProcessors[index].store(processor.get(), std::memory_order_release);
+}
+
+void TimeSeqCore::releaseDanglingProcessors() {
+	uint64_t processCycles = m_processCycles.load(std::memory_order_acquire);
+	m_danglingProcessors.erase(std::remove_if(m_danglingProcessors.begin(), m_danglingProcessors.end(), [processCycles](const DanglingProcessor& danglingProcessor) {
+		// The processing cycle that was running when the processor got replaced has completed
+		return danglingProcessor.processCycle < processCycles;
+	}), m_danglingProcessors.end());
+}
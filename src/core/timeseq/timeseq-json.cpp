@@ -6,13 +6,33 @@ using namespace timeseq;
 using namespace nlohmann;
 
 
+MemoryStreamBuffer::MemoryStreamBuffer(const char* data, size_t size) : m_data(data), m_size(size) {
+	char* begin = const_cast<char*>(data);
+	setg(begin, begin, begin + size);
+}
+
+const char* MemoryStreamBuffer::data() const {
+	return m_data;
+}
+
+size_t MemoryStreamBuffer::size() const {
+	return m_size;
+}
+
+
 JsonLoader::~JsonLoader() {}
 
 shared_ptr<json> JsonLoader::loadJson(istream& inputStream, vector<ValidationError> &validationErrors) {
 	shared_ptr<json> json;
 
 	try {
-		json = make_shared<nlohmann::json>(json::parse(inputStream));
+		// Parse memory directly instead of going through the stream one character at a time
+		MemoryStreamBuffer* memoryStreamBuffer = dynamic_cast<MemoryStreamBuffer*>(inputStream.rdbuf());
+		if (memoryStreamBuffer != nullptr) {
+			json = make_shared<nlohmann::json>(json::parse(memoryStreamBuffer->data(), memoryStreamBuffer->data() + memoryStreamBuffer->size()));
+		} else {
+			json = make_shared<nlohmann::json>(json::parse(inputStream));
+		}
 	} catch (const json::parse_error& error) {
 		string location = "/";
 		string message = error.what();
@@ -0,0 +1,101 @@
+#include "core/timeseq-tracer.hpp"
+#include "nlohmann/json.hpp"
+#include <vector>
+#include <unordered_map>
+
+using namespace std;
+using namespace timeseq;
+using json = nlohmann::json;
+
+
+namespace {
+	// Each type of instant event is shown on its own track
+	const char* TRACK_NAMES[] = { "segments", "lanes", "triggers", "variables", "sequences", "asserts" };
+
+	int getTrack(TraceEventType type) {
+		switch (type) {
+			case SEGMENT_START:
+			case SEGMENT_END:
+				return 0;
+			case LANE_LOOP:
+				return 1;
+			case TRIGGER:
+				return 2;
+			case VARIABLE_SET:
+				return 3;
+			case SEQUENCE_MOVE:
+				return 4;
+			case ASSERT_FAILED:
+				return 5;
+		}
+		return 0;
+	}
+}
+
+string EventTracer::getChromeTrace(float sampleRate) const {
+	// The processing thread may overwrite the oldest events while they are being copied,
+	// so only keep the events that were certainly not overwritten once the copy is done.
+	uint64_t end = m_count.load(memory_order_acquire);
+	uint64_t start = max(m_start.load(memory_order_relaxed), end > TIMESEQ_TRACE_CAPACITY ? end - TIMESEQ_TRACE_CAPACITY : 0);
+	vector<TraceEvent> events;
+	events.reserve(end - start);
+	for (uint64_t i = start; i < end; i++) {
+		events.push_back(m_events[i & (TIMESEQ_TRACE_CAPACITY - 1)]);
+	}
+	// The slot of the next event may already be in the middle of being written, which overwrites the event that is
+	// TIMESEQ_TRACE_CAPACITY events before it, so that one is dropped as well.
+	uint64_t after = m_count.load(memory_order_acquire) + 1;
+	if (after > TIMESEQ_TRACE_CAPACITY && after - TIMESEQ_TRACE_CAPACITY > start) {
+		events.erase(events.begin(), events.begin() + min((uint64_t) events.size(), after - TIMESEQ_TRACE_CAPACITY - start));
+	}
+
+	json traceEvents = json::array();
+	for (int i = 0; i < (int) (sizeof(TRACK_NAMES) / sizeof(TRACK_NAMES[0])); i++) {
+		traceEvents.push_back({ { "name", "thread_name" }, { "ph", "M" }, { "pid", 0 }, { "tid", i }, { "args", { { "name", TRACK_NAMES[i] } } } });
+	}
+
+	// Number the processor instances in the order that they first occur in the trace
+	unordered_map<const void*, int> sources;
+	for (const TraceEvent& event : events) {
+		int source = sources.emplace(event.source, (int) sources.size()).first->second;
+		json traceEvent = {
+			{ "name", event.id },
+			{ "ts", (double) event.sample * 1000000. / sampleRate },
+			{ "pid", 0 },
+			{ "tid", getTrack(event.type) }
+		};
+
+		switch (event.type) {
+			case SEGMENT_START:
+			case SEGMENT_END:
+				// Segments of different lanes can overlap, so they are traced as async slices, matched on their segment instance
+				if (traceEvent["name"] == "") {
+					traceEvent["name"] = "segment " + to_string(source);
+				}
+				traceEvent["ph"] = event.type == SEGMENT_START ? "b" : "e";
+				traceEvent["cat"] = "segment";
+				traceEvent["id"] = source;
+				break;
+			case LANE_LOOP:
+				traceEvent["name"] = "lane " + to_string(source);
+				traceEvent["ph"] = "i";
+				traceEvent["s"] = "t";
+				break;
+			case VARIABLE_SET:
+			case SEQUENCE_MOVE:
+				traceEvent["ph"] = "i";
+				traceEvent["s"] = "t";
+				traceEvent["args"] = { { event.type == VARIABLE_SET ? "value" : "position", event.value } };
+				break;
+			case TRIGGER:
+			case ASSERT_FAILED:
+				traceEvent["ph"] = "i";
+				traceEvent["s"] = "t";
+				break;
+		}
+
+		traceEvents.push_back(traceEvent);
+	}
+
+	return json({ { "traceEvents", traceEvents }, { "displayTimeUnit", "ms" } }).dump();
+}
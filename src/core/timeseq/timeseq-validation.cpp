@@ -23,11 +23,15 @@ const string timeseq::createValidationErrorMessage(ValidationErrorCode code, ...
 	return errorMessage.str();
 }
 
-const string timeseq::createValidationErrorLocation(const vector<string>& location) {
+const string timeseq::createValidationErrorLocation(const ValidationLocation& location) {
 	ostringstream errorLocation;
-	for (const string& entry : location) {
+	for (const ValidationLocation::Entry& entry : location) {
 		errorLocation << "/";
-		errorLocation << entry;
+		if (entry.name != nullptr) {
+			errorLocation << entry.name;
+		} else {
+			errorLocation << entry.index;
+		}
 	}
 
 	if (errorLocation.tellp() == 0) {
@@ -129,6 +129,13 @@ void RameligModule::process(const ProcessArgs& args) {
 	RameligExpanderModule* expander = getRameligExpander();
 	bool guiding[16] = { false };
 
+	// Each channel gets its own seed, so the channels don't produce the same melody
+	if ((randomSeedChanged()) && (hasFixedRandomSeed())) {
+		for (int i = 0; i < 16; i++) {
+			m_rameligCore[i]->seed((uint64_t) getRandomSeed() + i);
+		}
+	}
+
 	// Make sure the output polyphony is up to date
 	updatePolyphony(false, getRameligExpander());
 
@@ -458,6 +465,7 @@ void RameligWidget::appendContextMenu(Menu* menu) {
 			menu->addChild(createCheckMenuItem("Chromatic (1V/Oct)", "", [scaleMode]() { return scaleMode == RameligModule::ScaleMode::SCALE_MODE_CHROMATIC; }, [this, scaleMode]() { this->setScaleMode(RameligModule::ScaleMode::SCALE_MODE_CHROMATIC); }));
 		}
 	));
+	appendRandomSeedMenu(menu);
 }
 
 void RameligWidget::setScaleMode(RameligModule::ScaleMode scaleMode) {
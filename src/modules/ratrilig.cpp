@@ -67,9 +67,20 @@ void RatriligModule::process(const ProcessArgs& args) {
 	bool resetPushed = m_buttonReset.process(params[PARAM_RESET].getValue());
 	bool oneTriggered = false;
 
+	// Each channel gets its own seed, so the channels don't produce the same rhythm
+	if ((randomSeedChanged()) && (hasFixedRandomSeed())) {
+		for (int channel = 0; channel < 16; channel++) {
+			m_ratriligCore[channel]->seed((uint64_t) getRandomSeed() + channel);
+		}
+	}
+
 	for (int channel = 0; channel < m_channelCount; channel++) {
 		if ((m_inputReset[channel].process(inputs[IN_RESET].getVoltage(channel))) || (resetPushed)) {
 			m_ratriligCore[channel]->reset();
+			// With a fixed seed, each reset restarts the same rhythm
+			if (hasFixedRandomSeed()) {
+				m_ratriligCore[channel]->seed((uint64_t) getRandomSeed() + channel);
+			}
 		}
 		if ((m_inputTrigger[channel].process(inputs[IN_GATE].getVoltage(channel))) || (triggerPushed)) {
 			data.density = getValue(PARAM_DENSITY, IN_DENSITY, channel) / 100.f;
@@ -404,5 +415,12 @@ RatriligWidget::RatriligWidget(RatriligModule* module): NTModuleWidget(dynamic_c
 }
 
 
+void RatriligWidget::appendContextMenu(Menu* menu) {
+	NTModuleWidget::appendContextMenu(menu);
+
+	menu->addChild(new MenuSeparator);
+	appendRandomSeedMenu(menu);
+}
+
 
 Model* modelRatrilig = createModel<RatriligModule, RatriligWidget>("ratrilig");
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "modules/solim-input-octaver.hpp"
+#include "modules/solim.hpp"
 #include "components/ntport.hpp"
 #include "components/dualbefacoswitch.hpp"
 #include "components/lights.hpp"
@@ -60,6 +61,10 @@ void SolimInputOctaverModule::draw(const widget::Widget::DrawArgs& args) {
 	}
 }
 
+void SolimInputOctaverModule::onExpanderChange(const ExpanderChangeEvent& event) {
+	SolimModule::expanderChainChanged(this);
+}
+
 SolimInputOctaverWidget::SolimInputOctaverWidget(SolimInputOctaverModule* module): NTModuleWidget(dynamic_cast<NTModule*>(module), "solim-input-octaver") {
 	float y = 41.5f;
 	float yDelta = 40;
@@ -1,4 +1,5 @@
 #include "modules/solim-input.hpp"
+#include "modules/solim.hpp"
 #include "components/ntport.hpp"
 #include "components/lights.hpp"
 
@@ -47,6 +48,10 @@ void SolimInputModule::draw(const widget::Widget::DrawArgs& args) {
 	}
 }
 
+void SolimInputModule::onExpanderChange(const ExpanderChangeEvent& event) {
+	SolimModule::expanderChainChanged(this);
+}
+
 SolimInputWidget::SolimInputWidget(SolimInputModule* module): NTModuleWidget(dynamic_cast<NTModule*>(module), "solim-input") {
 	float xIn = 22.5;
 	float y = 41.5;
@@ -1,4 +1,5 @@
 #include "modules/solim-output-octaver.hpp"
+#include "modules/solim.hpp"
 #include "components/ntport.hpp"
 #include "components/lights.hpp"
 
@@ -81,6 +82,10 @@ void SolimOutputOctaverModule::draw(const widget::Widget::DrawArgs& args) {
 	}
 }
 
+void SolimOutputOctaverModule::onExpanderChange(const ExpanderChangeEvent& event) {
+	SolimModule::expanderChainChanged(this);
+}
+
 SolimOutputOctaverModule::SortMode SolimOutputOctaverModule::getSortMode() {
 	return m_sortMode;
 }
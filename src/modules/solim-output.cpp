@@ -1,4 +1,5 @@
 #include "modules/solim-output.hpp"
+#include "modules/solim.hpp"
 #include "components/ntport.hpp"
 #include "components/lights.hpp"
 
@@ -70,6 +71,10 @@ void SolimOutputModule::draw(const widget::Widget::DrawArgs& args) {
 	}
 }
 
+void SolimOutputModule::onExpanderChange(const ExpanderChangeEvent& event) {
+	SolimModule::expanderChainChanged(this);
+}
+
 void SolimOutputModule::onPortChange(const PortChangeEvent& event) {
 	for (int i = 0; i < 8; i++) {
 		m_connectedPorts[i] = outputs[i].isConnected();
@@ -82,6 +87,8 @@ SolimOutputMode SolimOutputModule::getOutputMode() {
 
 void SolimOutputModule::setOutputMode(SolimOutputMode outputMode) {
 	m_outputMode = outputMode;
+	// The output modes are part of the expanders that the Solim module detected
+	SolimModule::expanderChainChanged(this);
 }
 
 std::array<bool, 8>& SolimOutputModule::getConnectedPorts() {
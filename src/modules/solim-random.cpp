@@ -1,4 +1,5 @@
 #include "modules/solim-random.hpp"
+#include "modules/solim.hpp"
 #include "components/ntport.hpp"
 #include "components/lights.hpp"
 
@@ -39,6 +40,32 @@ void SolimRandomModule::process(const ProcessArgs& args) {
 }
 
 void SolimRandomModule::draw(const widget::Widget::DrawArgs& args) {
+	if (m_expandersChanged.exchange(false)) {
+		detectSolimModules();
+	}
+
+	if (m_hasLeftSolimModule) {
+		lights[LIGHT_CONNECTED_LEFT].setBrightness(1.f);
+	} else {
+		lights[LIGHT_CONNECTED_LEFT].setBrightness(0.f);
+	}
+	if (m_hasRightSolimModule) {
+		lights[LIGHT_CONNECTED_RIGHT].setBrightness(1.f);
+	} else {
+		lights[LIGHT_CONNECTED_RIGHT].setBrightness(0.f);
+	}
+}
+
+void SolimRandomModule::onExpanderChange(const ExpanderChangeEvent& event) {
+	m_expandersChanged = true;
+	SolimModule::expanderChainChanged(this);
+}
+
+void SolimRandomModule::expandersChanged() {
+	m_expandersChanged = true;
+}
+
+void SolimRandomModule::detectSolimModules() {
 	int inputCount = 0;
 	bool hasRightSolimModule = false;
 	bool encounteredInputOctaver = false;
@@ -102,16 +129,8 @@ void SolimRandomModule::draw(const widget::Widget::DrawArgs& args) {
 		expanderModule = &expanderModule->module->getLeftExpander();
 	}
 
-	if (hasLeftSolimModule) {
-		lights[LIGHT_CONNECTED_LEFT].setBrightness(1.f);
-	} else {
-		lights[LIGHT_CONNECTED_LEFT].setBrightness(0.f);
-	}
-	if (hasRightSolimModule) {
-		lights[LIGHT_CONNECTED_RIGHT].setBrightness(1.f);
-	} else {
-		lights[LIGHT_CONNECTED_RIGHT].setBrightness(0.f);
-	}
+	m_hasLeftSolimModule = hasLeftSolimModule;
+	m_hasRightSolimModule = hasRightSolimModule;
 }
 
 bool SolimRandomModule::processTriggers(ParamId paramId, InputId inputId, TriggerId triggerId, std::array<int, 8>& counters) {
@@ -7,6 +7,7 @@
 #include "modules/solim-output-octaver.hpp"
 #include "util/notes.hpp"
 
+extern Model* modelSolim;
 extern Model* modelSolimInput;
 extern Model* modelSolimInputOctaver;
 extern Model* modelSolimOutput;
@@ -93,6 +94,10 @@ void SolimModule::process(const ProcessArgs& args) {
 		}
 	#endif
 
+	if ((randomSeedChanged()) && (hasFixedRandomSeed())) {
+		m_solimCore->seed(getRandomSeed());
+	}
+
 	// Determine if we actually process in this invocation based on the process rate and clock divider
 	bool process = false;
 	if (m_processRate == ProcessRate::DIVIDED) {
@@ -102,7 +107,9 @@ void SolimModule::process(const ProcessArgs& args) {
 	}
 
 	if (process) {
-		detectExpanders();
+		if (m_expandersChanged.exchange(false)) {
+			detectExpanders();
+		}
 		readValues();
 		// If there is a randomizer module, check if there have been randomize triggers
 		if (m_solimExpanders.solimRandom != nullptr) {
@@ -180,6 +187,31 @@ void SolimModule::onPortChange(const PortChangeEvent& event) {
 	}
 }
 
+void SolimModule::onExpanderChange(const ExpanderChangeEvent& event) {
+	m_expandersChanged = true;
+	expanderChainChanged(this);
+}
+
+void SolimModule::expanderChainChanged(Module* module) {
+	// A change anywhere in the chain can change the expanders of the Solim and Solim Random modules in it, but only the
+	// direct neighbours of the change receive an event. So walk the Solim modules in both directions to mark them all.
+	for (int side = 0; side < 2; side++) {
+		Module* chainModule = module;
+		while (chainModule != nullptr) {
+			Model* model = chainModule->getModel();
+			if (model == modelSolim) {
+				reinterpret_cast<SolimModule*>(chainModule)->m_expandersChanged = true;
+			} else if (model == modelSolimRandom) {
+				reinterpret_cast<SolimRandomModule*>(chainModule)->expandersChanged();
+			} else if ((chainModule != module) && (model != modelSolimInput) && (model != modelSolimInputOctaver) && (model != modelSolimOutput) && (model != modelSolimOutputOctaver)) {
+				break;
+			}
+
+			chainModule = side == 0 ? chainModule->getLeftExpander().module : chainModule->getRightExpander().module;
+		}
+	}
+}
+
 SolimModule::ProcessRate SolimModule::getProcessRate() {
 	return m_processRate;
 }
@@ -193,6 +225,8 @@ SolimOutputMode SolimModule::getOutputMode() {
 
 void SolimModule::setOutputMode(SolimOutputMode outputMode) {
 	m_outputMode = outputMode;
+	// The output modes are part of the detected expanders
+	m_expandersChanged = true;
 }
 
 std::array<bool, 8>& SolimModule::getConnectedPorts() {
@@ -464,6 +498,7 @@ void SolimWidget::appendContextMenu(Menu* menu) {
 
 	SolimOutputMode outputMode = getModule() ? dynamic_cast<SolimModule *>(getModule())->getOutputMode() : SolimOutputMode::OUTPUT_MODE_MONOPHONIC;
 	menu->addChild(createCheckMenuItem("Polyphonic output", "", [outputMode]() { return outputMode == SolimOutputMode::OUTPUT_MODE_POLYPHONIC; }, [this]() { switchOutputMode(); }));
+	appendRandomSeedMenu(menu);
 }
 
 void SolimWidget::switchProcessRate() {
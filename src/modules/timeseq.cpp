@@ -1,15 +1,22 @@
 #include "modules/timeseq.hpp"
+#include "core/timeseq-processor.hpp"
+#include "core/timeseq-bus.hpp"
+#include "util/mappedfile.hpp"
 #include "components/ntport.hpp"
 #include "components/timeseq-display.hpp"
 #include "components/leddisplay.hpp"
 #include "components/lights.hpp"
 #include <osdialog.h>
 
-#define TO_CHANNEL_PORT_IDENTIFIER(channel, port) ((channel << 5) + port)
+// Scripts up to this size are also stored as plain text in the patch property that older TimeSeq versions read
+#define LEGACY_SCRIPT_MAX_SIZE (64 * 1024)
+// The format marker of a script bank slot that is zlib-compressed and base64-encoded
+#define SCRIPT_ENCODING_ZLIB_BASE64 "zlib-base64"
+// The largest decompressed script size that is accepted from the patch data, to protect against corrupt sizes
+#define SCRIPT_MAX_SIZE (64 * 1024 * 1024)
 
-
-TimeSeqModule::TimeSeqModule() {
-	m_timeSeqCore = new timeseq::TimeSeqCore(this, this, this, this);
+TimeSeqModule::TimeSeqModule() : m_portBuffer(this) {
+	m_timeSeqCore = new timeseq::TimeSeqCore(&m_portBuffer, this, this, this);
 
 	config(NUM_PARAMS, NUM_INPUTS, NUM_OUTPUTS, NUM_LIGHTS);
 	for (int i = 0; i < 8; i++) {
@@ -37,6 +44,7 @@ TimeSeqModule::TimeSeqModule() {
 
 	m_portChannelChangeClockDivider.setDivision(48000 / 15);
 
+	resetOutputs();
 	resetUi();
 }
 
@@ -46,32 +54,139 @@ TimeSeqModule::~TimeSeqModule() {
 
 json_t *TimeSeqModule::dataToJson() {
 	json_t *rootJ = NTModule::dataToJson();
-	if (m_script) {
-		json_object_set_new(rootJ, "ntTimeSeqScript", json_string(m_script->c_str()));
+	// Older TimeSeq versions only read the active script as plain text. Large scripts are left out of it to keep patch saves fast.
+	std::shared_ptr<std::string> script = getScript();
+	if ((script) && (script->size() <= LEGACY_SCRIPT_MAX_SIZE)) {
+		json_object_set_new(rootJ, "ntTimeSeqScript", json_string(script->c_str()));
 	} else {
 		json_object_set_new(rootJ, "ntTimeSeqScript", json_string(""));
 	}
+	json_t *scriptBankJ = json_array();
+	for (int i = 0; i < timeseq::TimeSeqCore::SCRIPT_BANK_SIZE; i++) {
+		json_array_append_new(scriptBankJ, scriptToJson(i));
+	}
+	json_object_set_new(rootJ, "ntTimeSeqScriptBank", scriptBankJ);
+	json_object_set_new(rootJ, "ntTimeSeqActiveScript", json_integer(m_timeSeqCore->getActiveScript()));
 	json_object_set_new(rootJ, "ntTimeSeqStatus", json_integer(m_timeSeqCore->getStatus()));
+	json_object_set_new(rootJ, "ntTimeSeqFastMath", json_boolean(m_fastMath));
 	return rootJ;
 }
 
+json_t* TimeSeqModule::scriptToJson(int index) {
+	std::shared_ptr<std::string> script = m_scripts[index];
+	if ((!script) || (script->empty())) {
+		return json_string("");
+	}
+
+	// Compressing a large script takes longer than writing it, so the compressed data is kept until the script changes.
+	if (m_compressedScriptSources[index] != script) {
+		std::vector<uint8_t> compressed = string::compress((const uint8_t*) script->data(), script->size());
+		m_compressedScripts[index] = string::toBase64(compressed);
+		m_compressedScriptSources[index] = script;
+	}
+
+	json_t *scriptJ = json_object();
+	json_object_set_new(scriptJ, "encoding", json_string(SCRIPT_ENCODING_ZLIB_BASE64));
+	json_object_set_new(scriptJ, "size", json_integer(script->size()));
+	json_object_set_new(scriptJ, "data", json_stringn(m_compressedScripts[index].data(), m_compressedScripts[index].size()));
+	return scriptJ;
+}
+
+std::shared_ptr<std::string> TimeSeqModule::scriptFromJson(json_t* scriptJ) {
+	if (!scriptJ) {
+		return nullptr;
+	}
+
+	// Patches saved before the scripts were compressed contain the plain script text
+	if (json_is_string(scriptJ)) {
+		if (json_string_length(scriptJ) == 0) {
+			return nullptr;
+		}
+		return std::make_shared<std::string>(json_string_value(scriptJ), json_string_length(scriptJ));
+	}
+
+	if (!json_is_object(scriptJ)) {
+		return nullptr;
+	}
+	json_t *encodingJ = json_object_get(scriptJ, "encoding");
+	json_t *sizeJ = json_object_get(scriptJ, "size");
+	json_t *dataJ = json_object_get(scriptJ, "data");
+	if ((!json_is_string(encodingJ)) || (strcmp(json_string_value(encodingJ), SCRIPT_ENCODING_ZLIB_BASE64) != 0) || (!json_is_integer(sizeJ)) || (!json_is_string(dataJ))) {
+		WARN("Unsupported TimeSeq script encoding in patch data");
+		return nullptr;
+	}
+
+	json_int_t size = json_integer_value(sizeJ);
+	if (size <= 0) {
+		return nullptr;
+	}
+	if (size > SCRIPT_MAX_SIZE) {
+		WARN("TimeSeq script size %lld in patch data exceeds the maximum of %d bytes", (long long) size, SCRIPT_MAX_SIZE);
+		return nullptr;
+	}
+	try {
+		std::vector<uint8_t> compressed = string::fromBase64(json_string_value(dataJ));
+		std::shared_ptr<std::string> script = std::make_shared<std::string>(size, '\0');
+		size_t scriptSize = script->size();
+		string::uncompress(compressed.data(), compressed.size(), (uint8_t*) &(*script)[0], &scriptSize);
+		if (scriptSize != script->size()) {
+			WARN("TimeSeq script in patch data decompressed to %zu bytes instead of %lld bytes", scriptSize, (long long) size);
+			return nullptr;
+		}
+		return script;
+	} catch (Exception& e) {
+		WARN("Could not decompress TimeSeq script from patch data: %s", e.what());
+		return nullptr;
+	}
+}
+
 void TimeSeqModule::dataFromJson(json_t *rootJ) {
 	NTModule::dataFromJson(rootJ);
 
-	json_t *ntTimeSeqScript = json_object_get(rootJ, "ntTimeSeqScript");
-	if (ntTimeSeqScript) {
-		if (json_is_string(ntTimeSeqScript)) {
-			const char* script = json_string_value(ntTimeSeqScript);
-			if (strlen(script) > 0) {
-				std::shared_ptr<std::string> script = std::make_shared<std::string>(json_string_value(ntTimeSeqScript));
-				std::string result = loadScript(script);
-				if ((result.length() > 0) && (!m_script)) {
-					// If the loading failed, and there is no script present yet, keep a copy of the script data so the user can copy it.
-					// It's most likely a script that was saved in a patch, and is no longer valid for some reason, and we shouldn't just dump it.
-					m_script = script;
+	// The calculation mode must be known before the script is loaded
+	json_t *ntTimeSeqFastMath = json_object_get(rootJ, "ntTimeSeqFastMath");
+	if (ntTimeSeqFastMath) {
+		m_fastMath = json_boolean_value(ntTimeSeqFastMath);
+		m_timeSeqCore->setFastMath(m_fastMath);
+	}
+
+	// Patches that were saved before the script bank existed only contain the active script
+	json_t *ntTimeSeqScriptBank = json_object_get(rootJ, "ntTimeSeqScriptBank");
+	if ((ntTimeSeqScriptBank) && (json_is_array(ntTimeSeqScriptBank))) {
+		for (int i = 0; i < timeseq::TimeSeqCore::SCRIPT_BANK_SIZE; i++) {
+			std::shared_ptr<std::string> script = scriptFromJson(json_array_get(ntTimeSeqScriptBank, i));
+			if (script) {
+				std::string result = loadScript(i, script);
+				if ((result.length() > 0) && (!m_scripts[i])) {
+					// Keep a copy of the script data that failed to load, so the user can still copy it.
+					m_scripts[i] = script;
+				}
+			} else if (m_scripts[i]) {
+				m_timeSeqCore->clearScript(i);
+				m_scripts[i].reset();
+			}
+		}
+
+		json_t *ntTimeSeqActiveScript = json_object_get(rootJ, "ntTimeSeqActiveScript");
+		if (ntTimeSeqActiveScript) {
+			selectScript(json_integer_value(ntTimeSeqActiveScript));
+		}
+	} else {
+		json_t *ntTimeSeqScript = json_object_get(rootJ, "ntTimeSeqScript");
+		if (ntTimeSeqScript) {
+			if (json_is_string(ntTimeSeqScript)) {
+				const char* script = json_string_value(ntTimeSeqScript);
+				if (strlen(script) > 0) {
+					std::shared_ptr<std::string> script = std::make_shared<std::string>(json_string_value(ntTimeSeqScript));
+					std::string result = loadScript(script);
+					if ((result.length() > 0) && (!getScript())) {
+						// If the loading failed, and there is no script present yet, keep a copy of the script data so the user can copy it.
+						// It's most likely a script that was saved in a patch, and is no longer valid for some reason, and we shouldn't just dump it.
+						m_scripts[m_timeSeqCore->getActiveScript()] = script;
+					}
+				} else {
+					clearScript();
 				}
-			} else {
-				clearScript();
 			}
 		}
 	}
@@ -86,6 +201,13 @@ void TimeSeqModule::dataFromJson(json_t *rootJ) {
 }
 
 void TimeSeqModule::process(const ProcessArgs& args) {
+	if (randomSeedChanged()) {
+		m_timeSeqCore->setRandomSeed(hasFixedRandomSeed(), getRandomSeed());
+	}
+
+	// All TimeSeq instances set the same engine frame, so bus variables written in this frame are read in the next one
+	timeseq::VariableBus::global().setFrame(args.frame);
+
 	// Reset the timer if requested
 	if (m_buttonTrigger[TriggerId::TRIG_RESET_CLOCK].process(params[ParamId::PARAM_RESET_CLOCK].getValue())) {
 		m_timeSeqCore->resetElapsedSamples();
@@ -114,6 +236,9 @@ void TimeSeqModule::process(const ProcessArgs& args) {
 		m_timeSeqCore->reset();
 	}
 
+	// Take a snapshot of the input voltages for the processors to use during this sample
+	captureInputs();
+
 	// Check the rate to see how many process calls should actually be done on the core.
 	int rate = getRate();
 	if (rate < -1) {
@@ -133,18 +258,15 @@ void TimeSeqModule::process(const ProcessArgs& args) {
 		m_timeSeqCore->process(1);
 	}
 
-	// Check if we should update the UI visualization of the changed voltages in this cycle
-	if ((m_timeSeqCore->getStatus() == timeseq::TimeSeqCore::Status::RUNNING) && (m_portChannelChangeClockDivider.process())) {
-		if (m_timeSeqDisplay != nullptr) {
-			if (m_changedPortChannelVoltages.size() > 0) {
-				// If there are changed voltages since the last time we checked, apply them now.
-				m_timeSeqDisplay->processChangedVoltages(m_changedPortChannelVoltages, m_outputVoltages);
-				m_changedPortChannelVoltages.clear();
-			} else {
-				// No port voltages have changed, so just age the existing voltages.
-				m_timeSeqDisplay->ageVoltages();
-			}
+	// Write the output voltages that were changed during this sample to the actual ports
+	flushOutputs();
+
+	// Check if we should publish the changed voltages and the progress for the UI visualization in this cycle
+	if (m_portChannelChangeClockDivider.process()) {
+		if (m_timeSeqCore->getStatus() == timeseq::TimeSeqCore::Status::RUNNING) {
+			publishVoltageSnapshot();
 		}
+		publishProgressSnapshot();
 	}
 
 	// Update the Run and Reset outputs
@@ -161,15 +283,36 @@ void TimeSeqModule::draw(const widget::Widget::DrawArgs& args) {
 	lights[LightId::LIGHT_TRIGGER_TRIGGERED].setBrightnessSmooth(m_triggerTriggered, .01f);
 	m_triggerTriggered = false;
 
+	// Apply the most recent voltage snapshot (if any) to the voltage display
+	if ((m_timeSeqDisplay != nullptr) && (m_voltageSnapshots.consume())) {
+		const TimeSeqVoltageSnapshot& snapshot = m_voltageSnapshots.getReadBuffer();
+		bool changed = false;
+		for (uint16_t changedChannels : snapshot.changedChannels) {
+			changed |= changedChannels != 0;
+		}
+
+		if (changed) {
+			// If there are changed voltages since the previous snapshot, apply them now.
+			m_timeSeqDisplay->processChangedVoltages(snapshot.changedChannels, snapshot.voltages);
+		} else {
+			// No port voltages have changed, so just age the existing voltages.
+			m_timeSeqDisplay->ageVoltages();
+		}
+	}
+
+	// Pass the most recent progress (if any) to the status display
+	if ((m_progressSnapshots.consume()) && (m_timeSeqDisplay != nullptr)) {
+		m_timeSeqDisplay->processProgress(m_progressSnapshots.getReadBuffer());
+	}
+	const timeseq::TimeSeqCore::ProgressSnapshot& progress = m_progressSnapshots.getReadBuffer();
+
 	// Update the status LEDs
-	lights[LightId::LIGHT_RUN].setBrightnessSmooth((m_timeSeqCore->getStatus() == timeseq::TimeSeqCore::RUNNING), .01f, 20.f);
+	lights[LightId::LIGHT_RUN].setBrightnessSmooth((progress.status == timeseq::TimeSeqCore::RUNNING), .01f, 20.f);
 	lights[LightId::LIGHT_RESET].setBrightnessSmooth(0.f, .01f, 20.f);
 
 	// Update the time display
-	if (m_timeSeqCore->getStatus() != timeseq::TimeSeqCore::Status::EMPTY) {
-		int sampleRate = getSampleRate();
-		uint32_t elapsedSamples = m_timeSeqCore->getElapsedSamples();
-		int seconds = elapsedSamples / sampleRate;
+	if (progress.status != timeseq::TimeSeqCore::Status::EMPTY) {
+		int seconds = progress.elapsedSamples / progress.sampleRate;
 		int minutes = seconds / 60;
 		seconds -= minutes * 60;
 		m_ledDisplay->setForegroundText(string::f("%02d:%02d", minutes, seconds));
@@ -197,39 +340,13 @@ void TimeSeqModule::onRemove(const RemoveEvent& e) {
 	m_ledDisplay = nullptr;
 }
 
-float TimeSeqModule::getInputPortVoltage(int index, int channel) const {
-	return const_cast<Input&>(inputs[InputId::IN_INPUTS + index]).getVoltage(channel);
-}
-
-float TimeSeqModule::getOutputPortVoltage(int index, int channel) const {
-	return m_outputVoltages[index][channel];
-}
-
 float TimeSeqModule::getSampleRate() const {
 	return APP->engine->getSampleRate();
 }
 
-void TimeSeqModule::setOutputPortVoltage(int index, int channel, float voltage) {
-	m_outputVoltages[index][channel] = voltage;
-	outputs[OutputId::OUT_OUTPUTS + index].setVoltage(voltage, channel);
-
-	int id = TO_CHANNEL_PORT_IDENTIFIER(index, channel);
-	if (std::find(m_changedPortChannelVoltages.begin(), m_changedPortChannelVoltages.end(), id) == m_changedPortChannelVoltages.end()) {
-		m_changedPortChannelVoltages.push_back(id);
-	}
-}
-
-void TimeSeqModule::setOutputPortChannels(int index, int channels) {
-	m_outputChannels[index] = channels;
-	outputs[OutputId::OUT_OUTPUTS + index].setChannels(channels);
-
-	for (int j = 0; j < m_outputChannels[index]; j++) {
-		outputs[OutputId::OUT_OUTPUTS + index].setVoltage(m_outputVoltages[index][j], j);
-	}
-}
-
-void TimeSeqModule::setOutputPortLabel(int index, const std::string& label) {
-	configOutput(OUT_OUTPUTS + index, label);
+void TimeSeqModule::outputPortLabelChanged(int index, const std::string& label) {
+	// Changing the port configuration isn't safe from the engine thread, so let the UI thread apply the label.
+	queueUiMessage(TimeSeqUiMessage::Type::SET_LABEL, index, label, nullptr);
 }
 
 void TimeSeqModule::laneLooped() {
@@ -245,19 +362,13 @@ void TimeSeqModule::triggerTriggered() {
 }
 
 void TimeSeqModule::scriptReset() {
-	resetUi();
+	resetOutputs();
+	queueUiMessage(TimeSeqUiMessage::Type::SCRIPT_RESET, 0, std::string(), nullptr);
 }
 
-void TimeSeqModule::assertFailed(const std::string& name, const std::string& message, bool stop) {
-	// Update the display (if needed)
-	if (m_timeSeqDisplay != nullptr) {
-		m_timeSeqDisplay->setAssert(true);
-	}
-
-	// We'll only keep the first 25 assert failures in memory.
-	if (m_failedAsserts.size() < 25) {
-		m_failedAsserts.push_back(string::f("Assert '%s' failed due to expectation '%s'.", name.c_str(), message.c_str()));
-	}
+void TimeSeqModule::assertFailed(const std::string& name, const timeseq::AssertExpectation& expectation, bool stop) {
+	// The failed assert is formatted and stored by the UI thread.
+	queueUiMessage(TimeSeqUiMessage::Type::ASSERT_FAILED, 0, name, &expectation);
 
 	// If it's an assert that also stops the running state, do so now.
 	if ((stop) && (m_timeSeqCore->getStatus() == timeseq::TimeSeqCore::Status::RUNNING)) {
@@ -266,16 +377,36 @@ void TimeSeqModule::assertFailed(const std::string& name, const std::string& mes
 }
 
 std::shared_ptr<std::string> TimeSeqModule::getScript() {
-	return m_script;
+	return m_scripts[m_timeSeqCore->getActiveScript()];
 }
 
 std::string TimeSeqModule::loadScript(std::shared_ptr<std::string> script) {
-	const std::vector<timeseq::ValidationError> errors = m_timeSeqCore->loadScript(*script);
+	return loadScript(m_timeSeqCore->getActiveScript(), script);
+}
+
+std::string TimeSeqModule::loadScript(int index, std::shared_ptr<std::string> script) {
+	return loadScript(index, script->data(), script->size(), script);
+}
+
+std::string TimeSeqModule::loadScriptFile(const std::string& path) {
+	MappedFile file(path);
+	if (!file.isOpen()) {
+		m_lastScriptLoadErrors.clear();
+		m_lastScriptLoadErrors.emplace_back("Could not open the script file " + path);
+		return "Could not open the script file.\n\nDo you want to copy the error details to the clipboard?";
+	}
+
+	return loadScript(m_timeSeqCore->getActiveScript(), file.data(), file.size(), nullptr);
+}
+
+std::string TimeSeqModule::loadScript(int index, const char* scriptData, size_t size, std::shared_ptr<std::string> script) {
+	const std::vector<timeseq::ValidationError> errors = m_timeSeqCore->loadScript(index, scriptData, size);
 
 	m_lastScriptLoadErrors.clear();
 	if (errors.size() == 0) {
 		setDisplayScriptError(false);
-		m_script = script;
+		// The script data is kept, since it is stored in the patch
+		m_scripts[index] = script ? script : std::make_shared<std::string>(scriptData, size);
 		return std::string();
 	} else {
 		std::ostringstream errorMessage;
@@ -299,7 +430,7 @@ std::string TimeSeqModule::loadScript(std::shared_ptr<std::string> script) {
 }
 
 void TimeSeqModule::resetUi() {
-	resetOutputs();
+	resetOutputLabels();
 	m_failedAsserts.clear();
 	if (m_timeSeqDisplay) {
 		m_timeSeqDisplay->reset();
@@ -308,12 +439,15 @@ void TimeSeqModule::resetUi() {
 }
 
 void TimeSeqModule::resetOutputs() {
-	m_outputVoltages.fill({ 1.f });
-	for (std::array<std::array<float, 16>, 8>::iterator it = m_outputVoltages.begin(); it != m_outputVoltages.end(); it++) {
+	m_portBuffer.outputVoltages.fill({ 1.f });
+	for (std::array<std::array<float, 16>, 8>::iterator it = m_portBuffer.outputVoltages.begin(); it != m_portBuffer.outputVoltages.end(); it++) {
 		it->fill(0.f);
 	}
-	m_outputChannels.fill(1);
+	m_portBuffer.outputChannels.fill(1);
 	updateOutputs();
+}
+
+void TimeSeqModule::resetOutputLabels() {
 	for (int i = 0; i < 8; i++) {
 		configOutput(OUT_OUTPUTS + i, string::f("Output %d", i + 1));
 	}
@@ -321,11 +455,115 @@ void TimeSeqModule::resetOutputs() {
 
 void TimeSeqModule::updateOutputs() {
 	for (int i = 0; i < 8; i++) {
-		outputs[OutputId::OUT_OUTPUTS + i].setChannels(m_outputChannels[i]);
-		for (int j = 0; j < m_outputChannels[i]; j++) {
-			outputs[OutputId::OUT_OUTPUTS + i].setVoltage(m_outputVoltages[i][j], j);
+		outputs[OutputId::OUT_OUTPUTS + i].setChannels(m_portBuffer.outputChannels[i]);
+		for (int j = 0; j < m_portBuffer.outputChannels[i]; j++) {
+			outputs[OutputId::OUT_OUTPUTS + i].setVoltage(m_portBuffer.outputVoltages[i][j], j);
+		}
+	}
+
+	// All outputs are up-to-date now, so there is nothing left to flush
+	m_portBuffer.outputDirtyChannels.fill(0);
+	m_portBuffer.outputDirtyPorts = 0;
+}
+
+void TimeSeqModule::captureInputs() {
+	for (int i = 0; i < 8; i++) {
+		std::memcpy(m_portBuffer.inputVoltages[i].data(), inputs[InputId::IN_INPUTS + i].voltages, sizeof(m_portBuffer.inputVoltages[i]));
+	}
+}
+
+void TimeSeqModule::flushOutputs() {
+	if (m_portBuffer.outputDirtyPorts) {
+		for (int i = 0; i < 8; i++) {
+			if (m_portBuffer.outputDirtyPorts & (1 << i)) {
+				// Changing the channel count clears the newly added channels in Rack, so all channels have to be re-applied
+				outputs[OutputId::OUT_OUTPUTS + i].setChannels(m_portBuffer.outputChannels[i]);
+				m_portBuffer.outputDirtyChannels[i] |= (1 << m_portBuffer.outputChannels[i]) - 1;
+			}
+		}
+		m_portBuffer.outputDirtyPorts = 0;
+	}
+
+	for (int i = 0; i < 8; i++) {
+		uint16_t dirtyChannels = m_portBuffer.outputDirtyChannels[i];
+		if (dirtyChannels) {
+			Output& output = outputs[OutputId::OUT_OUTPUTS + i];
+			m_changedChannels[i] |= dirtyChannels;
+			for (int j = 0; dirtyChannels; j++, dirtyChannels >>= 1) {
+				if (dirtyChannels & 1) {
+					output.setVoltage(m_portBuffer.outputVoltages[i][j], j);
+				}
+			}
+			m_portBuffer.outputDirtyChannels[i] = 0;
+		}
+	}
+}
+
+void TimeSeqModule::queueUiMessage(TimeSeqUiMessage::Type type, int index, const std::string& name, const timeseq::AssertExpectation* expectation) {
+	// If the UI thread falls behind and the queue is full, the message is dropped.
+	TimeSeqUiMessage* uiMessage = m_uiMessages.prepare();
+	if (uiMessage != nullptr) {
+		uiMessage->type = type;
+		uiMessage->index = index;
+		// Copy the name into the fixed-size message buffer (truncating it if needed) to avoid allocations.
+		uiMessage->name[name.copy(uiMessage->name, sizeof(uiMessage->name) - 1)] = '\0';
+		if (expectation != nullptr) {
+			// Only copy the terms that were filled in
+			uiMessage->expectation.termCount = expectation->termCount;
+			std::copy(expectation->terms.begin(), expectation->terms.begin() + expectation->termCount, uiMessage->expectation.terms.begin());
+		}
+		m_uiMessages.commit();
+	}
+}
+
+void TimeSeqModule::processUiMessages() {
+	for (const TimeSeqUiMessage* uiMessage = m_uiMessages.peek(); uiMessage != nullptr; uiMessage = m_uiMessages.peek()) {
+		switch (uiMessage->type) {
+			case TimeSeqUiMessage::Type::SCRIPT_RESET:
+				resetUi();
+				break;
+			case TimeSeqUiMessage::Type::SET_LABEL:
+				configOutput(OUT_OUTPUTS + uiMessage->index, uiMessage->name);
+				break;
+			case TimeSeqUiMessage::Type::ASSERT_FAILED:
+				// Update the display (if needed)
+				if (m_timeSeqDisplay != nullptr) {
+					m_timeSeqDisplay->setAssert(true);
+				}
+
+				// We'll only keep the first 25 assert failures in memory.
+				if (m_failedAsserts.size() < 25) {
+					m_failedAsserts.push_back(string::f("Assert '%s' failed due to expectation '%s'.", uiMessage->name, uiMessage->expectation.format().c_str()));
+				}
+				break;
 		}
+		m_uiMessages.release();
+	}
+}
+
+void TimeSeqModule::publishVoltageSnapshot() {
+	TimeSeqVoltageSnapshot& snapshot = m_voltageSnapshots.getWriteBuffer();
+	std::array<uint16_t, 8> changedChannels;
+	for (int i = 0; i < 8; i++) {
+		changedChannels[i] = m_unconsumedChangedChannels[i] | m_changedChannels[i];
 	}
+	snapshot.changedChannels = changedChannels;
+	snapshot.voltages = m_portBuffer.outputVoltages;
+
+	if (m_voltageSnapshots.publish()) {
+		// The display never saw the previous snapshot, so its changes must stay in the pending mask until a snapshot
+		// that includes them is consumed
+		m_unconsumedChangedChannels = changedChannels;
+	} else {
+		// The display consumed the previous snapshot, so only the changes of this one are still pending
+		m_unconsumedChangedChannels = m_changedChannels;
+	}
+	m_changedChannels.fill(0);
+}
+
+void TimeSeqModule::publishProgressSnapshot() {
+	m_timeSeqCore->getProgress(m_progressSnapshots.getWriteBuffer());
+	m_progressSnapshots.publish();
 }
 
 void TimeSeqModule::setDisplayScriptError(bool error) {
@@ -337,14 +575,72 @@ void TimeSeqModule::setDisplayScriptError(bool error) {
 
 void TimeSeqModule::clearScript() {
 	setDisplayScriptError(false);
+	m_scripts[m_timeSeqCore->getActiveScript()].reset();
 	m_timeSeqCore->clearScript();
-	m_script.reset();
+}
+
+void TimeSeqModule::selectScript(int index) {
+	m_timeSeqCore->selectScript(index);
+}
+
+int TimeSeqModule::getActiveScript() {
+	return m_timeSeqCore->getActiveScript();
+}
+
+bool TimeSeqModule::hasScript(int index) {
+	return m_timeSeqCore->hasScript(index);
 }
 
 std::list<std::string>& TimeSeqModule::getLastScriptLoadErrors() {
 	return m_lastScriptLoadErrors;
 }
 
+std::vector<std::string> TimeSeqModule::getCostReport() {
+	const timeseq::ProcessorCostReport* costReport = m_timeSeqCore->getCostReport();
+	return costReport ? costReport->describe() : std::vector<std::string>();
+}
+
+std::vector<std::string> TimeSeqModule::getMemoryReport() {
+	const timeseq::ProcessorMemoryReport* memoryReport = m_timeSeqCore->getMemoryReport();
+	return memoryReport ? memoryReport->describe() : std::vector<std::string>();
+}
+
+bool TimeSeqModule::isEventTraceEnabled() {
+	return m_timeSeqCore->getEventTracer().isEnabled();
+}
+
+void TimeSeqModule::setEventTraceEnabled(bool enabled) {
+	m_timeSeqCore->getEventTracer().setEnabled(enabled);
+}
+
+void TimeSeqModule::clearEventTrace() {
+	m_timeSeqCore->getEventTracer().clear();
+}
+
+std::string TimeSeqModule::getEventTrace() {
+	return m_timeSeqCore->getEventTracer().getChromeTrace(m_timeSeqCore->getCurrentSampleRate());
+}
+
+bool TimeSeqModule::isFastMath() {
+	return m_fastMath;
+}
+
+void TimeSeqModule::setFastMath(bool fastMath) {
+	m_fastMath = fastMath;
+	m_timeSeqCore->setFastMath(fastMath);
+}
+
+void TimeSeqModule::seek(double seconds) {
+	// Calculate in double precision, since a float can't represent every sample of a long position
+	m_timeSeqCore->seek((uint64_t) (std::max(seconds, 0.) * m_timeSeqCore->getCurrentSampleRate()));
+}
+
+#ifdef __NT_TIMESEQ_PROFILING__
+	std::vector<timeseq::ProfilerEntry> TimeSeqModule::getProfile() {
+		return m_timeSeqCore->getProfile();
+	}
+#endif
+
 std::vector<std::string>& TimeSeqModule::getFailedAsserts() {
 	return m_failedAsserts;
 }
@@ -352,7 +648,7 @@ std::vector<std::string>& TimeSeqModule::getFailedAsserts() {
 void TimeSeqModule::setTimeSeqDisplay(TimeSeqDisplay* timeSeqDisplay) {
 	m_timeSeqDisplay = timeSeqDisplay;
 	if (m_timeSeqDisplay != nullptr) {
-		m_timeSeqDisplay->setTimeSeqCore(m_timeSeqCore);
+		m_timeSeqDisplay->processProgress(m_progressSnapshots.getReadBuffer());
 		m_timeSeqDisplay->setError(m_scriptError);
 		m_timeSeqDisplay->setAssert(m_failedAsserts.size() > 0);
 	}
@@ -438,6 +734,80 @@ void TimeSeqWidget::appendContextMenu(Menu* menu) {
 			menu->addChild(createMenuItem("Clear script", "", [this]() { this->clearScript(); }, disabled));
 		}
 	));
+	menu->addChild(createSubmenuItem("Script bank", "",
+		[this](Menu* menu) {
+			TimeSeqModule* timeSeqModule = dynamic_cast<TimeSeqModule *>(getModule());
+			menu->addChild(createMenuLabel("Load, paste or clear a script after selecting its slot"));
+			for (int i = 0; i < timeseq::TimeSeqCore::SCRIPT_BANK_SIZE; i++) {
+				menu->addChild(createCheckMenuItem(string::f("Script %d", i + 1), timeSeqModule->hasScript(i) ? "" : "empty",
+					[timeSeqModule, i]() { return timeSeqModule->getActiveScript() == i; },
+					[timeSeqModule, i]() { timeSeqModule->selectScript(i); }
+				));
+			}
+		}
+	));
+	menu->addChild(createSubmenuItem("Complexity report", "",
+		[this](Menu* menu) {
+			TimeSeqModule* timeSeqModule = dynamic_cast<TimeSeqModule *>(getModule());
+			for (const std::string& line : timeSeqModule->getCostReport()) {
+				menu->addChild(createMenuLabel(line));
+			}
+			menu->addChild(new MenuSeparator);
+			menu->addChild(createMenuItem("Copy complexity report", "", [this]() { this->copyCostReport(); }));
+		}, disabled
+	));
+	menu->addChild(createSubmenuItem("Memory usage", "",
+		[this](Menu* menu) {
+			TimeSeqModule* timeSeqModule = dynamic_cast<TimeSeqModule *>(getModule());
+			for (const std::string& line : timeSeqModule->getMemoryReport()) {
+				menu->addChild(createMenuLabel(line));
+			}
+			menu->addChild(new MenuSeparator);
+			menu->addChild(createMenuItem("Copy memory usage report", "", [this]() { this->copyMemoryReport(); }));
+		}, disabled
+	));
+	menu->addChild(createSubmenuItem("Event trace", "",
+		[this](Menu* menu) {
+			TimeSeqModule* timeSeqModule = dynamic_cast<TimeSeqModule *>(getModule());
+			menu->addChild(createCheckMenuItem("Record events", "",
+				[timeSeqModule]() { return timeSeqModule->isEventTraceEnabled(); },
+				[timeSeqModule]() { timeSeqModule->setEventTraceEnabled(!timeSeqModule->isEventTraceEnabled()); }
+			));
+			menu->addChild(createMenuItem("Clear recorded events", "", [timeSeqModule]() { timeSeqModule->clearEventTrace(); }));
+			menu->addChild(new MenuSeparator);
+			menu->addChild(createMenuItem("Save event trace...", "", [this]() { this->saveEventTrace(); }));
+			menu->addChild(createMenuItem("Copy event trace", "", [this]() { this->copyEventTrace(); }));
+		}
+	));
+	menu->addChild(createSubmenuItem("Seek to position", "",
+		[this](Menu* menu) {
+			menu->addChild(createMenuLabel("Position (seconds or mm:ss), confirm with Enter"));
+			menu->addChild(new TimeSeqSeekField(dynamic_cast<TimeSeqModule *>(getModule())));
+		}, disabled
+	));
+	appendRandomSeedMenu(menu);
+	menu->addChild(createCheckMenuItem("Fast approximate calculations (restarts the script)", "",
+		[this]() { return dynamic_cast<TimeSeqModule *>(getModule())->isFastMath(); },
+		[this]() {
+			TimeSeqModule* timeSeqModule = dynamic_cast<TimeSeqModule *>(getModule());
+			timeSeqModule->setFastMath(!timeSeqModule->isFastMath());
+		}
+	));
+	#ifdef __NT_TIMESEQ_PROFILING__
+		menu->addChild(createSubmenuItem("Profiling", "",
+			[this](Menu* menu) {
+				menu->addChild(createCheckMenuItem("Sort by time", "", [this]() { return m_profileSort == SORT_BY_TIME; }, [this]() { m_profileSort = SORT_BY_TIME; }));
+				menu->addChild(createCheckMenuItem("Sort by invocations", "", [this]() { return m_profileSort == SORT_BY_INVOCATIONS; }, [this]() { m_profileSort = SORT_BY_INVOCATIONS; }));
+				menu->addChild(createCheckMenuItem("Sort by name", "", [this]() { return m_profileSort == SORT_BY_NAME; }, [this]() { m_profileSort = SORT_BY_NAME; }));
+				menu->addChild(new MenuSeparator);
+				for (const std::string& line : getProfileTable(" | ")) {
+					menu->addChild(createMenuLabel(line));
+				}
+				menu->addChild(new MenuSeparator);
+				menu->addChild(createMenuItem("Copy profiling data", "", [this]() { this->copyProfile(); }));
+			}, disabled
+		));
+	#endif
 	menu->addChild(new MenuSeparator);
 	menu->addChild(createMenuItem("Copy failed assertions", "", [this]() { this->copyAssertions(); }, !hasAsserts));
 }
@@ -451,6 +821,16 @@ void TimeSeqWidget::onRemove(const RemoveEvent& e) {
 	}
 }
 
+void TimeSeqWidget::step() {
+	NTModuleWidget::step();
+
+	// Handle the label changes and assert failures that were queued by the engine thread
+	engine::Module* module = getModule();
+	if (module != nullptr) {
+		dynamic_cast<TimeSeqModule *>(module)->processUiMessages();
+	}
+}
+
 void TimeSeqWidget::loadScript() {
 	// If a script is already loaded, first confirm if it should be replaced.
 	if ((!hasScript()) || (osdialog_message(OSDIALOG_ERROR, OSDIALOG_YES_NO, "A script is already loaded. Are you sure you want to load a new script?") == 1)) {
@@ -459,9 +839,6 @@ void TimeSeqWidget::loadScript() {
 		osdialog_filters_free(filters);
 		if (path) {
 			try {
-				std::vector<uint8_t> data = system::readFile(path);
-				std::string json = std::string(data.begin(), data.end());
-
 				TimeSeqModule* timeSeqModule = dynamic_cast<TimeSeqModule *>(getModule());
 				if (timeSeqModule != nullptr) {
 					history::ModuleChange *h = new history::ModuleChange;
@@ -470,7 +847,7 @@ void TimeSeqWidget::loadScript() {
 					h->oldModuleJ = json_incref(toJson());
 					h->newModuleJ = nullptr;
 
-					std::string error = timeSeqModule->loadScript(std::make_shared<std::string>(json));
+					std::string error = timeSeqModule->loadScriptFile(path);
 					if (error.length() > 0) {
 						delete h;
 						if (osdialog_message(OSDIALOG_ERROR, OSDIALOG_YES_NO, error.c_str()) == 1) {
@@ -601,6 +978,138 @@ void TimeSeqWidget::copyAssertions() {
 	}
 }
 
+void TimeSeqWidget::copyCostReport() {
+	TimeSeqModule* timeSeqModule = dynamic_cast<TimeSeqModule *>(getModule());
+	if (timeSeqModule != nullptr) {
+		std::vector<std::string> costReport = timeSeqModule->getCostReport();
+		if (costReport.size() > 0) {
+			std::ostringstream costReportMessage;
+			for (const std::string& line : costReport) {
+				if (costReportMessage.tellp() != 0) {
+					costReportMessage << "\n";
+				}
+				costReportMessage << line;
+			}
+			glfwSetClipboardString(APP->window->win, costReportMessage.str().c_str());
+		}
+	}
+}
+
+void TimeSeqWidget::copyMemoryReport() {
+	TimeSeqModule* timeSeqModule = dynamic_cast<TimeSeqModule *>(getModule());
+	if (timeSeqModule != nullptr) {
+		std::vector<std::string> memoryReport = timeSeqModule->getMemoryReport();
+		if (memoryReport.size() > 0) {
+			std::ostringstream memoryReportMessage;
+			for (const std::string& line : memoryReport) {
+				if (memoryReportMessage.tellp() != 0) {
+					memoryReportMessage << "\n";
+				}
+				memoryReportMessage << line;
+			}
+			glfwSetClipboardString(APP->window->win, memoryReportMessage.str().c_str());
+		}
+	}
+}
+
+void TimeSeqWidget::saveEventTrace() {
+	TimeSeqModule* timeSeqModule = dynamic_cast<TimeSeqModule *>(getModule());
+	if (timeSeqModule != nullptr) {
+		std::string trace = timeSeqModule->getEventTrace();
+		osdialog_filters* filters = osdialog_filters_parse("JSON Files (*.json):json;All Files (*.*):*");
+		char* path = osdialog_file(OSDIALOG_SAVE, "", "", filters);
+		osdialog_filters_free(filters);
+		if (path) {
+			std::string file = path;
+			std::string ext = ".json";
+			if ((ext.size() > file.size()) || (!std::equal(ext.rbegin(), ext.rend(), file.rbegin()))) {
+				file = file + ext;
+			}
+			try {
+				system::writeFile(file.c_str(), std::vector<uint8_t>(trace.begin(), trace.end()));
+			} catch (Exception& e) {
+				osdialog_message(OSDIALOG_ERROR, OSDIALOG_OK, string::f("Unexpected error: %s", e.msg.c_str()).c_str());
+			}
+			free(path);
+		}
+	}
+}
+
+void TimeSeqWidget::copyEventTrace() {
+	TimeSeqModule* timeSeqModule = dynamic_cast<TimeSeqModule *>(getModule());
+	if (timeSeqModule != nullptr) {
+		glfwSetClipboardString(APP->window->win, timeSeqModule->getEventTrace().c_str());
+	}
+}
+
+#ifdef __NT_TIMESEQ_PROFILING__
+	std::vector<std::string> TimeSeqWidget::getProfileTable(const char* separator) {
+		std::vector<std::string> table;
+		TimeSeqModule* timeSeqModule = dynamic_cast<TimeSeqModule *>(getModule());
+		if (timeSeqModule != nullptr) {
+			std::vector<timeseq::ProfilerEntry> profile = timeSeqModule->getProfile();
+			std::stable_sort(profile.begin(), profile.end(), [this](const timeseq::ProfilerEntry& a, const timeseq::ProfilerEntry& b) {
+				switch (m_profileSort) {
+					case SORT_BY_INVOCATIONS:
+						return a.invocations > b.invocations;
+					case SORT_BY_NAME:
+						return a.name < b.name;
+					default:
+						return a.nanos > b.nanos;
+				}
+			});
+
+			table.push_back(string::f("Name%sInvocations%sTotal (ms)%sAverage (ns)", separator, separator, separator));
+			for (const timeseq::ProfilerEntry& entry : profile) {
+				double average = entry.invocations > 0 ? entry.nanos / entry.invocations : 0.;
+				table.push_back(string::f("%s%s%llu%s%.3f%s%.1f", entry.name.c_str(), separator, (unsigned long long) entry.invocations, separator, entry.nanos / 1000000., separator, average));
+			}
+		}
+		return table;
+	}
+
+	void TimeSeqWidget::copyProfile() {
+		// Use tab separated columns so the data can be pasted into a spreadsheet
+		std::vector<std::string> table = getProfileTable("\t");
+		if (table.size() > 0) {
+			std::ostringstream profileMessage;
+			for (const std::string& line : table) {
+				if (profileMessage.tellp() != 0) {
+					profileMessage << "\n";
+				}
+				profileMessage << line;
+			}
+			glfwSetClipboardString(APP->window->win, profileMessage.str().c_str());
+		}
+	}
+#endif
+
+TimeSeqSeekField::TimeSeqSeekField(TimeSeqModule* module) : m_module(module) {
+	box.size.x = 120.f;
+	placeholder = "00:00";
+}
+
+void TimeSeqSeekField::onSelectKey(const SelectKeyEvent& e) {
+	if ((e.action == GLFW_PRESS) && ((e.key == GLFW_KEY_ENTER) || (e.key == GLFW_KEY_KP_ENTER))) {
+		std::string::size_type separator = text.find(':');
+		if (separator != std::string::npos) {
+			m_module->seek(std::atof(text.substr(0, separator).c_str()) * 60. + std::atof(text.substr(separator + 1).c_str()));
+		} else {
+			m_module->seek(std::atof(text.c_str()));
+		}
+
+		ui::MenuOverlay* overlay = getAncestorOfType<ui::MenuOverlay>();
+		if (overlay) {
+			overlay->requestDelete();
+		}
+		e.consume(this);
+	}
+
+	if (!e.getTarget()) {
+		ui::TextField::onSelectKey(e);
+	}
+}
+
 bool TimeSeqWidget::hasScript() {
 	return getModule() ? (bool) dynamic_cast<TimeSeqModule *>(getModule())->getScript() : false;
 }
@@ -8,6 +8,9 @@ extern Plugin* pluginInstance;
 json_t *NTModule::dataToJson() {
 	json_t *rootJ = json_object();
 	json_object_set_new(rootJ, "ntTheme", json_integer(m_themeId));
+	if (m_fixedRandomSeed) {
+		json_object_set_new(rootJ, "ntRandomSeed", json_integer(m_randomSeed));
+	}
 	return rootJ;
 }
 
@@ -21,6 +24,13 @@ void NTModule::dataFromJson(json_t *rootJ) {
 			m_themeId = ThemeId::VCV;
 		}
 	}
+
+	json_t *ntRandomSeedJson = json_object_get(rootJ, "ntRandomSeed");
+	m_fixedRandomSeed = ntRandomSeedJson != nullptr;
+	if (m_fixedRandomSeed) {
+		m_randomSeed = json_integer_value(ntRandomSeedJson);
+	}
+	m_randomSeedChanged = true;
 }
 
 ThemeId NTModule::getTheme() {
@@ -39,6 +49,31 @@ void NTModule::addThemeChangeListener(ThemeChangeListener* listener) {
 	listener->themeChanged(m_themeId);
 }
 
+bool NTModule::hasFixedRandomSeed() {
+	return m_fixedRandomSeed;
+}
+
+uint32_t NTModule::getRandomSeed() {
+	return m_randomSeed;
+}
+
+void NTModule::setFixedRandomSeed(bool fixed) {
+	if ((fixed) && (!m_fixedRandomSeed)) {
+		newRandomSeed();
+	}
+	m_fixedRandomSeed = fixed;
+	m_randomSeedChanged = true;
+}
+
+void NTModule::newRandomSeed() {
+	m_randomSeed = random::u32();
+	m_randomSeedChanged = true;
+}
+
+bool NTModule::randomSeedChanged() {
+	return m_randomSeedChanged.exchange(false);
+}
+
 NTModuleWidget::NTModuleWidget(Module* module, std::string slug) {
 	setModule(module);
 	std::string svgPath = "res/" + slug;
@@ -89,6 +124,20 @@ void NTModuleWidget::appendContextMenu(Menu* menu) {
 	));
 }
 
+void NTModuleWidget::appendRandomSeedMenu(Menu* menu) {
+	NTModule* ntModule = getNTModule();
+	if (ntModule) {
+		menu->addChild(createSubmenuItem("Random seed", ntModule->hasFixedRandomSeed() ? string::f("%u", ntModule->getRandomSeed()) : "",
+			[ntModule](Menu* menu) {
+				menu->addChild(createCheckMenuItem("New seed on each load", "", [ntModule]() { return !ntModule->hasFixedRandomSeed(); }, [ntModule]() { ntModule->setFixedRandomSeed(false); }));
+				menu->addChild(createCheckMenuItem("Fixed seed (stored in the patch)", "", [ntModule]() { return ntModule->hasFixedRandomSeed(); }, [ntModule]() { ntModule->setFixedRandomSeed(true); }));
+				menu->addChild(new MenuSeparator);
+				menu->addChild(createMenuItem("Pick a new fixed seed", "", [ntModule]() { ntModule->newRandomSeed(); }, !ntModule->hasFixedRandomSeed()));
+			}
+		));
+	}
+}
+
 void NTModuleWidget::addThemeChangeListener(Widget* widget) {
 	if (getModule()) {
 		ThemeChangeListener* listener = dynamic_cast<ThemeChangeListener*>(widget);
@@ -0,0 +1,97 @@
+#include "util/mappedfile.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path) {
+	// Paths are UTF-8 encoded, so use the wide character API
+	int length = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+	std::wstring widePath(length, L'\0');
+	MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &widePath[0], length);
+
+	HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return;
+	}
+	m_fileHandle = file;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size)) {
+		return;
+	}
+	if (size.QuadPart == 0) {
+		// Empty files can't be mapped
+		m_open = true;
+		return;
+	}
+
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr) {
+		return;
+	}
+	m_mappingHandle = mapping;
+
+	void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (data != nullptr) {
+		m_data = static_cast<const char*>(data);
+		m_size = size.QuadPart;
+		m_open = true;
+	}
+}
+
+MappedFile::~MappedFile() {
+	if (m_data != nullptr) {
+		UnmapViewOfFile(m_data);
+	}
+	if (m_mappingHandle != nullptr) {
+		CloseHandle(m_mappingHandle);
+	}
+	if (m_fileHandle != nullptr) {
+		CloseHandle(m_fileHandle);
+	}
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path) {
+	int file = open(path.c_str(), O_RDONLY);
+	if (file < 0) {
+		return;
+	}
+
+	struct stat status;
+	if ((fstat(file, &status) == 0) && (S_ISREG(status.st_mode))) {
+		if (status.st_size == 0) {
+			// Empty files can't be mapped
+			m_open = true;
+		} else {
+			void* data = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+			if (data != MAP_FAILED) {
+				// The file is parsed from start to end, so let the OS read ahead
+				madvise(data, status.st_size, MADV_SEQUENTIAL);
+				m_data = static_cast<const char*>(data);
+				m_size = status.st_size;
+				m_open = true;
+			}
+		}
+	}
+
+	// The mapping stays valid after the file is closed
+	close(file);
+}
+
+MappedFile::~MappedFile() {
+	if (m_data != nullptr) {
+		munmap(const_cast<char*>(m_data), m_size);
+	}
+}
+
+#endif
@@ -1,4 +1,5 @@
 #include "util/notes.hpp"
+#include "util/quantizer.hpp"
 #include <cctype>
 #include <cmath>
 
@@ -12,37 +13,11 @@ int noteNameToIndex(char noteName) {
 }
 
 int voltageToChromaticIndex(float voltage) {
-	float n;
-	float note = std::modf(voltage, &n);
-	while (note < 0.f) {
-		note++;
-	}
-
-	if (note < (1.f / 24)) {
+	if (!std::isfinite(voltage)) {
 		return 0;
-	} else if (note < (1.f / 12) + (1.f / 24)) {
-		return 1;
-	} else if (note < (2.f / 12) + (1.f / 24)) {
-		return 2;
-	} else if (note < (3.f / 12) + (1.f / 24)) {
-		return 3;
-	} else if (note < (4.f / 12) + (1.f / 24)) {
-		return 4;
-	} else if (note < (5.f / 12) + (1.f / 24)) {
-		return 5;
-	} else if (note < (6.f / 12) + (1.f / 24)) {
-		return 6;
-	} else if (note < (7.f / 12) + (1.f / 24)) {
-		return 7;
-	} else if (note < (8.f / 12) + (1.f / 24)) {
-		return 8;
-	} else if (note < (9.f / 12) + (1.f / 24)) {
-		return 9;
-	} else if (note < (10.f / 12) + (1.f / 24)) {
-		return 10;
-	} else if (note < (11.f / 12) + (1.f / 24)) {
-		return 11;
-	} else {
-		return 12;
 	}
+
+	// A voltage that is quantized up to the next octave results in index 12
+	QuantizedNote note = Quantizer::chromatic().quantizeNote(voltage);
+	return note.index + (note.octave - (int) std::floor(voltage)) * 12;
 }
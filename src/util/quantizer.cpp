@@ -0,0 +1,125 @@
+#include "util/quantizer.hpp"
+#include <cmath>
+#include <algorithm>
+
+
+static std::vector<float> chromaticNotes() {
+	std::vector<float> notes;
+	for (int i = 0; i < 12; i++) {
+		notes.push_back((float) i / 12);
+	}
+	return notes;
+}
+
+Quantizer::Quantizer() : Quantizer(chromaticNotes()) {}
+
+Quantizer::Quantizer(const std::vector<float>& notes, QuantizerTieBreak tieBreak) : m_notes(notes), m_roundDown(tieBreak == QuantizerTieBreak::ROUND_DOWN) {
+	if (m_notes.size() == 0) {
+		m_notes.push_back(0.f);
+	}
+
+	// Add the last note one octave lower at the front and the first note one octave higher at the back,
+	// so that values near the start or end of the octave can be quantized to the neighbouring octave.
+	m_targets.push_back(m_notes.back() - 1.f);
+	m_targets.insert(m_targets.end(), m_notes.begin(), m_notes.end());
+	m_targets.push_back(m_notes.front() + 1.f);
+
+	// The boundaries are halfway between each target. The last target is a round-up entry that catches all remaining values.
+	for (unsigned int i = 0; i < m_targets.size() - 1; i++) {
+		m_boundaries.push_back(m_targets[i] + ((m_targets[i + 1] - m_targets[i]) / 2.f));
+	}
+	m_boundaries.push_back(2.f);
+
+	int target = 0;
+	for (int i = 0; i < QUANTIZER_TABLE_SIZE; i++) {
+		float stepStart = (float) i / QUANTIZER_TABLE_SIZE;
+		while ((stepStart > m_boundaries[target]) || ((!m_roundDown) && (stepStart == m_boundaries[target]))) {
+			target++;
+		}
+		m_table[i] = target;
+	}
+}
+
+const Quantizer& Quantizer::chromatic() {
+	static const Quantizer quantizer;
+	return quantizer;
+}
+
+template<typename T>
+int Quantizer::findTarget(T fract) const {
+	// The table is a power of two in size, so the multiplication is exact and the step never starts after the value
+	int step = (int) (fract * QUANTIZER_TABLE_SIZE);
+	int target = m_table[std::min(std::max(step, 0), QUANTIZER_TABLE_SIZE - 1)];
+	if (m_roundDown) {
+		while (fract > m_boundaries[target]) {
+			target++;
+		}
+	} else {
+		while (fract >= m_boundaries[target]) {
+			target++;
+		}
+	}
+	return target;
+}
+
+QuantizedNote Quantizer::quantizeNote(double voltage) const {
+	// NaN or infinite voltages have no octave or step in the table, so they are treated as the first note
+	if (!std::isfinite(voltage)) {
+		return { 0, 0 };
+	}
+
+	double octave;
+	double fract = std::modf(voltage, &octave);
+	if (fract < 0.) {
+		fract += 1.;
+		octave -= 1.;
+	}
+
+	int target = findTarget(fract);
+	if (target == 0) {
+		return { (int) octave - 1, (int) m_notes.size() - 1 };
+	} else if (target > (int) m_notes.size()) {
+		return { (int) octave + 1, 0 };
+	} else {
+		return { (int) octave, target - 1 };
+	}
+}
+
+double Quantizer::quantize(double voltage) const {
+	// NaN or infinite voltages have no step in the table, so they are returned unchanged
+	if (!std::isfinite(voltage)) {
+		return voltage;
+	}
+
+	double octave;
+	double fract = std::modf(voltage, &octave);
+	if (fract < 0.) {
+		fract += 1.;
+		octave -= 1.;
+	}
+
+	return octave + m_targets[findTarget(fract)];
+}
+
+float Quantizer::quantize(float voltage) const {
+	if (!std::isfinite(voltage)) {
+		return voltage;
+	}
+
+	float octave = std::floor(voltage);
+	return octave + m_targets[findTarget(voltage - octave)];
+}
+
+void Quantizer::quantize(float* voltages, int count) const {
+	for (int i = 0; i < count; i++) {
+		voltages[i] = quantize(voltages[i]);
+	}
+}
+
+const std::vector<float>& Quantizer::getNotes() const {
+	return m_notes;
+}
+
+size_t Quantizer::getMemorySize() const {
+	return (m_notes.capacity() + m_targets.capacity() + m_boundaries.capacity()) * sizeof(float);
+}
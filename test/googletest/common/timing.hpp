@@ -0,0 +1,13 @@
+#pragma once
+#include <chrono>
+
+// Returns the average time in nanoseconds of a call to the function, measured over the number of calls
+template<typename Function>
+double measureNanosPerCall(int calls, Function function) {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (int i = 0; i < calls; i++) {
+		function();
+	}
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(end - start).count() / calls;
+}
@@ -198,6 +198,16 @@ TEST(RameligCoreScale, quantizeShouldQuantizeUpwardIfCloser) {
 	EXPECT_EQ(scale.quantize(0.9f, -2.f, 2.f), std::make_pair(1, 0));
 }
 
+TEST(RameligCoreScale, quantizeShouldQuantizeDownwardIfHalfway) {
+	RameligScale scale;
+
+	scale.setScale({ 0, 6 });
+	EXPECT_EQ(scale.quantize(0.25f, -2.f, 2.f), std::make_pair(0, 0));
+	EXPECT_EQ(scale.quantize(0.75f, -2.f, 2.f), std::make_pair(0, 1));
+	EXPECT_EQ(scale.quantize(-0.25f, -2.f, 2.f), std::make_pair(-1, 1));
+	EXPECT_EQ(scale.quantize(1.25f, -2.f, 2.f), std::make_pair(1, 0));
+}
+
 TEST(RameligCoreScale, moveShouldMoveUpOneWithinScale) {
 	RameligScale scale;
 
@@ -25,6 +25,7 @@ struct MockProcessor : Processor {
 
 	MOCK_METHOD(void, reset, (), (override));
 	MOCK_METHOD(void, process, (), (override));
+	MOCK_METHOD(void, seek, (uint64_t), (override));
 };
 
 ACTION_P(AddValidationErrorAndReturnEmptyScript, validationError) {
@@ -52,8 +53,8 @@ TEST(TimeSeqCore, LoadScriptWithInvalidJsonScriptShouldHandleValidationErrors) {
 
 	EXPECT_EQ(resultValidationErrors, returningValidationErrors);
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::EMPTY);
-	EXPECT_EQ(timeSeqCore.m_script, nullptr);
-	EXPECT_EQ(timeSeqCore.m_processor, nullptr);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, nullptr);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), nullptr);
 }
 
 TEST(TimeSeqCore, LoadScriptShouldNotLoadProcessorIfThereIsNoScript) {
@@ -68,8 +69,8 @@ TEST(TimeSeqCore, LoadScriptShouldNotLoadProcessorIfThereIsNoScript) {
 
 	EXPECT_EQ(resultValidationErrors.size(), 0u);
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::EMPTY);
-	EXPECT_EQ(timeSeqCore.m_script, nullptr);
-	EXPECT_EQ(timeSeqCore.m_processor, nullptr);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, nullptr);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), nullptr);
 }
 
 TEST(TimeSeqCore, LoadScriptShouldNotLoadProcessorOnInvalidProcessorScript) {
@@ -93,8 +94,8 @@ TEST(TimeSeqCore, LoadScriptShouldNotLoadProcessorOnInvalidProcessorScript) {
 
 	EXPECT_EQ(resultValidationErrors, returningValidationErrors);
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::EMPTY);
-	EXPECT_EQ(timeSeqCore.m_script, nullptr);
-	EXPECT_EQ(timeSeqCore.m_processor, nullptr);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, nullptr);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), nullptr);
 }
 
 TEST(TimeSeqCore, LoadScriptShouldNotLoadProcessorWhenNoProcessorParsed) {
@@ -118,8 +119,8 @@ TEST(TimeSeqCore, LoadScriptShouldNotLoadProcessorWhenNoProcessorParsed) {
 
 	EXPECT_EQ(resultValidationErrors.size(), 0u);
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::EMPTY);
-	EXPECT_EQ(timeSeqCore.m_script, nullptr);
-	EXPECT_EQ(timeSeqCore.m_processor, nullptr);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, nullptr);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), nullptr);
 }
 
 TEST(TimeSeqCore, LoadScriptShouldInitializeLoadingOnInitialScriptLoad) {
@@ -142,8 +143,8 @@ TEST(TimeSeqCore, LoadScriptShouldInitializeLoadingOnInitialScriptLoad) {
 	EXPECT_CALL(mockEventListener, scriptReset()).Times(0);
 	EXPECT_EQ(resultValidationErrors.size(), 0u);
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::LOADING);
-	EXPECT_EQ(timeSeqCore.m_script, script);
-	EXPECT_EQ(timeSeqCore.m_processor, processor);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor.get());
 	// The current sample rate should have been captured in the core
 	EXPECT_EQ(timeSeqCore.getCurrentSampleRate(), 420u);
 
@@ -182,8 +183,8 @@ TEST(TimeSeqCore, LoadScriptShouldReplaceExistingScriptOnNewSuccesfulLoad) {
 	std::vector<ValidationError> resultValidationErrors = timeSeqCore.loadScript(scriptData);
 	EXPECT_EQ(resultValidationErrors.size(), 0u);
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::LOADING);
-	EXPECT_EQ(timeSeqCore.m_script, script1);
-	EXPECT_EQ(timeSeqCore.m_processor, processor1);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script1);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor1.get());
 	EXPECT_EQ(timeSeqCore.getCurrentSampleRate(), 420u);
 	// Perform one processing cycle to complete the load
 	EXPECT_CALL(mockEventListener, scriptReset()).Times(1);
@@ -197,8 +198,8 @@ TEST(TimeSeqCore, LoadScriptShouldReplaceExistingScriptOnNewSuccesfulLoad) {
 	EXPECT_EQ(resultValidationErrors.size(), 0u);
 	// The core should have become idle again
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::LOADING);
-	EXPECT_EQ(timeSeqCore.m_script, script2);
-	EXPECT_EQ(timeSeqCore.m_processor, processor2);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script2);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor2.get());
 	// Perform one processing cycle to complete the load
 	EXPECT_CALL(mockEventListener, scriptReset()).Times(1); // Another reset should happen
 	timeSeqCore.process(1);
@@ -252,8 +253,8 @@ TEST(TimeSeqCore, LoadScriptShouldNotReplaceExistingScriptIfNewScriptFailsToLoad
 	std::vector<ValidationError> resultValidationErrors = timeSeqCore.loadScript(scriptData);
 	EXPECT_EQ(resultValidationErrors.size(), 0u);
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::LOADING);
-	EXPECT_EQ(timeSeqCore.m_script, script1);
-	EXPECT_EQ(timeSeqCore.m_processor, processor1);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script1);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor1.get());
 	EXPECT_EQ(timeSeqCore.getCurrentSampleRate(), 420u);
 	// Start the core so we can verify that it keeps running
 	timeSeqCore.process(1);
@@ -265,32 +266,32 @@ TEST(TimeSeqCore, LoadScriptShouldNotReplaceExistingScriptIfNewScriptFailsToLoad
 	resultValidationErrors = timeSeqCore.loadScript(scriptData);
 	EXPECT_EQ(resultValidationErrors, returningValidationErrors1);
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::RUNNING);
-	EXPECT_EQ(timeSeqCore.m_script, script1);
-	EXPECT_EQ(timeSeqCore.m_processor, processor1);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script1);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor1.get());
 	EXPECT_EQ(timeSeqCore.getCurrentSampleRate(), 420u);
 
 	// Check failure scenario (2)
 	resultValidationErrors = timeSeqCore.loadScript(scriptData);
 	EXPECT_EQ(resultValidationErrors.size(), 0u);
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::RUNNING);
-	EXPECT_EQ(timeSeqCore.m_script, script1);
-	EXPECT_EQ(timeSeqCore.m_processor, processor1);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script1);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor1.get());
 	EXPECT_EQ(timeSeqCore.getCurrentSampleRate(), 420u);
 
 	// Check failure scenario (3)
 	resultValidationErrors = timeSeqCore.loadScript(scriptData);
 	EXPECT_EQ(resultValidationErrors, returningValidationErrors2);
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::RUNNING);
-	EXPECT_EQ(timeSeqCore.m_script, script1);
-	EXPECT_EQ(timeSeqCore.m_processor, processor1);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script1);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor1.get());
 	EXPECT_EQ(timeSeqCore.getCurrentSampleRate(), 420u);
 
 	// Check failure scenario (4)
 	resultValidationErrors = timeSeqCore.loadScript(scriptData);
 	EXPECT_EQ(resultValidationErrors.size(), 0u);
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::RUNNING);
-	EXPECT_EQ(timeSeqCore.m_script, script1);
-	EXPECT_EQ(timeSeqCore.m_processor, processor1);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script1);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor1.get());
 	EXPECT_EQ(timeSeqCore.getCurrentSampleRate(), 420u);
 
 	// And make sure that a valid script can still be loaded
@@ -298,8 +299,8 @@ TEST(TimeSeqCore, LoadScriptShouldNotReplaceExistingScriptIfNewScriptFailsToLoad
 	EXPECT_EQ(resultValidationErrors.size(), 0u);
 	// The core should have become idle again
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::LOADING);
-	EXPECT_EQ(timeSeqCore.m_script, script2);
-	EXPECT_EQ(timeSeqCore.m_processor, processor2);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script2);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor2.get());
 	// The current sample rate should have been re-captured in the core
 	EXPECT_EQ(timeSeqCore.getCurrentSampleRate(), 69u);
 	// And the core should become paused after one cycle
@@ -311,14 +312,14 @@ TEST(TimeSeqCore, ReloadScriptShouldDoNothingWhenNoScriptIsLoaded) {
 	TimeSeqCore timeSeqCore(nullptr, nullptr, nullptr, nullptr);
 
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::EMPTY);
-	EXPECT_EQ(timeSeqCore.m_script, nullptr);
-	EXPECT_EQ(timeSeqCore.m_processor, nullptr);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, nullptr);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), nullptr);
 
 	timeSeqCore.reloadScript();
 
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::EMPTY);
-	EXPECT_EQ(timeSeqCore.m_script, nullptr);
-	EXPECT_EQ(timeSeqCore.m_processor, nullptr);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, nullptr);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), nullptr);
 }
 
 TEST(TimeSeqCore, ReloadScriptShouldReloadProcessorFromCurrentScript) {
@@ -347,8 +348,8 @@ TEST(TimeSeqCore, ReloadScriptShouldReloadProcessorFromCurrentScript) {
 	std::vector<ValidationError> resultValidationErrors = timeSeqCore.loadScript(scriptData);
 	EXPECT_EQ(resultValidationErrors.size(), 0u);
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::LOADING);
-	EXPECT_EQ(timeSeqCore.m_script, script1);
-	EXPECT_EQ(timeSeqCore.m_processor, processor1);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script1);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor1.get());
 	EXPECT_EQ(timeSeqCore.getCurrentSampleRate(), 420u);
 	// Start the core
 	timeSeqCore.start(0);
@@ -357,8 +358,8 @@ TEST(TimeSeqCore, ReloadScriptShouldReloadProcessorFromCurrentScript) {
 	timeSeqCore.reloadScript();
 	// The core should have become idle again
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::LOADING);
-	EXPECT_EQ(timeSeqCore.m_script, script1);
-	EXPECT_EQ(timeSeqCore.m_processor, processor2);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script1);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor2.get());
 	// The current sample rate should have been re-captured in the core
 	EXPECT_EQ(timeSeqCore.getCurrentSampleRate(), 69u);
 	// One cycle should move the state to paused
@@ -371,14 +372,14 @@ TEST(TimeSeqCore, ClearScriptShouldDoNothingWhenNoScriptIsLoaded) {
 	TimeSeqCore timeSeqCore(nullptr, nullptr, nullptr, &mockEventListener);
 
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::EMPTY);
-	EXPECT_EQ(timeSeqCore.m_script, nullptr);
-	EXPECT_EQ(timeSeqCore.m_processor, nullptr);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, nullptr);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), nullptr);
 
 	timeSeqCore.clearScript();
 
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::LOADING);
-	EXPECT_EQ(timeSeqCore.m_script, nullptr);
-	EXPECT_EQ(timeSeqCore.m_processor, nullptr);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, nullptr);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), nullptr);
 	timeSeqCore.process(0);
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::EMPTY);
 }
@@ -405,8 +406,8 @@ TEST(TimeSeqCore, PauseScriptShouldPauseWhenScriptLoaded) {
 	std::vector<ValidationError> resultValidationErrors = timeSeqCore.loadScript(scriptData);
 	EXPECT_EQ(resultValidationErrors.size(), 0u);
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::LOADING);
-	EXPECT_EQ(timeSeqCore.m_script, script1);
-	EXPECT_EQ(timeSeqCore.m_processor, processor);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script1);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor.get());
 	EXPECT_EQ(timeSeqCore.getCurrentSampleRate(), 420u);
 	// Start the core
 	timeSeqCore.start(0);
@@ -414,8 +415,8 @@ TEST(TimeSeqCore, PauseScriptShouldPauseWhenScriptLoaded) {
 
 	timeSeqCore.pause();
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::PAUSED);
-	EXPECT_EQ(timeSeqCore.m_script, script1);
-	EXPECT_EQ(timeSeqCore.m_processor, processor);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script1);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor.get());
 	EXPECT_EQ(timeSeqCore.getCurrentSampleRate(), 420u);
 }
 
@@ -423,28 +424,28 @@ TEST(TimeSeqCore, PauseScriptShouldDoNothingWhenNoScriptIsLoaded) {
 	TimeSeqCore timeSeqCore(nullptr, nullptr, nullptr, nullptr);
 
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::EMPTY);
-	EXPECT_EQ(timeSeqCore.m_script, nullptr);
-	EXPECT_EQ(timeSeqCore.m_processor, nullptr);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, nullptr);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), nullptr);
 
 	timeSeqCore.pause();
 
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::EMPTY);
-	EXPECT_EQ(timeSeqCore.m_script, nullptr);
-	EXPECT_EQ(timeSeqCore.m_processor, nullptr);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, nullptr);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), nullptr);
 }
 
 TEST(TimeSeqCore, StartScriptShouldDoNothingWhenNoScriptIsLoaded) {
 	TimeSeqCore timeSeqCore(nullptr, nullptr, nullptr, nullptr);
 
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::EMPTY);
-	EXPECT_EQ(timeSeqCore.m_script, nullptr);
-	EXPECT_EQ(timeSeqCore.m_processor, nullptr);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, nullptr);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), nullptr);
 
 	timeSeqCore.start(0);
 
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::EMPTY);
-	EXPECT_EQ(timeSeqCore.m_script, nullptr);
-	EXPECT_EQ(timeSeqCore.m_processor, nullptr);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, nullptr);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), nullptr);
 }
 
 TEST(TimeSeqCore, StartScriptShouldRestartScriptButKeepTriggersVariablesAndProgress) {
@@ -469,8 +470,8 @@ TEST(TimeSeqCore, StartScriptShouldRestartScriptButKeepTriggersVariablesAndProgr
 	std::vector<ValidationError> resultValidationErrors = timeSeqCore.loadScript(scriptData);
 	EXPECT_EQ(resultValidationErrors.size(), 0u);
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::LOADING);
-	EXPECT_EQ(timeSeqCore.m_script, script1);
-	EXPECT_EQ(timeSeqCore.m_processor, processor);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script1);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor.get());
 	EXPECT_EQ(timeSeqCore.getCurrentSampleRate(), 420u);
 	// Start the core
 	timeSeqCore.start(0);
@@ -498,8 +499,8 @@ TEST(TimeSeqCore, StartScriptShouldRestartScriptButKeepTriggersVariablesAndProgr
 	// Start the core again
 	timeSeqCore.start(0);
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::RUNNING);
-	EXPECT_EQ(timeSeqCore.m_script, script1);
-	EXPECT_EQ(timeSeqCore.m_processor, processor);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script1);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor.get());
 	EXPECT_EQ(timeSeqCore.getCurrentSampleRate(), 420u);
 
 	// Check that the variables and triggers are still there
@@ -534,8 +535,8 @@ TEST(TimeSeqCore, ResetScriptShouldRestartScriptAndClearTriggersVariablesAndProg
 	std::vector<ValidationError> resultValidationErrors = timeSeqCore.loadScript(scriptData);
 	EXPECT_EQ(resultValidationErrors.size(), 0u);
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::LOADING);
-	EXPECT_EQ(timeSeqCore.m_script, script1);
-	EXPECT_EQ(timeSeqCore.m_processor, processor);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script1);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor.get());
 	EXPECT_EQ(timeSeqCore.getCurrentSampleRate(), 420u);
 	// Start the core
 	timeSeqCore.start(0);
@@ -569,8 +570,8 @@ TEST(TimeSeqCore, ResetScriptShouldRestartScriptAndClearTriggersVariablesAndProg
 	}
 	timeSeqCore.reset();
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::RUNNING);
-	EXPECT_EQ(timeSeqCore.m_script, script1);
-	EXPECT_EQ(timeSeqCore.m_processor, processor);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script1);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor.get());
 	EXPECT_EQ(timeSeqCore.getCurrentSampleRate(), 420u);
 
 	// The next process call will do the actual reset
@@ -587,6 +588,51 @@ TEST(TimeSeqCore, ResetScriptShouldRestartScriptAndClearTriggersVariablesAndProg
 	EXPECT_EQ(timeSeqCore.getElapsedSamples(), 2u);
 }
 
+TEST(TimeSeqCore, SeekShouldResetScriptAndMoveProcessorAheadOnNextProcess) {
+	std::shared_ptr<MockJsonLoader> mockJsonLoader(new MockJsonLoader());
+	std::shared_ptr<MockProcessorLoader> mockProcessorLoader(new MockProcessorLoader());
+	MockSampleRateReader mockSampleRateReader;
+	testing::NiceMock<MockEventListener> mockEventListener;
+	TimeSeqCore timeSeqCore(mockJsonLoader, mockProcessorLoader, &mockSampleRateReader, &mockEventListener);
+
+	std::shared_ptr<Script> script(new Script());
+	std::shared_ptr<MockProcessor> processor(new testing::NiceMock<MockProcessor>());
+	std::string scriptData = DUMMY_TIMESEQ_SCRIPT;
+
+	EXPECT_CALL(*mockJsonLoader, loadScript).Times(1).WillOnce(testing::Return(script));
+	EXPECT_CALL(*mockProcessorLoader, loadScript(script, testing::_)).Times(1).WillOnce(testing::Return(processor));
+	EXPECT_CALL(mockSampleRateReader, getSampleRate()).Times(1).WillOnce(testing::Return(10));
+
+	timeSeqCore.loadScript(scriptData);
+	timeSeqCore.start(0);
+	for (int i = 0; i < 5; i++) {
+		timeSeqCore.process(1);
+	}
+	timeSeqCore.setVariable(var1, 1.f);
+
+	// The seek is only done on the next process call
+	timeSeqCore.seek(10 * 60 * 60 + 25);
+	testing::Mock::VerifyAndClearExpectations(processor.get());
+	{
+		testing::InSequence inSequence;
+		EXPECT_CALL(*processor, reset()).Times(1);
+		EXPECT_CALL(*processor, seek(10 * 60 * 60 + 25)).Times(1);
+		EXPECT_CALL(*processor, process()).Times(1);
+	}
+	timeSeqCore.process(1);
+
+	EXPECT_EQ(timeSeqCore.getVariable(var1), 0.f);
+	// The elapsed samples loop on the hour boundary
+	EXPECT_EQ(timeSeqCore.getElapsedSamples(), 26u);
+
+	// Further process calls shouldn't seek again
+	EXPECT_CALL(*processor, reset()).Times(0);
+	EXPECT_CALL(*processor, seek).Times(0);
+	EXPECT_CALL(*processor, process()).Times(1);
+	timeSeqCore.process(1);
+	EXPECT_EQ(timeSeqCore.getElapsedSamples(), 27u);
+}
+
 TEST(TimeSeqCore, SetVariableShouldUpdateVariable) {
 	TimeSeqCore timeSeqCore(nullptr, nullptr, nullptr, nullptr);
 
@@ -676,8 +722,8 @@ TEST(TimeSeqCore, ProcessShouldAdvanceScriptAndHandleTriggers) {
 	std::vector<ValidationError> resultValidationErrors = timeSeqCore.loadScript(scriptData);
 	EXPECT_EQ(resultValidationErrors.size(), 0u);
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::LOADING);
-	EXPECT_EQ(timeSeqCore.m_script, script1);
-	EXPECT_EQ(timeSeqCore.m_processor, processor);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script1);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor.get());
 	EXPECT_EQ(timeSeqCore.getCurrentSampleRate(), 420u);
 	// Start the core
 	timeSeqCore.start(0);
@@ -756,6 +802,39 @@ TEST(TimeSeqCore, ElapsedSamplesShouldLoopOnHourBoundary) {
 	}
 }
 
+TEST(TimeSeqCore, GetProgressShouldReflectStatusAndElapsedSamples) {
+	std::shared_ptr<MockJsonLoader> mockJsonLoader(new MockJsonLoader());
+	std::shared_ptr<MockProcessorLoader> mockProcessorLoader(new MockProcessorLoader());
+	MockSampleRateReader mockSampleRateReader;
+	testing::NiceMock<MockEventListener> mockEventListener;
+	TimeSeqCore timeSeqCore(mockJsonLoader, mockProcessorLoader, &mockSampleRateReader, &mockEventListener);
+
+	TimeSeqCore::ProgressSnapshot progress;
+	timeSeqCore.getProgress(progress);
+	EXPECT_EQ(progress.status, TimeSeqCore::Status::EMPTY);
+	EXPECT_EQ(progress.laneCount, 0);
+
+	std::shared_ptr<Script> script(new Script());
+	std::shared_ptr<Processor> processor(new Processor({}, {}, {}, {}));
+	std::string scriptData = DUMMY_TIMESEQ_SCRIPT;
+
+	EXPECT_CALL(*mockJsonLoader, loadScript).Times(1).WillOnce(testing::Return(script));
+	EXPECT_CALL(*mockProcessorLoader, loadScript(script, testing::_)).Times(1).WillOnce(testing::Return(processor));
+	EXPECT_CALL(mockSampleRateReader, getSampleRate()).Times(1).WillOnce(testing::Return(12));
+
+	timeSeqCore.loadScript(scriptData);
+	timeSeqCore.start(0);
+	for (int i = 0; i < 5; i++) {
+		timeSeqCore.process(1);
+	}
+
+	timeSeqCore.getProgress(progress);
+	EXPECT_EQ(progress.status, TimeSeqCore::Status::RUNNING);
+	EXPECT_EQ(progress.sampleRate, 12u);
+	EXPECT_EQ(progress.elapsedSamples, 5u);
+	EXPECT_EQ(progress.laneCount, 0);
+}
+
 TEST(TimeSeqCore, StartScriptShouldCauseImmediateProcessingOnZeroDelay) {
 	std::shared_ptr<MockJsonLoader> mockJsonLoader(new MockJsonLoader());
 	std::shared_ptr<MockProcessorLoader> mockProcessorLoader(new MockProcessorLoader());
@@ -778,8 +857,8 @@ TEST(TimeSeqCore, StartScriptShouldCauseImmediateProcessingOnZeroDelay) {
 	std::vector<ValidationError> resultValidationErrors = timeSeqCore.loadScript(scriptData);
 	EXPECT_EQ(resultValidationErrors.size(), 0u);
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::LOADING);
-	EXPECT_EQ(timeSeqCore.m_script, script1);
-	EXPECT_EQ(timeSeqCore.m_processor, processor);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script1);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor.get());
 	EXPECT_EQ(timeSeqCore.getCurrentSampleRate(), 420u);
 
 	// Start the core
@@ -817,8 +896,8 @@ TEST(TimeSeqCore, StartScriptShouldDelayProcessingWhenStartedWithDelay) {
 	std::vector<ValidationError> resultValidationErrors = timeSeqCore.loadScript(scriptData);
 	EXPECT_EQ(resultValidationErrors.size(), 0u);
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::LOADING);
-	EXPECT_EQ(timeSeqCore.m_script, script1);
-	EXPECT_EQ(timeSeqCore.m_processor, processor);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script1);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor.get());
 	EXPECT_EQ(timeSeqCore.getCurrentSampleRate(), 420u);
 
 	// Start the core
@@ -862,8 +941,8 @@ TEST(TimeSeqCore, StartScriptShouldDelayProcessingWhenStartedWithDelayAndProcess
 	std::vector<ValidationError> resultValidationErrors = timeSeqCore.loadScript(scriptData);
 	EXPECT_EQ(resultValidationErrors.size(), 0u);
 	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::LOADING);
-	EXPECT_EQ(timeSeqCore.m_script, script1);
-	EXPECT_EQ(timeSeqCore.m_processor, processor);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script1);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor.get());
 	EXPECT_EQ(timeSeqCore.getCurrentSampleRate(), 420u);
 
 	// Start the core
@@ -986,3 +1065,261 @@ TEST(TimeSeqCore, ResetShouldClearTriggersBeforeResettingProcessor) {
 	triggers = { "after1", "after2" };
 	EXPECT_EQ(timeSeqCore.getTriggers(), triggers);
 }
+
+TEST(TimeSeqCore, EventTracerShouldRecordVariablesAndTriggersWithTheProcessedSample) {
+	std::shared_ptr<MockJsonLoader> mockJsonLoader(new MockJsonLoader());
+	std::shared_ptr<MockProcessorLoader> mockProcessorLoader(new MockProcessorLoader());
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	testing::NiceMock<MockEventListener> mockEventListener;
+	TimeSeqCore timeSeqCore(mockJsonLoader, mockProcessorLoader, &mockSampleRateReader, &mockEventListener);
+
+	std::shared_ptr<Script> script1(new Script());
+	std::shared_ptr<MockProcessor> processor(new testing::NiceMock<MockProcessor>());
+	std::string scriptData = DUMMY_TIMESEQ_SCRIPT;
+
+	EXPECT_CALL(*mockJsonLoader, loadScript).Times(1).WillOnce(testing::Return(script1));
+	EXPECT_CALL(*mockProcessorLoader, loadScript(script1, testing::_)).Times(1).WillOnce(testing::Return(processor));
+	ON_CALL(mockSampleRateReader, getSampleRate()).WillByDefault(testing::Return(1000));
+
+	std::vector<ValidationError> resultValidationErrors = timeSeqCore.loadScript(scriptData);
+	timeSeqCore.start(0);
+	timeSeqCore.process(1);
+
+	// Events are only recorded once the tracer is enabled
+	timeSeqCore.setVariable(var1, 1.f);
+	timeSeqCore.getEventTracer().setEnabled(true);
+	timeSeqCore.process(2);
+	timeSeqCore.setVariable(var2, 2.f);
+	std::string triggerName = "trigger1";
+	timeSeqCore.setTrigger(triggerName);
+
+	nlohmann::json trace = nlohmann::json::parse(timeSeqCore.getEventTracer().getChromeTrace(timeSeqCore.getCurrentSampleRate()));
+	nlohmann::json& traceEvents = trace["traceEvents"];
+	ASSERT_EQ(traceEvents.size(), 8u);
+	EXPECT_EQ(traceEvents[6]["name"], var2);
+	EXPECT_EQ(traceEvents[6]["ts"], 3000.);
+	EXPECT_EQ(traceEvents[6]["args"]["value"], 2.f);
+	EXPECT_EQ(traceEvents[7]["name"], triggerName);
+	EXPECT_EQ(traceEvents[7]["ts"], 3000.);
+}
+
+TEST(TimeSeqCore, LoadScriptInOtherBankSlotShouldNotReplaceActiveScript) {
+	std::shared_ptr<MockJsonLoader> mockJsonLoader(new MockJsonLoader());
+	std::shared_ptr<MockProcessorLoader> mockProcessorLoader(new MockProcessorLoader());
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	testing::NiceMock<MockEventListener> mockEventListener;
+	TimeSeqCore timeSeqCore(mockJsonLoader, mockProcessorLoader, &mockSampleRateReader, &mockEventListener);
+
+	std::shared_ptr<Script> script1(new Script());
+	std::shared_ptr<Script> script2(new Script());
+	std::shared_ptr<Processor> processor1(new Processor({}, {}, {}, {}));
+	std::shared_ptr<Processor> processor2(new Processor({}, {}, {}, {}));
+	std::string scriptData = DUMMY_TIMESEQ_SCRIPT;
+
+	EXPECT_CALL(*mockJsonLoader, loadScript).Times(2).WillOnce(testing::Return(script1)).WillOnce(testing::Return(script2));
+	EXPECT_CALL(*mockProcessorLoader, loadScript(script1, testing::_)).Times(1).WillOnce(testing::Return(processor1));
+	EXPECT_CALL(*mockProcessorLoader, loadScript(script2, testing::_)).Times(1).WillOnce(testing::Return(processor2));
+
+	timeSeqCore.loadScript(scriptData);
+	timeSeqCore.process(1);
+	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::PAUSED);
+	timeSeqCore.start(0);
+
+	std::vector<ValidationError> resultValidationErrors = timeSeqCore.loadScript(3, scriptData);
+	EXPECT_EQ(resultValidationErrors.size(), 0u);
+	// The running script is not affected by loading a script in another slot
+	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::RUNNING);
+	EXPECT_EQ(timeSeqCore.getActiveScript(), 0);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script1);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor1.get());
+	EXPECT_TRUE(timeSeqCore.hasScript(0));
+	EXPECT_TRUE(timeSeqCore.hasScript(3));
+	EXPECT_FALSE(timeSeqCore.hasScript(1));
+	EXPECT_FALSE(timeSeqCore.hasScript(TimeSeqCore::SCRIPT_BANK_SIZE));
+
+	// Clearing another slot doesn't affect the running script either
+	timeSeqCore.clearScript(3);
+	EXPECT_FALSE(timeSeqCore.hasScript(3));
+	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::RUNNING);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor1.get());
+}
+
+TEST(TimeSeqCore, SelectScriptShouldSwitchToBankedScriptAndKeepVariables) {
+	std::shared_ptr<MockJsonLoader> mockJsonLoader(new MockJsonLoader());
+	std::shared_ptr<MockProcessorLoader> mockProcessorLoader(new MockProcessorLoader());
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	testing::NiceMock<MockEventListener> mockEventListener;
+	TimeSeqCore timeSeqCore(mockJsonLoader, mockProcessorLoader, &mockSampleRateReader, &mockEventListener);
+
+	std::shared_ptr<Script> script1(new Script());
+	std::shared_ptr<Script> script2(new Script());
+	std::shared_ptr<MockProcessor> processor1(new MockProcessor());
+	std::shared_ptr<MockProcessor> processor2(new MockProcessor());
+	std::string scriptData = DUMMY_TIMESEQ_SCRIPT;
+
+	EXPECT_CALL(*mockJsonLoader, loadScript).Times(2).WillOnce(testing::Return(script1)).WillOnce(testing::Return(script2));
+	EXPECT_CALL(*mockProcessorLoader, loadScript(script1, testing::_)).Times(1).WillOnce(testing::Return(processor1));
+	EXPECT_CALL(*mockProcessorLoader, loadScript(script2, testing::_)).Times(1).WillOnce(testing::Return(processor2));
+
+	timeSeqCore.loadScript(scriptData);
+	timeSeqCore.loadScript(2, scriptData);
+
+	EXPECT_CALL(*processor1, reset()).Times(1);
+	EXPECT_CALL(*processor1, process()).Times(1);
+	timeSeqCore.process(1);
+	timeSeqCore.start(0);
+	timeSeqCore.process(1);
+	testing::Mock::VerifyAndClearExpectations(processor1.get());
+
+	timeSeqCore.setVariable(var1, 1.f);
+	timeSeqCore.selectScript(2);
+	// The switch only happens when the next sample is processed
+	EXPECT_EQ(timeSeqCore.getActiveScript(), 0);
+
+	{
+		testing::InSequence inSequence;
+		EXPECT_CALL(*processor2, reset()).Times(1);
+		EXPECT_CALL(*processor2, process()).Times(2);
+	}
+	EXPECT_CALL(*processor1, reset()).Times(0);
+	EXPECT_CALL(*processor1, process()).Times(0);
+	EXPECT_CALL(mockEventListener, scriptReset()).Times(0);
+	timeSeqCore.process(2);
+
+	EXPECT_EQ(timeSeqCore.getActiveScript(), 2);
+	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::RUNNING);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script2);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor2.get());
+	EXPECT_EQ(timeSeqCore.getVariable(var1), 1.f);
+}
+
+TEST(TimeSeqCore, SelectScriptFromProcessorShouldSwitchOnTheNextSampleOfTheSameCycle) {
+	std::shared_ptr<MockJsonLoader> mockJsonLoader(new MockJsonLoader());
+	std::shared_ptr<MockProcessorLoader> mockProcessorLoader(new MockProcessorLoader());
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	testing::NiceMock<MockEventListener> mockEventListener;
+	TimeSeqCore timeSeqCore(mockJsonLoader, mockProcessorLoader, &mockSampleRateReader, &mockEventListener);
+
+	std::shared_ptr<Script> script1(new Script());
+	std::shared_ptr<Script> script2(new Script());
+	std::shared_ptr<MockProcessor> processor1(new testing::NiceMock<MockProcessor>());
+	std::shared_ptr<MockProcessor> processor2(new MockProcessor());
+	std::string scriptData = DUMMY_TIMESEQ_SCRIPT;
+
+	EXPECT_CALL(*mockJsonLoader, loadScript).Times(2).WillOnce(testing::Return(script1)).WillOnce(testing::Return(script2));
+	EXPECT_CALL(*mockProcessorLoader, loadScript(script1, testing::_)).Times(1).WillOnce(testing::Return(processor1));
+	EXPECT_CALL(*mockProcessorLoader, loadScript(script2, testing::_)).Times(1).WillOnce(testing::Return(processor2));
+
+	timeSeqCore.loadScript(scriptData);
+	timeSeqCore.loadScript(1, scriptData);
+	timeSeqCore.process(1);
+	timeSeqCore.start(0);
+
+	{
+		testing::InSequence inSequence;
+		EXPECT_CALL(*processor1, process()).Times(1).WillOnce(testing::Invoke([&]() { timeSeqCore.selectScript(1); }));
+		EXPECT_CALL(*processor2, reset()).Times(1);
+		EXPECT_CALL(*processor2, process()).Times(2);
+	}
+	timeSeqCore.process(3);
+	EXPECT_EQ(timeSeqCore.getActiveScript(), 1);
+}
+
+TEST(TimeSeqCore, SelectScriptOfEmptySlotShouldEmptyCore) {
+	std::shared_ptr<MockJsonLoader> mockJsonLoader(new MockJsonLoader());
+	std::shared_ptr<MockProcessorLoader> mockProcessorLoader(new MockProcessorLoader());
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	testing::NiceMock<MockEventListener> mockEventListener;
+	TimeSeqCore timeSeqCore(mockJsonLoader, mockProcessorLoader, &mockSampleRateReader, &mockEventListener);
+
+	std::shared_ptr<Script> script1(new Script());
+	std::shared_ptr<MockProcessor> processor1(new testing::NiceMock<MockProcessor>());
+	std::string scriptData = DUMMY_TIMESEQ_SCRIPT;
+
+	EXPECT_CALL(*mockJsonLoader, loadScript).Times(1).WillOnce(testing::Return(script1));
+	EXPECT_CALL(*mockProcessorLoader, loadScript(script1, testing::_)).Times(1).WillOnce(testing::Return(processor1));
+
+	timeSeqCore.loadScript(scriptData);
+	timeSeqCore.process(1);
+	timeSeqCore.start(0);
+
+	timeSeqCore.selectScript(5);
+	timeSeqCore.process(1);
+	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::EMPTY);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, nullptr);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), nullptr);
+
+	// Switching back makes the script available again, but doesn't restart it
+	EXPECT_CALL(*processor1, reset()).Times(1);
+	EXPECT_CALL(*processor1, process()).Times(0);
+	timeSeqCore.selectScript(0);
+	timeSeqCore.process(1);
+	EXPECT_EQ(timeSeqCore.getStatus(), TimeSeqCore::Status::PAUSED);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor1.get());
+}
+
+TEST(TimeSeqCore, ReloadScriptShouldReloadAllBankedScripts) {
+	std::shared_ptr<MockJsonLoader> mockJsonLoader(new MockJsonLoader());
+	std::shared_ptr<MockProcessorLoader> mockProcessorLoader(new MockProcessorLoader());
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	testing::NiceMock<MockEventListener> mockEventListener;
+	TimeSeqCore timeSeqCore(mockJsonLoader, mockProcessorLoader, &mockSampleRateReader, &mockEventListener);
+
+	std::shared_ptr<Script> script1(new Script());
+	std::shared_ptr<Script> script2(new Script());
+	std::shared_ptr<Processor> processor1(new Processor({}, {}, {}, {}));
+	std::shared_ptr<Processor> processor2(new Processor({}, {}, {}, {}));
+	std::shared_ptr<Processor> processor3(new Processor({}, {}, {}, {}));
+	std::shared_ptr<Processor> processor4(new Processor({}, {}, {}, {}));
+	std::string scriptData = DUMMY_TIMESEQ_SCRIPT;
+
+	EXPECT_CALL(*mockJsonLoader, loadScript).Times(2).WillOnce(testing::Return(script1)).WillOnce(testing::Return(script2));
+	EXPECT_CALL(*mockProcessorLoader, loadScript(script1, testing::_)).Times(2).WillOnce(testing::Return(processor1)).WillOnce(testing::Return(processor3));
+	EXPECT_CALL(*mockProcessorLoader, loadScript(script2, testing::_)).Times(2).WillOnce(testing::Return(processor2)).WillOnce(testing::Return(processor4));
+
+	timeSeqCore.loadScript(scriptData);
+	timeSeqCore.loadScript(7, scriptData);
+	timeSeqCore.reloadScript();
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor3.get());
+
+	timeSeqCore.selectScript(7);
+	timeSeqCore.process(1);
+	EXPECT_EQ(timeSeqCore.m_scriptBank[timeSeqCore.m_activeScript].script, script2);
+	EXPECT_EQ(timeSeqCore.getActiveProcessor(), processor4.get());
+}
+
+TEST(TimeSeqCore, ReplacedProcessorShouldOnlyBeReleasedOnLoadAfterAProcessCycle) {
+	std::shared_ptr<MockJsonLoader> mockJsonLoader(new MockJsonLoader());
+	std::shared_ptr<MockProcessorLoader> mockProcessorLoader(new MockProcessorLoader());
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	testing::NiceMock<MockEventListener> mockEventListener;
+	TimeSeqCore timeSeqCore(mockJsonLoader, mockProcessorLoader, &mockSampleRateReader, &mockEventListener);
+
+	std::shared_ptr<Script> script1(new Script());
+	std::shared_ptr<Script> script2(new Script());
+	std::shared_ptr<Script> script3(new Script());
+	std::shared_ptr<Processor> processor1(new Processor({}, {}, {}, {}));
+	std::shared_ptr<Processor> processor2(new Processor({}, {}, {}, {}));
+	std::shared_ptr<Processor> processor3(new Processor({}, {}, {}, {}));
+	std::weak_ptr<Processor> weakProcessor1(processor1);
+	std::string scriptData = DUMMY_TIMESEQ_SCRIPT;
+
+	EXPECT_CALL(*mockJsonLoader, loadScript).Times(3).WillOnce(testing::Return(script1)).WillOnce(testing::Return(script2)).WillOnce(testing::Return(script3));
+	// Move the processor into the mock, so that the core holds the only reference to it
+	EXPECT_CALL(*mockProcessorLoader, loadScript(script1, testing::_)).Times(1).WillOnce(testing::Return(testing::ByMove(std::move(processor1))));
+	EXPECT_CALL(*mockProcessorLoader, loadScript(script2, testing::_)).Times(1).WillOnce(testing::Return(processor2));
+	EXPECT_CALL(*mockProcessorLoader, loadScript(script3, testing::_)).Times(1).WillOnce(testing::Return(processor3));
+
+	timeSeqCore.loadScript(scriptData);
+	timeSeqCore.loadScript(scriptData);
+	// The replaced processor is kept alive, since the processing thread could still be using it
+	EXPECT_FALSE(weakProcessor1.expired());
+
+	// Processing doesn't release the replaced processor itself
+	timeSeqCore.process(1);
+	EXPECT_FALSE(weakProcessor1.expired());
+
+	// The next load happens after a completed process cycle, so it can release the replaced processor
+	timeSeqCore.loadScript(1, scriptData);
+	EXPECT_TRUE(weakProcessor1.expired());
+}
@@ -0,0 +1,59 @@
+#include "timeseq-json-shared.hpp"
+#include <sstream>
+
+namespace {
+	json getLargeScriptJson() {
+		json json = getMinimalJson();
+		json::array_t segments;
+		for (int i = 0; i < 100; i++) {
+			segments.push_back({ { "duration", { { "samples", 1 + i % 100 } } }, { "actions", json::array({
+				{ { "timing", "start" }, { "set-value", { { "output", 1 }, { "value", { { "voltage", (i % 1000) / 100.f } } } } } },
+				{ { "timing", "glide" }, { "start-value", 0.f }, { "end-value", { { "voltage", 5.f }, { "calc", json::array({ { { "add", (float) (i % 7) } } }) } } }, { "output", 2 } }
+			}) } });
+		}
+		json["timelines"] = json::array({ { { "lanes", json::array({ { { "loop", true }, { "segments", segments } } }) } } });
+		return json;
+	}
+}
+
+TEST(TimeSeqJsonMemory, LoadFromMemoryShouldMatchLoadFromStream) {
+	JsonLoader jsonLoader;
+	std::string data = getLargeScriptJson().dump();
+
+	vector<ValidationError> streamErrors;
+	std::istringstream stream(data);
+	shared_ptr<Script> streamScript = jsonLoader.loadScript(stream, streamErrors);
+
+	vector<ValidationError> memoryErrors;
+	MemoryStreamBuffer buffer(data.data(), data.size());
+	std::istream memoryStream(&buffer);
+	shared_ptr<Script> memoryScript = jsonLoader.loadScript(memoryStream, memoryErrors);
+
+	EXPECT_NO_ERRORS(streamErrors);
+	EXPECT_NO_ERRORS(memoryErrors);
+	ASSERT_TRUE(streamScript);
+	ASSERT_TRUE(memoryScript);
+	ASSERT_EQ(memoryScript->timelines.size(), 1u);
+	ASSERT_EQ(memoryScript->timelines[0].lanes.size(), 1u);
+	EXPECT_EQ(memoryScript->timelines[0].lanes[0].segments.size(), streamScript->timelines[0].lanes[0].segments.size());
+}
+
+TEST(TimeSeqJsonMemory, LoadFromMemoryShouldReportSameParseErrorAsStream) {
+	JsonLoader jsonLoader;
+	std::string data = "{ \"type\": \"not-things_timeseq_script\", ";
+
+	vector<ValidationError> streamErrors;
+	std::istringstream stream(data);
+	jsonLoader.loadScript(stream, streamErrors);
+
+	vector<ValidationError> memoryErrors;
+	MemoryStreamBuffer buffer(data.data(), data.size());
+	std::istream memoryStream(&buffer);
+	shared_ptr<Script> script = jsonLoader.loadScript(memoryStream, memoryErrors);
+
+	EXPECT_FALSE(script);
+	ASSERT_EQ(memoryErrors.size(), 1u);
+	ASSERT_EQ(streamErrors.size(), 1u);
+	EXPECT_EQ(memoryErrors[0].location, streamErrors[0].location);
+	EXPECT_EQ(memoryErrors[0].message, streamErrors[0].message);
+}
@@ -3050,3 +3050,277 @@ TEST(TimeSeqJsonScriptAction, ParseRemoveFromSequenceShouldParsePosition) {
 	EXPECT_EQ(script->actions[2].removeFromSequence->id, "sequence-id-3");
 	EXPECT_EQ(script->actions[2].removeFromSequence->position, 42);
 }
+
+TEST(TimeSeqJsonScriptAction, ParseSetPolyValueShouldRequireVersion130) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_2_0);
+	json["component-pool"] = {
+		{ "actions", json::array({
+			{ { "id", "action-1" }, { "set-poly-value", { { "output", 1 }, { "values", json::array({ 1.f, 2.f }) } } } }
+		} ) }
+	};
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 1u);
+	expectError(validationErrors, ValidationErrorCode::Feature_Not_In_Version, "/component-pool/actions/0");
+}
+
+TEST(TimeSeqJsonScriptAction, ParseSetPolyValueShouldFailOnNonObjectSetPolyValue) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["component-pool"] = {
+		{ "actions", json::array({
+			{ { "id", "action-1" }, { "set-poly-value", "not-an-object" } }
+		} ) }
+	};
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	ASSERT_GT(validationErrors.size(), 0u);
+	expectError(validationErrors, ValidationErrorCode::Action_SetPolyValueObject, "/component-pool/actions/0");
+}
+
+TEST(TimeSeqJsonScriptAction, ParseSetPolyValueShouldFailOnMissingOutputAndValues) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["component-pool"] = {
+		{ "actions", json::array({
+			{ { "id", "action-1" }, { "set-poly-value", json::object() } },
+			{ { "id", "action-2" }, { "set-poly-value", { { "output", 1 }, { "values", "not-an-array" } } } }
+		} ) }
+	};
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 3u);
+	expectError(validationErrors, ValidationErrorCode::SetPolyValue_OutputObject, "/component-pool/actions/0/set-poly-value");
+	expectError(validationErrors, ValidationErrorCode::SetPolyValue_ValuesArray, "/component-pool/actions/0/set-poly-value");
+	expectError(validationErrors, ValidationErrorCode::SetPolyValue_ValuesArray, "/component-pool/actions/1/set-poly-value");
+}
+
+TEST(TimeSeqJsonScriptAction, ParseSetPolyValueShouldFailOnEmptyOrTooManyValues) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["component-pool"] = {
+		{ "actions", json::array({
+			{ { "id", "action-1" }, { "set-poly-value", { { "output", 1 }, { "values", json::array() } } } },
+			{ { "id", "action-2" }, { "set-poly-value", { { "output", 1 }, { "values", json::array({ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 1, 2, 3, 4, 5, 6, 7 }) } } } }
+		} ) }
+	};
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 2u);
+	expectError(validationErrors, ValidationErrorCode::SetPolyValue_ValuesSize, "/component-pool/actions/0/set-poly-value");
+	expectError(validationErrors, ValidationErrorCode::SetPolyValue_ValuesSize, "/component-pool/actions/1/set-poly-value");
+}
+
+TEST(TimeSeqJsonScriptAction, ParseSetPolyValueShouldFailOnInvalidValue) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["component-pool"] = {
+		{ "actions", json::array({
+			{ { "id", "action-1" }, { "set-poly-value", { { "output", 1 }, { "values", json::array({ 1.f, true }) } } } }
+		} ) }
+	};
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 1u);
+	expectError(validationErrors, ValidationErrorCode::SetPolyValue_ValueObject, "/component-pool/actions/0/set-poly-value/values/1");
+}
+
+TEST(TimeSeqJsonScriptAction, ParseSetPolyValueShouldParseOutputAndValues) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["component-pool"] = {
+		{ "actions", json::array({
+			{ { "id", "action-1" }, { "set-poly-value", { { "output", { { "index", 2 }, { "channel", 3 } } }, { "values", json::array({ 1.f, "C4", { { "ref", "value-ref" } } }) } } } }
+		} ) }
+	};
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	ASSERT_EQ(script->actions.size(), 1u);
+	ASSERT_TRUE(script->actions[0].setPolyValue);
+	EXPECT_EQ(script->actions[0].setPolyValue->output.index, 2);
+	EXPECT_EQ(*script->actions[0].setPolyValue->output.channel, 3);
+	ASSERT_EQ(script->actions[0].setPolyValue->values.size(), 3u);
+	EXPECT_EQ(*script->actions[0].setPolyValue->values[0].voltage, 1.f);
+	EXPECT_EQ(*script->actions[0].setPolyValue->values[1].note, "C4");
+	EXPECT_EQ(script->actions[0].setPolyValue->values[2].ref, "value-ref");
+}
+
+TEST(TimeSeqJsonScriptAction, ParseGlideValuesShouldRequireVersion130) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_2_0);
+	json["component-pool"] = {
+		{ "actions", json::array({
+			{ { "id", "action-1" }, { "timing", "glide" }, { "start-values", json::array({ 1.f }) }, { "end-values", json::array({ 2.f }) }, { "output", 1 } }
+		} ) }
+	};
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 2u);
+	expectError(validationErrors, ValidationErrorCode::Feature_Not_In_Version, "/component-pool/actions/0");
+}
+
+TEST(TimeSeqJsonScriptAction, ParseGlideValuesShouldFailOnNonArrayOrInvalidValues) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["component-pool"] = {
+		{ "actions", json::array({
+			{ { "id", "action-1" }, { "timing", "glide" }, { "start-values", 1.f }, { "end-values", json::array({ true }) }, { "output", 1 } },
+			{ { "id", "action-2" }, { "timing", "glide" }, { "start-values", json::array() }, { "end-values", json::array() }, { "output", 1 } }
+		} ) }
+	};
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 5u);
+	expectError(validationErrors, ValidationErrorCode::Action_StartValuesArray, "/component-pool/actions/0");
+	expectError(validationErrors, ValidationErrorCode::Action_EndValuesArray, "/component-pool/actions/0/end-values/0");
+	expectError(validationErrors, ValidationErrorCode::Action_GlideValuesSize, "/component-pool/actions/0");
+	expectError(validationErrors, ValidationErrorCode::Action_GlideValuesSize, "/component-pool/actions/1");
+}
+
+TEST(TimeSeqJsonScriptAction, ParseGlideValuesShouldFailOnMismatchedOrMissingValues) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["component-pool"] = {
+		{ "actions", json::array({
+			{ { "id", "action-1" }, { "timing", "glide" }, { "start-values", json::array({ 1.f, 2.f }) }, { "end-values", json::array({ 1.f }) }, { "output", 1 } },
+			{ { "id", "action-2" }, { "timing", "glide" }, { "start-values", json::array({ 1.f, 2.f }) }, { "output", 1 } },
+			{ { "id", "action-3" }, { "timing", "glide" }, { "start-values", json::array({ 1.f }) }, { "end-values", json::array({ 1.f }) }, { "start-value", 1.f }, { "output", 1 } },
+			{ { "id", "action-4" }, { "timing", "glide" }, { "start-values", json::array({ 1.f }) }, { "end-values", json::array({ 1.f }) }, { "variable", "variable-name" } }
+		} ) }
+	};
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 4u);
+	expectError(validationErrors, ValidationErrorCode::Action_GlideValuesSize, "/component-pool/actions/0");
+	expectError(validationErrors, ValidationErrorCode::Action_MissingGlideValues, "/component-pool/actions/1");
+	expectError(validationErrors, ValidationErrorCode::Action_GlideValueOrValues, "/component-pool/actions/2");
+	expectError(validationErrors, ValidationErrorCode::Action_GlideValuesVariable, "/component-pool/actions/3");
+}
+
+TEST(TimeSeqJsonScriptAction, ParseGlideValuesShouldFailOnNonGlideTiming) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["component-pool"] = {
+		{ "actions", json::array({
+			{ { "id", "action-1" }, { "timing", "start" }, { "start-values", json::array({ 1.f }) }, { "trigger", "trigger-name" } },
+			{ { "id", "action-2" }, { "timing", "gate" }, { "end-values", json::array({ 1.f }) }, { "output", 1 } },
+			{ { "id", "action-3" }, { "timing", "glide" }, { "start-values", json::array({ 1.f }) }, { "end-values", json::array({ 1.f }) }, { "set-poly-value", { { "output", 1 }, { "values", json::array({ 1.f }) } } }, { "output", 1 } }
+		} ) }
+	};
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 3u);
+	expectError(validationErrors, ValidationErrorCode::Action_GlidePropertiesOnNonGlideAction, "/component-pool/actions/0");
+	expectError(validationErrors, ValidationErrorCode::Action_NonGateProperties, "/component-pool/actions/1");
+	expectError(validationErrors, ValidationErrorCode::Action_NonGlideProperties, "/component-pool/actions/2");
+}
+
+TEST(TimeSeqJsonScriptAction, ParseGlideValuesShouldParseStartAndEndValues) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["component-pool"] = {
+		{ "actions", json::array({
+			{ { "id", "action-1" }, { "timing", "glide" }, { "start-values", json::array({ 1.f, "C4" }) }, { "end-values", json::array({ { { "ref", "value-ref" } }, 2.5f }) }, { "output", 1 } }
+		} ) }
+	};
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	ASSERT_EQ(script->actions.size(), 1u);
+	ASSERT_TRUE(script->actions[0].startValues);
+	ASSERT_TRUE(script->actions[0].endValues);
+	EXPECT_FALSE(script->actions[0].startValue);
+	EXPECT_FALSE(script->actions[0].endValue);
+	ASSERT_EQ(script->actions[0].startValues->size(), 2u);
+	ASSERT_EQ(script->actions[0].endValues->size(), 2u);
+	EXPECT_EQ(*(*script->actions[0].startValues)[0].voltage, 1.f);
+	EXPECT_EQ(*(*script->actions[0].startValues)[1].note, "C4");
+	EXPECT_EQ((*script->actions[0].endValues)[0].ref, "value-ref");
+	EXPECT_EQ(*(*script->actions[0].endValues)[1].voltage, 2.5f);
+}
+
+TEST(TimeSeqJsonScriptAction, ParseSelectScriptShouldRequireVersion130) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_2_0);
+	json["component-pool"] = {
+		{ "actions", json::array({
+			{ { "id", "action-1" }, { "select-script", 2 } }
+		} ) }
+	};
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 1u);
+	expectError(validationErrors, ValidationErrorCode::Feature_Not_In_Version, "/component-pool/actions/0");
+}
+
+TEST(TimeSeqJsonScriptAction, ParseSelectScriptShouldFailOnNonNumericOrOutOfRangeValue) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["component-pool"] = {
+		{ "actions", json::array({
+			{ { "id", "action-1" }, { "select-script", "2" } },
+			{ { "id", "action-2" }, { "select-script", -1 } },
+			{ { "id", "action-3" }, { "select-script", 0 } },
+			{ { "id", "action-4" }, { "select-script", 9 } }
+		} ) }
+	};
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 6u);
+	expectError(validationErrors, ValidationErrorCode::Action_SelectScriptNumber, "/component-pool/actions/0");
+	expectError(validationErrors, ValidationErrorCode::Action_MissingNonGlideProperties, "/component-pool/actions/0");
+	expectError(validationErrors, ValidationErrorCode::Action_SelectScriptNumber, "/component-pool/actions/1");
+	expectError(validationErrors, ValidationErrorCode::Action_MissingNonGlideProperties, "/component-pool/actions/1");
+	expectError(validationErrors, ValidationErrorCode::Action_SelectScriptRange, "/component-pool/actions/2");
+	expectError(validationErrors, ValidationErrorCode::Action_SelectScriptRange, "/component-pool/actions/3");
+}
+
+TEST(TimeSeqJsonScriptAction, ParseSelectScriptShouldFailInCombinationWithOtherActions) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["component-pool"] = {
+		{ "actions", json::array({
+			{ { "id", "action-1" }, { "select-script", 2 }, { "trigger", "trigger-1" } },
+			{ { "id", "action-2" }, { "timing", "glide" }, { "select-script", 2 }, { "start-value", 0.f }, { "end-value", 1.f }, { "variable", "variable-1" } }
+		} ) }
+	};
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 2u);
+	expectError(validationErrors, ValidationErrorCode::Action_TooManyNonGlideProperties, "/component-pool/actions/0");
+	expectError(validationErrors, ValidationErrorCode::Action_NonGlideProperties, "/component-pool/actions/1");
+}
+
+TEST(TimeSeqJsonScriptAction, ParseSelectScriptShouldParseScriptNumber) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["component-pool"] = {
+		{ "actions", json::array({
+			{ { "id", "action-1" }, { "timing", "end" }, { "select-script", 8 } }
+		} ) }
+	};
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	expectNoErrors(validationErrors);
+	ASSERT_EQ(script->actions.size(), 1u);
+	ASSERT_TRUE(script->actions[0].selectScript);
+	EXPECT_EQ(*script->actions[0].selectScript, 8);
+	EXPECT_EQ(script->actions[0].timing, ScriptAction::ActionTiming::END);
+}
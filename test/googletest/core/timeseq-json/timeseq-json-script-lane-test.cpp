@@ -712,3 +712,83 @@ TEST(TimeSeqJsonScriptLane, ParseLaneShouldAllowUnknownPropertyWithXPrefix) {
 	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
 	expectNoErrors(validationErrors);
 }
+
+TEST(TimeSeqJsonScriptLane, ParseScriptShouldDefaultControlRateToOne) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson();
+	json["timelines"] = json::array({
+		{
+			{ "lanes", json::array({
+				json::object({ { "segments", json::array() } })
+			}) }
+		}
+	});
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	ASSERT_EQ(script->timelines.size(), 1u);
+	ASSERT_EQ(script->timelines[0].lanes.size(), 1u);
+	EXPECT_EQ(script->timelines[0].lanes[0].controlRate, 1);
+}
+
+TEST(TimeSeqJsonScriptLane, ParseScriptShouldParseControlRate) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["timelines"] = json::array({
+		{
+			{ "lanes", json::array({
+				json::object({ { "control-rate", 32 }, { "segments", json::array() } })
+			}) }
+		}
+	});
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	ASSERT_EQ(script->timelines.size(), 1u);
+	ASSERT_EQ(script->timelines[0].lanes.size(), 1u);
+	EXPECT_EQ(script->timelines[0].lanes[0].controlRate, 32);
+}
+
+TEST(TimeSeqJsonScriptLane, ParseScriptShouldFailOnInvalidControlRate) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["timelines"] = json::array({
+		{
+			{ "lanes", json::array({
+				json::object({ { "control-rate", "fast" }, { "segments", json::array() } }),
+				json::object({ { "control-rate", 0 }, { "segments", json::array() } }),
+				json::object({ { "control-rate", 1025 }, { "segments", json::array() } }),
+				json::object({ { "control-rate", 1.5 }, { "segments", json::array() } }),
+				json::object({ { "control-rate", -16 }, { "segments", json::array() } })
+			}) }
+		}
+	});
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 5u);
+	expectError(validationErrors, ValidationErrorCode::Lane_ControlRateNumber, "/timelines/0/lanes/0");
+	expectError(validationErrors, ValidationErrorCode::Lane_ControlRateNumber, "/timelines/0/lanes/1");
+	expectError(validationErrors, ValidationErrorCode::Lane_ControlRateNumber, "/timelines/0/lanes/2");
+	expectError(validationErrors, ValidationErrorCode::Lane_ControlRateNumber, "/timelines/0/lanes/3");
+	expectError(validationErrors, ValidationErrorCode::Lane_ControlRateNumber, "/timelines/0/lanes/4");
+}
+
+TEST(TimeSeqJsonScriptLane, ParseControlRateShouldRequireVersion130) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_2_0);
+	json["timelines"] = json::array({
+		{
+			{ "lanes", json::array({
+				json::object({ { "control-rate", 16 }, { "segments", json::array() } })
+			}) }
+		}
+	});
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 1u);
+	expectError(validationErrors, ValidationErrorCode::Feature_Not_In_Version, "/timelines/0/lanes/0");
+}
@@ -0,0 +1,146 @@
+#include "timeseq-json-shared.hpp"
+
+TEST(TimeSeqJsonScriptTable, ParseShouldFailWithTablesPre130Version) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_2_0);
+	json["component-pool"] = {
+		{ "tables", json::array() }
+	};
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 1u);
+	expectError(validationErrors, ValidationErrorCode::Feature_Not_In_Version, "/component-pool");
+}
+
+TEST(TimeSeqJsonScriptTable, ParseTablesShouldFailOnNonArrayTables) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["component-pool"] = {
+		{ "tables", "not-an-array" }
+	};
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 1u);
+	expectError(validationErrors, ValidationErrorCode::Script_TablesArray, "/component-pool");
+}
+
+TEST(TimeSeqJsonScriptTable, ParseTableShouldFailOnMissingIdAndVoltages) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["component-pool"] = {
+		{ "tables", json::array({
+			{ { "wrap", true } },
+		}) }
+	};
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 2u);
+	expectError(validationErrors, ValidationErrorCode::Id_String, "/component-pool/tables/0");
+	expectError(validationErrors, ValidationErrorCode::Table_VoltagesArray, "/component-pool/tables/0");
+}
+
+TEST(TimeSeqJsonScriptTable, ParseTableShouldFailOnInvalidVoltages) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["component-pool"] = {
+		{ "tables", json::array({
+			{ { "id", "table-1" }, { "voltages", json::array() } },
+			{ { "id", "table-2" }, { "voltages", json::array({ 1.f, "C4" }) } },
+			{ { "id", "table-3" }, { "voltages", json::array({ 1.f }) }, { "wrap", "yes" } },
+			{ { "id", "table-4" }, { "voltages", json::array({ 1.f }) }, { "unknown", true } },
+		}) }
+	};
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 4u);
+	expectError(validationErrors, ValidationErrorCode::Table_VoltagesArraySize, "/component-pool/tables/0");
+	expectError(validationErrors, ValidationErrorCode::Table_VoltageFloat, "/component-pool/tables/1/voltages/1");
+	expectError(validationErrors, ValidationErrorCode::Table_WrapBoolean, "/component-pool/tables/2");
+	expectError(validationErrors, ValidationErrorCode::Unknown_Property, "/component-pool/tables/3");
+}
+
+TEST(TimeSeqJsonScriptTable, ParseTableShouldSucceed) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["component-pool"] = {
+		{ "tables", json::array({
+			{ { "id", "table-1" }, { "voltages", json::array({ -1.f, 2.5f, 12.f }) } },
+			{ { "id", "table-2" }, { "voltages", json::array({ 3.f }) }, { "wrap", true } },
+		}) }
+	};
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	ASSERT_EQ(script->tables.size(), 2u);
+	EXPECT_EQ(script->tables[0].id, "table-1");
+	EXPECT_EQ(script->tables[0].voltages, vector<float>({ -1.f, 2.5f, 12.f }));
+	EXPECT_FALSE(script->tables[0].wrap);
+	EXPECT_EQ(script->tables[1].id, "table-2");
+	EXPECT_EQ(script->tables[1].voltages, vector<float>({ 3.f }));
+	EXPECT_TRUE(script->tables[1].wrap);
+}
+
+TEST(TimeSeqJsonScriptTable, ParseTableValueShouldFailPre130Version) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_2_0);
+	json["component-pool"] = {
+		{ "values", json::array({
+			{ { "id", "value-1" }, { "table", { { "id", "table-1" }, { "position", .5f } } } }
+		}) }
+	};
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 1u);
+	expectError(validationErrors, ValidationErrorCode::Feature_Not_In_Version, "/component-pool/values/0");
+}
+
+TEST(TimeSeqJsonScriptTable, ParseTableValueShouldFailOnInvalidTableValues) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["component-pool"] = {
+		{ "values", json::array({
+			{ { "id", "value-1" }, { "table", "table-1" } },
+			{ { "id", "value-2" }, { "table", { { "position", .5f } } } },
+			{ { "id", "value-3" }, { "table", { { "id", "" }, { "position", .5f } } } },
+			{ { "id", "value-4" }, { "table", { { "id", "table-1" } } } },
+			{ { "id", "value-5" }, { "table", { { "id", "table-1" }, { "position", true } } } },
+			{ { "id", "value-6" }, { "table", { { "id", "table-1" }, { "position", .5f } } }, { "voltage", 1.f } }
+		}) }
+	};
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 6u);
+	expectError(validationErrors, ValidationErrorCode::Value_TableObject, "/component-pool/values/0");
+	expectError(validationErrors, ValidationErrorCode::TableValue_IdString, "/component-pool/values/1/table");
+	expectError(validationErrors, ValidationErrorCode::TableValue_IdLength, "/component-pool/values/2/table");
+	expectError(validationErrors, ValidationErrorCode::TableValue_PositionObject, "/component-pool/values/3/table");
+	expectError(validationErrors, ValidationErrorCode::TableValue_PositionObject, "/component-pool/values/4/table/position");
+	expectError(validationErrors, ValidationErrorCode::Value_MultipleValues, "/component-pool/values/5");
+}
+
+TEST(TimeSeqJsonScriptTable, ParseTableValueShouldSucceed) {
+	vector<ValidationError> validationErrors;
+	JsonLoader jsonLoader;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["component-pool"] = {
+		{ "values", json::array({
+			{ { "id", "value-1" }, { "table", { { "id", "table-1" }, { "position", { { "variable", "phase" } } } } } }
+		}) }
+	};
+
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	ASSERT_EQ(script->values.size(), 1u);
+	ASSERT_TRUE(script->values[0].table);
+	EXPECT_EQ(script->values[0].table->id, "table-1");
+	ASSERT_TRUE(script->values[0].table->position);
+	ASSERT_TRUE(script->values[0].table->position->variable);
+	EXPECT_EQ(*script->values[0].table->position->variable, "phase");
+}
@@ -31,7 +31,7 @@ TEST(TimeSeqProcessorAssertAction, AssertActionWithNoStopOnFailShouldStopOnFail)
 	EXPECT_CALL(mockEventListener, segmentStarted()).Times(1);
 	string name = "the-assert";
 	string message = "(1 eq 0)";
-	EXPECT_CALL(mockAssertListener, assertFailed(name, message, true)).Times(1);
+	EXPECT_CALL(mockAssertListener, assertFailed(name, FormatsTo(message), true)).Times(1);
 
 	script.second->process();
 }
@@ -72,7 +72,7 @@ TEST(TimeSeqProcessorAssertAction, AssertActionShouldUseRefIf) {
 	EXPECT_CALL(mockEventListener, segmentStarted()).Times(1);
 	string name = "the-assert";
 	string message = "(1 eq 0)";
-	EXPECT_CALL(mockAssertListener, assertFailed(name, message, true)).Times(1);
+	EXPECT_CALL(mockAssertListener, assertFailed(name, FormatsTo(message), true)).Times(1);
 
 	script.second->process();
 }
@@ -179,7 +179,7 @@ TEST(TimeSeqProcessorAssertAction, AssertActionWithStopOnFailShouldStopOnFail) {
 	EXPECT_CALL(mockEventListener, segmentStarted()).Times(1);
 	string name = "the-assert";
 	string message = "(1 eq 0)";
-	EXPECT_CALL(mockAssertListener, assertFailed(name, message, true)).Times(1);
+	EXPECT_CALL(mockAssertListener, assertFailed(name, FormatsTo(message), true)).Times(1);
 
 	script.second->process();
 }
@@ -215,7 +215,46 @@ TEST(TimeSeqProcessorAssertAction, AssertActionWithStopOnFailFalseShouldNotStopO
 	EXPECT_CALL(mockEventListener, segmentStarted()).Times(1);
 	string name = "the-assert";
 	string message = "(1 eq 0)";
-	EXPECT_CALL(mockAssertListener, assertFailed(name, message, false)).Times(1);
+	EXPECT_CALL(mockAssertListener, assertFailed(name, FormatsTo(message), false)).Times(1);
+
+	script.second->process();
+}
+
+TEST(TimeSeqProcessorAssertAction, AssertActionWithTooManyConditionsShouldTruncateMessage) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	MockAssertListener mockAssertListener;
+	ProcessorLoader processorLoader(nullptr, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, &mockAssertListener);
+	vector<ValidationError> validationErrors;
+	json conditions = json::array();
+	string message = "(";
+	for (int i = 0; i < 40; i++) {
+		conditions.push_back({ { "eq", json::array({ { { "voltage", (float) (i % 10) } }, { { "voltage", 0.f } } }) } });
+		if (i > 0) {
+			message += " and ";
+		}
+		// The first term is taken by the and-condition itself
+		message += (i < 31) ? "(" + to_string(i % 10) + " eq 0)" : "...";
+	}
+	message += ")";
+	json json = getMinimalJson(SCRIPT_VERSION_1_2_0);
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "loop", true }, { "segments", json::array({ { { "duration", { { "samples", 1 } } }, { "actions", json::array({
+				{
+					{ "assert", { { "name", "the-assert" }, { "stop-on-fail", false }, { "expect", { { "and", conditions } } } } }
+				}
+			}) } } }) } },
+		}) } }
+	});
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	expectNoErrors(validationErrors);
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+	string name = "the-assert";
+	EXPECT_CALL(mockAssertListener, assertFailed(name, FormatsTo(message), false)).Times(1);
 
 	script.second->process();
 }
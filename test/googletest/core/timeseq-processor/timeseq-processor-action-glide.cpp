@@ -670,3 +670,82 @@ TEST(TimeSeqProcessorGlideAction, GlideActionWithOneSampleDurationShouldSetEndVa
 
 	script.second->process();
 }
+
+void runControlRateGlide(int controlRate, json glideAction, vector<float>& values) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	MockSampleRateReader mockSampleRateReader;
+	MockVariableHandler mockVariableHandler;
+	ProcessorLoader processorLoader(nullptr, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "control-rate", controlRate }, { "segments", json::array({ { { "duration", { { "samples", 18 } } }, { "actions", json::array({ glideAction }) } } }) } },
+		}) } }
+	});
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	EXPECT_CALL(mockVariableHandler, setVariable(outputVariableName, testing::_)).Times(18).WillRepeatedly([&values](const std::string& name, float value) { values.push_back(value); });
+	for (int i = 0; i < 18; i++) {
+		script.second->process();
+	}
+}
+
+TEST(TimeSeqProcessorGlideAction, GlideActionInControlRateLaneShouldRampBetweenControlSteps) {
+	json glideAction = {
+		{ "timing", "glide" },
+		{ "start-value", { { "voltage", -2.f } } },
+		{ "end-value", { { "voltage", 8.f } } },
+		{ "ease-factor", 2.f },
+		{ "ease-algorithm", "pow" },
+		{ "variable", "output-variable" }
+	};
+
+	vector<float> sampleRateValues;
+	vector<float> controlRateValues;
+	runControlRateGlide(1, glideAction, sampleRateValues);
+	runControlRateGlide(4, glideAction, controlRateValues);
+	ASSERT_EQ(sampleRateValues.size(), 18u);
+	ASSERT_EQ(controlRateValues.size(), 18u);
+
+	// The control steps (and the final step of the glide) should match the per-sample calculation
+	for (int i = 0; i < 18; i += 4) {
+		EXPECT_NEAR(controlRateValues[i], sampleRateValues[i], 1e-5f) << "step " << i;
+	}
+	EXPECT_FLOAT_EQ(controlRateValues[17], 8.f);
+
+	// The steps in between should be linearly interpolated between the control steps
+	for (int i = 0; i < 16; i++) {
+		int rampStart = i - (i % 4);
+		float expected = controlRateValues[rampStart] + (controlRateValues[rampStart + 4] - controlRateValues[rampStart]) * (i - rampStart) / 4.f;
+		EXPECT_NEAR(controlRateValues[i], expected, 1e-5f) << "step " << i;
+	}
+
+	// The pow ease starts slow, so the linear ramps should stay above the curve
+	for (int i = 1; i < 16; i++) {
+		EXPECT_GE(controlRateValues[i], sampleRateValues[i] - 1e-5f) << "step " << i;
+	}
+}
+
+TEST(TimeSeqProcessorGlideAction, LinearGlideActionInControlRateLaneShouldMatchSampleRate) {
+	json glideAction = {
+		{ "timing", "glide" },
+		{ "start-value", { { "voltage", 1.f } } },
+		{ "end-value", { { "voltage", -3.f } } },
+		{ "variable", "output-variable" }
+	};
+
+	vector<float> sampleRateValues;
+	vector<float> controlRateValues;
+	runControlRateGlide(1, glideAction, sampleRateValues);
+	runControlRateGlide(16, glideAction, controlRateValues);
+	ASSERT_EQ(controlRateValues.size(), sampleRateValues.size());
+	for (unsigned int i = 0; i < sampleRateValues.size(); i++) {
+		EXPECT_FLOAT_EQ(controlRateValues[i], sampleRateValues[i]) << "step " << i;
+	}
+}
@@ -0,0 +1,67 @@
+#include "timeseq-processor-shared.hpp"
+
+TEST(TimeSeqProcessorSelectScript, SelectScriptActionShouldSelectZeroBasedScriptIndex) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	MockSampleRateReader mockSampleRateReader;
+	MockScriptBankHandler mockScriptBankHandler;
+	ProcessorLoader processorLoader(nullptr, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	processorLoader.setScriptBankHandler(&mockScriptBankHandler);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "segments", json::array({
+				{ { "duration", { { "samples", 2 } } }, { "actions", json::array({
+					{ { "timing", "end" }, { "select-script", 3 } }
+				}) } },
+				{ { "duration", { { "samples", 2 } } }, { "actions", json::array({
+					{ { "select-script", 1 } }
+				}) } }
+			}) } },
+		}) } }
+	});
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	// The end action of the first segment acts as a quantized switch point
+	EXPECT_CALL(mockScriptBankHandler, selectScript(testing::_)).Times(0);
+	script.second->process();
+	testing::Mock::VerifyAndClearExpectations(&mockScriptBankHandler);
+
+	{
+		testing::InSequence inSequence;
+		EXPECT_CALL(mockScriptBankHandler, selectScript(2)).Times(1);
+		EXPECT_CALL(mockScriptBankHandler, selectScript(0)).Times(1);
+	}
+	for (int i = 0; i < 3; i++) {
+		script.second->process();
+	}
+}
+
+TEST(TimeSeqProcessorSelectScript, SelectScriptActionWithoutHandlerShouldDoNothing) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	MockSampleRateReader mockSampleRateReader;
+	ProcessorLoader processorLoader(nullptr, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "loop", true }, { "segments", json::array({ { { "duration", { { "samples", 1 } } }, { "actions", json::array({
+				{ { "select-script", 2 } }
+			}) } } }) } },
+		}) } }
+	});
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	for (int i = 0; i < 3; i++) {
+		script.second->process();
+	}
+}
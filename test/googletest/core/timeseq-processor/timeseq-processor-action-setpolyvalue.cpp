@@ -0,0 +1,206 @@
+#include "timeseq-processor-shared.hpp"
+
+TEST(TimeSeqProcessorSetPolyValueAction, SetPolyValueActionWithUnknownValueShouldFail) {
+	MockEventListener mockEventListener;
+	MockTriggerHandler mockTriggerHandler;
+	MockSampleRateReader mockSampleRateReader;
+	ProcessorLoader processorLoader(nullptr, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "segments", json::array({ { { "duration", { { "samples", 1 } } }, { "actions", json::array({
+				{ { "set-poly-value", { { "output", { { "index", 1 } } }, { "values", json::array({ 1.f, { { "ref", "unknown-value" } } }) } } } }
+			}) } } }) } },
+		}) } }
+	});
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 1u);
+	expectError(validationErrors, ValidationErrorCode::Ref_NotFound, "/timelines/0/lanes/0/segments/0/actions/0/set-poly-value/values/1");
+}
+
+TEST(TimeSeqProcessorSetPolyValueAction, SetPolyValueActionWithTooManyValuesForOutputChannelShouldFail) {
+	MockEventListener mockEventListener;
+	MockTriggerHandler mockTriggerHandler;
+	MockSampleRateReader mockSampleRateReader;
+	ProcessorLoader processorLoader(nullptr, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "segments", json::array({ { { "duration", { { "samples", 1 } } }, { "actions", json::array({
+				{ { "set-poly-value", { { "output", { { "ref", "the-output" } } }, { "values", json::array({ 1.f, 2.f, 3.f }) } } } }
+			}) } } }) } },
+		}) } }
+	});
+	json["component-pool"] = json::object();
+	json["component-pool"]["outputs"] = json::array({
+		{ { "id", "the-output" }, { "index", 2 }, { "channel", 15 } }
+	});
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 1u);
+	expectError(validationErrors, ValidationErrorCode::SetPolyValue_ChannelRange, "/timelines/0/lanes/0/segments/0/actions/0/set-poly-value");
+}
+
+TEST(TimeSeqProcessorSetPolyValueAction, SetPolyValueActionShouldSetAllChannelsFromOutputChannel) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	MockTriggerHandler mockTriggerHandler;
+	MockSampleRateReader mockSampleRateReader;
+	MockVariableHandler mockVariableHandler;
+	MockPortHandler mockPortHandler;
+	ProcessorLoader processorLoader(&mockPortHandler, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "loop", true }, { "segments", json::array({ { { "duration", { { "samples", 1 } } }, { "actions", json::array({
+				{ { "set-poly-value", { { "output", { { "index", 3 }, { "channel", 5 } } }, { "values", json::array({ 1.5f, { { "variable", "input-variable" } }, { { "ref", "the-value" } } }) } } } }
+			}) } } }) } },
+		}) } }
+	});
+	json["component-pool"] = json::object();
+	json["component-pool"]["values"] = json::array({
+		{ { "id", "the-value" }, { "voltage", -2.f } }
+	});
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	vector<string> emptyTriggers = {};
+	{
+		testing::InSequence inSequence;
+
+		for (int i = 0; i < 3; i++) {
+			EXPECT_CALL(mockTriggerHandler, getTriggers()).Times(1).WillOnce(testing::ReturnRef(emptyTriggers));
+			EXPECT_CALL(mockVariableHandler, getVariable(inputVariableName)).Times(1).WillOnce(testing::Return(i));
+			EXPECT_CALL(mockPortHandler, setOutputPortVoltage(2, 4, 1.5f)).Times(1);
+			EXPECT_CALL(mockPortHandler, setOutputPortVoltage(2, 5, (float) i)).Times(1);
+			EXPECT_CALL(mockPortHandler, setOutputPortVoltage(2, 6, -2.f)).Times(1);
+		}
+	}
+
+	for (int i = 0; i < 3; i++) {
+		script.second->process();
+	}
+}
+
+TEST(TimeSeqProcessorSetPolyValueAction, GlidePolyActionWithTooManyValuesForOutputChannelShouldFail) {
+	MockEventListener mockEventListener;
+	MockTriggerHandler mockTriggerHandler;
+	MockSampleRateReader mockSampleRateReader;
+	ProcessorLoader processorLoader(nullptr, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "segments", json::array({ { { "duration", { { "samples", 10 } } }, { "actions", json::array({
+				{
+					{ "timing", "glide" },
+					{ "start-values", json::array({ 0.f, 1.f }) },
+					{ "end-values", json::array({ 1.f, 0.f }) },
+					{ "output", { { "index", 1 }, { "channel", 16 } } }
+				}
+			}) } } }) } },
+		}) } }
+	});
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 1u);
+	expectError(validationErrors, ValidationErrorCode::Action_GlideValuesChannelRange, "/timelines/0/lanes/0/segments/0/actions/0");
+}
+
+TEST(TimeSeqProcessorSetPolyValueAction, GlidePolyActionShouldGlideAllChannels) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	MockTriggerHandler mockTriggerHandler;
+	MockSampleRateReader mockSampleRateReader;
+	MockVariableHandler mockVariableHandler;
+	MockPortHandler mockPortHandler;
+	ProcessorLoader processorLoader(&mockPortHandler, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "segments", json::array({ { { "duration", { { "samples", 10 } } }, { "actions", json::array({
+				{
+					{ "timing", "glide" },
+					{ "start-values", json::array({ 0.f, 4.5f, 1.f }) },
+					{ "end-values", json::array({ 4.5f, 0.f, 1.f }) },
+					{ "output", 8 }
+				}
+			}) } } }) } },
+		}) } }
+	});
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	vector<string> emptyTriggers = {};
+	{
+		testing::InSequence inSequence;
+
+		for (int i = 0; i < 10; i++) {
+			EXPECT_CALL(mockTriggerHandler, getTriggers()).Times(1).WillOnce(testing::ReturnRef(emptyTriggers));
+			EXPECT_CALL(mockPortHandler, setOutputPortVoltage(7, 0, testing::FloatEq((float) i / 2.f))).Times(1);
+			EXPECT_CALL(mockPortHandler, setOutputPortVoltage(7, 1, testing::FloatEq(4.5f - (float) i / 2.f))).Times(1);
+			EXPECT_CALL(mockPortHandler, setOutputPortVoltage(7, 2, testing::FloatEq(1.f))).Times(1);
+		}
+
+		// No further calls should happen after that
+		EXPECT_CALL(mockTriggerHandler, getTriggers()).Times(1).WillOnce(testing::ReturnRef(emptyTriggers));
+		EXPECT_CALL(mockPortHandler, setOutputPortVoltage).Times(0);
+	}
+
+	for (int i = 0; i < 11; i++) {
+		script.second->process();
+	}
+}
+
+TEST(TimeSeqProcessorSetPolyValueAction, GlidePolyActionShouldApplyTheSameEaseToAllChannels) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	MockSampleRateReader mockSampleRateReader;
+	MockVariableHandler mockVariableHandler;
+	MockPortHandler mockPortHandler;
+	ProcessorLoader processorLoader(&mockPortHandler, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "segments", json::array({ { { "duration", { { "samples", 20 } } }, { "actions", json::array({
+				{
+					{ "timing", "glide" },
+					{ "start-values", json::array({ 0.f, 2.f }) },
+					{ "end-values", json::array({ 1.f, 0.f }) },
+					{ "ease-factor", 1.5f },
+					{ "ease-algorithm", "pow" },
+					{ "output", { { "index", 1 }, { "channel", 3 } } }
+				}
+			}) } } }) } },
+		}) } }
+	});
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	// The second channel glides down over twice the range of the first channel, so it should always be at 2 - 2 * the first channel
+	vector<float> firstChannel;
+	EXPECT_CALL(mockPortHandler, setOutputPortVoltage(0, 2, testing::_)).Times(20).WillRepeatedly([&firstChannel](int index, int channel, float voltage) { firstChannel.push_back(voltage); });
+	EXPECT_CALL(mockPortHandler, setOutputPortVoltage(0, 3, testing::_)).Times(20).WillRepeatedly([&firstChannel](int index, int channel, float voltage) {
+		ASSERT_GT(firstChannel.size(), 0u);
+		EXPECT_FLOAT_EQ(voltage, 2.f - 2.f * firstChannel.back());
+	});
+
+	for (int i = 0; i < 20; i++) {
+		script.second->process();
+	}
+
+	ASSERT_EQ(firstChannel.size(), 20u);
+	EXPECT_FLOAT_EQ(firstChannel.front(), 0.f);
+	EXPECT_FLOAT_EQ(firstChannel.back(), 1.f);
+	// A positive pow ease starts slow, so halfway through the glide the value should be below the linear halfway value
+	EXPECT_LT(firstChannel[10], .5f);
+}
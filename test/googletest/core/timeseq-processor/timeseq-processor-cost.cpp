@@ -0,0 +1,170 @@
+#include "timeseq-processor-shared.hpp"
+
+TEST(TimeSeqProcessorCost, CostReportShouldCountLanesSegmentsAndOngoingActions) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	ProcessorLoader processorLoader(nullptr, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson();
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "segments", json::array({
+				{ { "duration", { { "samples", 1000 } } }, { "actions", json::array({
+					{ { "timing", "glide" }, { "start-value", { { "voltage", 0.f } } }, { "end-value", { { "voltage", 1.f } } }, { "output", { { "index", 1 } } } },
+					{ { "timing", "gate" }, { "output", { { "index", 2 } } } }
+				}) } },
+				{ { "duration", { { "samples", 1000 } } }, { "actions", json::array({
+					{ { "timing", "gate" }, { "output", { { "index", 2 } } } }
+				}) } }
+			}) }, { "start-trigger", "trigger-1" } },
+			{ { "segments", json::array({
+				{ { "duration", { { "samples", 1000 } } }, { "actions", json::array({
+					{ { "timing", "gate" }, { "output", { { "index", 3 } } } }
+				}) } }
+			}) }, { "start-trigger", "trigger-1" }, { "stop-trigger", "trigger-2" } }
+		}) } },
+		{ { "lanes", json::array({
+			{ { "segments", json::array({ { { "duration", { { "samples", 1000 } } } } }) }, { "stop-trigger", "trigger-1" } }
+		}) } }
+	});
+	json["input-triggers"] = json::array({
+		{ { "id", "trigger-1" }, { "input", { { "index", 1 } } } }
+	});
+
+	ON_CALL(mockSampleRateReader, getSampleRate()).WillByDefault(testing::Return(48000));
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	ProcessorCostReport costReport = script.second->getCostReport();
+	ASSERT_EQ(costReport.timelines.size(), 2u);
+	EXPECT_EQ(costReport.timelines[0].lanes, 2);
+	EXPECT_EQ(costReport.timelines[0].segments, 3);
+	EXPECT_EQ(costReport.timelines[0].maxConcurrentOngoingActions, 3);
+	EXPECT_EQ(costReport.timelines[1].lanes, 1);
+	EXPECT_EQ(costReport.timelines[1].segments, 1);
+	EXPECT_EQ(costReport.timelines[1].maxConcurrentOngoingActions, 0);
+	EXPECT_EQ(costReport.inputTriggers, 1);
+	EXPECT_EQ(costReport.maxTriggerFanOut, 3);
+	EXPECT_EQ(costReport.maxTriggerFanOutId, "trigger-1");
+	EXPECT_EQ(costReport.hotSpots.size(), 0u);
+}
+
+TEST(TimeSeqProcessorCost, CostReportShouldDetermineCalcDepthAndRandEvaluations) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	ProcessorLoader processorLoader(nullptr, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson();
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "segments", json::array({
+				{ { "duration", { { "samples", 1000 } } }, { "actions", json::array({
+					{ { "set-value", { { "output", 1 }, { "value", { { "voltage", 1.f }, { "calc", json::array({
+						{ { "add", { { "voltage", 1.f } } } },
+						{ { "mult", { { "voltage", 2.f }, { "calc", json::array({
+							{ { "add", { { "rand", { { "lower", { { "voltage", 0.f } } }, { "upper", { { "voltage", 1.f } } } } } } } }
+						}) } } } }
+					}) } } } } } },
+					{ { "set-value", { { "output", 2 }, { "value", { { "rand", { { "lower", { { "voltage", 0.f } } }, { "upper", { { "voltage", 1.f } } } } } } } } } }
+				}) } },
+				{ { "duration", { { "samples", 1000 } } }, { "actions", json::array({
+					{ { "timing", "end" }, { "set-value", { { "output", 1 }, { "value", { { "voltage", 1.f }, { "calc", json::array({
+						{ { "add", { { "voltage", 1.f } } } }
+					}) } } } } } }
+				}) } }
+			}) } }
+		}) } }
+	});
+
+	ON_CALL(mockSampleRateReader, getSampleRate()).WillByDefault(testing::Return(48000));
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	ProcessorCostReport costReport = script.second->getCostReport();
+	// voltage -> add -> mult, where mult has a nested voltage -> add, and that add has a nested rand
+	EXPECT_EQ(costReport.maxCalcDepth, 4);
+	EXPECT_EQ(costReport.maxSegmentStartRandEvaluations, 2);
+	EXPECT_EQ(costReport.maxSegmentStartSequenceEvaluations, 0);
+	EXPECT_GT(costReport.worstCaseSampleOperations, 0);
+	EXPECT_EQ(costReport.hotSpots.size(), 0u);
+}
+
+TEST(TimeSeqProcessorCost, CostReportShouldReportAudioRateSegmentsWithHeavyActionsAsHotSpots) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	ProcessorLoader processorLoader(nullptr, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson();
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "segments", json::array({ { { "ref", "segment-heavy" } } }) }, { "loop", true } }
+		}) } },
+		{ { "lanes", json::array({
+			{ { "segments", json::array({ { { "ref", "segment-light" } } }) }, { "loop", true } },
+			{ { "segments", json::array({ { { "ref", "segment-slow" } } }) }, { "loop", true } }
+		}) } }
+	});
+	nlohmann::json heavyActions = json::array({
+		{ { "set-value", { { "output", 1 }, { "value", { { "rand", { { "lower", { { "voltage", 0.f } } }, { "upper", { { "voltage", 1.f } } } } } } } } } },
+		{ { "set-value", { { "output", 2 }, { "value", { { "voltage", 1.f } } } } } }
+	});
+	json["component-pool"] = { { "segments", json::array({
+		{ { "id", "segment-heavy" }, { "duration", { { "hz", 1000 } } }, { "actions", heavyActions } },
+		{ { "id", "segment-light" }, { "duration", { { "hz", 1000 } } }, { "actions", json::array({
+			{ { "set-value", { { "output", 3 }, { "value", { { "voltage", 1.f } } } } } }
+		}) } },
+		{ { "id", "segment-slow" }, { "duration", { { "hz", 10 } } }, { "actions", heavyActions } }
+	}) } };
+
+	ON_CALL(mockSampleRateReader, getSampleRate()).WillByDefault(testing::Return(48000));
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	ProcessorCostReport costReport = script.second->getCostReport();
+	ASSERT_EQ(costReport.hotSpots.size(), 1u);
+	EXPECT_EQ(costReport.hotSpots[0].location, "/component-pool/segments/0");
+	EXPECT_EQ(costReport.hotSpots[0].message, "The hz segment lasts 48 sample(s), but does 6 operations each time it starts and ends (including 1 rand and 0 sequence evaluations).");
+	EXPECT_EQ(costReport.describe().back(), "/component-pool/segments/0 : " + costReport.hotSpots[0].message);
+}
+
+TEST(TimeSeqProcessorCost, CostReportShouldReportHotSpotsInSegmentBlocksOnceAtTheirScriptLocation) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	ProcessorLoader processorLoader(nullptr, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson();
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "segments", json::array({
+				{ { "duration", { { "samples", 100 } } }, { "actions", json::array({ { { "set-value", { { "output", 3 }, { "value", { { "voltage", 1.f } } } } } } }) } },
+				{ { "segment-block", "heavy-block" } }
+			}) }, { "loop", true } }
+		}) } }
+	});
+	json["component-pool"] = { { "segment-blocks", json::array({
+		{ { "id", "heavy-block" }, { "repeat", 3 }, { "segments", json::array({
+			{ { "duration", { { "samples", 10 } } }, { "actions", json::array({ { { "set-value", { { "output", 1 }, { "value", { { "voltage", 1.f } } } } } } }) } },
+			{ { "duration", { { "samples", 10 } } }, { "actions", json::array({
+				{ { "set-value", { { "output", 1 }, { "value", { { "rand", { { "lower", { { "voltage", 0.f } } }, { "upper", { { "voltage", 1.f } } } } } } } } } },
+				{ { "set-value", { { "output", 2 }, { "value", { { "voltage", 1.f } } } } } }
+			}) } }
+		}) } }
+	}) } };
+
+	ON_CALL(mockSampleRateReader, getSampleRate()).WillByDefault(testing::Return(48000));
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	// The segment block is expanded to 6 segments, of which the heavy one is repeated 3 times
+	ProcessorCostReport costReport = script.second->getCostReport();
+	ASSERT_EQ(costReport.hotSpots.size(), 1u);
+	EXPECT_EQ(costReport.hotSpots[0].location, "/component-pool/segment-blocks/0/segments/1");
+}
@@ -52,7 +52,7 @@ TEST(TimeSeqProcessorIfAssert, ActionWithEqIfShouldCheckIfResult) {
 				string name = "the-assert";
 				string message = formatAssert(1.f, values[i], "eq");
 				EXPECT_CALL(mockVariableHandler, getVariable(inputVariableName)).Times(1).WillOnce(testing::Return(values[i])); // The second getVariable call is to construct the assertion message
-				EXPECT_CALL(mockAssertListener, assertFailed(name, message, false)).Times(1);
+				EXPECT_CALL(mockAssertListener, assertFailed(name, FormatsTo(message), false)).Times(1);
 			}
 		}
 	}
@@ -105,7 +105,7 @@ TEST(TimeSeqProcessorIfAssert, ActionWithEqIfShouldCheckIfResultWithTolerance) {
 				string name = "the-assert";
 				string message = formatAssert(1.f, values[i], "eq");
 				EXPECT_CALL(mockVariableHandler, getVariable(inputVariableName)).Times(1).WillOnce(testing::Return(values[i]));  // The second getVariable call is to construct the assertion message
-				EXPECT_CALL(mockAssertListener, assertFailed(name, message, false)).Times(1);
+				EXPECT_CALL(mockAssertListener, assertFailed(name, FormatsTo(message), false)).Times(1);
 			}
 		}
 	}
@@ -158,7 +158,7 @@ TEST(TimeSeqProcessorIfAssert, ActionWithNeIfShouldCheckIfResultWithTolerance) {
 				string name = "the-assert";
 				string message = formatAssert(1.f, values[i], "ne");
 				EXPECT_CALL(mockVariableHandler, getVariable(inputVariableName)).Times(1).WillOnce(testing::Return(values[i])); // The second getVariable call is to construct the assertion message
-				EXPECT_CALL(mockAssertListener, assertFailed(name, message, false)).Times(1);
+				EXPECT_CALL(mockAssertListener, assertFailed(name, FormatsTo(message), false)).Times(1);
 			}
 		}
 	}
@@ -211,7 +211,7 @@ TEST(TimeSeqProcessorIfAssert, ActionWithNeIfShouldCheckIfResult) {
 				string name = "the-assert";
 				string message = formatAssert(1.f, values[i], "ne");
 				EXPECT_CALL(mockVariableHandler, getVariable(inputVariableName)).Times(1).WillOnce(testing::Return(values[i])); // The second getVariable call is to construct the assertion message
-				EXPECT_CALL(mockAssertListener, assertFailed(name, message, false)).Times(1);
+				EXPECT_CALL(mockAssertListener, assertFailed(name, FormatsTo(message), false)).Times(1);
 			}
 		}
 	}
@@ -264,7 +264,7 @@ TEST(TimeSeqProcessorIfAssert, ActionWithGtShouldCheckIfResult) {
 				string name = "the-assert";
 				string message = formatAssert(1.f, values[i], "gt");
 				EXPECT_CALL(mockVariableHandler, getVariable(inputVariableName)).Times(1).WillOnce(testing::Return(values[i])); // The second getVariable call is to construct the assertion message
-				EXPECT_CALL(mockAssertListener, assertFailed(name, message, false)).Times(1);
+				EXPECT_CALL(mockAssertListener, assertFailed(name, FormatsTo(message), false)).Times(1);
 			}
 		}
 	}
@@ -317,7 +317,7 @@ TEST(TimeSeqProcessorIfAssert, ActionWithGteShouldCheckIfResult) {
 				string name = "the-assert";
 				string message = formatAssert(1.f, values[i], "gte");
 				EXPECT_CALL(mockVariableHandler, getVariable(inputVariableName)).Times(1).WillOnce(testing::Return(values[i])); // The second getVariable call is to construct the assertion message
-				EXPECT_CALL(mockAssertListener, assertFailed(name, message, false)).Times(1);
+				EXPECT_CALL(mockAssertListener, assertFailed(name, FormatsTo(message), false)).Times(1);
 			}
 		}
 	}
@@ -370,7 +370,7 @@ TEST(TimeSeqProcessorIfAssert, ActionWithLtShouldCheckIfResult) {
 				string name = "the-assert";
 				string message = formatAssert(1.f, values[i], "lt");
 				EXPECT_CALL(mockVariableHandler, getVariable(inputVariableName)).Times(1).WillOnce(testing::Return(values[i])); // The second getVariable call is to construct the assertion message
-				EXPECT_CALL(mockAssertListener, assertFailed(name, message, false)).Times(1);
+				EXPECT_CALL(mockAssertListener, assertFailed(name, FormatsTo(message), false)).Times(1);
 			}
 		}
 	}
@@ -423,7 +423,7 @@ TEST(TimeSeqProcessorIfAssert, ActionWithLteShouldCheckIfResult) {
 				string name = "the-assert";
 				string message = formatAssert(1.f, values[i], "lte");
 				EXPECT_CALL(mockVariableHandler, getVariable(inputVariableName)).Times(1).WillOnce(testing::Return(values[i])); // The second getVariable call is to construct the assertion message
-				EXPECT_CALL(mockAssertListener, assertFailed(name, message, false)).Times(1);
+				EXPECT_CALL(mockAssertListener, assertFailed(name, FormatsTo(message), false)).Times(1);
 			}
 		}
 	}
@@ -501,7 +501,7 @@ TEST(TimeSeqProcessorIfAssert, ActionWithAndShouldCheckIfResult) {
 				EXPECT_CALL(mockVariableHandler, getVariable(inputVariable1)).Times(1).WillOnce(testing::Return(values1[i])); // The second getVariable call is to construct the assertion message
 				EXPECT_CALL(mockVariableHandler, getVariable(inputVariable2)).Times(1).WillOnce(testing::Return(values2[i])); // The second getVariable call is to construct the assertion message
 				EXPECT_CALL(mockVariableHandler, getVariable(inputVariable3)).Times(1).WillOnce(testing::Return(values3[i])); // The second getVariable call is to construct the assertion message
-				EXPECT_CALL(mockAssertListener, assertFailed(name, message, false)).Times(1);
+				EXPECT_CALL(mockAssertListener, assertFailed(name, FormatsTo(message), false)).Times(1);
 			}
 		}
 	}
@@ -579,7 +579,7 @@ TEST(TimeSeqProcessorIfAssert, ActionWithOrShouldCheckIfResult) {
 				EXPECT_CALL(mockVariableHandler, getVariable(inputVariable1)).Times(1).WillOnce(testing::Return(values1[i])); // The second getVariable call is to construct the assertion message
 				EXPECT_CALL(mockVariableHandler, getVariable(inputVariable2)).Times(1).WillOnce(testing::Return(values2[i])); // The second getVariable call is to construct the assertion message
 				EXPECT_CALL(mockVariableHandler, getVariable(inputVariable3)).Times(1).WillOnce(testing::Return(values3[i])); // The second getVariable call is to construct the assertion message
-				EXPECT_CALL(mockAssertListener, assertFailed(name, message, false)).Times(1);
+				EXPECT_CALL(mockAssertListener, assertFailed(name, FormatsTo(message), false)).Times(1);
 			}
 		}
 	}
@@ -158,3 +158,48 @@ TEST(TimeSeqProcessorInputTriggers, ScriptWithInputTriggersWithPooledInputsShoul
 
 	testTriggerInvocation(mockPortHandler, mockTriggerHandler, processorLoader, script.second);
 }
+
+TEST(TimeSeqProcessorInputTriggers, InputTriggersOnTheSameInputShouldBeDetectedTogether) {
+	MockPortHandler mockPortHandler;
+	MockTriggerHandler mockTriggerHandler;
+	ProcessorLoader processorLoader(&mockPortHandler, nullptr, &mockTriggerHandler, nullptr, nullptr, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson();
+	json["input-triggers"] = json::array({
+		{ { "id", "trigger-1" }, { "input", { { "index", 3 }, { "channel", 4 } } } },
+		{ { "id", "trigger-2" }, { "input", { { "index", 1 } } } },
+		{ { "id", "trigger-3" }, { "input", { { "index", 3 }, { "channel", 2 } } } },
+		{ { "id", "trigger-4" }, { "input", { { "ref", "input-1" } } } }
+	});
+	json["component-pool"] = { { "inputs", json::array({
+		{ { "id", "input-1" }, { "index", 3 }, { "channel", 4 } }
+	})}};
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	ASSERT_EQ(script.second->m_triggers.size(), 2u);
+	EXPECT_EQ(script.second->m_triggers[0]->m_inputPort, 2);
+	EXPECT_EQ(script.second->m_triggers[0]->m_channelMask, (1 << 3) | (1 << 1));
+	EXPECT_EQ(script.second->m_triggers[1]->m_inputPort, 0);
+	EXPECT_EQ(script.second->m_triggers[1]->m_channelMask, 1);
+	EXPECT_EQ(script.second->getCostReport().inputTriggers, 4);
+
+	ON_CALL(mockPortHandler, getInputPortVoltage(testing::_, testing::_)).WillByDefault(testing::Return(0.f));
+	EXPECT_CALL(mockPortHandler, getInputPortVoltage(testing::_, testing::_)).Times(3);
+	EXPECT_CALL(mockTriggerHandler, setTrigger).Times(0);
+	script.second->process();
+	testing::Mock::VerifyAndClearExpectations(&mockPortHandler);
+	testing::Mock::VerifyAndClearExpectations(&mockTriggerHandler);
+
+	// The triggers of a port are fired in channel order, and in script order for triggers on the same channel
+	EXPECT_CALL(mockPortHandler, getInputPortVoltage(2, 1)).WillOnce(testing::Return(5.f));
+	EXPECT_CALL(mockPortHandler, getInputPortVoltage(2, 3)).WillOnce(testing::Return(5.f));
+	EXPECT_CALL(mockPortHandler, getInputPortVoltage(0, 0)).WillOnce(testing::Return(0.f));
+	{
+		testing::InSequence inSequence;
+		EXPECT_CALL(mockTriggerHandler, setTrigger("trigger-3")).Times(1);
+		EXPECT_CALL(mockTriggerHandler, setTrigger("trigger-1")).Times(1);
+		EXPECT_CALL(mockTriggerHandler, setTrigger("trigger-4")).Times(1);
+	}
+	script.second->process();
+}
@@ -0,0 +1,88 @@
+#include "timeseq-processor-shared.hpp"
+#include "util/mappedfile.hpp"
+#include <fstream>
+#include <cstdio>
+
+namespace {
+#ifdef __linux__
+	// Resets the peak resident set size of the process to its current size. Returns false if the kernel doesn't allow it.
+	bool resetPeakRss() {
+		std::ofstream clearRefs("/proc/self/clear_refs");
+		clearRefs << "5";
+		clearRefs.close();
+		return !clearRefs.fail();
+	}
+
+	long getPeakRssKb() {
+		std::ifstream status("/proc/self/status");
+		std::string line;
+		while (std::getline(status, line)) {
+			if (line.rfind("VmHWM:", 0) == 0) {
+				return std::stol(line.substr(6));
+			}
+		}
+		return -1;
+	}
+
+	long getRssKb() {
+		std::ifstream status("/proc/self/status");
+		std::string line;
+		while (std::getline(status, line)) {
+			if (line.rfind("VmRSS:", 0) == 0) {
+				return std::stol(line.substr(6));
+			}
+		}
+		return -1;
+	}
+#endif
+}
+
+TEST(TimeSeqProcessorMappedFile, MappedScriptFileShouldLoadAndReportPeakRss) {
+	std::string path = testing::TempDir() + "timeseq-json-memory-large.json";
+	size_t fileSize;
+	{
+		std::ofstream file(path, std::ios::binary);
+		file << getLargeScriptJson(1, 1, 2500, false).dump();
+		fileSize = file.tellp();
+	}
+
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	JsonLoader jsonLoader;
+	ProcessorLoader processorLoader(nullptr, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+
+#ifdef __linux__
+	bool peakRssReset = resetPeakRss();
+	long startRssKb = getRssKb();
+#endif
+
+	shared_ptr<Script> script;
+	shared_ptr<Processor> processor;
+	{
+		MappedFile file(path);
+		ASSERT_TRUE(file.isOpen());
+		ASSERT_EQ(file.size(), fileSize);
+
+		MemoryStreamBuffer buffer(file.data(), file.size());
+		std::istream stream(&buffer);
+		script = jsonLoader.loadScript(stream, validationErrors);
+		EXPECT_NO_ERRORS(validationErrors);
+		ASSERT_TRUE(script);
+		processor = processorLoader.loadScript(script, validationErrors);
+		EXPECT_NO_ERRORS(validationErrors);
+		ASSERT_TRUE(processor);
+	}
+	EXPECT_EQ(processor->m_timelines[0]->m_lanes[0]->m_segments.size(), 5000u);
+
+#ifdef __linux__
+	if (peakRssReset) {
+		long peakRssKb = getPeakRssKb();
+		RecordProperty("ScriptFileKb", (int) (fileSize / 1024));
+		RecordProperty("PeakRssIncreaseKb", (int) (peakRssKb - startRssKb));
+	}
+#endif
+
+	std::remove(path.c_str());
+}
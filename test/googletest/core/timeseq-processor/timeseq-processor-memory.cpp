@@ -0,0 +1,131 @@
+#include "timeseq-processor-shared.hpp"
+
+namespace {
+	// A script with one lane per set-value action, where each action uses the same sequence
+	json getSequenceJson(int lanes, bool shared) {
+		json json = getMinimalJson(SCRIPT_VERSION_1_2_0);
+		json::array_t laneArray;
+		for (int i = 0; i < lanes; i++) {
+			laneArray.push_back({ { "segments", json::array({ { { "duration", { { "samples", 1 } } }, { "actions", json::array({
+				{ { "set-value", { { "output", i + 1 }, { "value", { { "sequence", "the-sequence-with-a-long-enough-id" } } } } } }
+			}) } } }) } });
+		}
+		json["timelines"] = json::array({ { { "lanes", laneArray } } });
+		json["sequences"] = json::array({
+			{ { "id", "the-sequence-with-a-long-enough-id" }, { "shared", shared }, { "values", json::array({ 1.f, 2.f, 3.f }) } }
+		});
+		return json;
+	}
+}
+
+TEST(TimeSeqProcessorMemory, MemoryReportShouldCountAllCategories) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	testing::NiceMock<MockVariableHandler> mockVariableHandler;
+	testing::NiceMock<MockPortHandler> mockPortHandler;
+	ProcessorLoader processorLoader(&mockPortHandler, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson(SCRIPT_VERSION_1_2_0);
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "loop", true }, { "segments", json::array({
+				{ { "duration", { { "samples", 1000 } } }, { "actions", json::array({
+					{ { "timing", "start" }, { "set-value", { { "output", { { "index", 1 } } }, { "value", 3.f } } } },
+					{ { "timing", "glide" }, { "start-value", 0.f }, { "end-value", 3.f }, { "output", { { "index", 2 } } } }
+				}) } },
+				{ { "duration", { { "samples", 10 } } }, { "actions", json::array({
+					{ { "set-variable", { { "name", "a-variable-name-that-does-not-fit-in-a-short-string" }, { "value", { { "sequence", "the-sequence" } } } } } }
+				}) } }
+			}) } }
+		}) } }
+	});
+	json["sequences"] = json::array({
+		{ { "id", "the-sequence" }, { "values", json::array({ 1.f, 2.f, 3.f }) } }
+	});
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+	ON_CALL(mockSampleRateReader, getSampleRate()).WillByDefault(testing::Return(48000));
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	ASSERT_TRUE(script.second->m_timelines[0]->m_lanes[0]->m_segments[0]->m_recordOutputs);
+
+	ProcessorMemoryReport memoryReport = script.second->getMemoryReport();
+	EXPECT_GT(memoryReport.processors, 0u);
+	EXPECT_GT(memoryReport.values, 0u);
+	EXPECT_GT(memoryReport.strings, strlen("a-variable-name-that-does-not-fit-in-a-short-string"));
+	EXPECT_GT(memoryReport.sequences, 0u);
+	// The recording of the first segment is only filled in once it runs, but should already be counted for all its steps
+	EXPECT_GE(memoryReport.recordings, 1001u * 2 * sizeof(uint32_t));
+	EXPECT_GT(memoryReport.script, sizeof(Script));
+	EXPECT_EQ(memoryReport.getTotal(), memoryReport.processors + memoryReport.values + memoryReport.strings + memoryReport.sequences + memoryReport.recordings + memoryReport.script);
+
+	// Running the script fills in the recording, which shouldn't change the memory that it was expected to use
+	for (int i = 0; i < 1010; i++) {
+		script.second->process();
+	}
+	ASSERT_TRUE(script.second->m_timelines[0]->m_lanes[0]->m_segments[0]->m_recording.isComplete());
+	EXPECT_GE(script.second->getMemoryReport().recordings, memoryReport.recordings);
+
+	vector<string> lines = memoryReport.describe();
+	ASSERT_EQ(lines.size(), 7u);
+	EXPECT_EQ(lines[0].rfind("Processors: ", 0), 0u);
+	EXPECT_EQ(lines[6].rfind("Total: ", 0), 0u);
+}
+
+TEST(TimeSeqProcessorMemory, SharedProcessorsShouldOnlyBeCountedOnce) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	ProcessorLoader processorLoader(nullptr, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+
+	// All lanes use the same position in a shared sequence
+	json sharedScriptJson = getSequenceJson(1, true);
+	pair<shared_ptr<Script>, shared_ptr<Processor>> sharedScript = loadProcessor(processorLoader, sharedScriptJson, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	json sharedScript4Json = getSequenceJson(4, true);
+	pair<shared_ptr<Script>, shared_ptr<Processor>> sharedScript4 = loadProcessor(processorLoader, sharedScript4Json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	ProcessorMemoryReport sharedReport = sharedScript.second->getMemoryReport();
+	ProcessorMemoryReport sharedReport4 = sharedScript4.second->getMemoryReport();
+	EXPECT_EQ(sharedReport4.sequences, sharedReport.sequences);
+	EXPECT_EQ(sharedReport4.strings, sharedReport.strings);
+	EXPECT_GT(sharedReport4.processors, sharedReport.processors);
+
+	// Each lane has its own position in a non-shared sequence, but the sequence itself is still shared
+	json nonSharedScriptJson = getSequenceJson(1, false);
+	pair<shared_ptr<Script>, shared_ptr<Processor>> nonSharedScript = loadProcessor(processorLoader, nonSharedScriptJson, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	json nonSharedScript4Json = getSequenceJson(4, false);
+	pair<shared_ptr<Script>, shared_ptr<Processor>> nonSharedScript4 = loadProcessor(processorLoader, nonSharedScript4Json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	ProcessorMemoryReport nonSharedReport = nonSharedScript.second->getMemoryReport();
+	ProcessorMemoryReport nonSharedReport4 = nonSharedScript4.second->getMemoryReport();
+	EXPECT_GT(nonSharedReport4.sequences, nonSharedReport.sequences);
+	EXPECT_LT(nonSharedReport4.sequences - nonSharedReport.sequences, 3 * nonSharedReport.sequences);
+	EXPECT_EQ(nonSharedReport4.strings, nonSharedReport.strings);
+}
+
+TEST(TimeSeqProcessorMemory, LargerScriptShouldReportMoreMemory) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	ProcessorLoader processorLoader(nullptr, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+
+	json smallScriptJson = getSequenceJson(1, true);
+	pair<shared_ptr<Script>, shared_ptr<Processor>> smallScript = loadProcessor(processorLoader, smallScriptJson, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	json largeScriptJson = getSequenceJson(8, true);
+	pair<shared_ptr<Script>, shared_ptr<Processor>> largeScript = loadProcessor(processorLoader, largeScriptJson, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	ProcessorMemoryReport smallReport = smallScript.second->getMemoryReport();
+	ProcessorMemoryReport largeReport = largeScript.second->getMemoryReport();
+	EXPECT_GT(largeReport.processors, smallReport.processors);
+	EXPECT_GT(largeReport.values, smallReport.values);
+	EXPECT_GT(largeReport.script, smallReport.script);
+	EXPECT_GT(largeReport.getTotal(), smallReport.getTotal());
+}
@@ -0,0 +1,87 @@
+#include "timeseq-processor-shared.hpp"
+
+namespace {
+	shared_ptr<Processor> parseScript(PortHandler* portHandler, TriggerHandler* triggerHandler, SampleRateReader* sampleRateReader, EventListener* eventListener, shared_ptr<Script>& script, bool parallel, vector<ValidationError>& validationErrors) {
+		ProcessorScriptParser processorScriptParser(portHandler, nullptr, triggerHandler, sampleRateReader, eventListener, nullptr, make_shared<RandValueGenerator>(), nullptr, nullptr, nullptr, false);
+		if (parallel) {
+			processorScriptParser.m_parallelMinSegments = 0;
+			processorScriptParser.m_workerCount = 4;
+		} else {
+			processorScriptParser.m_workerCount = 1;
+		}
+		return processorScriptParser.parseScript(script, validationErrors);
+	}
+}
+
+TEST(TimeSeqProcessorParallel, ParallelParseShouldReportSameErrorsInSameOrderAsSerialParse) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	testing::NiceMock<MockPortHandler> mockPortHandler;
+	JsonLoader jsonLoader;
+	vector<ValidationError> validationErrors;
+	json json = getLargeScriptJson(3, 5, 4, true);
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	vector<ValidationError> serialErrors;
+	parseScript(&mockPortHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, script, false, serialErrors);
+	ASSERT_EQ(serialErrors.size(), 15u);
+	expectError(serialErrors, ValidationErrorCode::Ref_NotFound, "/timelines/0/lanes/4/segments/0");
+	expectError(serialErrors, ValidationErrorCode::Ref_NotFound, "/timelines/1/lanes/3/segments/2");
+	expectError(serialErrors, ValidationErrorCode::Ref_NotFound, "/timelines/2/lanes/3/segments/7/actions/1");
+
+	// Repeat a few times, since the order in which the workers pick up the lanes differs on each run
+	for (int i = 0; i < 10; i++) {
+		vector<ValidationError> parallelErrors;
+		parseScript(&mockPortHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, script, true, parallelErrors);
+		ASSERT_EQ(parallelErrors.size(), serialErrors.size());
+		for (size_t j = 0; j < serialErrors.size(); j++) {
+			EXPECT_EQ(parallelErrors[j].location, serialErrors[j].location) << "run " << i << ", error " << j;
+			EXPECT_EQ(parallelErrors[j].message, serialErrors[j].message) << "run " << i << ", error " << j;
+		}
+	}
+}
+
+TEST(TimeSeqProcessorParallel, ParallelParseShouldCreateSameProcessorAsSerialParse) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	MockPortHandler mockPortHandler;
+	JsonLoader jsonLoader;
+	vector<ValidationError> validationErrors;
+	json json = getLargeScriptJson(3, 5, 4, false);
+	shared_ptr<Script> script = loadScript(jsonLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+
+	shared_ptr<Processor> serialProcessor = parseScript(&mockPortHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, script, false, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	shared_ptr<Processor> parallelProcessor = parseScript(&mockPortHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, script, true, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	ASSERT_EQ(parallelProcessor->m_timelines.size(), serialProcessor->m_timelines.size());
+	for (size_t i = 0; i < serialProcessor->m_timelines.size(); i++) {
+		ASSERT_EQ(parallelProcessor->m_timelines[i]->m_lanes.size(), serialProcessor->m_timelines[i]->m_lanes.size());
+		for (size_t j = 0; j < serialProcessor->m_timelines[i]->m_lanes.size(); j++) {
+			EXPECT_EQ(parallelProcessor->m_timelines[i]->m_lanes[j]->m_scriptLane, serialProcessor->m_timelines[i]->m_lanes[j]->m_scriptLane);
+			EXPECT_EQ(parallelProcessor->m_timelines[i]->m_lanes[j]->m_segments.size(), serialProcessor->m_timelines[i]->m_lanes[j]->m_segments.size());
+		}
+	}
+
+	vector<pair<int, float>> voltages;
+	EXPECT_CALL(mockPortHandler, setOutputPortVoltage(testing::_, 0, testing::_)).WillRepeatedly([&voltages](int index, int channel, float voltage) { voltages.push_back({ index, voltage }); });
+
+	for (int i = 0; i < 100; i++) {
+		serialProcessor->process();
+	}
+	vector<pair<int, float>> serialVoltages = voltages;
+	ASSERT_GT(serialVoltages.size(), 0u);
+
+	voltages.clear();
+	for (int i = 0; i < 100; i++) {
+		parallelProcessor->process();
+	}
+	EXPECT_EQ(voltages, serialVoltages);
+}
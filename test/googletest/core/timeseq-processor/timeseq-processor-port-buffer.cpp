@@ -0,0 +1,164 @@
+#include "timeseq-processor-shared.hpp"
+
+namespace {
+	struct MockPortLabelListener : PortLabelListener {
+		MOCK_METHOD(void, outputPortLabelChanged, (int, const std::string&), (override));
+	};
+
+	// Does exactly the same as a PortBuffer, but isn't final, so the processors can only call it through the vtable
+	struct VirtualPortBuffer : PortHandler {
+		float getInputPortVoltage(int index, int channel) const override {
+			return inputVoltages[index][channel];
+		}
+
+		void getInputPortVoltages(int index, float* voltages, uint16_t channelMask) const override {
+			std::memcpy(voltages, inputVoltages[index].data(), sizeof(inputVoltages[index]));
+		}
+
+		float getOutputPortVoltage(int index, int channel) const override {
+			return outputVoltages[index][channel];
+		}
+
+		void setOutputPortVoltage(int index, int channel, float voltage) override {
+			outputVoltages[index][channel] = voltage;
+			outputDirtyChannels[index] |= 1 << channel;
+		}
+
+		void setOutputPortVoltages(int index, int channel, const float* voltages, int count) override {
+			std::memcpy(outputVoltages[index].data() + channel, voltages, count * sizeof(float));
+			outputDirtyChannels[index] |= ((1 << count) - 1) << channel;
+		}
+
+		void setOutputPortChannels(int index, int channels) override {
+			outputChannels[index] = channels;
+		}
+
+		void setOutputPortLabel(int index, const std::string& label) override {}
+
+		std::array<std::array<float, 16>, TIMESEQ_PORT_COUNT> inputVoltages = {};
+		std::array<std::array<float, 16>, TIMESEQ_PORT_COUNT> outputVoltages = {};
+		std::array<int, TIMESEQ_PORT_COUNT> outputChannels = {};
+		std::array<uint16_t, TIMESEQ_PORT_COUNT> outputDirtyChannels = {};
+	};
+
+	// A script that reads and writes ports on every sample. The values depend on the inputs, so the segments aren't recorded.
+	json getPortHeavyScriptJson() {
+		json json = getMinimalJson();
+		json::array_t lanes;
+		for (int lane = 0; lane < 8; lane++) {
+			json::array_t segments;
+			for (int i = 0; i < 4; i++) {
+				segments.push_back({ { "duration", { { "samples", 64 + i * 16 } } }, { "actions", json::array({
+					{ { "timing", "start" }, { "set-value", { { "output", { { "index", lane + 1 }, { "channel", 1 } } }, { "value", { { "input", lane + 1 } } } } } },
+					{ { "timing", "glide" }, { "start-value", { { "input", lane + 1 } } }, { "end-value", { { "output", { { "index", lane + 1 }, { "channel", 1 } } } } }, { "output", { { "index", lane + 1 }, { "channel", 2 } } } },
+					{ { "timing", "glide" }, { "start-value", 0.f }, { "end-value", { { "input", { { "index", lane + 1 }, { "channel", 2 } } } } }, { "output", { { "index", lane + 1 }, { "channel", 3 } } } },
+					{ { "timing", "gate" }, { "output", { { "index", lane + 1 }, { "channel", 4 } } } }
+				}) } });
+			}
+			lanes.push_back({ { "loop", true }, { "segments", segments } });
+		}
+		json["timelines"] = json::array({ { { "lanes", lanes } } });
+		return json;
+	}
+
+	template<typename PortHandlerT>
+	void fillInputs(PortHandlerT& portHandler) {
+		for (int i = 0; i < TIMESEQ_PORT_COUNT; i++) {
+			for (int j = 0; j < 16; j++) {
+				portHandler.inputVoltages[i][j] = (i + 1) * .5f - j * .25f;
+			}
+		}
+	}
+}
+
+TEST(TimeSeqProcessorPortBuffer, PortBufferShouldTrackDirtyChannelsAndPorts) {
+	MockPortLabelListener mockPortLabelListener;
+	PortBuffer portBuffer(&mockPortLabelListener);
+
+	portBuffer.setOutputPortVoltage(2, 3, 4.5f);
+	float voltages[] = { 1.f, 2.f, 3.f };
+	portBuffer.setOutputPortVoltages(5, 4, voltages, 3);
+	portBuffer.setOutputPortChannels(7, 6);
+
+	EXPECT_EQ(portBuffer.getOutputPortVoltage(2, 3), 4.5f);
+	EXPECT_EQ(portBuffer.getOutputPortVoltage(5, 4), 1.f);
+	EXPECT_EQ(portBuffer.getOutputPortVoltage(5, 6), 3.f);
+	EXPECT_EQ(portBuffer.outputDirtyChannels[2], 0x0008);
+	EXPECT_EQ(portBuffer.outputDirtyChannels[5], 0x0070);
+	EXPECT_EQ(portBuffer.outputChannels[7], 6);
+	EXPECT_EQ(portBuffer.outputDirtyPorts, 0x80);
+
+	portBuffer.inputVoltages[1][9] = -3.f;
+	EXPECT_EQ(portBuffer.getInputPortVoltage(1, 9), -3.f);
+	array<float, 16> inputVoltages;
+	portBuffer.getInputPortVoltages(1, inputVoltages.data(), 0x0200);
+	EXPECT_EQ(inputVoltages[9], -3.f);
+
+	EXPECT_CALL(mockPortLabelListener, outputPortLabelChanged(3, "label")).Times(1);
+	portBuffer.setOutputPortLabel(3, "label");
+}
+
+TEST(TimeSeqProcessorPortBuffer, ProcessorsShouldOnlyBeBoundToPortBuffer) {
+	testing::NiceMock<MockPortLabelListener> mockPortLabelListener;
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	testing::NiceMock<MockPortHandler> mockPortHandler;
+	PortBuffer portBuffer(&mockPortLabelListener);
+	vector<ValidationError> validationErrors;
+	json json = getPortHeavyScriptJson();
+
+	ProcessorLoader boundProcessorLoader(&portBuffer, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	pair<shared_ptr<Script>, shared_ptr<Processor>> boundScript = loadProcessor(boundProcessorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	shared_ptr<ActionSetValueProcessor> boundAction = dynamic_pointer_cast<ActionSetValueProcessor>(boundScript.second->m_timelines[0]->m_lanes[0]->m_segments[0]->m_startActions[0]);
+	ASSERT_TRUE(boundAction);
+	EXPECT_TRUE(boundAction->m_portHandler.isPortBuffer());
+	EXPECT_EQ(boundAction->m_portHandler.getPortHandler(), &portBuffer);
+
+	ProcessorLoader mockProcessorLoader(&mockPortHandler, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	pair<shared_ptr<Script>, shared_ptr<Processor>> mockScript = loadProcessor(mockProcessorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	shared_ptr<ActionSetValueProcessor> mockAction = dynamic_pointer_cast<ActionSetValueProcessor>(mockScript.second->m_timelines[0]->m_lanes[0]->m_segments[0]->m_startActions[0]);
+	ASSERT_TRUE(mockAction);
+	EXPECT_FALSE(mockAction->m_portHandler.isPortBuffer());
+}
+
+TEST(TimeSeqProcessorPortBuffer, BoundProcessorsShouldMatchVirtualCallsAndReportSampleTime) {
+	testing::NiceMock<MockPortLabelListener> mockPortLabelListener;
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+	ON_CALL(mockSampleRateReader, getSampleRate()).WillByDefault(testing::Return(48000));
+	vector<ValidationError> validationErrors;
+	json json = getPortHeavyScriptJson();
+
+	PortBuffer portBuffer(&mockPortLabelListener);
+	fillInputs(portBuffer);
+	ProcessorLoader boundProcessorLoader(&portBuffer, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	pair<shared_ptr<Script>, shared_ptr<Processor>> boundScript = loadProcessor(boundProcessorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	VirtualPortBuffer virtualPortBuffer;
+	fillInputs(virtualPortBuffer);
+	ProcessorLoader virtualProcessorLoader(&virtualPortBuffer, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	pair<shared_ptr<Script>, shared_ptr<Processor>> virtualScript = loadProcessor(virtualProcessorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	// Both port handlers should end up with the same voltages after each sample
+	for (int i = 0; i < 1000; i++) {
+		boundScript.second->process();
+		virtualScript.second->process();
+		ASSERT_EQ(portBuffer.outputVoltages, virtualPortBuffer.outputVoltages) << "sample " << i;
+		ASSERT_EQ(portBuffer.outputDirtyChannels, virtualPortBuffer.outputDirtyChannels) << "sample " << i;
+	}
+
+	// Time both variants over the same number of samples. The timings are reported, but not compared, since they depend on the build and the machine.
+	const int samples = 200000;
+	double boundNs = measureNanosPerCall(samples, [&boundScript]() { boundScript.second->process(); });
+	double virtualNs = measureNanosPerCall(samples, [&virtualScript]() { virtualScript.second->process(); });
+	RecordProperty("bound-ns-per-sample", to_string(boundNs));
+	RecordProperty("virtual-ns-per-sample", to_string(virtualNs));
+	EXPECT_EQ(portBuffer.outputVoltages, virtualPortBuffer.outputVoltages);
+}
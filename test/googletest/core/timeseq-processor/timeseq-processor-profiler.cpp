@@ -0,0 +1,45 @@
+#ifdef __NT_TIMESEQ_PROFILING__
+
+#include "timeseq-processor-shared.hpp"
+
+TEST(TimeSeqProcessorProfiler, ProfileShouldCountLaneAndSegmentInvocations) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+	ProcessorLoader processorLoader(nullptr, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson();
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "segments", json::array({ { { "ref", "segment-1" } }, { { "duration", { { "samples", 10 } } } } }) }, { "loop", true } },
+			{ { "segments", json::array({ { { "ref", "segment-1" } } }) }, { "loop", true } }
+		}) } }
+	});
+	json["component-pool"] = { { "segments", json::array({
+		{ { "id", "segment-1" }, { "duration", { { "samples", 10 } } } }
+	}) } };
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	script.second->reset();
+	for (int i = 0; i < 200; i++) {
+		script.second->process();
+	}
+
+	vector<ProfilerEntry> profile = script.second->getProfile();
+	ASSERT_EQ(profile.size(), 4u);
+	// Each loop of a lane causes an additional process invocation for that lane
+	EXPECT_EQ(profile[0].name, "/timelines/0/lanes/0");
+	EXPECT_EQ(profile[0].invocations, 209u);
+	EXPECT_GT(profile[0].nanos, 0.);
+	EXPECT_EQ(profile[1].name, "/timelines/0/lanes/1");
+	EXPECT_EQ(profile[1].invocations, 219u);
+	EXPECT_EQ(profile[2].name, "segment 'segment-1'");
+	EXPECT_EQ(profile[2].invocations, 300u);
+	EXPECT_EQ(profile[3].name, "/timelines/0/lanes/0/segments/1");
+	EXPECT_EQ(profile[3].invocations, 100u);
+}
+
+#endif
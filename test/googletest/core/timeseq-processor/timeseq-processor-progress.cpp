@@ -0,0 +1,91 @@
+#include "timeseq-processor-shared.hpp"
+
+namespace {
+	// Two segments of four samples in a looping lane, and a lane that isn't started automatically
+	json getProgressJson() {
+		json json = getMinimalJson();
+		json["timelines"] = json::array({
+			{ { "lanes", json::array({
+				{ { "loop", true }, { "segments", json::array({
+					{ { "duration", { { "samples", 4 } } } },
+					{ { "duration", { { "samples", 4 } } } }
+				}) } },
+				{ { "auto-start", false }, { "segments", json::array({
+					{ { "duration", { { "samples", 4 } } } }
+				}) } }
+			}) } }
+		});
+		return json;
+	}
+}
+
+TEST(TimeSeqProcessorProgress, LaneProgressShouldFollowSegmentsAndLoops) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	ProcessorLoader processorLoader(nullptr, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getProgressJson();
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	array<LaneProgress, 4> lanes;
+	ASSERT_EQ(script.second->getLaneProgress(lanes.data(), lanes.size()), 2);
+	EXPECT_TRUE(lanes[0].active);
+	EXPECT_EQ(lanes[0].segment, 0);
+	EXPECT_EQ(lanes[0].segmentCount, 2);
+	EXPECT_EQ(lanes[0].position, 0.f);
+	EXPECT_EQ(lanes[0].loops, 0);
+	EXPECT_FALSE(lanes[1].active);
+	EXPECT_EQ(lanes[1].segmentCount, 1);
+	EXPECT_EQ(lanes[1].position, 0.f);
+
+	// Halfway into the second segment
+	for (int i = 0; i < 6; i++) {
+		script.second->process();
+	}
+	script.second->getLaneProgress(lanes.data(), lanes.size());
+	EXPECT_EQ(lanes[0].segment, 1);
+	EXPECT_FLOAT_EQ(lanes[0].position, .5f);
+	EXPECT_EQ(lanes[0].loops, 0);
+
+	// At the end of the second segment
+	for (int i = 0; i < 2; i++) {
+		script.second->process();
+	}
+	script.second->getLaneProgress(lanes.data(), lanes.size());
+	EXPECT_EQ(lanes[0].segment, 1);
+	EXPECT_FLOAT_EQ(lanes[0].position, 1.f);
+
+	// The lane looped and is in the first sample of its first segment again
+	script.second->process();
+	script.second->getLaneProgress(lanes.data(), lanes.size());
+	EXPECT_TRUE(lanes[0].active);
+	EXPECT_EQ(lanes[0].segment, 0);
+	EXPECT_FLOAT_EQ(lanes[0].position, .25f);
+	EXPECT_EQ(lanes[0].loops, 1);
+	EXPECT_FALSE(lanes[1].active);
+}
+
+TEST(TimeSeqProcessorProgress, LaneProgressShouldBeLimitedToMaxLanes) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	ProcessorLoader processorLoader(nullptr, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getProgressJson();
+	json["timelines"].push_back(json["timelines"][0]);
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	array<LaneProgress, 3> lanes;
+	lanes[2].segmentCount = -1;
+	EXPECT_EQ(script.second->getLaneProgress(lanes.data(), 2), 2);
+	EXPECT_EQ(lanes[2].segmentCount, -1);
+	EXPECT_EQ(script.second->getLaneProgress(lanes.data(), 3), 3);
+	EXPECT_EQ(lanes[2].segmentCount, 2);
+}
@@ -0,0 +1,322 @@
+#include "timeseq-processor-shared.hpp"
+
+// Processes one processor up to the specified sample and seeks another one to the same sample, after which both should be in
+// the same state and set the same output voltages
+void expectSeekToMatchProcessing(json& json, uint64_t samples, int compareSamples) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	testing::NiceMock<MockVariableHandler> mockVariableHandler;
+	MockPortHandler processedPortHandler;
+	MockPortHandler seekedPortHandler;
+	ProcessorLoader processedLoader(&processedPortHandler, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	ProcessorLoader seekedLoader(&seekedPortHandler, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+	ON_CALL(mockSampleRateReader, getSampleRate()).WillByDefault(testing::Return(48000));
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> processed = loadProcessor(processedLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	pair<shared_ptr<Script>, shared_ptr<Processor>> seeked = loadProcessor(seekedLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	vector<tuple<int, int, float>> processedVoltages;
+	vector<tuple<int, int, float>> seekedVoltages;
+	EXPECT_CALL(processedPortHandler, setOutputPortVoltage).WillRepeatedly([&processedVoltages](int index, int channel, float voltage) { processedVoltages.push_back({ index, channel, voltage }); });
+	EXPECT_CALL(seekedPortHandler, setOutputPortVoltage).WillRepeatedly([&seekedVoltages](int index, int channel, float voltage) { seekedVoltages.push_back({ index, channel, voltage }); });
+
+	processed.second->reset();
+	for (uint64_t i = 0; i < samples; i++) {
+		processed.second->process();
+	}
+	seeked.second->reset();
+	seeked.second->seek(samples);
+
+	// A loop-locked timeline that can't skip its passes at once continues the seek while processing
+	while (any_of(seeked.second->m_timelines.begin(), seeked.second->m_timelines.end(), [](const shared_ptr<TimelineProcessor>& timeline) { return timeline->m_seeking; })) {
+		processed.second->process();
+		seeked.second->process();
+	}
+
+	for (size_t timeline = 0; timeline < processed.second->m_timelines.size(); timeline++) {
+		// A processed segment only moves on to the next segment (or loops) on the sample after it ended, while the seek immediately
+		// moves on. Since this also affects the loop-lock of the other lanes, only compare timelines in which no segment just ended.
+		bool segmentEnded = false;
+		for (const shared_ptr<LaneProcessor>& processedLane : processed.second->m_timelines[timeline]->m_lanes) {
+			segmentEnded = segmentEnded || ((processedLane->m_state == LaneProcessor::LaneState::STATE_PROCESSING) && (processedLane->m_segments[processedLane->m_activeSegment]->getState() == DurationProcessor::DurationState::STATE_END));
+		}
+		if (segmentEnded) {
+			continue;
+		}
+
+		for (size_t lane = 0; lane < processed.second->m_timelines[timeline]->m_lanes.size(); lane++) {
+			const shared_ptr<LaneProcessor>& processedLane = processed.second->m_timelines[timeline]->m_lanes[lane];
+			const shared_ptr<LaneProcessor>& seekedLane = seeked.second->m_timelines[timeline]->m_lanes[lane];
+			EXPECT_EQ(seekedLane->m_state, processedLane->m_state) << "lane " << lane;
+			EXPECT_EQ(seekedLane->m_repeatCount, processedLane->m_repeatCount) << "lane " << lane;
+			EXPECT_NEAR(seekedLane->m_drift, processedLane->m_drift, 1e-6) << "lane " << lane;
+			if (processedLane->m_state == LaneProcessor::LaneState::STATE_PROCESSING) {
+				EXPECT_EQ(seekedLane->m_activeSegment, processedLane->m_activeSegment) << "lane " << lane;
+			}
+		}
+	}
+
+	// Only compare the voltages of the samples after the seek position
+	processedVoltages.clear();
+	seekedVoltages.clear();
+	for (int i = 0; i < compareSamples; i++) {
+		processed.second->process();
+		seeked.second->process();
+	}
+
+	EXPECT_EQ(seekedVoltages, processedVoltages);
+}
+
+TEST(TimeSeqProcessorSeek, SeekShouldMatchProcessingOfLoopingLane) {
+	json json = getMinimalJson();
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "loop", true }, { "segments", json::array({
+				{ { "duration", { { "hz", 13000 } } }, { "actions", json::array({
+					{ { "timing", "start" }, { "set-value", { { "output", { { "index", 1 } } }, { "value", 3.f } } } },
+					{ { "timing", "glide" }, { "start-value", -2.f }, { "end-value", 5.f }, { "ease-factor", 1.2f }, { "output", { { "index", 2 } } } }
+				}) } },
+				{ { "duration", { { "samples", 7 } } }, { "actions", json::array({
+					{ { "timing", "start" }, { "set-value", { { "output", { { "index", 1 } } }, { "value", -1.f } } } },
+					{ { "timing", "gate" }, { "gate-high-ratio", .3f }, { "output", { { "index", 3 } } } }
+				}) } },
+				{ { "duration", { { "hz", 7000 } } }, { "actions", json::array({
+					{ { "timing", "glide" }, { "start-value", 5.f }, { "end-value", -2.f }, { "output", { { "index", 2 } } } }
+				}) } }
+			}) } }
+		}) } }
+	});
+
+	for (uint64_t samples : { 0u, 1u, 3u, 4u, 11u, 12u, 17u, 1000u, 123457u }) {
+		SCOPED_TRACE(samples);
+		expectSeekToMatchProcessing(json, samples, 50);
+	}
+}
+
+TEST(TimeSeqProcessorSeek, SeekShouldStopRepeatingLaneAtItsEnd) {
+	json json = getMinimalJson();
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "repeat", 3 }, { "segments", json::array({
+				{ { "duration", { { "hz", 11000 } } }, { "actions", json::array({
+					{ { "timing", "glide" }, { "start-value", 0.f }, { "end-value", 5.f }, { "output", { { "index", 1 } } } }
+				}) } },
+				{ { "duration", { { "samples", 3 } } }, { "actions", json::array({
+					{ { "timing", "start" }, { "set-value", { { "output", { { "index", 1 } } }, { "value", 1.f } } } }
+				}) } }
+			}) } }
+		}) } }
+	});
+
+	for (uint64_t samples : { 7u, 14u, 21u, 22u, 23u, 1000u }) {
+		SCOPED_TRACE(samples);
+		expectSeekToMatchProcessing(json, samples, 10);
+	}
+}
+
+TEST(TimeSeqProcessorSeek, SeekShouldMatchProcessingOfLoopLockedLanes) {
+	json json = getMinimalJson();
+	json["timelines"] = json::array({
+		{ { "loop-lock", true }, { "lanes", json::array({
+			{ { "loop", true }, { "segments", json::array({
+				{ { "duration", { { "hz", 9000 } } }, { "actions", json::array({
+					{ { "timing", "glide" }, { "start-value", 0.f }, { "end-value", 5.f }, { "output", { { "index", 1 } } } }
+				}) } },
+				{ { "duration", { { "samples", 5 } } }, { "actions", json::array({
+					{ { "timing", "start" }, { "set-value", { { "output", { { "index", 1 } } }, { "value", 1.f } } } }
+				}) } }
+			}) } },
+			{ { "repeat", 4 }, { "segments", json::array({
+				{ { "duration", { { "samples", 13 } } }, { "actions", json::array({
+					{ { "timing", "gate" }, { "output", { { "index", 2 } } } }
+				}) } }
+			}) } }
+		}) } },
+		{ { "loop-lock", true }, { "lanes", json::array({
+			{ { "loop", true }, { "segments", json::array({
+				{ { "duration", { { "samples", 6 } } }, { "actions", json::array({
+					{ { "timing", "glide" }, { "start-value", 0.f }, { "end-value", 5.f }, { "output", { { "index", 3 } } } }
+				}) } }
+			}) } },
+			{ { "loop", true }, { "segments", json::array({
+				{ { "duration", { { "samples", 4 } } }, { "actions", json::array({
+					{ { "timing", "gate" }, { "output", { { "index", 4 } } } }
+				}) } }
+			}) } }
+		}) } }
+	});
+
+	for (uint64_t samples : { 5u, 13u, 26u, 52u, 53u, 60u, 10001u }) {
+		SCOPED_TRACE(samples);
+		expectSeekToMatchProcessing(json, samples, 30);
+	}
+}
+
+TEST(TimeSeqProcessorSeek, SeekShouldSkipPassesOfLoopLockedLanesWithDriftAtOnce) {
+	json json = getMinimalJson();
+	json["timelines"] = json::array({
+		{ { "loop-lock", true }, { "lanes", json::array({
+			{ { "loop", true }, { "segments", json::array({
+				{ { "duration", { { "hz", 4645.16129 } } }, { "actions", json::array({
+					{ { "timing", "glide" }, { "start-value", 0.f }, { "end-value", 5.f }, { "output", { { "index", 1 } } } }
+				}) } }
+			}) } },
+			{ { "repeat", 100000 }, { "segments", json::array({
+				{ { "duration", { { "hz", 3870.96774 } } }, { "actions", json::array({
+					{ { "timing", "gate" }, { "output", { { "index", 2 } } } }
+				}) } }
+			}) } }
+		}) } }
+	});
+
+	for (uint64_t samples : { 1000003u, 1240000u, 1250001u }) {
+		SCOPED_TRACE(samples);
+		expectSeekToMatchProcessing(json, samples, 30);
+	}
+
+	// Seeking an hour ahead completes at once, also after the repeating lane has ended
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	testing::NiceMock<MockVariableHandler> mockVariableHandler;
+	testing::NiceMock<MockPortHandler> mockPortHandler;
+	ProcessorLoader processorLoader(&mockPortHandler, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+	ON_CALL(mockSampleRateReader, getSampleRate()).WillByDefault(testing::Return(48000));
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	script.second->reset();
+	script.second->seek(48000u * 60 * 60);
+	EXPECT_FALSE(script.second->m_timelines[0]->m_seeking);
+	EXPECT_EQ(script.second->m_timelines[0]->m_lanes[0]->m_state, LaneProcessor::LaneState::STATE_PROCESSING);
+	EXPECT_EQ(script.second->m_timelines[0]->m_lanes[1]->m_repeatCount, 99999);
+}
+
+TEST(TimeSeqProcessorSeek, SeekShouldContinueSkippingAlternatingPassesOfLoopLockedLanesWhileProcessing) {
+	json json = getMinimalJson();
+	json["timelines"] = json::array({
+		{ { "loop-lock", true }, { "lanes", json::array({
+			{ { "loop", true }, { "segments", json::array({
+				{ { "duration", { { "hz", 4571.42857 } } }, { "actions", json::array({
+					{ { "timing", "glide" }, { "start-value", 0.f }, { "end-value", 5.f }, { "output", { { "index", 1 } } } }
+				}) } }
+			}) } },
+			{ { "loop", true }, { "segments", json::array({
+				{ { "duration", { { "hz", 4660.19417 } } }, { "actions", json::array({
+					{ { "timing", "glide" }, { "start-value", 2.f }, { "end-value", 7.f }, { "output", { { "index", 2 } } } }
+				}) } }
+			}) } }
+		}) } }
+	});
+
+	for (uint64_t samples : { 1003u, 200001u }) {
+		SCOPED_TRACE(samples);
+		expectSeekToMatchProcessing(json, samples, 30);
+	}
+}
+
+TEST(TimeSeqProcessorSeek, SeekShouldStopAtSegmentWithVariableDuration) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	testing::NiceMock<MockVariableHandler> mockVariableHandler;
+	MockPortHandler mockPortHandler;
+	ProcessorLoader processorLoader(&mockPortHandler, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson();
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "segments", json::array({
+				{ { "duration", { { "samples", 10 } } }, { "actions", json::array({
+					{ { "timing", "start" }, { "set-value", { { "output", { { "index", 1 } } }, { "value", 1.f } } } }
+				}) } },
+				{ { "duration", { { "samples", { { "variable", inputVariableName } } } } }, { "actions", json::array({
+					{ { "timing", "start" }, { "set-value", { { "output", { { "index", 1 } } }, { "value", 2.f } } } }
+				}) } },
+				{ { "duration", { { "samples", 10 } } }, { "actions", json::array({
+					{ { "timing", "start" }, { "set-value", { { "output", { { "index", 1 } } }, { "value", 3.f } } } }
+				}) } }
+			}) } }
+		}) } }
+	});
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+	ON_CALL(mockVariableHandler, getVariable(inputVariableName)).WillByDefault(testing::Return(10.f));
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	// Neither the passed over segment, nor the segment with the variable duration should execute any actions during the seek
+	EXPECT_CALL(mockPortHandler, setOutputPortVoltage).Times(0);
+	script.second->reset();
+	script.second->seek(25);
+	testing::Mock::VerifyAndClearExpectations(&mockPortHandler);
+
+	const shared_ptr<LaneProcessor>& lane = script.second->m_timelines[0]->m_lanes[0];
+	EXPECT_EQ(lane->m_activeSegment, 1);
+	EXPECT_EQ(lane->m_segments[1]->getState(), DurationProcessor::DurationState::STATE_START);
+
+	EXPECT_CALL(mockPortHandler, setOutputPortVoltage(0, 0, 2.f)).Times(1);
+	script.second->process();
+}
+
+TEST(TimeSeqProcessorSeek, SeekShouldOnlyExecuteStartActionsOfLandingSegment) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	MockTriggerHandler mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	MockVariableHandler mockVariableHandler;
+	MockPortHandler mockPortHandler;
+	ProcessorLoader processorLoader(&mockPortHandler, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson();
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "segments", json::array({
+				{ { "duration", { { "samples", 10 } } }, { "actions", json::array({
+					{ { "timing", "start" }, { "set-variable", { { "name", "first" }, { "value", 1.f } } } },
+					{ { "timing", "end" }, { "trigger", "first-trigger" } }
+				}) } },
+				{ { "duration", { { "samples", 10 } } }, { "actions", json::array({
+					{ { "timing", "start" }, { "set-variable", { { "name", "second" }, { "value", 2.f } } } },
+					{ { "timing", "glide" }, { "start-value", 0.f }, { "end-value", 9.f }, { "output", { { "index", 1 } } } },
+					{ { "timing", "end" }, { "trigger", "second-trigger" } }
+				}) } }
+			}) } }
+		}) } }
+	});
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	vector<string> emptyTriggers = {};
+	{
+		testing::InSequence inSequence;
+
+		// The seek only executes the start action of the second segment
+		EXPECT_CALL(mockVariableHandler, setVariable("second", 2.f)).Times(1);
+
+		// The glide continues from the position of the seek, and the end action is executed at the end of the segment
+		for (int i = 4; i < 9; i++) {
+			EXPECT_CALL(mockTriggerHandler, getTriggers()).Times(1).WillOnce(testing::ReturnRef(emptyTriggers));
+			EXPECT_CALL(mockPortHandler, setOutputPortVoltage(0, 0, testing::FloatEq(i))).Times(1);
+		}
+		EXPECT_CALL(mockTriggerHandler, getTriggers()).Times(1).WillOnce(testing::ReturnRef(emptyTriggers));
+		EXPECT_CALL(mockPortHandler, setOutputPortVoltage(0, 0, testing::FloatEq(9.f))).Times(1);
+		EXPECT_CALL(mockTriggerHandler, setTrigger("second-trigger")).Times(1);
+	}
+
+	script.second->reset();
+	script.second->seek(14);
+	for (int i = 0; i < 6; i++) {
+		script.second->process();
+	}
+}
@@ -0,0 +1,256 @@
+#include "timeseq-processor-shared.hpp"
+
+TEST(TimeSeqProcessorSegmentRecording, DeterministicSegmentShouldReplayRecordedVoltages) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	MockVariableHandler mockVariableHandler;
+	MockPortHandler mockPortHandler;
+	ProcessorLoader processorLoader(&mockPortHandler, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson();
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "loop", true }, { "segments", json::array({ { { "duration", { { "samples", 4 } } }, { "actions", json::array({
+				{ { "timing", "start" }, { "set-value", { { "output", { { "index", 1 } } }, { "value", 3.f } } } },
+				{ { "timing", "glide" }, { "start-value", 0.f }, { "end-value", 3.f }, { "output", { { "index", 2 } } } },
+				{ { "timing", "gate" }, { "output", { { "index", 3 } } } }
+			}) } } }) } },
+		}) } }
+	});
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+	ON_CALL(mockSampleRateReader, getSampleRate()).WillByDefault(testing::Return(48000));
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	shared_ptr<SegmentProcessor> segment = script.second->m_timelines[0]->m_lanes[0]->m_segments[0];
+	EXPECT_TRUE(segment->m_recordOutputs);
+
+	vector<pair<int, float>> voltages;
+	EXPECT_CALL(mockPortHandler, setOutputPortVoltage(testing::_, 0, testing::_)).WillRepeatedly([&voltages](int index, int channel, float voltage) { voltages.push_back({ index, voltage }); });
+
+	for (int i = 0; i < 4; i++) {
+		script.second->process();
+	}
+	EXPECT_TRUE(segment->m_recording.isComplete());
+	vector<pair<int, float>> firstRun = voltages;
+	ASSERT_GT(firstRun.size(), 0u);
+
+	// Each further run of the segment should set exactly the same voltages
+	for (int run = 0; run < 3; run++) {
+		voltages.clear();
+		for (int i = 0; i < 4; i++) {
+			script.second->process();
+		}
+		EXPECT_EQ(voltages, firstRun) << "run " << run;
+	}
+}
+
+TEST(TimeSeqProcessorSegmentRecording, ReplayedSegmentWithDriftShouldMatchProcessedSegment) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	testing::NiceMock<MockVariableHandler> mockVariableHandler;
+	MockPortHandler mockPortHandler;
+	ProcessorLoader processorLoader(&mockPortHandler, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson();
+	// Both lanes do the same, but the variable makes the second lane non-deterministic, so only the first lane is recorded
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "loop", true }, { "segments", json::array({ { { "duration", { { "hz", 13000 } } }, { "actions", json::array({
+				{ { "timing", "glide" }, { "start-value", -2.f }, { "end-value", 5.f }, { "ease-factor", 1.2f }, { "output", { { "index", 1 } } } },
+				{ { "timing", "gate" }, { "gate-high-ratio", .6f }, { "output", { { "index", 2 } } } }
+			}) } } }) } },
+			{ { "loop", true }, { "segments", json::array({ { { "duration", { { "hz", 13000 } } }, { "actions", json::array({
+				{ { "timing", "glide" }, { "start-value", -2.f }, { "end-value", { { "variable", inputVariableName } } }, { "ease-factor", 1.2f }, { "output", { { "index", 3 } } } },
+				{ { "timing", "gate" }, { "gate-high-ratio", .6f }, { "output", { { "index", 4 } } } }
+			}) } } }) } }
+		}) } }
+	});
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+	ON_CALL(mockSampleRateReader, getSampleRate()).WillByDefault(testing::Return(48000));
+	ON_CALL(mockVariableHandler, getVariable(inputVariableName)).WillByDefault(testing::Return(5.f));
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	EXPECT_TRUE(script.second->m_timelines[0]->m_lanes[0]->m_segments[0]->m_recordOutputs);
+	EXPECT_FALSE(script.second->m_timelines[0]->m_lanes[1]->m_segments[0]->m_recordOutputs);
+
+	array<vector<float>, 4> voltages;
+	EXPECT_CALL(mockPortHandler, setOutputPortVoltage(testing::_, 0, testing::_)).WillRepeatedly([&voltages](int index, int channel, float voltage) { voltages[index].push_back(voltage); });
+
+	// 48000 / 13000 is about 3.69 samples, so the drift correction repeats a sample of the segment every few runs
+	for (int i = 0; i < 1000; i++) {
+		script.second->process();
+	}
+
+	EXPECT_TRUE(script.second->m_timelines[0]->m_lanes[0]->m_segments[0]->m_recording.isComplete());
+	ASSERT_GT(voltages[0].size(), 900u);
+	EXPECT_EQ(voltages[0], voltages[2]);
+	EXPECT_EQ(voltages[1], voltages[3]);
+}
+
+TEST(TimeSeqProcessorSegmentRecording, NonDeterministicSegmentsShouldNotBeRecorded) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	MockVariableHandler mockVariableHandler;
+	MockPortHandler mockPortHandler;
+	ProcessorLoader processorLoader(&mockPortHandler, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson();
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "segments", json::array({
+				// A value that depends on an input
+				{ { "duration", { { "samples", 10 } } }, { "actions", json::array({
+					{ { "timing", "start" }, { "set-value", { { "output", { { "index", 1 } } }, { "value", { { "input", { { "index", 1 } } } } } } } }
+				}) } },
+				// A value with a random calc
+				{ { "duration", { { "samples", 10 } } }, { "actions", json::array({
+					{ { "timing", "start" }, { "set-value", { { "output", { { "index", 1 } } }, { "value", { { "voltage", 1.f }, { "calc", json::array({ { { "add", { { "rand", { { "lower", 0.f }, { "upper", 1.f } } } } } } }) } } } } } }
+				}) } },
+				// A conditional action
+				{ { "duration", { { "samples", 10 } } }, { "actions", json::array({
+					{ { "timing", "start" }, { "set-value", { { "output", { { "index", 1 } } }, { "value", 1.f } } }, { "if", { { "eq", json::array({ 1.f, 1.f }) } } } }
+				}) } },
+				// An action that doesn't set an output
+				{ { "duration", { { "samples", 10 } } }, { "actions", json::array({
+					{ { "timing", "start" }, { "set-variable", { { "name", outputVariableName }, { "value", 1.f } } } }
+				}) } },
+				// A glide to a variable
+				{ { "duration", { { "samples", 10 } } }, { "actions", json::array({
+					{ { "timing", "glide" }, { "start-value", 0.f }, { "end-value", 1.f }, { "variable", outputVariableName } }
+				}) } },
+				// A segment that is too short
+				{ { "duration", { { "samples", 2 } } }, { "actions", json::array({
+					{ { "timing", "start" }, { "set-value", { { "output", { { "index", 1 } } }, { "value", 1.f } } } }
+				}) } },
+				// A segment with a variable duration
+				{ { "duration", { { "samples", { { "variable", inputVariableName } } } } }, { "actions", json::array({
+					{ { "timing", "start" }, { "set-value", { { "output", { { "index", 1 } } }, { "value", 1.f } } } }
+				}) } },
+				// A deterministic segment
+				{ { "duration", { { "samples", 10 } } }, { "actions", json::array({
+					{ { "timing", "start" }, { "set-value", { { "output", { { "index", 1 } } }, { "value", 1.f } } } }
+				}) } }
+			}) } },
+		}) } }
+	});
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	const vector<shared_ptr<SegmentProcessor>>& segments = script.second->m_timelines[0]->m_lanes[0]->m_segments;
+	ASSERT_EQ(segments.size(), 8u);
+	for (int i = 0; i < 7; i++) {
+		EXPECT_FALSE(segments[i]->m_recordOutputs) << "segment " << i;
+		EXPECT_FALSE(segments[i]->m_outputRecorder) << "segment " << i;
+	}
+	EXPECT_TRUE(segments[7]->m_recordOutputs);
+}
+
+TEST(TimeSeqProcessorSegmentRecording, ResetDuringFirstRunShouldDiscardPartialRecording) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	MockSampleRateReader mockSampleRateReader;
+	MockVariableHandler mockVariableHandler;
+	MockPortHandler mockPortHandler;
+	ProcessorLoader processorLoader(&mockPortHandler, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson();
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "loop", true }, { "segments", json::array({ { { "duration", { { "samples", 5 } } }, { "actions", json::array({
+				{ { "timing", "glide" }, { "start-value", 0.f }, { "end-value", 4.f }, { "output", { { "index", 1 } } } }
+			}) } } }) } },
+		}) } }
+	});
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	shared_ptr<SegmentProcessor> segment = script.second->m_timelines[0]->m_lanes[0]->m_segments[0];
+
+	vector<float> voltages;
+	EXPECT_CALL(mockPortHandler, setOutputPortVoltage(0, 0, testing::_)).WillRepeatedly([&voltages](int index, int channel, float voltage) { voltages.push_back(voltage); });
+
+	for (int i = 0; i < 2; i++) {
+		script.second->process();
+	}
+	EXPECT_FALSE(segment->m_recording.isComplete());
+
+	script.second->reset();
+	voltages.clear();
+	for (int i = 0; i < 10; i++) {
+		script.second->process();
+	}
+	EXPECT_TRUE(segment->m_recording.isComplete());
+
+	// Both the recorded run and the replayed run should glide over the full range
+	vector<float> expected = { 0.f, 1.f, 2.f, 3.f, 4.f, 0.f, 1.f, 2.f, 3.f, 4.f };
+	ASSERT_EQ(voltages.size(), expected.size());
+	for (size_t i = 0; i < expected.size(); i++) {
+		EXPECT_FLOAT_EQ(voltages[i], expected[i]) << "sample " << i;
+	}
+}
+
+TEST(TimeSeqProcessorSegmentRecording, RecordingShouldBeAllocatedWhenTheScriptIsLoaded) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	MockVariableHandler mockVariableHandler;
+	testing::NiceMock<MockPortHandler> mockPortHandler;
+	ProcessorLoader processorLoader(&mockPortHandler, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "loop", true }, { "segments", json::array({ { { "duration", { { "samples", 4 } } }, { "actions", json::array({
+				{ { "timing", "start" }, { "set-value", { { "output", { { "index", 1 } } }, { "value", 3.f } } } },
+				{ { "timing", "end" }, { "set-poly-value", { { "output", { { "index", 1 } } }, { "values", json::array({ 1.f, 2.f, 3.f }) } } } },
+				{ { "timing", "glide" }, { "start-values", json::array({ 0.f, 1.f }) }, { "end-values", json::array({ 3.f, 4.f }) }, { "output", { { "index", 2 } } } },
+				{ { "timing", "gate" }, { "output", { { "index", 3 } } } }
+			}) } } }) } },
+		}) } }
+	});
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+	ON_CALL(mockSampleRateReader, getSampleRate()).WillByDefault(testing::Return(48000));
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	shared_ptr<SegmentProcessor> segment = script.second->m_timelines[0]->m_lanes[0]->m_segments[0];
+	ASSERT_TRUE(segment->m_recordOutputs);
+
+	// The actions are only parsed once, with the output recorder as port handler
+	EXPECT_EQ(static_pointer_cast<ActionSetValueProcessor>(segment->m_startActions[0])->m_portHandler.getPortHandler(), segment->m_outputRecorder.get());
+
+	SegmentRecording& recording = segment->m_recording;
+	EXPECT_EQ(recording.m_steps.size(), 5u);
+	const SegmentRecording::Step* steps = recording.m_steps.data();
+	const SegmentRecording::Voltages* writes = recording.m_writes.data();
+	const float* voltages = recording.m_voltages.data();
+	size_t writesCapacity = recording.m_writes.capacity();
+	size_t voltagesCapacity = recording.m_voltages.capacity();
+	ASSERT_GT(writesCapacity, 0u);
+	ASSERT_GT(voltagesCapacity, 0u);
+
+	// Recording the first run (twice, since a reset discards it) fits in what was allocated when the script was loaded
+	for (int run = 0; run < 2; run++) {
+		for (int i = 0; i < 4; i++) {
+			script.second->process();
+		}
+		EXPECT_TRUE(recording.isComplete());
+		script.second->reset();
+	}
+	EXPECT_EQ(recording.m_steps.data(), steps);
+	EXPECT_EQ(recording.m_writes.data(), writes);
+	EXPECT_EQ(recording.m_voltages.data(), voltages);
+	EXPECT_EQ(recording.m_writes.capacity(), writesCapacity);
+	EXPECT_EQ(recording.m_voltages.capacity(), voltagesCapacity);
+	EXPECT_GT(recording.m_writes.size(), 0u);
+}
@@ -9,3 +9,36 @@ pair<shared_ptr<Script>, shared_ptr<Processor>> loadProcessor(ProcessorLoader& p
 		return { script, nullptr };
 	}
 }
+
+json getLargeScriptJson(int timelines, int lanes, int segmentPairs, bool withErrors) {
+	json json = getMinimalJson();
+	json["timelines"] = json::array();
+	for (int i = 0; i < timelines; i++) {
+		json::array_t timelineLanes;
+		for (int j = 0; j < lanes; j++) {
+			json::array_t segments;
+			for (int k = 0; k < segmentPairs; k++) {
+				std::string ref = ((withErrors) && (j == lanes - 1 - i) && (k == i)) ? "unknown-segment" : "pool-segment";
+				segments.push_back({ { "ref", ref } });
+				segments.push_back({ { "duration", { { "samples", 1 + ((j + k) % 3) } } }, { "actions", json::array({
+					{ { "timing", "glide" }, { "start-value", { { "ref", "pool-value" } } }, { "end-value", (float) ((i + j + k) % 11) }, { "output", { { "ref", "pool-output" } } } },
+					{ { "ref", (withErrors) && (k == j) ? "unknown-action" : "pool-action" } }
+				}) } });
+			}
+			timelineLanes.push_back({ { "loop", true }, { "segments", segments } });
+		}
+		json["timelines"].push_back({ { "lanes", timelineLanes } });
+	}
+	json["component-pool"] = {
+		{ "segments", json::array({
+			{ { "id", "pool-segment" }, { "duration", { { "samples", 2 } } }, { "actions", json::array({
+				{ { "timing", "start" }, { "set-value", { { "output", { { "ref", "pool-output" } } }, { "value", { { "voltage", 1.f }, { "calc", json::array({ { { "ref", "pool-calc" } } }) } } } } } }
+			}) } }
+		}) },
+		{ "values", json::array({ { { "id", "pool-value" }, { "voltage", -1.f } } }) },
+		{ "calcs", json::array({ { { "id", "pool-calc" }, { "add", 2.f } } }) },
+		{ "outputs", json::array({ { { "id", "pool-output" }, { "index", 1 } } }) },
+		{ "actions", json::array({ { { "id", "pool-action" }, { "timing", "end" }, { "set-value", { { "output", 2 }, { "value", 4.f } } } } }) }
+	};
+	return json;
+}
@@ -5,6 +5,7 @@
 #include "core/timeseq-core.hpp"
 #include "core/timeseq-processor.hpp"
 #include "../timeseq-json/timeseq-json-shared.hpp"
+#include "../../common/timing.hpp"
 #include <gmock/gmock.h>
 
 struct MockPortHandler : PortHandler {
@@ -25,6 +26,10 @@ struct MockTriggerHandler : TriggerHandler {
 	MOCK_METHOD(void, setTrigger, (const std::string&), (override));
 };
 
+struct MockScriptBankHandler : ScriptBankHandler {
+	MOCK_METHOD(void, selectScript, (int), (override));
+};
+
 struct MockSampleRateReader : SampleRateReader {
 	MOCK_METHOD(float, getSampleRate, (), (const, override));
 };
@@ -37,9 +42,14 @@ struct MockEventListener : EventListener {
 };
 
 struct MockAssertListener : AssertListener {
-	MOCK_METHOD(void, assertFailed, (const std::string&, const std::string&, bool), (override));
+	MOCK_METHOD(void, assertFailed, (const std::string&, const AssertExpectation&, bool), (override));
 };
 
+// Matches an assert expectation that is formatted into the message
+MATCHER_P(FormatsTo, message, "") {
+	return arg.format() == message;
+}
+
 struct MockRandValueGenerator : RandValueGenerator {
 	MOCK_METHOD(float, generate, (float, float), (override));
 };
@@ -50,6 +60,10 @@ static std::vector<std::string> mockDefaultTriggerHandlerEmptyTriggers;
 
 
 pair<shared_ptr<Script>, shared_ptr<Processor>> loadProcessor(ProcessorLoader& processorLoader, nlohmann::json& json, vector<ValidationError>& validationErrors);
+// Creates a script with the number of timelines and lanes, where each lane repeats a segment from the component pool followed
+// by a segment with a glide and an action from the component pool segmentPairs times. With errors, some of the segment and
+// action refs point to components that don't exist.
+nlohmann::json getLargeScriptJson(int timelines, int lanes, int segmentPairs, bool withErrors);
 
 static std::string inputVariableName = "input-variable";
 static std::string outputVariableName = "output-variable";
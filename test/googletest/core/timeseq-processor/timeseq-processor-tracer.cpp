@@ -0,0 +1,130 @@
+#include "timeseq-processor-shared.hpp"
+#include "core/timeseq-processor-parser.hpp"
+#include "core/timeseq-tracer.hpp"
+
+// The first events of a Chrome trace are the track name metadata events
+#define TRACK_NAME_EVENT_COUNT 6
+
+nlohmann::json getTracerTestJson() {
+	json json = getMinimalJson(SCRIPT_VERSION_1_2_0);
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "loop", true }, { "segments", json::array({
+				{ { "ref", "segment-1" } },
+				{ { "duration", { { "samples", 1 } } }, { "actions", json::array({
+					{ { "assert", { { "name", "the-assert" }, { "expect", { { "eq", json::array({ { { "voltage", 1.f } }, { { "voltage", 0.f } } }) } } } } } }
+				}) } }
+			}) } }
+		}) } }
+	});
+	json["component-pool"] = { { "segments", json::array({
+		{ { "id", "segment-1" }, { "duration", { { "samples", 2 } } }, { "actions", json::array({
+			{ { "move-sequence", { { "id", "the-sequence" } } } }
+		}) } }
+	}) } };
+	json["sequences"] = json::array({
+		{ { "id", "the-sequence" }, { "shared", true }, { "values", json::array({ 1, 2, 3 }) } }
+	});
+	return json;
+}
+
+TEST(TimeSeqProcessorTracer, TracerShouldRecordSegmentLaneSequenceAndAssertEvents) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	testing::NiceMock<MockAssertListener> mockAssertListener;
+	EventTracer eventTracer;
+	ProcessorLoader processorLoader(nullptr, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, &mockAssertListener, &eventTracer);
+	vector<ValidationError> validationErrors;
+	json json = getTracerTestJson();
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	eventTracer.setEnabled(true);
+	for (int i = 0; i < 4; i++) {
+		script.second->process();
+		eventTracer.advance();
+	}
+
+	nlohmann::json trace = nlohmann::json::parse(eventTracer.getChromeTrace(1000.f));
+	nlohmann::json& traceEvents = trace["traceEvents"];
+	ASSERT_EQ(traceEvents.size(), TRACK_NAME_EVENT_COUNT + 9u);
+	EXPECT_EQ(traceEvents[0]["ph"], "M");
+	EXPECT_EQ(traceEvents[0]["args"]["name"], "segments");
+
+	vector<tuple<string, string, double>> expectedEvents = {
+		{ "segment-1", "b", 0. },
+		{ "the-sequence", "i", 0. },
+		{ "segment-1", "e", 1000. },
+		{ "segment 2", "b", 2000. },
+		{ "the-assert", "i", 2000. },
+		{ "segment 2", "e", 2000. },
+		// The lane loops once the last segment has ended
+		{ "lane 4", "i", 3000. },
+		{ "segment-1", "b", 3000. },
+		{ "the-sequence", "i", 3000. }
+	};
+	for (int i = 0; i < (int) expectedEvents.size(); i++) {
+		nlohmann::json& traceEvent = traceEvents[TRACK_NAME_EVENT_COUNT + i];
+		EXPECT_EQ(traceEvent["name"], get<0>(expectedEvents[i])) << "event " << i;
+		EXPECT_EQ(traceEvent["ph"], get<1>(expectedEvents[i])) << "event " << i;
+		EXPECT_EQ(traceEvent["ts"], get<2>(expectedEvents[i])) << "event " << i;
+	}
+	// The move and the assert are instant events on the tracks of their type, the segments are matched on their instance
+	EXPECT_EQ(traceEvents[TRACK_NAME_EVENT_COUNT + 1]["tid"], 4);
+	EXPECT_EQ(traceEvents[TRACK_NAME_EVENT_COUNT + 1]["args"]["position"], 1);
+	EXPECT_EQ(traceEvents[TRACK_NAME_EVENT_COUNT + 4]["tid"], 5);
+	EXPECT_EQ(traceEvents[TRACK_NAME_EVENT_COUNT + 8]["args"]["position"], 2);
+	EXPECT_EQ(traceEvents[TRACK_NAME_EVENT_COUNT]["id"], traceEvents[TRACK_NAME_EVENT_COUNT + 2]["id"]);
+	EXPECT_EQ(traceEvents[TRACK_NAME_EVENT_COUNT]["id"], traceEvents[TRACK_NAME_EVENT_COUNT + 7]["id"]);
+	EXPECT_NE(traceEvents[TRACK_NAME_EVENT_COUNT]["id"], traceEvents[TRACK_NAME_EVENT_COUNT + 3]["id"]);
+}
+
+TEST(TimeSeqProcessorTracer, DisabledTracerShouldNotRecordEvents) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	testing::NiceMock<MockAssertListener> mockAssertListener;
+	EventTracer eventTracer;
+	ProcessorLoader processorLoader(nullptr, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, &mockAssertListener, &eventTracer);
+	vector<ValidationError> validationErrors;
+	json json = getTracerTestJson();
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	for (int i = 0; i < 4; i++) {
+		script.second->process();
+		eventTracer.advance();
+	}
+
+	nlohmann::json trace = nlohmann::json::parse(eventTracer.getChromeTrace(1000.f));
+	EXPECT_EQ(trace["traceEvents"].size(), (size_t) TRACK_NAME_EVENT_COUNT);
+}
+
+TEST(TimeSeqProcessorTracer, TracerShouldOnlyKeepTheMostRecentEvents) {
+	EventTracer eventTracer;
+	eventTracer.setEnabled(true);
+	for (int i = 0; i < TIMESEQ_TRACE_CAPACITY + 10; i++) {
+		eventTracer.record(TraceEventType::VARIABLE_SET, nullptr, "a-variable-with-a-name-that-is-too-long-for-the-trace", i);
+	}
+
+	nlohmann::json trace = nlohmann::json::parse(eventTracer.getChromeTrace(1000.f));
+	nlohmann::json& traceEvents = trace["traceEvents"];
+	// The oldest event is in the slot that the next event will be written to, so it isn't exported
+	ASSERT_EQ(traceEvents.size(), (size_t) TRACK_NAME_EVENT_COUNT + TIMESEQ_TRACE_CAPACITY - 1);
+	EXPECT_EQ(traceEvents[TRACK_NAME_EVENT_COUNT]["args"]["value"], 11.f);
+	EXPECT_EQ(traceEvents.back()["args"]["value"], TIMESEQ_TRACE_CAPACITY + 9.f);
+	EXPECT_EQ(traceEvents.back()["name"], "a-variable-with-a-name-that-is-too-long");
+
+	eventTracer.clear();
+	eventTracer.record(TraceEventType::TRIGGER, nullptr, "a-trigger");
+	trace = nlohmann::json::parse(eventTracer.getChromeTrace(1000.f));
+	ASSERT_EQ(trace["traceEvents"].size(), TRACK_NAME_EVENT_COUNT + 1u);
+	EXPECT_EQ(trace["traceEvents"].back()["name"], "a-trigger");
+}
@@ -1122,3 +1122,90 @@ TEST(TimeSeqProcessorValueCalc, ValueWithCalcShouldConvertVoltageToFrequency) {
 		script.second->process();
 	}
 }
+
+TEST(TimeSeqProcessorValueCalc, ValueWithCalcShouldApproximateVoltageToFrequencyWithFastMath) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	MockSampleRateReader mockSampleRateReader;
+	MockVariableHandler mockVariableHandler;
+	MockPortHandler mockPortHandler;
+	ProcessorLoader processorLoader(&mockPortHandler, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson(SCRIPT_VERSION_1_1_0);
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "loop", true }, { "segments", json::array({ { { "duration", { { "samples", 1 } } }, { "actions", json::array({
+				{ { "set-variable", { { "name", "output-variable" }, { "value", { { "input", 1 }, { "calc", json::array({
+					{ { "vtof", true } }
+				}) } } } } } }
+			}) } } }) } },
+		}) } }
+	});
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+
+	processorLoader.setFastMath(true);
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	vector<float> voltages = { -4.5f, -1.f, 0.f, .33f, 1.66f, 4.75f };
+	{
+		testing::InSequence inSequence;
+
+		for (float voltage : voltages) {
+			float frequency = std::pow(2, voltage) * rack::dsp::FREQ_C4;
+			EXPECT_CALL(mockPortHandler, getInputPortVoltage(0, 0)).Times(1).WillOnce(testing::Return(voltage));
+			EXPECT_CALL(mockVariableHandler, setVariable(outputVariableName, testing::FloatNear(frequency, frequency * 1e-6f))).Times(1);
+		}
+	}
+
+	for (unsigned int i = 0; i < voltages.size(); i++) {
+		script.second->process();
+	}
+}
+
+TEST(TimeSeqProcessorValueCalc, ValueWithCalcShouldApproximateRemainAndFracWithFastMath) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	MockSampleRateReader mockSampleRateReader;
+	MockVariableHandler mockVariableHandler;
+	MockPortHandler mockPortHandler;
+	ProcessorLoader processorLoader(&mockPortHandler, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson(SCRIPT_VERSION_1_1_0);
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "loop", true }, { "segments", json::array({ { { "duration", { { "samples", 1 } } }, { "actions", json::array({
+				{ { "set-variable", { { "name", "remain-variable" }, { "value", { { "input", 1 }, { "calc", json::array({
+					{ { "remain", { { "voltage", 1.5f } } } }
+				}) } } } } } },
+				{ { "set-variable", { { "name", "frac-variable" }, { "value", { { "input", 1 }, { "calc", json::array({
+					{ { "frac", true } }
+				}) } } } } } }
+			}) } } }) } },
+		}) } }
+	});
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+
+	processorLoader.setFastMath(true);
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	vector<float> voltages = { -4.2f, -1.f, 0.f, .33f, 1.66f, 4.75f };
+	{
+		testing::InSequence inSequence;
+
+		for (float voltage : voltages) {
+			double x;
+			EXPECT_CALL(mockPortHandler, getInputPortVoltage(0, 0)).Times(1).WillOnce(testing::Return(voltage));
+			EXPECT_CALL(mockVariableHandler, setVariable(std::string("remain-variable"), testing::FloatEq(std::fmod(voltage, 1.5)))).Times(1);
+			EXPECT_CALL(mockPortHandler, getInputPortVoltage(0, 0)).Times(1).WillOnce(testing::Return(voltage));
+			EXPECT_CALL(mockVariableHandler, setVariable(std::string("frac-variable"), testing::FloatEq(std::modf(voltage, &x)))).Times(1);
+		}
+	}
+
+	for (unsigned int i = 0; i < voltages.size(); i++) {
+		script.second->process();
+	}
+}
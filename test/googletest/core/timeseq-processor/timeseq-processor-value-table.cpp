@@ -0,0 +1,177 @@
+#include "timeseq-processor-shared.hpp"
+
+TEST(TimeSeqProcessorValueTable, TableValueWithUnknownTableShouldFail) {
+	MockEventListener mockEventListener;
+	MockTriggerHandler mockTriggerHandler;
+	MockSampleRateReader mockSampleRateReader;
+	ProcessorLoader processorLoader(nullptr, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "segments", json::array({ { { "duration", { { "samples", 1 } } }, { "actions", json::array({
+				{ { "set-variable", { { "name", "output-variable" }, { "value", { { "table", { { "id", "unknown-table" }, { "position", .5f } } } } } } } }
+			}) } } }) } },
+		}) } }
+	});
+	json["component-pool"] = { { "tables", json::array({
+		{ { "id", "the-table" }, { "voltages", json::array({ 0.f, 1.f }) } }
+	}) } };
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 1u);
+	expectError(validationErrors, ValidationErrorCode::TableValue_TableNotFound, "/timelines/0/lanes/0/segments/0/actions/0/set-variable/value/table");
+}
+
+TEST(TimeSeqProcessorValueTable, TableValueShouldInterpolateAndClampNonWrappingTable) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	MockVariableHandler mockVariableHandler;
+	ProcessorLoader processorLoader(nullptr, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "loop", true }, { "segments", json::array({ { { "duration", { { "samples", 1 } } }, { "actions", json::array({
+				{ { "set-variable", { { "name", "output-variable" }, { "value", { { "table", { { "id", "the-table" }, { "position", { { "variable", "input-variable" } } } } } } } } } }
+			}) } } }) } },
+		}) } }
+	});
+	json["component-pool"] = { { "tables", json::array({
+		{ { "id", "the-table" }, { "voltages", json::array({ 0.f, 4.f, -2.f }) } }
+	}) } };
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	vector<pair<float, float>> positions = { { 0.f, 0.f }, { .25f, 2.f }, { .5f, 4.f }, { .75f, 1.f }, { 1.f, -2.f }, { -.5f, 0.f }, { 1.5f, -2.f } };
+	{
+		testing::InSequence inSequence;
+
+		for (const pair<float, float>& position : positions) {
+			EXPECT_CALL(mockVariableHandler, getVariable(inputVariableName)).Times(1).WillOnce(testing::Return(position.first));
+			EXPECT_CALL(mockVariableHandler, setVariable(outputVariableName, testing::FloatEq(position.second))).Times(1);
+		}
+	}
+
+	for (size_t i = 0; i < positions.size(); i++) {
+		script.second->process();
+	}
+}
+
+TEST(TimeSeqProcessorValueTable, TableValueShouldInterpolateAndRepeatWrappingTable) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	MockVariableHandler mockVariableHandler;
+	ProcessorLoader processorLoader(nullptr, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "loop", true }, { "segments", json::array({ { { "duration", { { "samples", 1 } } }, { "actions", json::array({
+				{ { "set-variable", { { "name", "output-variable" }, { "value", { { "table", { { "id", "the-table" }, { "position", { { "variable", "input-variable" } } } } }, { "calc", json::array({ { { "mult", 2.f } } }) } } } } } }
+			}) } } }) } },
+		}) } }
+	});
+	json["component-pool"] = { { "tables", json::array({
+		{ { "id", "the-table" }, { "voltages", json::array({ 0.f, 4.f, 2.f, -2.f }) }, { "wrap", true } }
+	}) } };
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	// The last voltage interpolates back towards the first one, and the calc is applied on the table voltage
+	vector<pair<float, float>> positions = { { 0.f, 0.f }, { .125f, 4.f }, { .5f, 4.f }, { .875f, -2.f }, { 1.f, 0.f }, { 1.25f, 8.f }, { -.125f, -2.f } };
+	{
+		testing::InSequence inSequence;
+
+		for (const pair<float, float>& position : positions) {
+			EXPECT_CALL(mockVariableHandler, getVariable(inputVariableName)).Times(1).WillOnce(testing::Return(position.first));
+			EXPECT_CALL(mockVariableHandler, setVariable(outputVariableName, testing::FloatEq(position.second))).Times(1);
+		}
+	}
+
+	for (size_t i = 0; i < positions.size(); i++) {
+		script.second->process();
+	}
+}
+
+TEST(TimeSeqProcessorValueTable, TableValueWithStaticPositionShouldBeDeterministic) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	MockTriggerHandler mockTriggerHandler;
+	MockSampleRateReader mockSampleRateReader;
+	ProcessorLoader processorLoader(nullptr, nullptr, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "segments", json::array({ { { "duration", { { "samples", 10 } } }, { "actions", json::array({
+				{ { "set-value", { { "output", 1 }, { "value", { { "table", { { "id", "the-table" }, { "position", .3f } } } } } } } },
+				{ { "set-value", { { "output", 2 }, { "value", { { "table", { { "id", "the-table" }, { "position", { { "variable", "input-variable" } } } } } } } } } }
+			}) } } }) } },
+		}) } }
+	});
+	json["component-pool"] = { { "tables", json::array({
+		{ { "id", "the-table" }, { "voltages", json::array({ 0.f, 1.f }) } }
+	}) } };
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	const vector<shared_ptr<ActionProcessor>>& actions = script.second->m_timelines[0]->m_lanes[0]->m_segments[0]->m_startActions;
+	ASSERT_EQ(actions.size(), 2u);
+	EXPECT_TRUE(actions[0]->isDeterministic());
+	EXPECT_FALSE(actions[1]->isDeterministic());
+}
+
+TEST(TimeSeqProcessorValueTable, TableValueWithNaNPositionShouldUseStartOfTable) {
+	for (bool wrap : { false, true }) {
+		SCOPED_TRACE(wrap);
+		testing::NiceMock<MockEventListener> mockEventListener;
+		testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+		testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+		MockVariableHandler mockVariableHandler;
+		ProcessorLoader processorLoader(nullptr, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+		vector<ValidationError> validationErrors;
+		json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+		json["timelines"] = json::array({
+			{ { "lanes", json::array({
+				{ { "loop", true }, { "segments", json::array({ { { "duration", { { "samples", 1 } } }, { "actions", json::array({
+					{ { "set-variable", { { "name", "output-variable" }, { "value", { { "table", { { "id", "the-table" }, { "position", { { "variable", "input-variable" } } } } } } } } } }
+				}) } } }) } },
+			}) } }
+		});
+		json["component-pool"] = { { "tables", json::array({
+			{ { "id", "the-table" }, { "voltages", json::array({ 3.f, 4.f, -2.f }) }, { "wrap", wrap } }
+		}) } };
+
+		MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+
+		pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+		EXPECT_NO_ERRORS(validationErrors);
+
+		// An infinite position can only be clamped by a non-wrapping table, a wrapping table has no position for it either
+		vector<pair<float, float>> positions = {
+			{ std::numeric_limits<float>::quiet_NaN(), 3.f },
+			{ std::numeric_limits<float>::infinity(), wrap ? 3.f : -2.f },
+			{ -std::numeric_limits<float>::infinity(), 3.f }
+		};
+		{
+			testing::InSequence inSequence;
+
+			for (const pair<float, float>& position : positions) {
+				EXPECT_CALL(mockVariableHandler, getVariable(inputVariableName)).Times(1).WillOnce(testing::Return(position.first));
+				EXPECT_CALL(mockVariableHandler, setVariable(outputVariableName, testing::FloatEq(position.second))).Times(1);
+			}
+		}
+
+		for (size_t i = 0; i < positions.size(); i++) {
+			script.second->process();
+		}
+	}
+}
@@ -756,3 +756,47 @@ TEST(TimeSeqProcessorValue, RandValueShouldHandleEqualLowerAndUpper) {
 	}
 
 }
+
+TEST(TimeSeqProcessorValue, RandValueShouldRepeatValuesAfterSeeding) {
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	MockSampleRateReader mockSampleRateReader;
+	MockVariableHandler mockVariableHandler;
+	MockPortHandler mockPortHandler;
+	ProcessorLoader processorLoader(&mockPortHandler, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson();
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "loop", true }, { "segments", json::array({
+					{ { "duration", { { "samples", 1 } } }, { "actions", json::array({
+						{ { "set-variable", { { "name", "output-variable" }, { "value", { { "rand", {
+							{ "lower", { { "voltage", -5.f } } },
+							{ "upper", { { "voltage", 5.f } } }
+						} } } } } } }
+					}) } }
+			}) } },
+		}) } }
+	});
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	vector<float> values;
+	EXPECT_CALL(mockVariableHandler, setVariable(outputVariableName, testing::_)).Times(200).WillRepeatedly([&values](const string&, float value) { values.push_back(value); });
+	processorLoader.seedRandomValues(1234);
+	for (int i = 0; i < 100; i++) {
+		script.second->process();
+	}
+	processorLoader.seedRandomValues(1234);
+	for (int i = 0; i < 100; i++) {
+		script.second->process();
+	}
+
+	for (int i = 0; i < 100; i++) {
+		EXPECT_EQ(values[i], values[i + 100]) << "value " << i;
+	}
+	EXPECT_NE(values[0], values[1]);
+}
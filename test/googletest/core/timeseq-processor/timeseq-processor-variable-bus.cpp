@@ -0,0 +1,202 @@
+#include "timeseq-processor-shared.hpp"
+#include "core/timeseq-bus.hpp"
+
+TEST(TimeSeqProcessorVariableBus, BusSlotShouldOnlyExposeWritesInTheNextFrame) {
+	VariableBus variableBus;
+	VariableBusSlot* slot = variableBus.resolve("bus:shared");
+	ASSERT_NE(slot, nullptr);
+	EXPECT_EQ(variableBus.resolve("bus:shared"), slot);
+	EXPECT_NE(variableBus.resolve("bus:other"), slot);
+
+	variableBus.setFrame(1);
+	EXPECT_EQ(slot->getVariable("bus:shared"), 0.f);
+	slot->setVariable("bus:shared", 2.f);
+	// A read after the write in the same frame still sees the value of the previous frame
+	EXPECT_EQ(slot->getVariable("bus:shared"), 0.f);
+	slot->setVariable("bus:shared", 3.f);
+	EXPECT_EQ(slot->getVariable("bus:shared"), 0.f);
+
+	variableBus.setFrame(2);
+	EXPECT_EQ(slot->getVariable("bus:shared"), 3.f);
+	slot->setVariable("bus:shared", 4.f);
+	EXPECT_EQ(slot->getVariable("bus:shared"), 3.f);
+
+	// Without writes, the last written value is kept
+	variableBus.setFrame(3);
+	EXPECT_EQ(slot->getVariable("bus:shared"), 4.f);
+	variableBus.setFrame(4);
+	EXPECT_EQ(slot->getVariable("bus:shared"), 4.f);
+}
+
+TEST(TimeSeqProcessorVariableBus, BusShouldFailWhenAllSlotsAreInUse) {
+	VariableBus variableBus;
+	for (int i = 0; i < TIMESEQ_BUS_SIZE; i++) {
+		ASSERT_NE(variableBus.resolve("bus:" + to_string(i)), nullptr);
+	}
+	EXPECT_EQ(variableBus.resolve("bus:one-too-many"), nullptr);
+	EXPECT_NE(variableBus.resolve("bus:0"), nullptr);
+
+	testing::NiceMock<MockEventListener> mockEventListener;
+	MockTriggerHandler mockTriggerHandler;
+	MockSampleRateReader mockSampleRateReader;
+	MockVariableHandler mockVariableHandler;
+	ProcessorLoader processorLoader(nullptr, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	processorLoader.setVariableBus(&variableBus);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "segments", json::array({ { { "duration", { { "samples", 1 } } }, { "actions", json::array({
+				{ { "set-variable", { { "name", "bus:one-too-many" }, { "value", 1.f } } } }
+			}) } } }) } },
+		}) } }
+	});
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	ASSERT_EQ(validationErrors.size(), 1u);
+	expectError(validationErrors, ValidationErrorCode::VariableBus_Full, "/timelines/0/lanes/0/segments/0/actions/0/set-variable");
+}
+
+TEST(TimeSeqProcessorVariableBus, BusSlotShouldBeClearedAndReusedWhenTheLastReferenceIsReleased) {
+	VariableBus variableBus;
+	for (int i = 0; i < TIMESEQ_BUS_SIZE; i++) {
+		ASSERT_NE(variableBus.resolve("bus:" + to_string(i)), nullptr);
+	}
+	VariableBusSlot* slot = variableBus.resolve("bus:0");
+	slot->setVariable("bus:0", 5.f);
+	variableBus.setFrame(1);
+	EXPECT_EQ(slot->getVariable("bus:0"), 5.f);
+
+	// The slot stays bound while a reference remains
+	variableBus.release("bus:0");
+	EXPECT_EQ(variableBus.resolve("bus:new"), nullptr);
+	EXPECT_EQ(slot->getVariable("bus:0"), 5.f);
+
+	variableBus.release("bus:0");
+	EXPECT_EQ(variableBus.resolve("bus:new"), slot);
+	EXPECT_EQ(slot->getVariable("bus:new"), 0.f);
+}
+
+TEST(TimeSeqProcessorVariableBus, BusVariablesShouldBeReleasedWhenTheProcessorIsDestroyed) {
+	VariableBus variableBus;
+	for (int i = 0; i < TIMESEQ_BUS_SIZE - 1; i++) {
+		ASSERT_NE(variableBus.resolve("bus:" + to_string(i)), nullptr);
+	}
+
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	MockVariableHandler mockVariableHandler;
+	ProcessorLoader processorLoader(nullptr, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	processorLoader.setVariableBus(&variableBus);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "segments", json::array({ { { "duration", { { "samples", 1 } } }, { "actions", json::array({
+				{ { "set-variable", { { "name", "bus:script" }, { "value", 1.f } } } },
+				{ { "set-variable", { { "name", "bus:script" }, { "value", { { "variable", "bus:script" } } } } } }
+			}) } } }) } },
+		}) } }
+	});
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	EXPECT_EQ(variableBus.resolve("bus:one-too-many"), nullptr);
+
+	// The last free slot becomes available again once the script is gone
+	script.second.reset();
+	EXPECT_NE(variableBus.resolve("bus:one-too-many"), nullptr);
+}
+
+TEST(TimeSeqProcessorVariableBus, BusVariablesShouldBeSharedWithOneFrameLatencyInAnyProcessingOrder) {
+	VariableBus variableBus;
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	MockVariableHandler writerVariableHandler;
+	MockVariableHandler readerVariableHandler;
+	ProcessorLoader writerLoader(nullptr, &writerVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	ProcessorLoader readerLoader(nullptr, &readerVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	writerLoader.setVariableBus(&variableBus);
+	readerLoader.setVariableBus(&variableBus);
+	vector<ValidationError> validationErrors;
+
+	// The writer glides a bus variable from 0 to 10 over 10 samples
+	json writerJson = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	writerJson["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "segments", json::array({ { { "duration", { { "samples", 11 } } }, { "actions", json::array({
+				{ { "timing", "glide" }, { "start-value", 0.f }, { "end-value", 10.f }, { "variable", "bus:glide" } }
+			}) } } }) } },
+		}) } }
+	});
+	// The reader copies the bus variable into a regular variable on each sample
+	json readerJson = getMinimalJson(SCRIPT_VERSION_1_3_0);
+	readerJson["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "loop", true }, { "segments", json::array({ { { "duration", { { "samples", 1 } } }, { "actions", json::array({
+				{ { "set-variable", { { "name", outputVariableName }, { "value", { { "variable", "bus:glide" } } } } } }
+			}) } } }) } },
+		}) } }
+	});
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> writer = loadProcessor(writerLoader, writerJson, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+	pair<shared_ptr<Script>, shared_ptr<Processor>> reader = loadProcessor(readerLoader, readerJson, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	// Bus variables never go through the variable handler of the instance
+	EXPECT_CALL(writerVariableHandler, setVariable(testing::_, testing::_)).Times(0);
+	EXPECT_CALL(readerVariableHandler, getVariable(testing::_)).Times(0);
+
+	vector<float> readValues;
+	EXPECT_CALL(readerVariableHandler, setVariable(outputVariableName, testing::_)).WillRepeatedly([&readValues](const string& name, float value) { readValues.push_back(value); });
+
+	// Alternate the processing order on each frame
+	for (int frame = 0; frame < 10; frame++) {
+		variableBus.setFrame(frame);
+		if (frame % 2 == 0) {
+			writer.second->process();
+			reader.second->process();
+		} else {
+			reader.second->process();
+			writer.second->process();
+		}
+	}
+
+	vector<float> expected = { 0.f, 0.f, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f };
+	ASSERT_EQ(readValues.size(), expected.size());
+	for (size_t i = 0; i < expected.size(); i++) {
+		EXPECT_FLOAT_EQ(readValues[i], expected[i]) << "frame " << i;
+	}
+}
+
+TEST(TimeSeqProcessorVariableBus, BusPrefixShouldBeARegularVariableBeforeVersion130) {
+	VariableBus variableBus;
+	testing::NiceMock<MockEventListener> mockEventListener;
+	testing::NiceMock<MockTriggerHandler> mockTriggerHandler;
+	testing::NiceMock<MockSampleRateReader> mockSampleRateReader;
+	MockVariableHandler mockVariableHandler;
+	ProcessorLoader processorLoader(nullptr, &mockVariableHandler, &mockTriggerHandler, &mockSampleRateReader, &mockEventListener, nullptr);
+	processorLoader.setVariableBus(&variableBus);
+	vector<ValidationError> validationErrors;
+	json json = getMinimalJson(SCRIPT_VERSION_1_2_0);
+	json["timelines"] = json::array({
+		{ { "lanes", json::array({
+			{ { "segments", json::array({ { { "duration", { { "samples", 1 } } }, { "actions", json::array({
+				{ { "set-variable", { { "name", "bus:not-shared" }, { "value", 1.f } } } }
+			}) } } }) } },
+		}) } }
+	});
+
+	MOCK_DEFAULT_TRIGGER_HANDLER(mockTriggerHandler);
+
+	pair<shared_ptr<Script>, shared_ptr<Processor>> script = loadProcessor(processorLoader, json, validationErrors);
+	EXPECT_NO_ERRORS(validationErrors);
+
+	EXPECT_CALL(mockVariableHandler, setVariable("bus:not-shared", 1.f)).Times(1);
+	script.second->process();
+}
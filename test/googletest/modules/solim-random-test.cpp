@@ -75,6 +75,25 @@ TEST(SolimRandomTest, WithSolimExpanderOnBothSidesShouldActivateBothLed) {
 	expectConnected(solimRandomModule, true, true);
 }
 
+TEST(SolimRandomTest, ShouldOnlyDetectSolimModulesAgainAfterAnExpanderChange) {
+	SolimModule solimModule;
+	SolimRandomModule solimRandomModule;
+	initializeSolimRandomModule(solimRandomModule);
+
+	registerExpanderModule(solimRandomModule, ExpanderData(solimModule, modelSolim, ExpanderSide::RIGHT));
+	solimRandomModule.draw(widget::Widget::DrawArgs());
+	expectConnected(solimRandomModule, false, true);
+
+	// Without an expander change event, the detected Solim module remains connected
+	solimRandomModule.rightExpander.module = nullptr;
+	solimRandomModule.draw(widget::Widget::DrawArgs());
+	expectConnected(solimRandomModule, false, true);
+
+	solimRandomModule.onExpanderChange(Module::ExpanderChangeEvent());
+	solimRandomModule.draw(widget::Widget::DrawArgs());
+	expectConnected(solimRandomModule, false, false);
+}
+
 TEST(SolimRandomTest, WithUnknownExpanderBeforeRightSolimExpanderShouldDectivateLed) {
 	Module module;
 	SolimModule solimModule;
@@ -238,6 +257,8 @@ TEST(SolimRandomTest, WithUpToSevenInputExpanderAndASolimExpanderOnRightShouldAc
 			registerExpanderModule(solimInputExpanderModule[i - 1], ExpanderData(solimInputExpanderModule[i], modelSolimInput, ExpanderSide::RIGHT));
 		}
 		registerExpanderModule(solimInputExpanderModule[i], ExpanderData(solimModule, modelSolim, ExpanderSide::RIGHT));
+		// The engine would send an expander change event through the chain for each added module
+		solimRandomModule.onExpanderChange(Module::ExpanderChangeEvent());
 
 		solimRandomModule.draw(widget::Widget::DrawArgs());
 
@@ -258,6 +279,8 @@ TEST(SolimRandomTest, WithUpToSevenOutputExpanderAndASolimExpanderOnLeftShouldAc
 			registerExpanderModule(solimOutputExpanderModule[i - 1], ExpanderData(solimOutputExpanderModule[i], modelSolimOutput, ExpanderSide::LEFT));
 		}
 		registerExpanderModule(solimOutputExpanderModule[i], ExpanderData(solimModule, modelSolim, ExpanderSide::LEFT));
+		// The engine would send an expander change event through the chain for each added module
+		solimRandomModule.onExpanderChange(Module::ExpanderChangeEvent());
 
 		solimRandomModule.draw(widget::Widget::DrawArgs());
 
@@ -11,6 +11,7 @@
 
 #include "../common/vcv-registration.hpp"
 #include "../common/save-data.hpp"
+#include "../common/timing.hpp"
 
 using RandomTriggerArray = std::array<RandomTrigger, 8>*;
 struct MockSolimCore : SolimCore {
@@ -1640,6 +1641,7 @@ TEST(SolimTest, ProcessShouldDetectRandomAddingAndRemoving) {
 
 	solimModule.process(Module::ProcessArgs()); // No random module present
 	registerExpanderModule(solimModule, ExpanderData(solimRandomModule, modelSolimRandom, ExpanderSide::LEFT));
+	solimModule.onExpanderChange(Module::ExpanderChangeEvent());
 	solimModule.process(Module::ProcessArgs()); // Detection of random, no trigger
 	solimModule.process(Module::ProcessArgs()); // Random still there, but no new triggers
 	solimRandomModule.m_oneCounters[0]++;
@@ -1648,16 +1650,121 @@ TEST(SolimTest, ProcessShouldDetectRandomAddingAndRemoving) {
 	solimRandomModule.m_oneCounters[0]++;
 	solimModule.process(Module::ProcessArgs()); // New trigger
 	solimModule.leftExpander.module = nullptr;
+	solimModule.onExpanderChange(Module::ExpanderChangeEvent());
 	solimRandomModule.m_oneCounters[0]++;
 	solimModule.process(Module::ProcessArgs()); // No random anymore
 	solimRandomModule.m_oneCounters[0]++;
 	registerExpanderModule(solimModule, ExpanderData(solimRandomModule, modelSolimRandom, ExpanderSide::LEFT));
+	solimModule.onExpanderChange(Module::ExpanderChangeEvent());
 	solimModule.process(Module::ProcessArgs()); // Random present again, but don't fire a trigger
 	solimModule.process(Module::ProcessArgs()); // Random still there, but no new trigger
 	solimRandomModule.m_oneCounters[0]++;
 	solimModule.process(Module::ProcessArgs()); // New trigger
 }
 
+TEST(SolimTest, ProcessShouldOnlyDetectExpandersAgainAfterAnExpanderChange) {
+	MockSolimCore* solimCore = new MockSolimCore();
+	SolimModule solimModule(solimCore);
+	SolimInputModule solimInputModule[2];
+	SolimOutputModule solimOutputModule[2];
+	initializeSolimModule(solimModule);
+
+	SolimValueSet activeSolimValueSet[3];
+	SolimValueSet inactiveSolimValueSet[3];
+	for (int i = 0; i < 3; i++) {
+		EXPECT_CALL(*solimCore, getActiveValues(i)).WillRepeatedly(testing::ReturnRef(activeSolimValueSet[i]));
+		EXPECT_CALL(*solimCore, getInactiveValues(i)).WillRepeatedly(testing::ReturnRef(inactiveSolimValueSet[i]));
+	}
+	{
+		testing::InSequence seq;
+		// The first two calls use the initially detected expanders
+		EXPECT_CALL(*solimCore, processAndActivateInactiveValues(2, nullptr)).Times(2);
+		// The third call uses the input expander that was added after the expander change
+		EXPECT_CALL(*solimCore, processAndActivateInactiveValues(3, nullptr)).Times(1);
+	}
+
+	// Link the modules in both directions, like the engine does
+	registerExpanderModule(solimModule, ExpanderData(solimInputModule[0], modelSolimInput, ExpanderSide::LEFT));
+	registerExpanderModule(solimInputModule[0], ExpanderData(solimModule, modelSolim, ExpanderSide::RIGHT));
+	registerExpanderModule(solimModule, ExpanderData(solimOutputModule[0], modelSolimOutput, ExpanderSide::RIGHT));
+	registerExpanderModule(solimOutputModule[0], ExpanderData(solimModule, modelSolim, ExpanderSide::LEFT));
+	registerExpanderModule(solimOutputModule[0], ExpanderData(solimOutputModule[1], modelSolimOutput, ExpanderSide::RIGHT));
+	registerExpanderModule(solimOutputModule[1], ExpanderData(solimOutputModule[0], modelSolimOutput, ExpanderSide::LEFT));
+
+	solimModule.process(Module::ProcessArgs());
+
+	// Add an input expander at the end of the chain. Without an expander change event, the detected expanders remain in use.
+	registerExpanderModule(solimInputModule[0], ExpanderData(solimInputModule[1], modelSolimInput, ExpanderSide::LEFT));
+	registerExpanderModule(solimInputModule[1], ExpanderData(solimInputModule[0], modelSolimInput, ExpanderSide::RIGHT));
+	solimModule.process(Module::ProcessArgs());
+
+	// Only the neighbour of the added module receives the event, and should pass it on to the Solim module
+	solimInputModule[0].onExpanderChange(Module::ExpanderChangeEvent());
+	solimModule.process(Module::ProcessArgs());
+}
+
+TEST(SolimTest, ProcessWithFullExpanderChainShouldNotWalkTheChainOnEachSample) {
+	SolimModule solimModule;
+	SolimInputModule solimInputModule[7];
+	SolimInputOctaverModule solimInputOctaverModule;
+	SolimRandomModule solimRandomModule;
+	SolimOutputModule solimOutputModule[7];
+	SolimOutputOctaverModule solimOutputOctaverModule;
+	initializeSolimModule(solimModule);
+
+	registerExpanderModules(solimModule, {
+		ExpanderData(solimInputModule[0], modelSolimInput, ExpanderSide::LEFT),
+		ExpanderData(solimInputModule[1], modelSolimInput, ExpanderSide::LEFT),
+		ExpanderData(solimInputModule[2], modelSolimInput, ExpanderSide::LEFT),
+		ExpanderData(solimInputModule[3], modelSolimInput, ExpanderSide::LEFT),
+		ExpanderData(solimInputModule[4], modelSolimInput, ExpanderSide::LEFT),
+		ExpanderData(solimInputModule[5], modelSolimInput, ExpanderSide::LEFT),
+		ExpanderData(solimInputModule[6], modelSolimInput, ExpanderSide::LEFT),
+		ExpanderData(solimInputOctaverModule, modelSolimInputOctaver, ExpanderSide::LEFT),
+		ExpanderData(solimRandomModule, modelSolimRandom, ExpanderSide::LEFT)
+	});
+	registerExpanderModules(solimModule, {
+		ExpanderData(solimOutputModule[0], modelSolimOutput, ExpanderSide::RIGHT),
+		ExpanderData(solimOutputModule[1], modelSolimOutput, ExpanderSide::RIGHT),
+		ExpanderData(solimOutputModule[2], modelSolimOutput, ExpanderSide::RIGHT),
+		ExpanderData(solimOutputModule[3], modelSolimOutput, ExpanderSide::RIGHT),
+		ExpanderData(solimOutputModule[4], modelSolimOutput, ExpanderSide::RIGHT),
+		ExpanderData(solimOutputModule[5], modelSolimOutput, ExpanderSide::RIGHT),
+		ExpanderData(solimOutputModule[6], modelSolimOutput, ExpanderSide::RIGHT),
+		ExpanderData(solimOutputOctaverModule, modelSolimOutputOctaver, ExpanderSide::RIGHT)
+	});
+
+	for (int i = 0; i < 8; i++) {
+		setPortVoltages(solimModule.inputs[SolimModule::IN_INPUTS + i], { (float) i * .1f });
+	}
+	for (int i = 0; i < 7; i++) {
+		for (int j = 0; j < 8; j++) {
+			setPortVoltages(solimInputModule[i].inputs[SolimInputModule::IN_INPUTS + j], { (float) (i + 1) + (.1f * j) });
+		}
+	}
+
+	solimModule.process(Module::ProcessArgs());
+	std::array<float, 8> expectedVoltages;
+	for (int i = 0; i < 8; i++) {
+		expectedVoltages[i] = solimOutputModule[6].outputs[SolimOutputModule::OUT_OUTPUTS + i].getVoltage();
+	}
+
+	// Time the processing with the detected expanders, and with an expander change before each sample, which makes the
+	// module walk the chain on each sample. The timings are reported, but not compared, since they depend on the machine.
+	const int samples = 20000;
+	double cachedNs = measureNanosPerCall(samples, [&solimModule]() { solimModule.process(Module::ProcessArgs()); });
+	double detectNs = measureNanosPerCall(samples, [&solimModule]() {
+		solimModule.onExpanderChange(Module::ExpanderChangeEvent());
+		solimModule.process(Module::ProcessArgs());
+	});
+	RecordProperty("cached-ns-per-sample", std::to_string(cachedNs));
+	RecordProperty("detect-ns-per-sample", std::to_string(detectNs));
+
+	for (int i = 0; i < 8; i++) {
+		EXPECT_EQ(solimOutputModule[6].outputs[SolimOutputModule::OUT_OUTPUTS + i].getVoltage(), expectedVoltages[i]);
+	}
+}
+
 TEST(SolimTest, ProcessWithOneInputAndOutputExpanderShouldProcessExpanders) {
 	MockSolimCore* solimCore = new MockSolimCore();
 	SolimModule solimModule(solimCore);
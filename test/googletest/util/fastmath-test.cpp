@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <cmath>
+
+#include "util/fastmath.hpp"
+
+
+TEST(FastMath, FastExp2ShouldStayWithinErrorBound) {
+	double maxError = 0.;
+	for (int i = -126000; i < 126000; i++) {
+		float x = i / 1000.f + .0003f;
+		double expected = std::exp2((double) x);
+		maxError = std::max(maxError, std::abs(fastExp2(x) - expected) / expected);
+	}
+	EXPECT_LT(maxError, 3e-7);
+
+	// Whole numbers should result in exact powers of two
+	EXPECT_EQ(fastExp2(0.f), 1.f);
+	EXPECT_EQ(fastExp2(3.f), 8.f);
+	EXPECT_EQ(fastExp2(-2.f), .25f);
+}
+
+TEST(FastMath, FastExp2ShouldHandleNonFiniteValues) {
+	EXPECT_TRUE(std::isnan(fastExp2(NAN)));
+	EXPECT_EQ(fastExp2(INFINITY), fastExp2(126.f));
+	EXPECT_EQ(fastExp2(-INFINITY), fastExp2(-126.f));
+	EXPECT_EQ(fastExp2(-126.f), std::ldexp(1.f, -126));
+}
+
+TEST(FastMath, FastLog2ShouldStayWithinErrorBound) {
+	double maxError = 0.;
+	for (int i = 1; i <= 200000; i++) {
+		float x = i / 1000.f;
+		maxError = std::max(maxError, std::abs(fastLog2(x) - std::log2((double) x)));
+	}
+	for (int i = -100; i <= 100; i++) {
+		float x = std::exp2(i + .37f);
+		maxError = std::max(maxError, std::abs(fastLog2(x) - std::log2((double) x)));
+	}
+	EXPECT_LT(maxError, 3e-6);
+}
+
+TEST(FastMath, FastPowShouldStayWithinErrorBound) {
+	// The range of the glide easing
+	for (int j = 0; j <= 20; j++) {
+		float exponent = 1.f + j / 10.f;
+		double maxError = 0.;
+		for (int i = 1; i <= 10000; i++) {
+			float base = i / 10000.f;
+			double expected = std::pow((double) base, (double) exponent);
+			maxError = std::max(maxError, std::abs(fastPow(base, exponent) - expected) / expected);
+		}
+		EXPECT_LT(maxError, exponent * 3e-6 + 3e-7) << "exponent " << exponent;
+	}
+
+	EXPECT_EQ(fastPow(0.f, 2.f), 0.f);
+}
+
+TEST(FastMath, FastFracShouldMatchModf) {
+	double x;
+	for (int i = -20000; i <= 20000; i++) {
+		double value = i * 0.0137;
+		EXPECT_EQ(fastFrac(value), std::modf(value, &x)) << "value " << value;
+	}
+	EXPECT_EQ(fastFrac(1e20), 0.);
+	EXPECT_EQ(fastFrac(-1e20), 0.);
+}
+
+TEST(FastMath, FastFmodShouldStayWithinErrorBound) {
+	std::vector<double> divisors = { 1., .5, 3., -2.5, .013, 7.25 };
+	for (double y : divisors) {
+		for (int i = -10000; i <= 10000; i++) {
+			double value = i * 0.0731 + .0001;
+			double expected = std::fmod(value, y);
+			double actual = fastFmod(value, y);
+			double error = std::abs(actual - expected);
+			// Close to a multiple of y, the result may wrap around to the other end of the range
+			if (std::abs(error - std::abs(y)) < 1e-9) {
+				error = std::abs(error - std::abs(y));
+			}
+			EXPECT_LT(error, 4 * std::abs(value) * std::pow(2., -52) + 1e-300) << "value " << value << " mod " << y;
+		}
+	}
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <fstream>
+#include <cstdio>
+
+#include "util/mappedfile.hpp"
+
+
+static std::string writeTempFile(const std::string& name, const std::string& contents) {
+	std::string path = testing::TempDir() + name;
+	std::ofstream file(path, std::ios::binary);
+	file << contents;
+	return path;
+}
+
+TEST(MappedFile, ShouldMapFileContents) {
+	std::string contents = "{ \"version\": \"1.3.0\" }\n";
+	std::string path = writeTempFile("mappedfile-contents.json", contents);
+
+	{
+		MappedFile file(path);
+		ASSERT_TRUE(file.isOpen());
+		ASSERT_EQ(file.size(), contents.size());
+		EXPECT_EQ(std::string(file.data(), file.size()), contents);
+	}
+
+	std::remove(path.c_str());
+}
+
+TEST(MappedFile, ShouldOpenEmptyFileWithoutData) {
+	std::string path = writeTempFile("mappedfile-empty.json", "");
+
+	{
+		MappedFile file(path);
+		EXPECT_TRUE(file.isOpen());
+		EXPECT_EQ(file.size(), 0u);
+		EXPECT_EQ(file.data(), nullptr);
+	}
+
+	std::remove(path.c_str());
+}
+
+TEST(MappedFile, ShouldNotOpenMissingFile) {
+	MappedFile file(testing::TempDir() + "mappedfile-does-not-exist.json");
+	EXPECT_FALSE(file.isOpen());
+	EXPECT_EQ(file.size(), 0u);
+	EXPECT_EQ(file.data(), nullptr);
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "util/quantizer.hpp"
+#include "util/notes.hpp"
+#include <cmath>
+
+
+TEST(Quantizer, ChromaticShouldQuantizeToNearestNote) {
+	const Quantizer& quantizer = Quantizer::chromatic();
+
+	for (int octave = -5; octave < 5; octave++) {
+		for (int i = 0; i < 12; i++) {
+			float note = octave + (float) i / 12;
+			EXPECT_NEAR(quantizer.quantize(note), note, 0.0001f) << "note " << i << " in octave " << octave;
+			EXPECT_NEAR(quantizer.quantize(note + 0.04f), note, 0.0001f) << "note " << i << " in octave " << octave;
+			EXPECT_NEAR(quantizer.quantize(note - 0.04f), note, 0.0001f) << "note " << i << " in octave " << octave;
+			EXPECT_NEAR(quantizer.quantize((double) note + 0.04), note, 0.0001) << "note " << i << " in octave " << octave;
+			EXPECT_NEAR(quantizer.quantize((double) note - 0.04), note, 0.0001) << "note " << i << " in octave " << octave;
+		}
+	}
+}
+
+TEST(Quantizer, ShouldQuantizeToNearestNoteOfTuning) {
+	Quantizer quantizer({ .1f, .5f, .6f });
+
+	EXPECT_FLOAT_EQ(quantizer.quantize(.2f), .1f);
+	EXPECT_FLOAT_EQ(quantizer.quantize(.35f), .5f);
+	EXPECT_FLOAT_EQ(quantizer.quantize(.56f), .6f);
+	EXPECT_FLOAT_EQ(quantizer.quantize(.84f), .6f);
+	// Values near the end and start of an octave are quantized to the first note of the next octave or the last note of the previous octave
+	EXPECT_FLOAT_EQ(quantizer.quantize(.86f), 1.1f);
+	EXPECT_FLOAT_EQ(quantizer.quantize(.04f), .1f);
+	EXPECT_FLOAT_EQ(quantizer.quantize(-.1f), .1f);
+	EXPECT_FLOAT_EQ(quantizer.quantize(-.2f), -.4f);
+	EXPECT_FLOAT_EQ(quantizer.quantize(2.58f), 2.6f);
+}
+
+TEST(Quantizer, ShouldQuantizeToSingleNoteTuning) {
+	Quantizer quantizer({ .25f });
+
+	EXPECT_FLOAT_EQ(quantizer.quantize(.25f), .25f);
+	EXPECT_FLOAT_EQ(quantizer.quantize(.7f), .25f);
+	EXPECT_FLOAT_EQ(quantizer.quantize(.8f), 1.25f);
+	EXPECT_FLOAT_EQ(quantizer.quantize(-.2f), .25f);
+	EXPECT_FLOAT_EQ(quantizer.quantize(-.3f), -.75f);
+}
+
+TEST(Quantizer, ShouldQuantizeNotesCloserTogetherThanTheTableSteps) {
+	Quantizer quantizer({ .5f, .5f + 1.f / (QUANTIZER_TABLE_SIZE * 4), .5f + 2.f / (QUANTIZER_TABLE_SIZE * 4) });
+
+	EXPECT_FLOAT_EQ(quantizer.quantize(.5f + .4f / (QUANTIZER_TABLE_SIZE * 4)), .5f);
+	EXPECT_FLOAT_EQ(quantizer.quantize(.5f + 1.1f / (QUANTIZER_TABLE_SIZE * 4)), .5f + 1.f / (QUANTIZER_TABLE_SIZE * 4));
+	EXPECT_FLOAT_EQ(quantizer.quantize(.5f + 1.9f / (QUANTIZER_TABLE_SIZE * 4)), .5f + 2.f / (QUANTIZER_TABLE_SIZE * 4));
+}
+
+TEST(Quantizer, QuantizeNoteShouldReturnOctaveAndIndex) {
+	Quantizer quantizer({ 0.f, .25f, .5f, .75f });
+
+	QuantizedNote note = quantizer.quantizeNote(2.3);
+	EXPECT_EQ(note.octave, 2);
+	EXPECT_EQ(note.index, 1);
+
+	note = quantizer.quantizeNote(-.2);
+	EXPECT_EQ(note.octave, -1);
+	EXPECT_EQ(note.index, 3);
+
+	note = quantizer.quantizeNote(-.9);
+	EXPECT_EQ(note.octave, -1);
+	EXPECT_EQ(note.index, 0);
+
+	note = quantizer.quantizeNote(.9);
+	EXPECT_EQ(note.octave, 1);
+	EXPECT_EQ(note.index, 0);
+}
+
+TEST(Quantizer, ShouldQuantizeHalfwayValuesUpOrDownBasedOnTieBreak) {
+	Quantizer roundUpQuantizer({ 0.f, .5f });
+	Quantizer roundDownQuantizer({ 0.f, .5f }, QuantizerTieBreak::ROUND_DOWN);
+
+	EXPECT_FLOAT_EQ(roundUpQuantizer.quantize(.25f), .5f);
+	EXPECT_FLOAT_EQ(roundUpQuantizer.quantize(.75f), 1.f);
+	EXPECT_FLOAT_EQ(roundUpQuantizer.quantize(-.25f), 0.f);
+	EXPECT_DOUBLE_EQ(roundUpQuantizer.quantize(.25), .5);
+	EXPECT_FLOAT_EQ(roundDownQuantizer.quantize(.25f), 0.f);
+	EXPECT_FLOAT_EQ(roundDownQuantizer.quantize(.75f), .5f);
+	EXPECT_FLOAT_EQ(roundDownQuantizer.quantize(-.25f), -.5f);
+	EXPECT_DOUBLE_EQ(roundDownQuantizer.quantize(.25), 0.);
+	// Values next to the halfway point are still quantized to the nearest note
+	EXPECT_FLOAT_EQ(roundDownQuantizer.quantize(.2501f), .5f);
+	EXPECT_FLOAT_EQ(roundUpQuantizer.quantize(.2499f), 0.f);
+}
+
+TEST(Quantizer, BatchQuantizeShouldMatchSingleQuantize) {
+	Quantizer quantizer({ .1f, .3f, .7f });
+	float voltages[16];
+	for (int i = 0; i < 16; i++) {
+		voltages[i] = -4.f + i * .57f;
+	}
+
+	quantizer.quantize(voltages, 16);
+	for (int i = 0; i < 16; i++) {
+		EXPECT_EQ(voltages[i], quantizer.quantize(-4.f + i * .57f)) << "channel " << i;
+	}
+}
+
+TEST(Quantizer, VoltageToChromaticIndexShouldReturnNearestNoteIndex) {
+	for (int i = 0; i < 12; i++) {
+		EXPECT_EQ(voltageToChromaticIndex((float) i / 12), i);
+		EXPECT_EQ(voltageToChromaticIndex((float) i / 12 + .03f), i);
+		EXPECT_EQ(voltageToChromaticIndex(3.f + (float) (i + 1) / 12 - .03f), i + 1);
+		EXPECT_EQ(voltageToChromaticIndex(-2.f + (float) i / 12), i);
+	}
+	// Voltages that are quantized up to the next octave result in index 12
+	EXPECT_EQ(voltageToChromaticIndex(.98f), 12);
+	EXPECT_EQ(voltageToChromaticIndex(-.01f), 12);
+}
+
+TEST(Quantizer, ShouldReturnNonFiniteVoltagesUnchanged) {
+	Quantizer quantizer({ 0.f, 4.f / 12, 7.f / 12 });
+	float voltages[3] = { NAN, INFINITY, -INFINITY };
+
+	EXPECT_TRUE(std::isnan(quantizer.quantize(NAN)));
+	EXPECT_TRUE(std::isnan(quantizer.quantize((double) NAN)));
+	EXPECT_EQ(quantizer.quantize(INFINITY), INFINITY);
+	EXPECT_EQ(quantizer.quantize(-INFINITY), -INFINITY);
+	EXPECT_EQ(quantizer.quantize((double) INFINITY), INFINITY);
+	EXPECT_EQ(quantizer.quantize((double) -INFINITY), -INFINITY);
+
+	// Notes and note displays use the first note for non-finite voltages
+	for (float voltage : voltages) {
+		SCOPED_TRACE(voltage);
+		QuantizedNote note = quantizer.quantizeNote(voltage);
+		EXPECT_EQ(note.octave, 0);
+		EXPECT_EQ(note.index, 0);
+		EXPECT_EQ(voltageToChromaticIndex(voltage), 0);
+	}
+
+	quantizer.quantize(voltages, 3);
+	EXPECT_TRUE(std::isnan(voltages[0]));
+	EXPECT_EQ(voltages[1], INFINITY);
+	EXPECT_EQ(voltages[2], -INFINITY);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "util/random.hpp"
+
+
+TEST(RandomGenerator, SameSeedShouldGenerateSameValues) {
+	RandomGenerator generator1(42);
+	RandomGenerator generator2(42);
+
+	for (int i = 0; i < 100; i++) {
+		EXPECT_EQ(generator1(), generator2()) << "value " << i;
+	}
+}
+
+TEST(RandomGenerator, DifferentSeedsShouldGenerateDifferentValues) {
+	RandomGenerator generator1(42);
+	RandomGenerator generator2(43);
+
+	int equalCount = 0;
+	for (int i = 0; i < 100; i++) {
+		if (generator1() == generator2()) {
+			equalCount++;
+		}
+	}
+	EXPECT_LT(equalCount, 2);
+}
+
+TEST(RandomGenerator, ReseedingShouldRestartTheValues) {
+	RandomGenerator generator(1234);
+	std::vector<uint32_t> values;
+	for (int i = 0; i < 10; i++) {
+		values.push_back(generator());
+	}
+
+	generator.seed(1234);
+	for (int i = 0; i < 10; i++) {
+		EXPECT_EQ(generator(), values[i]) << "value " << i;
+	}
+}
+
+TEST(RandomGenerator, NextFloatShouldStayInRange) {
+	RandomGenerator generator(5);
+
+	float sum = 0.f;
+	for (int i = 0; i < 10000; i++) {
+		float value = generator.nextFloat();
+		EXPECT_GE(value, 0.f);
+		EXPECT_LT(value, 1.f);
+		sum += value;
+	}
+	// The values should be roughly uniformly distributed
+	EXPECT_NEAR(sum / 10000.f, .5f, .02f);
+
+	for (int i = 0; i < 1000; i++) {
+		float value = generator.nextFloat(-3.f, 7.f);
+		EXPECT_GE(value, -3.f);
+		EXPECT_LT(value, 7.f);
+	}
+}
+
+TEST(RandomGenerator, FillShouldGenerateTheSameValuesAsNextFloat) {
+	RandomGenerator generator1(99);
+	RandomGenerator generator2(99);
+	float values[11];
+
+	// Fill whole blocks first, followed by a partial block
+	generator1.fill(values, 11, -1.f, 1.f);
+	for (int i = 0; i < 11; i++) {
+		EXPECT_EQ(values[i], generator2.nextFloat(-1.f, 1.f)) << "value " << i;
+	}
+}
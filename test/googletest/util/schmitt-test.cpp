@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "util/schmitt.hpp"
+
+
+TEST(BatchSchmittTrigger, ShouldTriggerOnRisingEdgeOfEachChannel) {
+	BatchSchmittTrigger trigger;
+	float voltages[16] = {};
+
+	// The initial state is high, so a channel must go low before it can trigger
+	voltages[0] = 5.f;
+	EXPECT_EQ(trigger.process(voltages, 0xFFFF), 0);
+
+	voltages[0] = 0.f;
+	EXPECT_EQ(trigger.process(voltages, 0xFFFF), 0);
+
+	voltages[0] = 1.f;
+	voltages[3] = 2.f;
+	EXPECT_EQ(trigger.process(voltages, 0xFFFF), (1 << 0) | (1 << 3));
+
+	// Staying high should not trigger again
+	EXPECT_EQ(trigger.process(voltages, 0xFFFF), 0);
+	EXPECT_TRUE(trigger.isHigh(0));
+	EXPECT_TRUE(trigger.isHigh(3));
+}
+
+TEST(BatchSchmittTrigger, ShouldApplyHysteresis) {
+	BatchSchmittTrigger trigger;
+	float voltages[16] = {};
+	trigger.process(voltages, 0xFFFF);
+
+	// Between the thresholds, the state should not change
+	voltages[7] = .5f;
+	EXPECT_EQ(trigger.process(voltages, 0xFFFF), 0);
+	EXPECT_FALSE(trigger.isHigh(7));
+	voltages[7] = 1.5f;
+	EXPECT_EQ(trigger.process(voltages, 0xFFFF), 1 << 7);
+	voltages[7] = .5f;
+	EXPECT_EQ(trigger.process(voltages, 0xFFFF), 0);
+	EXPECT_TRUE(trigger.isHigh(7));
+	voltages[7] = 1.5f;
+	EXPECT_EQ(trigger.process(voltages, 0xFFFF), 0);
+	voltages[7] = 0.f;
+	EXPECT_EQ(trigger.process(voltages, 0xFFFF), 0);
+	voltages[7] = 1.5f;
+	EXPECT_EQ(trigger.process(voltages, 0xFFFF), 1 << 7);
+}
+
+TEST(BatchSchmittTrigger, ShouldIgnoreChannelsOutsideOfMask) {
+	BatchSchmittTrigger trigger;
+	float voltages[16] = {};
+	trigger.process(voltages, 0xFFFF);
+
+	for (int i = 0; i < 16; i++) {
+		voltages[i] = 10.f;
+	}
+	EXPECT_EQ(trigger.process(voltages, 0x0101), 0x0101);
+	// The other channels kept their low state, so they trigger once they are included
+	EXPECT_FALSE(trigger.isHigh(1));
+	EXPECT_EQ(trigger.process(voltages, 0xFFFF), 0xFEFE);
+}
+
+TEST(BatchSchmittTrigger, ResetShouldReturnToHighState) {
+	BatchSchmittTrigger trigger;
+	float voltages[16] = {};
+	trigger.process(voltages, 0xFFFF);
+	trigger.reset();
+
+	voltages[2] = 3.f;
+	EXPECT_EQ(trigger.process(voltages, 0xFFFF), 0);
+}
@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "util/triplebuffer.hpp"
+
+
+TEST(TripleBuffer, ShouldOnlyConsumeTheMostRecentlyPublishedBuffer) {
+	TripleBuffer<int> tripleBuffer;
+	EXPECT_FALSE(tripleBuffer.consume());
+
+	tripleBuffer.getWriteBuffer() = 1;
+	tripleBuffer.publish();
+	tripleBuffer.getWriteBuffer() = 2;
+	tripleBuffer.publish();
+
+	EXPECT_TRUE(tripleBuffer.consume());
+	EXPECT_EQ(tripleBuffer.getReadBuffer(), 2);
+	EXPECT_FALSE(tripleBuffer.consume());
+	EXPECT_EQ(tripleBuffer.getReadBuffer(), 2);
+}
+
+TEST(TripleBuffer, PublishShouldReportIfThePreviousBufferWasNeverConsumed) {
+	TripleBuffer<int> tripleBuffer;
+
+	tripleBuffer.getWriteBuffer() = 1;
+	EXPECT_FALSE(tripleBuffer.publish());
+	tripleBuffer.getWriteBuffer() = 2;
+	EXPECT_TRUE(tripleBuffer.publish());
+
+	EXPECT_TRUE(tripleBuffer.consume());
+	tripleBuffer.getWriteBuffer() = 3;
+	EXPECT_FALSE(tripleBuffer.publish());
+	tripleBuffer.getWriteBuffer() = 4;
+	EXPECT_TRUE(tripleBuffer.publish());
+}